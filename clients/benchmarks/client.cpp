@@ -20,6 +20,8 @@
  *
  * ************************************************************************ */
 
+// The GEMM solution queries used by --autotune are beta features
+#define ROCBLAS_BETA_FEATURES_API
 #include "program_options.hpp"
 
 #include "rocblas.h"
@@ -34,16 +36,20 @@
 #include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 // aux
+#include "testing_gemm_autotune.hpp"
 #include "testing_set_get_matrix.hpp"
 #include "testing_set_get_matrix_async.hpp"
+#include "testing_set_get_matrix_throughput.hpp"
 #include "testing_set_get_vector.hpp"
 #include "testing_set_get_vector_async.hpp"
+#include "testing_trsm_blksize_sweep.hpp"
 // blas1
 #include "testing_asum.hpp"
 #include "testing_asum_batched.hpp"
@@ -312,6 +318,8 @@ struct perf_blas<T, U, std::enable_if_t<std::is_same<T, float>{} || std::is_same
                 {"set_get_vector_async", testing_set_get_vector_async<T>},
                 {"set_get_matrix", testing_set_get_matrix<T>},
                 {"set_get_matrix_async", testing_set_get_matrix_async<T>},
+                {"set_matrix", testing_set_matrix<T>},
+                {"get_matrix", testing_get_matrix<T>},
                 // L1
                 {"asum", testing_asum<T>},
                 {"asum_batched", testing_asum_batched<T>},
@@ -487,6 +495,8 @@ struct perf_blas<T,
                 {"set_get_vector_async", testing_set_get_vector_async<T>},
                 {"set_get_matrix", testing_set_get_matrix<T>},
                 {"set_get_matrix_async", testing_set_get_matrix_async<T>},
+                {"set_matrix", testing_set_matrix<T>},
+                {"get_matrix", testing_get_matrix<T>},
                 // L1
                 {"asum", testing_asum<T>},
                 {"asum_batched", testing_asum_batched<T>},
@@ -1144,11 +1154,23 @@ int run_bench_test(
     return 0;
 }
 
+// Iterator over the data file records whose function contains filter
+// With an indexed data file, only the records of matching functions are visited
+static auto rocblas_bench_data_begin(const std::string& filter)
+{
+    return RocBLAS_TestData::begin_indexed([filter](const Arguments& arg) {
+        return filter.empty() || strstr(arg.function, filter.c_str());
+    });
+}
+
 int rocblas_bench_datafile(const std::string& filter, bool any_stride)
 {
     int ret = 0;
-    for(Arguments arg : RocBLAS_TestData())
+    for(auto it = rocblas_bench_data_begin(filter); it != RocBLAS_TestData::end(); ++it)
+    {
+        Arguments arg = *it;
         ret |= run_bench_test(true, arg, filter, any_stride, true);
+    }
     test_cleanup::cleanup();
     return ret;
 }
@@ -1239,6 +1261,9 @@ try
     std::string initialization;
     std::string arithmetic_check;
     std::string filter;
+    std::string trsm_blksize_sweep;
+    std::string autotune;
+    std::string autotune_problems;
     rocblas_int device_id;
     rocblas_int parallel_devices;
     int         flags               = 0;
@@ -1483,6 +1508,25 @@ try
          value<std::string>(&filter),
          "Simple strstr filter on function name only without wildcards")
 
+        ("trsm_blksize_sweep",
+         value<std::string>(&trsm_blksize_sweep),
+         "Time the trsm block sizes for --precision and write the tuned table to this file. "
+         "Uses --batch_count, --uplo, --transposeA, --diag, --iters and --cold_iters")
+
+        ("autotune",
+         value<std::string>(&autotune),
+         "Time every Tensile solution of each GEMM problem and write the fastest, where it beats "
+         "the default selection, to this override file for ROCBLAS_GEMM_OVERRIDE_PATH. Problems "
+         "are read from --yaml or --data, from --autotune_problems, or else taken from the "
+         "command line. Uses --iters and --cold_iters")
+
+        ("autotune_problems",
+         value<std::string>(&autotune_problems),
+         "CSV file of GEMM problems for --autotune. The header row names the columns among "
+         "transA, transB, M, N, K, lda, ldb, ldc, ldd, stride_a, stride_b, stride_c, stride_d, "
+         "batch_count, alpha, beta, precision, a_type, b_type, c_type, d_type and compute_type; "
+         "other fields, including the GEMM --function, are taken from the command line")
+
         ("help,h", "produces this help message")
 
         ("version", "Prints the version number");
@@ -1554,6 +1598,15 @@ try
     if(device_id >= 0)
         set_device(device_id);
 
+    if(datafile && !autotune.empty())
+    {
+        std::vector<Arguments> problems;
+        for(auto it = rocblas_bench_data_begin(filter); it != RocBLAS_TestData::end(); ++it)
+            problems.push_back(*it);
+        testing_gemm_autotune(problems, autotune);
+        return 0;
+    }
+
     if(datafile)
         return rocblas_bench_datafile(filter, any_stride);
 
@@ -1601,10 +1654,31 @@ try
     if(arg.K < 0)
         throw std::invalid_argument("Invalid value for -k " + std::to_string(arg.K));
 
+    if(!trsm_blksize_sweep.empty())
+    {
+        testing_trsm_blksize_sweep(arg, trsm_blksize_sweep);
+        return 0;
+    }
+
     int copied = snprintf(arg.function, sizeof(arg.function), "%s", function.c_str());
     if(copied <= 0 || copied >= sizeof(arg.function))
         throw std::invalid_argument("Invalid value for --function");
 
+    if(!autotune.empty())
+    {
+        std::vector<Arguments> problems{arg};
+        if(!autotune_problems.empty())
+        {
+            std::ifstream is(autotune_problems);
+            if(!is)
+                throw std::invalid_argument("Cannot read --autotune_problems "
+                                            + autotune_problems);
+            problems = gemm_autotune_read_csv(is, arg);
+        }
+        testing_gemm_autotune(problems, autotune);
+        return 0;
+    }
+
     if(!parallel_devices)
         return run_bench_test(true, arg, filter, any_stride);
     else
@@ -0,0 +1,170 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*******************************************************************************
+ * rocblas-handle-bench measures the latency of obtaining and giving up a      *
+ * handle, as a server using a handle per request does, with 1 to --threads    *
+ * threads at once. rocblas_create_handle and rocblas_destroy_handle are       *
+ * compared with rocblas_clone_handle and with a handle pool.                  *
+ *******************************************************************************/
+
+#include "rocblas.h"
+#include "utility.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#define CHECK_ROCBLAS(expr)                                                                 \
+    do                                                                                      \
+    {                                                                                       \
+        rocblas_status status_ = (expr);                                                    \
+        if(status_ != rocblas_status_success)                                               \
+        {                                                                                   \
+            rocblas_cerr << "rocBLAS error " << rocblas_status_to_string(status_) << " in " \
+                         << #expr << std::endl;                                             \
+            exit(EXIT_FAILURE);                                                             \
+        }                                                                                   \
+    } while(0)
+
+// Time iters calls to cycle from each of threads threads, returning the microseconds per call
+static double time_cycle(const std::function<void()>& cycle, size_t threads, size_t iters)
+{
+    std::mutex              mutex;
+    std::condition_variable cond;
+    bool                    start = false;
+
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < threads; ++t)
+        workers.emplace_back([&] {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return start; });
+            }
+            for(size_t i = 0; i < iters; ++i)
+                cycle();
+        });
+
+    auto begin = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        start = true;
+    }
+    cond.notify_all();
+
+    for(auto& w : workers)
+        w.join();
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / iters;
+}
+
+static void usage(const char* program)
+{
+    rocblas_cerr << "Usage: " << program << " [--iters n] [--threads n]\n"
+                 << "  --iters    handles obtained by each thread (default 200)\n"
+                 << "  --threads  maximum number of threads (default 16)\n"
+                 << std::flush;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iters       = 200;
+    size_t max_threads = 16;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--iters") && i + 1 < argc)
+            iters = strtoul(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "--threads") && i + 1 < argc)
+            max_threads = strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(!iters || !max_threads)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Each worker thread must use the device of the main thread
+    int device;
+    if(hipGetDevice(&device) != hipSuccess)
+    {
+        rocblas_cerr << "No HIP device" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The first handle initializes the library, which is not part of the measurement
+    rocblas_handle prototype;
+    CHECK_ROCBLAS(rocblas_create_handle(&prototype));
+
+    rocblas_cout << "threads,create_destroy_us,clone_destroy_us,pool_acquire_release_us"
+                 << std::endl;
+
+    for(size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        double create_us = time_cycle(
+            [&] {
+                (void)hipSetDevice(device);
+                rocblas_handle handle;
+                CHECK_ROCBLAS(rocblas_create_handle(&handle));
+                CHECK_ROCBLAS(rocblas_destroy_handle(handle));
+            },
+            threads,
+            iters);
+
+        double clone_us = time_cycle(
+            [&] {
+                rocblas_handle handle;
+                CHECK_ROCBLAS(rocblas_clone_handle(prototype, &handle));
+                CHECK_ROCBLAS(rocblas_destroy_handle(handle));
+            },
+            threads,
+            iters);
+
+        rocblas_handle_pool pool;
+        CHECK_ROCBLAS(rocblas_create_handle_pool(&pool, threads));
+        double pool_us = time_cycle(
+            [&] {
+                (void)hipSetDevice(device);
+                rocblas_handle handle;
+                CHECK_ROCBLAS(rocblas_handle_pool_acquire(pool, &handle));
+                CHECK_ROCBLAS(rocblas_handle_pool_release(pool, handle));
+            },
+            threads,
+            iters);
+        CHECK_ROCBLAS(rocblas_destroy_handle_pool(pool));
+
+        rocblas_cout << threads << "," << create_us << "," << clone_us << "," << pool_us
+                     << std::endl;
+    }
+
+    CHECK_ROCBLAS(rocblas_destroy_handle(prototype));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,429 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*******************************************************************************
+ * rocblas-level2-tune measures the crossover points between the gemv and symv *
+ * kernels on the current device, and writes the Level 2 threshold table, with *
+ * the entry for the device's architecture replaced, to a file which can be    *
+ * loaded with ROCBLAS_LEVEL2_THRESHOLD_PATH.                                  *
+ *                                                                             *
+ * Each threshold is measured on square problems at multiples of --step up to  *
+ * --max, or as large as fits in device memory, by timing its kernel forced on *
+ * and forced off. The threshold below which the kernel is used is the end of  *
+ * the leading run of sizes at which it wins, and the threshold above which it *
+ * is used is the start of the trailing run.                                   *
+ *******************************************************************************/
+
+#include "../../library/src/blas2/rocblas_level2_threshold.hpp"
+#include "rocblas.h"
+#include "utility.hpp"
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+#define CHECK_HIP(expr)                                                           \
+    do                                                                            \
+    {                                                                             \
+        hipError_t status_ = (expr);                                              \
+        if(status_ != hipSuccess)                                                 \
+        {                                                                         \
+            rocblas_cerr << "hip error " << hipGetErrorString(status_) << " in " \
+                         << #expr << std::endl;                                   \
+            exit(EXIT_FAILURE);                                                   \
+        }                                                                         \
+    } while(0)
+
+#define CHECK_ROCBLAS(expr)                                                                 \
+    do                                                                                      \
+    {                                                                                       \
+        rocblas_status status_ = (expr);                                                    \
+        if(status_ != rocblas_status_success)                                               \
+        {                                                                                   \
+            rocblas_cerr << "rocBLAS error " << rocblas_status_to_string(status_) << " in " \
+                         << #expr << std::endl;                                             \
+            exit(EXIT_FAILURE);                                                             \
+        }                                                                                   \
+    } while(0)
+
+static rocblas_status gemv(rocblas_handle    h,
+                           rocblas_operation op,
+                           rocblas_int       n,
+                           const float*      alpha,
+                           const float*      A,
+                           const float*      x,
+                           const float*      beta,
+                           float*            y)
+{
+    return rocblas_sgemv(h, op, n, n, alpha, A, n, x, 1, beta, y, 1);
+}
+
+static rocblas_status gemv(rocblas_handle    h,
+                           rocblas_operation op,
+                           rocblas_int       n,
+                           const double*     alpha,
+                           const double*     A,
+                           const double*     x,
+                           const double*     beta,
+                           double*           y)
+{
+    return rocblas_dgemv(h, op, n, n, alpha, A, n, x, 1, beta, y, 1);
+}
+
+static rocblas_status gemv(rocblas_handle               h,
+                           rocblas_operation            op,
+                           rocblas_int                  n,
+                           const rocblas_float_complex* alpha,
+                           const rocblas_float_complex* A,
+                           const rocblas_float_complex* x,
+                           const rocblas_float_complex* beta,
+                           rocblas_float_complex*       y)
+{
+    return rocblas_cgemv(h, op, n, n, alpha, A, n, x, 1, beta, y, 1);
+}
+
+static rocblas_status gemv(rocblas_handle                h,
+                           rocblas_operation             op,
+                           rocblas_int                   n,
+                           const rocblas_double_complex* alpha,
+                           const rocblas_double_complex* A,
+                           const rocblas_double_complex* x,
+                           const rocblas_double_complex* beta,
+                           rocblas_double_complex*       y)
+{
+    return rocblas_zgemv(h, op, n, n, alpha, A, n, x, 1, beta, y, 1);
+}
+
+static rocblas_status symv(rocblas_handle h,
+                           rocblas_fill   uplo,
+                           rocblas_int    n,
+                           const float*   alpha,
+                           const float*   A,
+                           const float*   x,
+                           const float*   beta,
+                           float*         y)
+{
+    return rocblas_ssymv(h, uplo, n, alpha, A, n, x, 1, beta, y, 1);
+}
+
+static rocblas_status symv(rocblas_handle h,
+                           rocblas_fill   uplo,
+                           rocblas_int    n,
+                           const double*  alpha,
+                           const double*  A,
+                           const double*  x,
+                           const double*  beta,
+                           double*        y)
+{
+    return rocblas_dsymv(h, uplo, n, alpha, A, n, x, 1, beta, y, 1);
+}
+
+struct tune_options
+{
+    rocblas_int step  = 1024;
+    rocblas_int max   = 32768;
+    int         iters = 10;
+};
+
+// Thresholds on either side of the sizes at which a kernel wins
+struct crossover
+{
+    rocblas_int upper; // last size of the leading run of wins, or 0 if there is none
+    rocblas_int lower; // first size of the trailing run of wins, or INT_MAX if there is none
+};
+
+// Convert to thresholds which the size must be below, or above
+static rocblas_int below(const crossover& c)
+{
+    return c.upper == INT_MAX ? INT_MAX : c.upper + (c.upper > 0);
+}
+
+static rocblas_int above(const crossover& c)
+{
+    return c.lower == INT_MAX ? INT_MAX : c.lower - 1;
+}
+
+static crossover find_crossover(const std::vector<rocblas_int>& sizes,
+                                const std::vector<bool>&        wins)
+{
+    size_t lead = 0, trail = sizes.size();
+    while(lead < sizes.size() && wins[lead])
+        ++lead;
+    while(trail > lead && wins[trail - 1])
+        --trail;
+
+    if(lead == sizes.size())
+        return {INT_MAX, sizes.empty() ? INT_MAX : sizes[0]};
+    return {lead ? sizes[lead - 1] : 0, trail < sizes.size() ? sizes[trail] : INT_MAX};
+}
+
+template <typename T>
+class level2_tuner
+{
+    rocblas_handle             handle;
+    rocblas_level2_thresholds& thresholds;
+    const tune_options&        options;
+    std::vector<rocblas_int>   sizes;
+    T *                        dA = nullptr, *dx = nullptr, *dy = nullptr;
+    hipEvent_t                 start, stop;
+    const char*                precision;
+
+    double time_us(const std::function<rocblas_status()>& call)
+    {
+        CHECK_ROCBLAS(call());
+        CHECK_HIP(hipEventRecord(start, nullptr));
+        for(int i = 0; i < options.iters; ++i)
+            CHECK_ROCBLAS(call());
+        CHECK_HIP(hipEventRecord(stop, nullptr));
+        CHECK_HIP(hipEventSynchronize(stop));
+        float ms;
+        CHECK_HIP(hipEventElapsedTime(&ms, start, stop));
+        return 1000.0 * ms / options.iters;
+    }
+
+    // Time the kernel with the thresholds set by on and by off, at size(s) for each of sizes
+    crossover measure(const char*                                       name,
+                      const std::function<void()>&                      on,
+                      const std::function<void()>&                      off,
+                      const std::function<rocblas_int(rocblas_int)>&    size,
+                      const std::function<rocblas_status(rocblas_int)>& call)
+    {
+        rocblas_level2_thresholds saved = thresholds;
+        std::vector<rocblas_int>  ns;
+        std::vector<bool>         wins;
+        for(rocblas_int s : sizes)
+        {
+            rocblas_int n = size(s);
+            ns.push_back(n);
+            on();
+            double on_us = time_us([&] { return call(n); });
+            thresholds   = saved;
+            off();
+            double off_us = time_us([&] { return call(n); });
+            thresholds    = saved;
+
+            wins.push_back(on_us < off_us);
+            rocblas_cout << precision << ',' << name << ',' << n << ',' << on_us << ','
+                         << off_us << std::endl;
+        }
+        return find_crossover(ns, wins);
+    }
+
+public:
+    level2_tuner(rocblas_handle             handle,
+                 rocblas_level2_thresholds& thresholds,
+                 const tune_options&        options,
+                 const char*                precision)
+        : handle(handle)
+        , thresholds(thresholds)
+        , options(options)
+        , precision(precision)
+    {
+        // Sweep up to the largest square matrix which fits in half the free memory
+        size_t free_bytes, total_bytes;
+        CHECK_HIP(hipMemGetInfo(&free_bytes, &total_bytes));
+        auto fit = rocblas_int(std::sqrt(double(free_bytes / 2 / sizeof(T))));
+        for(rocblas_int s = options.step; s <= std::min(options.max, fit); s += options.step)
+            sizes.push_back(s);
+
+        rocblas_int n = sizes.empty() ? 1 : sizes.back();
+        CHECK_HIP(hipMalloc(&dA, sizeof(T) * n * n));
+        CHECK_HIP(hipMalloc(&dx, sizeof(T) * n));
+        CHECK_HIP(hipMalloc(&dy, sizeof(T) * n));
+        CHECK_HIP(hipMemset(dA, 0, sizeof(T) * n * n));
+        CHECK_HIP(hipMemset(dx, 0, sizeof(T) * n));
+        CHECK_HIP(hipMemset(dy, 0, sizeof(T) * n));
+        CHECK_HIP(hipEventCreate(&start));
+        CHECK_HIP(hipEventCreate(&stop));
+    }
+
+    ~level2_tuner()
+    {
+        (void)hipFree(dA);
+        (void)hipFree(dx);
+        (void)hipFree(dy);
+        (void)hipEventDestroy(start);
+        (void)hipEventDestroy(stop);
+    }
+
+    void tune_gemv()
+    {
+        static constexpr bool real = std::is_same<T, float>{} || std::is_same<T, double>{};
+        const T               alpha(1), beta(0);
+        auto&                 t    = thresholds;
+        auto                  same = [](rocblas_int s) { return s; };
+
+        auto gemv_call = [&](rocblas_operation op) {
+            return [&, op](rocblas_int n) {
+                return gemv(handle, op, n, &alpha, dA, dx, &beta, dy);
+            };
+        };
+
+        crossover c = measure(
+            "gemvn_upper",
+            [&] { t.gemvn_upper = INT_MAX; },
+            [&] { t.gemvn_upper = 0, t.gemvn_lower = INT_MAX; },
+            same,
+            gemv_call(rocblas_operation_none));
+        t.gemvn_upper = c.upper;
+        t.gemvn_lower = c.lower;
+
+        if(real)
+        {
+            c = measure(
+                "gemvt_double_buffered_lower",
+                [&] { t.gemvt_double_buffered_lower = 0; },
+                [&] { t.gemvt_double_buffered_lower = INT_MAX; },
+                same,
+                gemv_call(rocblas_operation_transpose));
+            t.gemvt_double_buffered_lower = above(c);
+        }
+
+        c = measure(
+            "gemvt_warp_reduce_upper",
+            [&] { t.gemvt_warp_reduce_upper = INT_MAX; },
+            [&] { t.gemvt_warp_reduce_upper = 0; },
+            same,
+            gemv_call(rocblas_operation_transpose));
+        t.gemvt_warp_reduce_upper = below(c);
+
+        c = measure(
+            "gemvt_shared_reduce_upper",
+            [&] { t.gemvt_shared_reduce_upper = INT_MAX; },
+            [&] { t.gemvt_shared_reduce_upper = 0; },
+            same,
+            gemv_call(rocblas_operation_transpose));
+        t.gemvt_shared_reduce_upper = below(c);
+    }
+
+    void tune_symv()
+    {
+        const T alpha(1), beta(0);
+        auto&   t = thresholds;
+
+        for(rocblas_fill uplo : {rocblas_fill_upper, rocblas_fill_lower})
+        {
+            const bool upper = uplo == rocblas_fill_upper;
+            auto       call  = [&, uplo](rocblas_int n) {
+                return symv(handle, uplo, n, &alpha, dA, dx, &beta, dy);
+            };
+
+            for(bool aligned : {true, false})
+            {
+                rocblas_int& symv_upper = upper ? aligned ? t.symv_U_upper : t.symv_U_generic_upper
+                                                : aligned ? t.symv_L_upper : t.symv_L_generic_upper;
+                rocblas_int& symv_lower = upper ? aligned ? t.symv_U_lower : t.symv_U_generic_lower
+                                                : aligned ? t.symv_L_lower : t.symv_L_generic_lower;
+
+                crossover c = measure(
+                    upper ? aligned ? "symv_U" : "symv_U_generic"
+                          : aligned ? "symv_L" : "symv_L_generic",
+                    [&] { symv_upper = INT_MAX; },
+                    [&] { symv_upper = 0, symv_lower = INT_MAX; },
+                    [aligned](rocblas_int s) { return aligned ? s : s - 17; },
+                    call);
+                symv_upper = below(c);
+                symv_lower = above(c);
+            }
+        }
+    }
+};
+
+static void usage(const char* program)
+{
+    rocblas_cerr << "Usage: " << program
+                 << " [--output file] [--step n] [--max n] [--iters n]\n"
+                 << "  --output  threshold file to write (default rocblas_level2_thresholds.txt)\n"
+                 << "  --step    step between the measured sizes (default 1024)\n"
+                 << "  --max     largest measured size (default 32768)\n"
+                 << "  --iters   timed calls per measurement (default 10)\n"
+                 << std::flush;
+}
+
+int main(int argc, char* argv[])
+{
+    tune_options options;
+    std::string  output = "rocblas_level2_thresholds.txt";
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--output") && i + 1 < argc)
+            output = argv[++i];
+        else if(!strcmp(argv[i], "--step") && i + 1 < argc)
+            options.step = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--max") && i + 1 < argc)
+            options.max = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--iters") && i + 1 < argc)
+            options.iters = atoi(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The double buffered gemvt kernel needs sizes which are multiples of 64
+    if(options.step <= 0 || options.step % 64 || options.max < options.step || options.iters <= 0)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The architecture gets an entry of its own before the handle looks it up, so that
+    // changes to the entry apply to the handle
+    const std::string            arch    = rocblas_internal_get_arch_name();
+    rocblas_level2_threshold_db& db      = rocblas_level2_current_threshold_db();
+    auto&                        entry   = db.archs.emplace(arch, db.lookup(arch)).first->second;
+    const char*                  names[] = {"s", "d", "c", "z"};
+
+    rocblas_handle handle;
+    CHECK_ROCBLAS(rocblas_create_handle(&handle));
+
+    rocblas_cout << "precision,threshold,n,on_us,off_us" << std::endl;
+    {
+        level2_tuner<float> tuner(handle, entry[0], options, names[0]);
+        tuner.tune_gemv();
+        tuner.tune_symv();
+    }
+    {
+        level2_tuner<double> tuner(handle, entry[1], options, names[1]);
+        tuner.tune_gemv();
+        tuner.tune_symv();
+    }
+    level2_tuner<rocblas_float_complex>(handle, entry[2], options, names[2]).tune_gemv();
+    level2_tuner<rocblas_double_complex>(handle, entry[3], options, names[3]).tune_gemv();
+
+    CHECK_ROCBLAS(rocblas_destroy_handle(handle));
+
+    std::ofstream os(output);
+    rocblas_level2_thresholds_write(os, db);
+    if(!os.flush())
+    {
+        rocblas_cerr << "Cannot write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    rocblas_cout << "Wrote Level 2 thresholds for " << arch << " to " << output << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*******************************************************************************
+ * rocblas-log-decode converts a binary log, written when ROCBLAS_LAYER        *
+ * includes rocblas_layer_mode_log_binary (8), into the text of trace or bench *
+ * logging.                                                                    *
+ *******************************************************************************/
+
+#include "rocblas_binary_log.hpp"
+#include <cstring>
+#include <fstream>
+
+static void usage(const char* program)
+{
+    rocblas_cerr << "Usage: " << program << " [--trace | --bench] [--timestamps] file\n"
+                 << "  --trace       decode trace logging records (default)\n"
+                 << "  --bench       decode bench logging records\n"
+                 << "  --timestamps  prefix each line with the time in microseconds since the\n"
+                 << "                log was opened, and the number of the calling thread\n"
+                 << std::flush;
+}
+
+int main(int argc, char* argv[])
+{
+    rocblas_binary_log_kind kind       = rocblas_binary_log_kind::trace;
+    bool                    timestamps = false;
+    const char*             path       = nullptr;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--trace"))
+            kind = rocblas_binary_log_kind::trace;
+        else if(!strcmp(argv[i], "--bench"))
+            kind = rocblas_binary_log_kind::bench;
+        else if(!strcmp(argv[i], "--timestamps"))
+            timestamps = true;
+        else if(!path && argv[i][0] != '-')
+            path = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(!path)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if(!in)
+    {
+        rocblas_cerr << "Cannot open " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    rocblas_binary_log_summary summary;
+    if(!rocblas_binary_log_decode(in, kind, rocblas_cout, timestamps, summary))
+    {
+        rocblas_cerr << path << " is not a rocBLAS binary log" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if(summary.truncated)
+        rocblas_cerr << summary.truncated << " records had too many arguments and were truncated"
+                     << std::endl;
+    if(summary.dropped)
+        rocblas_cerr << summary.dropped << " records were dropped because a buffer was full"
+                     << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,190 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*******************************************************************************
+ * rocblas-profile-bench measures the cost per call of recording a function's  *
+ * arguments for profile logging, with 1 to 64 threads calling at once. The    *
+ * sharded table used by the library is compared with the previous table, in   *
+ * which all threads shared one map and one lock.                              *
+ *******************************************************************************/
+
+#include "logging.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+// The argument profile table before it was sharded: one map and one lock shared by all threads
+template <typename TUP>
+class locked_argument_profile
+{
+    mutable std::shared_timed_mutex mutex;
+
+    std::unordered_map<TUP,
+                       size_t,
+                       typename tuple_helper::hash_t<TUP>,
+                       typename tuple_helper::equal_t<TUP>>
+        map;
+
+public:
+    void operator()(TUP&& arg)
+    {
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex);
+            auto                                      p = map.find(arg);
+            if(p != map.end())
+            {
+                __atomic_fetch_add(&p->second, 1, __ATOMIC_SEQ_CST);
+                return;
+            }
+        }
+        {
+            std::lock_guard<std::shared_timed_mutex> lock(mutex);
+            map.emplace(std::move(arg), 0).first->second++;
+        }
+    }
+};
+
+// Arguments of the form recorded by log_profile for rocblas_sgemm
+static auto profile_args(size_t i, size_t distinct)
+{
+    rocblas_int size = rocblas_int(64 * (1 + i % distinct));
+    return std::make_tuple("rocblas_function",
+                           "rocblas_sgemm",
+                           "atomics_mode",
+                           rocblas_atomics_allowed,
+                           "transA",
+                           'N',
+                           "transB",
+                           'T',
+                           "M",
+                           size,
+                           "N",
+                           size,
+                           "K",
+                           rocblas_int(128),
+                           "lda",
+                           size,
+                           "ldb",
+                           size,
+                           "ldc",
+                           size);
+}
+
+using profile_tuple = decltype(profile_args(0, 1));
+
+// Time calls to profile from each of threads threads, returning the nanoseconds per call
+template <typename PROFILE>
+static double time_profile(PROFILE& profile, size_t threads, size_t calls, size_t distinct)
+{
+    std::mutex              mutex;
+    std::condition_variable cond;
+    bool                    start = false;
+
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < threads; ++t)
+        workers.emplace_back([&, t] {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return start; });
+            }
+            // Each thread visits the same arguments, starting at a different one
+            for(size_t i = 0; i < calls; ++i)
+                profile(profile_args(i + t * 7, distinct));
+        });
+
+    auto begin = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        start = true;
+    }
+    cond.notify_all();
+
+    for(auto& w : workers)
+        w.join();
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / calls;
+}
+
+static void usage(const char* program)
+{
+    rocblas_cerr << "Usage: " << program << " [--calls n] [--distinct n]\n"
+                 << "  --calls     calls made by each thread (default 200000)\n"
+                 << "  --distinct  number of distinct argument tuples (default 64)\n"
+                 << std::flush;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t calls    = 200000;
+    size_t distinct = 64;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--calls") && i + 1 < argc)
+            calls = strtoul(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "--distinct") && i + 1 < argc)
+            distinct = strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(!calls || !distinct)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The sharded profile dumps its counts on destruction, which is discarded
+    rocblas_internal_ostream null_os(NULL_DEVICE);
+
+    rocblas_cout << "threads,locked_ns_per_call,sharded_ns_per_call,speedup" << std::endl;
+
+    for(size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        double locked_ns, sharded_ns;
+        {
+            locked_argument_profile<profile_tuple> profile;
+            locked_ns = time_profile(profile, threads, calls, distinct);
+        }
+        {
+            argument_profile<profile_tuple> profile(null_os);
+            sharded_ns = time_profile(profile, threads, calls, distinct);
+        }
+
+        rocblas_cout << threads << "," << locked_ns << "," << sharded_ns << ","
+                     << locked_ns / sharded_ns << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -575,6 +575,186 @@ void cblas_geam(rocblas_operation       transa,
 }
 
 // gemm
+
+// Panel sizes for the reference gemm of types which cblas does not support
+constexpr size_t cblas_gemm_panel_k = 256;
+constexpr size_t cblas_gemm_panel_n = 1024;
+
+inline void cblas_gemm_panel(rocblas_operation transA,
+                             rocblas_operation transB,
+                             size_t            m,
+                             size_t            n,
+                             size_t            k,
+                             float             alpha,
+                             const float*      A,
+                             size_t            lda,
+                             const float*      B,
+                             size_t            ldb,
+                             float             beta,
+                             float*            C,
+                             size_t            ldc)
+{
+    cblas_sgemm(CblasColMajor,
+                static_cast<CBLAS_TRANSPOSE>(transA),
+                static_cast<CBLAS_TRANSPOSE>(transB),
+                m,
+                n,
+                k,
+                alpha,
+                A,
+                lda,
+                B,
+                ldb,
+                beta,
+                C,
+                ldc);
+}
+
+inline void cblas_gemm_panel(rocblas_operation transA,
+                             rocblas_operation transB,
+                             size_t            m,
+                             size_t            n,
+                             size_t            k,
+                             double            alpha,
+                             const double*     A,
+                             size_t            lda,
+                             const double*     B,
+                             size_t            ldb,
+                             double            beta,
+                             double*           C,
+                             size_t            ldc)
+{
+    cblas_dgemm(CblasColMajor,
+                static_cast<CBLAS_TRANSPOSE>(transA),
+                static_cast<CBLAS_TRANSPOSE>(transB),
+                m,
+                n,
+                k,
+                alpha,
+                A,
+                lda,
+                B,
+                ldb,
+                beta,
+                C,
+                ldc);
+}
+
+// Copy the rows x cols block at (row, col) of src into dst with leading dimension rows
+template <typename Td, typename Ts, typename F>
+void cblas_gemm_pack(
+    Td* dst, const Ts* src, size_t ld, size_t row, size_t col, size_t rows, size_t cols, F convert)
+{
+#pragma omp parallel for if(rows * cols >= 16384)
+    for(size_t j = 0; j < cols; j++)
+        for(size_t i = 0; i < rows; i++)
+            dst[i + j * rows] = convert(src[row + i + (col + j) * ld]);
+}
+
+// Compute C = alpha * op(A) * op(B) + beta * C in the cblas type Tc, converting a panel of
+// cblas_gemm_panel_k columns of op(A) and rows of op(B), and a block of cblas_gemm_panel_n
+// columns of C, at a time. The panels keep their storage order, so op is applied by cblas.
+template <typename Tc, typename Ti, typename To, typename FI, typename FC>
+void cblas_gemm_panels(rocblas_operation transA,
+                       rocblas_operation transB,
+                       rocblas_int       m,
+                       rocblas_int       n,
+                       rocblas_int       k,
+                       Tc                alpha,
+                       const Ti*         A,
+                       rocblas_int       lda,
+                       const Ti*         B,
+                       rocblas_int       ldb,
+                       Tc                beta,
+                       To*               C,
+                       rocblas_int       ldc,
+                       FI                convert_in,
+                       FC                convert_c)
+{
+    if(m <= 0 || n <= 0 || k < 0)
+        return;
+
+    constexpr bool convert_C = !std::is_same<To, Tc>{};
+
+    size_t M = m, N = n, K = k;
+
+    size_t kb_max = std::max(std::min(K, cblas_gemm_panel_k), size_t(1));
+    size_t nb_max = std::min(N, cblas_gemm_panel_n);
+
+    host_vector<Tc> A_panel(M * kb_max), B_panel(kb_max * nb_max);
+    host_vector<Tc> C_block(convert_C ? M * nb_max : 0);
+
+    for(size_t j0 = 0; j0 < N; j0 += nb_max)
+    {
+        size_t nb = std::min(nb_max, N - j0);
+
+        Tc*    C_ptr;
+        size_t C_ld;
+        if constexpr(convert_C)
+        {
+            C_ptr = C_block;
+            C_ld  = M;
+            cblas_gemm_pack(C_ptr, C, ldc, 0, j0, M, nb, convert_c);
+        }
+        else
+        {
+            C_ptr = C + j0 * ldc;
+            C_ld  = ldc;
+        }
+
+        // One pass with an empty panel when k == 0 scales C by beta
+        size_t k0 = 0;
+        do
+        {
+            size_t kb = std::min(kb_max, K - k0);
+
+            size_t A_ld = transA == rocblas_operation_none ? M : std::max(kb, size_t(1));
+            if(transA == rocblas_operation_none)
+                cblas_gemm_pack((Tc*)A_panel, A, lda, 0, k0, M, kb, convert_in);
+            else
+                cblas_gemm_pack((Tc*)A_panel, A, lda, k0, 0, kb, M, convert_in);
+
+            size_t B_ld = transB == rocblas_operation_none ? std::max(kb, size_t(1)) : nb;
+            if(transB == rocblas_operation_none)
+                cblas_gemm_pack((Tc*)B_panel, B, ldb, k0, j0, kb, nb, convert_in);
+            else
+                cblas_gemm_pack((Tc*)B_panel, B, ldb, j0, k0, nb, kb, convert_in);
+
+            cblas_gemm_panel(transA,
+                             transB,
+                             M,
+                             nb,
+                             kb,
+                             alpha,
+                             A_panel,
+                             A_ld,
+                             B_panel,
+                             B_ld,
+                             k0 ? Tc(1) : beta,
+                             C_ptr,
+                             C_ld);
+
+            k0 += kb;
+        } while(k0 < K);
+
+        if constexpr(convert_C)
+        {
+#pragma omp parallel for if(M * nb >= 16384)
+            for(size_t j = 0; j < nb; j++)
+                for(size_t i = 0; i < M; i++)
+                    C[i + (j0 + j) * ldc] = static_cast<To>(C_block[i + j * M]);
+        }
+    }
+}
+
+// cblas does not support rocblas_bfloat16 or rocblas_half, so compute in higher precision float
+// This will give more precise result which is acceptable for testing
+template <typename Ti>
+inline float cblas_gemm_to_float(Ti x)
+{
+    return static_cast<float>(x);
+}
+
 template <>
 void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation       transA,
                                                 rocblas_operation       transB,
@@ -591,35 +771,21 @@ void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation       transA,
                                                 rocblas_int             ldc,
                                                 bool                    alt)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    cblas_gemm_panels(transA,
+                      transB,
+                      m,
+                      n,
+                      k,
+                      alpha,
+                      A,
+                      lda,
+                      B,
+                      ldb,
+                      beta,
+                      C,
+                      ldc,
+                      cblas_gemm_to_float<rocblas_bfloat16>,
+                      cblas_gemm_to_float<float>);
 }
 
 template <>
@@ -638,41 +804,21 @@ void cblas_gemm<rocblas_bfloat16, rocblas_bfloat16, float>(rocblas_operation
                                                            rocblas_int             ldc,
                                                            bool                    alt)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<rocblas_bfloat16>(C_float[i]);
+    cblas_gemm_panels(transA,
+                      transB,
+                      m,
+                      n,
+                      k,
+                      alpha,
+                      A,
+                      lda,
+                      B,
+                      ldb,
+                      beta,
+                      C,
+                      ldc,
+                      cblas_gemm_to_float<rocblas_bfloat16>,
+                      cblas_gemm_to_float<rocblas_bfloat16>);
 }
 
 template <>
@@ -691,35 +837,21 @@ void cblas_gemm<rocblas_half, float, float>(rocblas_operation   transA,
                                             rocblas_int         ldc,
                                             bool                alt)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    cblas_gemm_panels(transA,
+                      transB,
+                      m,
+                      n,
+                      k,
+                      alpha,
+                      A,
+                      lda,
+                      B,
+                      ldb,
+                      beta,
+                      C,
+                      ldc,
+                      cblas_gemm_to_float<rocblas_half>,
+                      cblas_gemm_to_float<float>);
 }
 
 template <>
@@ -738,56 +870,43 @@ void cblas_gemm<rocblas_half, rocblas_half, float>(rocblas_operation   transA,
                                                    rocblas_int         ldc,
                                                    bool                alt)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
+    // alt rounds the inputs as the device does, by truncation to rocblas_bfloat16
+    auto to_alt_float = [](rocblas_half x) -> float {
+        return rocblas_bfloat16(float(x), rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
+    };
 
     if(alt)
-    {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = rocblas_bfloat16(float(A[i]),
-                                          rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = rocblas_bfloat16(float(B[i]),
-                                          rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = rocblas_bfloat16(float(C[i]),
-                                          rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
-    }
+        cblas_gemm_panels(transA,
+                          transB,
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          A,
+                          lda,
+                          B,
+                          ldb,
+                          beta,
+                          C,
+                          ldc,
+                          to_alt_float,
+                          to_alt_float);
     else
-    {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = A[i];
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = C[i];
-    }
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+        cblas_gemm_panels(transA,
+                          transB,
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          A,
+                          lda,
+                          B,
+                          ldb,
+                          beta,
+                          C,
+                          ldc,
+                          cblas_gemm_to_float<rocblas_half>,
+                          cblas_gemm_to_float<rocblas_half>);
 }
 
 template <>
@@ -806,43 +925,21 @@ void cblas_gemm<rocblas_half, rocblas_half, rocblas_half>(rocblas_operation   tr
                                                           rocblas_int         ldc,
                                                           bool                alt)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-    float alpha_float = alpha;
-    float beta_float  = beta;
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = C[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha_float,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta_float,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+    cblas_gemm_panels(transA,
+                      transB,
+                      m,
+                      n,
+                      k,
+                      float(alpha),
+                      A,
+                      lda,
+                      B,
+                      ldb,
+                      float(beta),
+                      C,
+                      ldc,
+                      cblas_gemm_to_float<rocblas_half>,
+                      cblas_gemm_to_float<rocblas_half>);
 }
 
 template <>
@@ -866,40 +963,23 @@ void cblas_gemm<int8_t, int32_t, int32_t>(rocblas_operation transA,
     // floats, so convert to doubles and downcast result down to int32_t.
     // NOTE: This will not properly account for 32-bit integer overflow, however
     //       the result should be acceptable for testing.
-
-    size_t const sizeA = ((transA == rocblas_operation_none) ? k : m) * size_t(lda);
-    size_t const sizeB = ((transB == rocblas_operation_none) ? n : k) * size_t(ldb);
-    size_t const sizeC = n * size_t(ldc);
-
-    host_vector<double> A_double(sizeA);
-    host_vector<double> B_double(sizeB);
-    host_vector<double> C_double(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_double[i] = static_cast<double>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_double[i] = static_cast<double>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_double[i] = static_cast<double>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    cblas_dgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_double,
-                lda,
-                B_double,
-                ldb,
-                beta,
-                C_double,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<int32_t>(C_double[i]);
+    auto to_double = [](auto x) -> double { return static_cast<double>(x); };
+
+    cblas_gemm_panels(transA,
+                      transB,
+                      m,
+                      n,
+                      k,
+                      double(alpha),
+                      A,
+                      lda,
+                      B,
+                      ldb,
+                      double(beta),
+                      C,
+                      ldc,
+                      to_double,
+                      to_double);
 }
 
 template <typename T>
@@ -29,13 +29,126 @@
 #include <string.h>
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <malloc.h>
+#include <mutex>
 #include <stdlib.h>
+#include <string>
+#include <vector>
 
 #include "host_alloc.hpp"
 #include "rocblas_test.hpp"
 
+#ifndef WIN32
+
+namespace
+{
+    // Reads the first number of a file, or the value of a "key value" line of it.
+    // Returns -1 if the file or key does not exist, or the value is not a number ("max").
+    ptrdiff_t read_host_mem_value(const std::string& path, const char* key = nullptr)
+    {
+        FILE* fp = fopen(path.c_str(), "r");
+        if(!fp)
+            return -1;
+
+        const int BUF_MAX = 1024;
+        char      buf[BUF_MAX];
+        ptrdiff_t value = -1;
+        size_t    len   = key ? strlen(key) : 0;
+
+        while(fgets(buf, BUF_MAX, fp))
+        {
+            if(key && (strncmp(buf, key, len) || (buf[len] != ' ' && buf[len] != ':')))
+                continue;
+            long long n;
+            if(sscanf(buf + len + (key ? 1 : 0), "%lld", &n) == 1)
+                value = n;
+            break;
+        }
+
+        fclose(fp);
+        return value;
+    }
+
+    // Directories of the memory cgroup of this process and of its ancestors, leaf first, with
+    // the names of the limit, usage and inactive file statistic of the cgroup version in use
+    struct host_mem_cgroup
+    {
+        std::vector<std::string> dirs;
+        const char*              limit    = nullptr;
+        const char*              usage    = nullptr;
+        const char*              inactive = nullptr;
+
+        host_mem_cgroup()
+        {
+            FILE* fp = fopen("/proc/self/cgroup", "r");
+            if(!fp)
+                return;
+
+            // Lines are hierarchy-ID:controller-list:cgroup-path, with an empty controller list
+            // for cgroup v2
+            std::string root, path;
+            const int   BUF_MAX = 4096;
+            char        buf[BUF_MAX];
+            while(fgets(buf, BUF_MAX, fp))
+            {
+                char* controllers = strchr(buf, ':');
+                char* cgroup      = controllers ? strchr(controllers + 1, ':') : nullptr;
+                if(!cgroup)
+                    continue;
+                *controllers++                 = '\0';
+                *cgroup++                      = '\0';
+                cgroup[strcspn(cgroup, "\n")] = '\0';
+
+                if((',' + std::string(controllers) + ',').find(",memory,") != std::string::npos)
+                {
+                    root     = "/sys/fs/cgroup/memory";
+                    path     = cgroup;
+                    limit    = "memory.limit_in_bytes";
+                    usage    = "memory.usage_in_bytes";
+                    inactive = "total_inactive_file";
+                    break;
+                }
+                else if(!*controllers && !limit)
+                {
+                    root     = "/sys/fs/cgroup";
+                    path     = cgroup;
+                    limit    = "memory.max";
+                    usage    = "memory.current";
+                    inactive = "inactive_file";
+                }
+            }
+            fclose(fp);
+
+            if(!limit)
+                return;
+
+            // Inside a container the path may be relative to a cgroup namespace whose root is
+            // mounted at root, or name a host directory which is not visible; the ancestors
+            // which exist are kept
+            while(true)
+            {
+                std::string dir = root + path;
+                if(FILE* f = fopen((dir + "/" + usage).c_str(), "r"))
+                {
+                    fclose(f);
+                    dirs.push_back(dir);
+                }
+                if(path.empty() || path == "/")
+                    break;
+                path.resize(path.find_last_of('/'));
+            }
+        }
+    };
+}
+
+#endif
+
 //!
-//! @brief Memory free helper.  Returns kB or -1 if unknown.
+//! @brief Memory free helper.  Returns bytes or -1 if unknown.
 //!
 ptrdiff_t host_bytes_available()
 {
@@ -48,102 +161,244 @@ ptrdiff_t host_bytes_available()
 
 #else
 
-    const int BUF_MAX = 1024;
-    char      buf[BUF_MAX];
+    // MemAvailable includes reclaimable caches; kernels before 3.14 only report MemFree
+    ptrdiff_t n_bytes = read_host_mem_value("/proc/meminfo", "MemAvailable");
+    if(n_bytes < 0)
+        n_bytes = read_host_mem_value("/proc/meminfo", "MemFree");
+    if(n_bytes >= 0)
+        n_bytes *= 1024; // kB
 
-    ptrdiff_t n_bytes = -1; // unknown
-
-    FILE* fp = popen("cat /proc/meminfo", "r");
-    if(fp == NULL)
+    // Limited by the headroom of the memory cgroups, counting their inactive page cache as
+    // reclaimable like the kernel does before invoking the OOM killer
+    static const host_mem_cgroup cgroup;
+    for(auto& dir : cgroup.dirs)
     {
-        return n_bytes;
+        ptrdiff_t limit = read_host_mem_value(dir + "/" + cgroup.limit);
+        ptrdiff_t usage = read_host_mem_value(dir + "/" + cgroup.usage);
+
+        // cgroup v1 reports no limit as a page-aligned maximum value
+        if(limit < 0 || usage < 0 || limit >= std::numeric_limits<ptrdiff_t>::max() / 2)
+            continue;
+
+        ptrdiff_t inactive  = read_host_mem_value(dir + "/memory.stat", cgroup.inactive);
+        ptrdiff_t headroom  = limit - usage + std::max(inactive, ptrdiff_t(0));
+        headroom            = std::max(headroom, ptrdiff_t(0));
+        n_bytes             = n_bytes < 0 ? headroom : std::min(n_bytes, headroom);
     }
 
-    while(fgets(buf, BUF_MAX, fp) != NULL)
+    return n_bytes;
+
+#endif
+}
+
+namespace
+{
+    constexpr size_t host_mem_check_threshold = 100 * 1024 * 1024; // 100 MB
+
+    // Longest time an allocation waits for other threads to release memory before it is skipped
+    constexpr auto host_mem_wait_limit = std::chrono::seconds(30);
+
+    //!
+    //! @brief Process-wide accounting of host allocations. Large allocations reserve bytes
+    //! from a budget which is set at the first large allocation to the available memory, shared
+    //! between the shards of a sharded gtest run, or by ROCBLAS_CLIENT_HOST_MEM_BUDGET (MB).
+    //! An allocation which does not fit waits while other threads hold reservations which they
+    //! may release, and is skipped otherwise.
+    //!
+    class host_memory_governor
     {
-        const char cMemTok[] = "MemFree"; // Can consider MemAvailable if too many SKIPS occur
-        if(!strncmp(buf, cMemTok, sizeof(cMemTok) - 1))
+        std::mutex              m_mutex;
+        std::condition_variable m_released;
+        size_t                  m_reserved = 0;
+        size_t                  m_peak     = 0;
+        ptrdiff_t               m_budget   = -2; // -1 if unknown, -2 if not yet computed
+
+        // Bytes reserved by the current thread, to tell whether waiting can succeed
+        static size_t& thread_reserved()
         {
-            sscanf(buf, "%*s %td", &n_bytes); // kB assumed as 3rd column and ignored
-            n_bytes *= 1024;
-            break;
+            thread_local size_t reserved = 0;
+            return reserved;
         }
-    }
 
-    int status = pclose(fp);
-    if(status == -1)
-    {
-        return -1;
-    }
-    else
-    {
-        return n_bytes;
-    }
+        void add(size_t bytes)
+        {
+            m_reserved += bytes;
+            m_peak = std::max(m_peak, m_reserved);
+            thread_reserved() += bytes;
+        }
+
+        ptrdiff_t budget()
+        {
+            if(m_budget == -2)
+            {
+                if(auto* env = getenv("ROCBLAS_CLIENT_HOST_MEM_BUDGET"))
+                {
+                    m_budget = ptrdiff_t(strtoull(env, nullptr, 10)) << 20;
+                }
+                else
+                {
+                    ptrdiff_t avail  = host_bytes_available();
+                    auto*     shards = getenv("GTEST_TOTAL_SHARDS");
+                    ptrdiff_t count  = shards ? std::max(atoll(shards), 1LL) : 1;
+                    m_budget         = avail < 0 ? -1 : ptrdiff_t(m_reserved) + avail / count;
+                }
+            }
+            return m_budget;
+        }
+
+    public:
+        static host_memory_governor& instance()
+        {
+            static host_memory_governor governor;
+            return governor;
+        }
 
+        // Returns whether bytes could be reserved; without check they are always reserved
+        bool reserve(size_t bytes, bool check)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if(!check || bytes <= host_mem_check_threshold)
+            {
+                add(bytes);
+                return true;
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + host_mem_wait_limit;
+            while(true)
+            {
+                ptrdiff_t limit = budget();
+                ptrdiff_t avail = host_bytes_available(); // negative if unknown
+
+                // the budget is shared with the other threads, and the available memory with
+                // the other processes
+                bool fits = (limit < 0 || m_reserved + bytes <= size_t(limit))
+                            && (avail < 0 || bytes <= size_t(avail));
+                if(fits)
+                {
+                    add(bytes);
+                    return true;
+                }
+
+                // we don't try if it looks to push load into swap
+                bool others = m_reserved > thread_reserved();
+                if(!others || (limit >= 0 && bytes > size_t(limit))
+                   || m_released.wait_until(lock, deadline) == std::cv_status::timeout)
+                {
+                    rocblas_cerr << "Warning: skipped allocating " << bytes << " bytes ("
+                                 << (bytes >> 30) << " GB) as more than free memory ("
+                                 << (std::max(avail, ptrdiff_t(0)) >> 30) << " GB) or the "
+                                 << (std::max(limit - ptrdiff_t(m_reserved), ptrdiff_t(0)) >> 30)
+                                 << " GB left of the host memory budget" << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        void release(size_t bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_reserved -= std::min(bytes, m_reserved);
+                // memory may be freed by another thread than the one which allocated it
+                thread_reserved() -= std::min(bytes, thread_reserved());
+            }
+            m_released.notify_all();
+        }
+
+        size_t peak()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_peak;
+        }
+
+        ptrdiff_t budget_bytes()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_budget < 0 ? -1 : m_budget;
+        }
+    };
+
+    size_t host_usable_size(void* ptr)
+    {
+#ifdef WIN32
+        return _msize(ptr);
+#else
+        return malloc_usable_size(ptr);
 #endif
-}
+    }
 
-inline bool host_mem_safe(size_t n_bytes)
-{
+    inline bool host_mem_check()
+    {
 #if defined(ROCBLAS_BENCH)
-    return true; // roll out to rocblas-bench when CI does perf testing
+        return false; // roll out to rocblas-bench when CI does perf testing
 #else
-    static auto* no_alloc_check = getenv("ROCBLAS_CLIENT_NO_ALLOC_CHECK");
-    if(no_alloc_check)
-    {
-        return true;
+        static auto* no_alloc_check = getenv("ROCBLAS_CLIENT_NO_ALLOC_CHECK");
+        return !no_alloc_check;
+#endif
     }
 
-    constexpr size_t threshold = 100 * 1024 * 1024; // 100 MB
-    if(n_bytes > threshold)
+    // Reserves size bytes and allocates them with alloc, accounting for the usable size of the
+    // allocation
+    template <typename F>
+    void* host_alloc_reserved(size_t size, F alloc)
     {
-        ptrdiff_t avail_bytes = host_bytes_available(); // negative if unknown
-        if(avail_bytes >= 0 && n_bytes > avail_bytes)
-        {
-            rocblas_cerr << "Warning: skipped allocating " << n_bytes << " bytes ("
-                         << (n_bytes >> 30) << " GB) as more than free memory ("
-                         << (avail_bytes >> 30) << " GB)" << std::endl;
+        auto& governor = host_memory_governor::instance();
+        if(!governor.reserve(size, host_mem_check()))
+            return nullptr;
 
-            // we don't try if it looks to push load into swap
-            return false;
+        void* ptr = alloc();
+        if(!ptr)
+        {
+            governor.release(size);
+            return nullptr;
         }
+
+        size_t usable = host_usable_size(ptr);
+        if(usable > size)
+            governor.reserve(usable - size, false);
+        return ptr;
     }
-    return true;
-#endif
 }
 
 void* host_malloc(size_t size)
 {
-    if(host_mem_safe(size))
-    {
+    return host_alloc_reserved(size, [size] {
         void* ptr = malloc(size);
 
-        static int value = -1;
-
-        static auto once = false;
-        if(!once)
-        {
+        // CPU references allocate from several threads, so read the fill byte once at first use
+        static const int value = [] {
             auto* alloc_byte_str = getenv("ROCBLAS_CLIENT_ALLOC_FILL_HEX_BYTE");
-            if(alloc_byte_str)
-            {
-                value = strtol(alloc_byte_str, nullptr, 16); // hex
-            }
-            once = true;
-        }
+            return alloc_byte_str ? int(strtol(alloc_byte_str, nullptr, 16)) : -1; // hex
+        }();
 
         if(value != -1 && ptr)
             memset(ptr, value, size);
 
         return ptr;
-    }
-    else
-        return nullptr;
+    });
 }
 
 void* host_calloc(size_t nmemb, size_t size)
 {
-    if(host_mem_safe(nmemb * size))
-        return calloc(nmemb, size);
-    else
-        return nullptr;
+    return host_alloc_reserved(nmemb * size, [=] { return calloc(nmemb, size); });
+}
+
+void host_free(void* ptr)
+{
+    if(ptr)
+    {
+        host_memory_governor::instance().release(host_usable_size(ptr));
+        free(ptr);
+    }
+}
+
+size_t host_bytes_peak_reserved()
+{
+    return host_memory_governor::instance().peak();
+}
+
+ptrdiff_t host_bytes_budget()
+{
+    return host_memory_governor::instance().budget_bytes();
 }
@@ -26,6 +26,10 @@ import sys
 import os
 import argparse
 import ctypes
+import hashlib
+import shutil
+import struct
+import tempfile
 from fnmatch import fnmatchcase
 try:  # Import either the C or pure-Python YAML parser
     from yaml import CLoader as Loader
@@ -43,6 +47,18 @@ INT_RANGE_RE = re.compile(
 # Regex for include: YAML extension
 INCLUDE_RE = re.compile(r'include\s*:\s*([-.\w/]+)')
 
+# Indexed data file format, matching clients/include/rocblas_indexed_data.hpp
+INDEX_MAGIC = b'rocBLASI'
+INDEX_VERSION = 2
+INDEX_HEADER = struct.Struct('<8sIIQQQQQQ')
+INDEX_KEY = struct.Struct('<QQ')
+INDEX_ALIGN = 64
+
+# Arguments members which form the key of the index: those on which the type and
+# function filters of the test suites depend, such as the flags of the gemm filter
+INDEX_KEY_FIELDS = ('function', 'category', 'known_bug_platforms', 'a_type',
+                    'b_type', 'c_type', 'd_type', 'compute_type', 'flags')
+
 args = {}
 testcases = set()
 datatypes = {}
@@ -51,8 +67,19 @@ param = {}
 
 def main():
     args.update(parse_args().__dict__)
-    for doc in get_yaml_docs():
+    source = get_yaml_source()
+    cache_file = args['cache'] and get_cache_file(source)
+    if cache_file and read_cache(cache_file, args['outfile']):
+        return
+    if args['index']:
+        args['records'] = []
+        args['keys'] = {}
+    for doc in get_yaml_docs(source):
         process_doc(doc)
+    if args['index']:
+        write_index(args['outfile'])
+    if cache_file:
+        write_cache(cache_file, args['outfile'])
 
 
 def process_doc(doc):
@@ -115,6 +142,12 @@ Expand rocBLAS YAML test data file into binary Arguments records
                         default=[])
     parser.add_argument('-t', '--template',
                         type=argparse.FileType('r'))
+    parser.add_argument('--index',
+                        help="Write an indexed data file",
+                        action='store_true')
+    parser.add_argument('--cache',
+                        help="Directory in which to cache the output, keyed "
+                        "by the content of the inputs and of this script")
     return parser.parse_args()
 
 
@@ -145,13 +178,86 @@ def read_yaml_file(file):
     return source
 
 
-def get_yaml_docs():
-    """Parse the YAML file"""
+def get_yaml_source():
+    """Read the YAML file, preceded by the template, with includes expanded"""
     source = read_yaml_file(args['infile'])
 
     if args.get('template'):
         source = read_yaml_file(args['template']) + source
+    return source
+
+
+def get_cache_file(source):
+    """Return the name of the cache file for the output from source"""
+    key = hashlib.sha256()
+    with open(os.path.abspath(__file__), 'rb') as script:
+        key.update(script.read())
+    key.update(b'--index\n' if args['index'] else b'\n')
+    key.update(''.join([line[0] for line in source]).encode('utf_8'))
+    return os.path.join(args['cache'], 'gentest-' + key.hexdigest() + '.data')
+
+
+def read_cache(cache_file, out):
+    """Copy the cached output to out if it exists, returning whether it did"""
+    try:
+        with open(cache_file, 'rb') as cache:
+            shutil.copyfileobj(cache, out.buffer if hasattr(out, 'buffer') else out)
+    except OSError:
+        return False
+    # Mark the file as recently used
+    try:
+        os.utime(cache_file)
+    except OSError:
+        pass
+    return True
+
+
+def write_cache(cache_file, out):
+    """Copy the output file to the cache, removing the least recently used
+    files when it is larger than ROCBLAS_TEST_DATA_CACHE_SIZE megabytes"""
+    if out.name in ('<stdout>', '/dev/stdout'):
+        return
+    out.flush()
+    cache_dir = os.path.dirname(cache_file)
+    temp = None
+    try:
+        os.makedirs(cache_dir, exist_ok=True)
+        with tempfile.NamedTemporaryFile(dir=cache_dir, suffix='.tmp',
+                                         delete=False) as temp:
+            with open(out.name, 'rb') as data:
+                shutil.copyfileobj(data, temp)
+        os.chmod(temp.name, 0o644)
+        os.replace(temp.name, cache_file)
+    except OSError:
+        if temp:
+            try:
+                os.remove(temp.name)
+            except OSError:
+                pass
+        return
 
+    limit = int(os.environ.get('ROCBLAS_TEST_DATA_CACHE_SIZE') or 4096) << 20
+    entries = []
+    for name in os.listdir(cache_dir):
+        path = os.path.join(cache_dir, name)
+        if name.startswith(('yaml-', 'gentest-')) and name.endswith('.data'):
+            try:
+                st = os.stat(path)
+            except OSError:
+                continue
+            entries.append((st.st_mtime, st.st_size, path))
+    total = 0
+    for mtime, size, path in sorted(entries, reverse=True):
+        total += size
+        if total > limit and path != cache_file:
+            try:
+                os.remove(path)
+            except OSError:
+                pass
+
+
+def get_yaml_docs(source):
+    """Parse the YAML source"""
     source_str = ''.join([line[0] for line in source])
 
     def mark_str(mark):
@@ -417,10 +523,55 @@ def write_signature(out):
             byt.append(0)
         byt.extend(bytes("ROCblas", 'utf_8'))
         byt.append(0)
-        out.write(byt)
+        if args['index']:
+            args['signature'] = bytes(byt)
+        else:
+            out.write(byt)
         args['signature_written'] = True
 
 
+def index_test(byt):
+    """Add the test case to the records of the indexed data file"""
+    key = b''
+    for name in INDEX_KEY_FIELDS:
+        member = getattr(param['Arguments'], name)
+        key += byt[member.offset:member.offset + member.size]
+    args['keys'].setdefault(key, []).append(len(args['records']))
+    args['records'].append(byt)
+
+
+def write_index(out):
+    """Write the indexed data file: header, signature, records, keys and indices"""
+    records = args['records']
+    if not records:
+        return
+
+    def align(offset):
+        return (offset + INDEX_ALIGN - 1) // INDEX_ALIGN * INDEX_ALIGN
+
+    signature = args['signature']
+    signature_offset = INDEX_HEADER.size
+    records_offset = align(signature_offset + len(signature))
+    keys_offset = records_offset + len(records[0]) * len(records)
+    indices_offset = keys_offset + INDEX_KEY.size * len(args['keys'])
+
+    out.write(INDEX_HEADER.pack(INDEX_MAGIC, INDEX_VERSION, len(records[0]),
+                                len(records), len(args['keys']),
+                                signature_offset, records_offset, keys_offset,
+                                indices_offset))
+    out.write(signature)
+    out.write(bytes(records_offset - signature_offset - len(signature)))
+    for byt in records:
+        out.write(byt)
+
+    # Keys in sorted order, each followed by its range of record numbers
+    indices = []
+    for key in sorted(args['keys']):
+        out.write(INDEX_KEY.pack(len(indices), len(args['keys'][key])))
+        indices.extend(args['keys'][key])
+    out.write(struct.pack('<%dQ' % len(indices), *indices))
+
+
 def write_test(test):
     """Write the test case out to the binary file if not seen already"""
 
@@ -449,7 +600,10 @@ def write_test(test):
     if byt not in testcases:
         testcases.add(byt)
         write_signature(args['outfile'])
-        args['outfile'].write(byt)
+        if args['index']:
+            index_test(byt)
+        else:
+            args['outfile'].write(byt)
 
 
 def instantiate(test):
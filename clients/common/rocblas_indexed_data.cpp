@@ -0,0 +1,170 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_indexed_data.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error no filesystem found
+#endif
+
+namespace
+{
+    [[noreturn]] void indexed_data_error(const std::string& file, const char* problem)
+    {
+        rocblas_cerr << "Fatal error: " << file << " is not a valid indexed test data file: "
+                     << problem << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+bool rocblas_indexed_data::is_indexed(const std::string& file)
+{
+    // Only regular files are checked, so that reading the magic number does not consume
+    // data from a pipe such as /dev/stdin
+    std::error_code ec;
+    if(!fs::is_regular_file(file, ec))
+        return false;
+    char          magic[sizeof(ROCBLAS_INDEXED_DATA_MAGIC)]{};
+    std::ifstream is(file, std::ios::binary);
+    is.read(magic, sizeof(magic));
+    return is && !memcmp(magic, ROCBLAS_INDEXED_DATA_MAGIC, sizeof(magic));
+}
+
+rocblas_indexed_data::rocblas_indexed_data(const std::string& file)
+{
+#ifndef WIN32
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+    {
+        rocblas_cerr << "Cannot open " << file << ": " << strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    struct stat st;
+    if(!fstat(fd, &st) && st.st_size > 0)
+    {
+        // The mapping is private and writable, because match_test_category() changes the
+        // category of records which are known bugs on the current platform
+        void* map = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED)
+        {
+            m_base = static_cast<const char*>(map);
+            m_size = st.st_size;
+        }
+    }
+    close(fd);
+#endif
+
+    // Read the file when it cannot be mapped
+    if(!m_base)
+    {
+        std::ifstream is(file, std::ios::binary);
+        if(!is)
+        {
+            rocblas_cerr << "Cannot open " << file << ": " << strerror(errno) << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        m_buffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        m_size = m_buffer.size();
+    }
+    const char* base = m_base ? m_base : m_buffer.data();
+
+    if(m_size < sizeof(rocblas_indexed_data_header))
+        indexed_data_error(file, "truncated header");
+    m_header = reinterpret_cast<const rocblas_indexed_data_header*>(base);
+    if(memcmp(m_header->magic, ROCBLAS_INDEXED_DATA_MAGIC, sizeof(m_header->magic)))
+        indexed_data_error(file, "bad magic number");
+    if(m_header->version != ROCBLAS_INDEXED_DATA_VERSION)
+        indexed_data_error(file, "unsupported version");
+    if(m_header->record_size != sizeof(Arguments))
+        indexed_data_error(file, "record size does not match Arguments");
+
+    // Check that each section lies within the file
+    auto in_file = [&](uint64_t offset, uint64_t count, uint64_t size) {
+        return offset <= m_size && count <= (m_size - offset) / size;
+    };
+    size_t signature_size = 16 + sizeof(Arguments);
+    if(!in_file(m_header->signature_offset, 1, signature_size)
+       || !in_file(m_header->records_offset, m_header->record_count, sizeof(Arguments))
+       || !in_file(m_header->keys_offset, m_header->key_count, sizeof(rocblas_indexed_data_key))
+       || !in_file(m_header->indices_offset, m_header->record_count, sizeof(uint64_t))
+       || m_header->records_offset % alignof(Arguments) || m_header->keys_offset % 8
+       || m_header->indices_offset % 8)
+        indexed_data_error(file, "truncated or misaligned section");
+
+    m_records = reinterpret_cast<const Arguments*>(base + m_header->records_offset);
+    m_keys    = reinterpret_cast<const rocblas_indexed_data_key*>(base + m_header->keys_offset);
+    m_indices = reinterpret_cast<const uint64_t*>(base + m_header->indices_offset);
+
+    for(size_t k = 0; k < m_header->key_count; ++k)
+        if(!m_keys[k].count || m_keys[k].first > m_header->record_count
+           || m_keys[k].count > m_header->record_count - m_keys[k].first)
+            indexed_data_error(file, "corrupt index");
+    for(size_t i = 0; i < m_header->record_count; ++i)
+        if(m_indices[i] >= m_header->record_count)
+            indexed_data_error(file, "corrupt index");
+
+    // Validate the signature as for sequential data files
+    std::istringstream signature(std::string(base + m_header->signature_offset, signature_size));
+    Arguments::validate(signature);
+}
+
+rocblas_indexed_data::~rocblas_indexed_data()
+{
+#ifndef WIN32
+    if(m_base)
+        munmap(const_cast<char*>(m_base), m_size);
+#endif
+}
+
+std::vector<size_t>
+    rocblas_indexed_data::select(const std::function<bool(const Arguments&)>& filter) const
+{
+    std::vector<size_t> selection;
+    for(size_t k = 0; k < m_header->key_count; ++k)
+    {
+        auto first = m_indices + m_keys[k].first;
+        if(filter(m_records[*first]))
+            selection.insert(selection.end(), first, first + m_keys[k].count);
+    }
+    std::sort(selection.begin(), selection.end());
+    return selection;
+}
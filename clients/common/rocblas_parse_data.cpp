@@ -31,28 +31,6 @@
 #include <string>
 #include <sys/types.h>
 
-// Parse YAML data
-static std::string rocblas_parse_yaml(const std::string& yaml)
-{
-    std::string tmp     = rocblas_tempname();
-    auto        exepath = rocblas_exepath();
-    auto cmd = exepath + "rocblas_gentest.py --template " + exepath + "rocblas_template.yaml -o "
-               + tmp + " " + yaml;
-    rocblas_cerr << cmd << std::endl;
-
-#ifdef WIN32
-    int status = std::system(cmd.c_str());
-    if(status == -1)
-        exit(EXIT_FAILURE);
-#else
-    int status = system(cmd.c_str());
-    if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status))
-        exit(EXIT_FAILURE);
-#endif
-
-    return tmp;
-}
-
 // Parse --data and --yaml command-line arguments
 bool rocblas_parse_data(int& argc, char** argv, const std::string& default_file)
 {
@@ -106,14 +84,16 @@ bool rocblas_parse_data(int& argc, char** argv, const std::string& default_file)
     else if(filename == "")
         filename = default_file;
 
-    if(yaml)
-        filename = rocblas_parse_yaml(filename);
+    if(filename == "")
+        return false;
 
-    if(filename != "")
-    {
-        RocBLAS_TestData::set_filename(filename, yaml);
-        return true;
-    }
+    // YAML files are expanded as they are read, with the template used for logged problems,
+    // unless the same expansion has been cached by an earlier run
+    if(yaml)
+        RocBLAS_TestData::set_yaml(
+            filename, rocblas_exepath() + "rocblas_template.yaml", rocblas_yaml_cache_dir());
+    else
+        RocBLAS_TestData::set_filename(filename);
 
-    return false;
+    return true;
 }
@@ -0,0 +1,368 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_ref_cache.hpp"
+#include "cblas.h"
+#include "rocblas_random.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error no filesystem found
+#endif
+
+namespace
+{
+    constexpr char ref_cache_magic[8] = {'r', 'o', 'c', 'B', 'L', 'A', 'S', 'R'};
+
+    struct ref_cache_header
+    {
+        char     magic[8];
+        uint64_t check; // second hash of the key
+        uint64_t span_count; // followed by the size of each span in bytes, and the data
+    };
+
+    // Runs of at least this many equal 32-bit words are encoded as a run
+    constexpr uint32_t ref_cache_min_run = 4;
+    constexpr uint32_t ref_cache_run_bit = 0x80000000;
+
+    struct fnv1a
+    {
+        uint64_t hash;
+
+        void add(const void* data, size_t size)
+        {
+            for(size_t i = 0; i < size; i++)
+                hash = (hash ^ static_cast<const unsigned char*>(data)[i]) * 0x100000001b3;
+        }
+
+        void add(const std::string& s)
+        {
+            add(s.data(), s.size() + 1);
+        }
+    };
+
+    // Identity of the reference BLAS library: the path, size and modification time of the file
+    // holding it. This is ROCBLAS_REF_BLAS_LIBRARY, the library which is linked statically, if
+    // it exists, or else the file mapped at the address of cblas_sgemm.
+    std::string ref_blas_library()
+    {
+        std::string path;
+#ifdef ROCBLAS_REF_BLAS_LIBRARY
+        if(fs::is_regular_file(ROCBLAS_REF_BLAS_LIBRARY))
+            path = ROCBLAS_REF_BLAS_LIBRARY;
+#endif
+#ifndef WIN32
+        std::ifstream maps("/proc/self/maps");
+        auto          addr = reinterpret_cast<uintptr_t>(&cblas_sgemm);
+        for(std::string line; path.empty() && std::getline(maps, line);)
+        {
+            uintptr_t          start, end;
+            char               dash;
+            std::istringstream is(line);
+            if(is >> std::hex >> start >> dash >> end && start <= addr && addr < end)
+            {
+                std::string perms, offset, dev, inode;
+                is >> perms >> offset >> dev >> inode >> std::ws;
+                std::getline(is, path);
+            }
+        }
+#endif
+        std::error_code ec;
+        auto            size = fs::file_size(path, ec);
+        auto            time = fs::last_write_time(path, ec).time_since_epoch().count();
+        return path + '\n' + std::to_string(size) + '\n' + std::to_string(time);
+    }
+
+    // Remove the least recently used files from the cache, other than keep, until its size
+    // is at most ROCBLAS_REF_CACHE_SIZE megabytes (4096 by default)
+    void prune_ref_cache(const fs::path& dir, const fs::path& keep)
+    {
+        const char* env   = getenv("ROCBLAS_REF_CACHE_SIZE");
+        uintmax_t   limit = (env && *env ? strtoull(env, nullptr, 10) : 4096) << 20;
+
+        struct entry
+        {
+            fs::file_time_type time;
+            uintmax_t          size;
+            fs::path           path;
+        };
+        std::vector<entry> entries;
+        std::error_code    ec;
+        for(fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+        {
+            std::string name = it->path().filename().string();
+            if(name.compare(0, 4, "ref-") || it->path().extension() != ".data")
+                continue;
+            std::error_code fec;
+            entry           e{fs::last_write_time(it->path(), fec), 0, it->path()};
+            e.size = fs::file_size(it->path(), fec);
+            if(!fec)
+                entries.push_back(std::move(e));
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+            return a.time > b.time;
+        });
+        uintmax_t total = 0;
+        for(auto& e : entries)
+        {
+            total += e.size;
+            if(total > limit && e.path != keep)
+                fs::remove(e.path, ec);
+        }
+    }
+}
+
+rocblas_ref_cache::rocblas_ref_cache(const Arguments& arg)
+{
+    // Timed runs measure the CPU reference, so they always compute it
+    const char* dir = getenv("ROCBLAS_REF_CACHE");
+    if(!dir || !*dir || arg.timing || std::this_thread::get_id() != g_main_thread_id)
+        return;
+
+    static const std::string library = ref_blas_library();
+
+    fnv1a key{0xcbf29ce484222325}, check{0x84222325cbf29ce4};
+    auto  add = [&](const void* data, size_t size) {
+        key.add(data, size);
+        check.add(data, size);
+    };
+
+    add(&ROCBLAS_REF_CACHE_VERSION, sizeof(ROCBLAS_REF_CACHE_VERSION));
+
+    // Arguments which only affect how the test is run, and not its results, are not part of
+    // the key
+    auto skip = [](const char* name) {
+        for(const char* s : {"name",
+                             "category",
+                             "known_bug_platforms",
+                             "iters",
+                             "cold_iters",
+                             "solution_index",
+                             "threads",
+                             "streams",
+                             "devices",
+                             "timing",
+                             "HMM",
+                             "fortran",
+                             "graph_test"})
+            if(!strcmp(name, s))
+                return true;
+        return false;
+    };
+
+#define ADD_ARGUMENT(NAME)                   \
+    if(!skip(#NAME))                         \
+    {                                        \
+        add(#NAME, sizeof(#NAME));           \
+        add(&arg.NAME, sizeof(arg.NAME));    \
+    }
+
+    // cppcheck-suppress unknownMacro
+    FOR_EACH_ARGUMENT(ADD_ARGUMENT, ;);
+
+#undef ADD_ARGUMENT
+
+    // Inputs are initialized from the current state of the generator, or from the seed after
+    // rocblas_seedrand()
+    std::ostringstream rng;
+    rng << t_rocblas_rng << '\n' << g_rocblas_seed;
+    key.add(rng.str());
+    check.add(rng.str());
+    key.add(library);
+    check.add(library);
+
+    std::ostringstream file;
+    file << "ref-" << std::hex << std::setfill('0') << std::setw(16) << key.hash << ".data";
+    m_file  = (fs::path(dir) / file.str()).string();
+    m_check = check.hash;
+}
+
+// Each token is a 32-bit count, followed by one word repeated count & ~ref_cache_run_bit times
+// if ref_cache_run_bit is set, or else by count literal words. Trailing bytes which do not
+// fill a word follow the tokens.
+void rocblas_ref_cache::encode(std::string& out, const void* data, size_t size)
+{
+    auto*  bytes   = static_cast<const char*>(data);
+    size_t n_words = size / sizeof(uint32_t);
+
+    auto word = [&](size_t i) {
+        uint32_t w;
+        memcpy(&w, bytes + i * sizeof(w), sizeof(w));
+        return w;
+    };
+    auto token = [&](size_t count, size_t first, size_t words) {
+        uint32_t t = count;
+        out.append((const char*)&t, sizeof(t));
+        out.append(bytes + first * sizeof(uint32_t), words * sizeof(uint32_t));
+    };
+    auto literals = [&](size_t first, size_t end) {
+        for(size_t n; first < end; first += n)
+        {
+            n = std::min<size_t>(end - first, ~ref_cache_run_bit);
+            token(n, first, n);
+        }
+    };
+
+    size_t literal = 0; // first word not yet encoded
+    for(size_t i = 0; i < n_words;)
+    {
+        size_t run = 1;
+        while(i + run < n_words && run < ~ref_cache_run_bit && word(i + run) == word(i))
+            run++;
+        if(run >= ref_cache_min_run)
+        {
+            literals(literal, i);
+            token(run | ref_cache_run_bit, i, 1);
+            literal = i + run;
+        }
+        i += run;
+    }
+    literals(literal, n_words);
+    out.append(bytes + n_words * sizeof(uint32_t), size % sizeof(uint32_t));
+}
+
+bool rocblas_ref_cache::decode(const std::string& in, size_t& pos, void* data, size_t size)
+{
+    auto*  out     = static_cast<char*>(data);
+    size_t n_words = size / sizeof(uint32_t);
+    for(size_t i = 0; i < n_words;)
+    {
+        uint32_t count;
+        if(in.size() - pos < sizeof(count))
+            return false;
+        memcpy(&count, &in[pos], sizeof(count));
+        pos += sizeof(count);
+
+        bool   run   = count & ref_cache_run_bit;
+        size_t words = count & ~ref_cache_run_bit;
+        size_t bytes = (run ? 1 : words) * sizeof(uint32_t);
+        if(!words || words > n_words - i || in.size() - pos < bytes)
+            return false;
+        if(out)
+        {
+            if(run)
+                for(size_t j = 0; j < words; j++)
+                    memcpy(out + (i + j) * sizeof(uint32_t), &in[pos], sizeof(uint32_t));
+            else
+                memcpy(out + i * sizeof(uint32_t), &in[pos], bytes);
+        }
+        pos += bytes;
+        i += words;
+    }
+    size_t tail = size % sizeof(uint32_t);
+    if(in.size() - pos < tail)
+        return false;
+    if(out)
+        memcpy(out + n_words * sizeof(uint32_t), &in[pos], tail);
+    pos += tail;
+    return true;
+}
+
+bool rocblas_ref_cache::load_spans(const std::vector<span>& spans) const
+{
+    std::ifstream is(m_file, std::ios::binary);
+    if(!is)
+        return false;
+    std::string in((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+    ref_cache_header header;
+    size_t           pos = sizeof(header) + spans.size() * sizeof(uint64_t);
+    if(is.bad() || in.size() < pos)
+        return false;
+    memcpy(&header, in.data(), sizeof(header));
+    if(memcmp(header.magic, ref_cache_magic, sizeof(header.magic)) || header.check != m_check
+       || header.span_count != spans.size())
+        return false;
+    for(size_t i = 0; i < spans.size(); i++)
+    {
+        uint64_t size;
+        memcpy(&size, &in[sizeof(header) + i * sizeof(size)], sizeof(size));
+        if(size != spans[i].second)
+            return false;
+    }
+
+    // Check the whole file before writing to the outputs, so that they are unchanged if it is
+    // truncated
+    size_t start = pos;
+    for(auto& s : spans)
+        if(!decode(in, pos, nullptr, s.second))
+            return false;
+    for(auto& s : spans)
+        decode(in, start, s.first, s.second);
+
+    // Mark the file as recently used
+    std::error_code ec;
+    fs::last_write_time(m_file, fs::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void rocblas_ref_cache::store_spans(const std::vector<span>& spans) const
+{
+    ref_cache_header header;
+    memcpy(header.magic, ref_cache_magic, sizeof(header.magic));
+    header.check      = m_check;
+    header.span_count = spans.size();
+
+    std::string out((const char*)&header, sizeof(header));
+    for(auto& s : spans)
+    {
+        uint64_t size = s.second;
+        out.append((const char*)&size, sizeof(size));
+    }
+    for(auto& s : spans)
+        encode(out, s.first, s.second);
+
+    // Write to a temporary file which is renamed, so that concurrent readers and writers of
+    // the cache only see complete files. Failures leave the cache unchanged.
+    fs::path        cache_file = m_file;
+    fs::path        temp_file  = cache_file;
+    std::error_code ec;
+    temp_file += "." + std::to_string(std::random_device{}()) + ".tmp";
+    fs::create_directories(cache_file.parent_path(), ec);
+    {
+        std::ofstream os(temp_file, std::ios::binary);
+        if(!os.write(out.data(), out.size()) || !os.flush())
+        {
+            fs::remove(temp_file, ec);
+            return;
+        }
+    }
+    fs::rename(temp_file, cache_file, ec);
+    if(ec)
+        fs::remove(temp_file, ec);
+    else
+        prune_ref_cache(cache_file.parent_path(), cache_file);
+}
@@ -0,0 +1,2446 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_yaml_expand.hpp"
+#include "rocblas_yaml_expand_hash.hpp"
+#include "../../library/src/include/rocblas_ostream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error no filesystem found
+#endif
+
+namespace
+{
+    /******************************************************************************
+     * A YAML value, holding the same types of Python values which PyYAML would  *
+     * construct. Sequences and mappings are immutable and shared, so that copies *
+     * of test cases are cheap, as they are in Python.                            *
+     ******************************************************************************/
+    struct yaml_value;
+    using yaml_sequence = std::vector<yaml_value>;
+    using yaml_mapping  = std::vector<std::pair<std::string, yaml_value>>;
+
+    struct yaml_value
+    {
+        enum class kind
+        {
+            none,
+            boolean,
+            integer,
+            real,
+            string,
+            sequence,
+            mapping,
+        };
+
+        kind                                 type = kind::none;
+        int64_t                              i    = 0; // boolean and integer
+        double                               d    = 0;
+        std::string                          s;
+        std::shared_ptr<const yaml_sequence> seq;
+        std::shared_ptr<const yaml_mapping>  map;
+
+        static yaml_value boolean(bool b)
+        {
+            yaml_value v;
+            v.type = kind::boolean;
+            v.i    = b;
+            return v;
+        }
+
+        static yaml_value integer(int64_t i)
+        {
+            yaml_value v;
+            v.type = kind::integer;
+            v.i    = i;
+            return v;
+        }
+
+        static yaml_value real(double d)
+        {
+            yaml_value v;
+            v.type = kind::real;
+            v.d    = d;
+            return v;
+        }
+
+        static yaml_value string(std::string s)
+        {
+            yaml_value v;
+            v.type = kind::string;
+            v.s    = std::move(s);
+            return v;
+        }
+
+        static yaml_value sequence(yaml_sequence seq)
+        {
+            yaml_value v;
+            v.type = kind::sequence;
+            v.seq  = std::make_shared<const yaml_sequence>(std::move(seq));
+            return v;
+        }
+
+        static yaml_value mapping(yaml_mapping map)
+        {
+            yaml_value v;
+            v.type = kind::mapping;
+            v.map  = std::make_shared<const yaml_mapping>(std::move(map));
+            return v;
+        }
+
+        bool is_string() const
+        {
+            return type == kind::string;
+        }
+
+        bool is_number() const
+        {
+            return type == kind::boolean || type == kind::integer || type == kind::real;
+        }
+
+        // Look up a key in a mapping
+        const yaml_value* find(const std::string& key) const
+        {
+            if(type == kind::mapping)
+                for(auto& p : *map)
+                    if(p.first == key)
+                        return &p.second;
+            return nullptr;
+        }
+
+        // Python truth value
+        explicit operator bool() const
+        {
+            switch(type)
+            {
+            case kind::none:
+                return false;
+            case kind::boolean:
+            case kind::integer:
+                return i != 0;
+            case kind::real:
+                return d != 0;
+            case kind::string:
+                return !s.empty();
+            case kind::sequence:
+                return !seq->empty();
+            case kind::mapping:
+                return !map->empty();
+            }
+            return false;
+        }
+
+        // Python type name, for error messages
+        const char* type_name() const
+        {
+            switch(type)
+            {
+            case kind::none:
+                return "<class 'NoneType'>";
+            case kind::boolean:
+                return "<class 'bool'>";
+            case kind::integer:
+                return "<class 'int'>";
+            case kind::real:
+                return "<class 'float'>";
+            case kind::string:
+                return "<class 'str'>";
+            case kind::sequence:
+                return "<class 'list'>";
+            case kind::mapping:
+                return "<class 'dict'>";
+            }
+            return "";
+        }
+    };
+
+    // Python repr() of a value, for error messages
+    std::ostream& operator<<(std::ostream& os, const yaml_value& v)
+    {
+        switch(v.type)
+        {
+        case yaml_value::kind::none:
+            return os << "None";
+        case yaml_value::kind::boolean:
+            return os << (v.i ? "True" : "False");
+        case yaml_value::kind::integer:
+            return os << v.i;
+        case yaml_value::kind::real:
+        {
+            if(std::isnan(v.d))
+                return os << "nan";
+            if(std::isinf(v.d))
+                return os << (v.d < 0 ? "-inf" : "inf");
+            std::ostringstream str;
+            for(int prec = 1; prec <= 17; ++prec)
+            {
+                str.str("");
+                str << std::setprecision(prec) << v.d;
+                if(std::strtod(str.str().c_str(), nullptr) == v.d)
+                    break;
+            }
+            auto text = str.str();
+            return os << text << (text.find_first_of(".e") == std::string::npos ? ".0" : "");
+        }
+        case yaml_value::kind::string:
+            return os << (v.s.find('\'') == std::string::npos ? "'" + v.s + "'"
+                                                               : '"' + v.s + '"');
+        case yaml_value::kind::sequence:
+        {
+            const char* sep = "";
+            os << "[";
+            for(auto& e : *v.seq)
+                os << sep << e, sep = ", ";
+            return os << "]";
+        }
+        case yaml_value::kind::mapping:
+        {
+            const char* sep = "";
+            os << "{";
+            for(auto& p : *v.map)
+                os << sep << "'" << p.first << "': " << p.second, sep = ", ";
+            return os << "}";
+        }
+        }
+        return os;
+    }
+
+    // Python == between values
+    bool operator==(const yaml_value& a, const yaml_value& b)
+    {
+        if(a.is_number() && b.is_number())
+        {
+            if(a.type != yaml_value::kind::real && b.type != yaml_value::kind::real)
+                return a.i == b.i;
+            double x = a.type == yaml_value::kind::real ? a.d : double(a.i);
+            double y = b.type == yaml_value::kind::real ? b.d : double(b.i);
+            return x == y;
+        }
+        if(a.type != b.type)
+            return false;
+        switch(a.type)
+        {
+        case yaml_value::kind::none:
+            return true;
+        case yaml_value::kind::string:
+            return a.s == b.s;
+        case yaml_value::kind::sequence:
+            return *a.seq == *b.seq;
+        case yaml_value::kind::mapping:
+            if(a.map->size() != b.map->size())
+                return false;
+            for(auto& p : *a.map)
+            {
+                auto* q = b.find(p.first);
+                if(!q || !(p.second == *q))
+                    return false;
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool operator!=(const yaml_value& a, const yaml_value& b)
+    {
+        return !(a == b);
+    }
+
+    // Insert or replace a key, keeping the position of the first insertion like a Python dict
+    void mapping_set(yaml_mapping& map, const std::string& key, const yaml_value& value)
+    {
+        for(auto& p : map)
+            if(p.first == key)
+            {
+                p.second = value;
+                return;
+            }
+        map.emplace_back(key, value);
+    }
+
+    /*************************************************************************
+     * Source lines of the YAML text, with their file names and line numbers *
+     *************************************************************************/
+    struct source_line
+    {
+        std::string text; // including the trailing newline, if any
+        std::string file;
+        size_t      line_no;
+    };
+
+    // Match "include\s*:\s*([-.\w/]+)" at the start of a line, returning the file name
+    bool match_include(const std::string& line, std::string& file, size_t& column)
+    {
+        if(line.compare(0, 7, "include"))
+            return false;
+        size_t p = 7;
+        while(p < line.size() && isspace((unsigned char)line[p]))
+            ++p;
+        if(p >= line.size() || line[p] != ':')
+            return false;
+        ++p;
+        while(p < line.size() && isspace((unsigned char)line[p]))
+            ++p;
+        size_t start = p;
+        while(p < line.size()
+              && (isalnum((unsigned char)line[p]) || strchr("-._/", line[p]) || line[p] & 0x80))
+            ++p;
+        if(p == start)
+            return false;
+        file   = line.substr(start, p - start);
+        column = start;
+        return true;
+    }
+
+    // Read a YAML file, replacing include: lines with the contents of the included files
+    void read_yaml_file(const std::string&              name,
+                        const std::vector<std::string>& include_dirs,
+                        std::vector<source_line>&       source)
+    {
+        std::ifstream is(name, std::ios::binary);
+        if(!is)
+            throw rocblas_yaml_error("Cannot open " + name + ": " + strerror(errno));
+        std::string text{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+
+        std::string file_dir = fs::path(name).parent_path().string();
+        if(file_dir.empty())
+            file_dir = fs::current_path().string();
+
+        // Split into lines with universal newlines, as Python reads text files
+        size_t line_no = 0;
+        for(size_t p = 0; p < text.size();)
+        {
+            size_t      e = text.find_first_of("\r\n", p);
+            std::string line
+                = text.substr(p, e == std::string::npos ? std::string::npos : e - p);
+            if(e == std::string::npos)
+                p = text.size();
+            else
+            {
+                line += '\n';
+                p = e + (text[e] == '\r' && e + 1 < text.size() && text[e + 1] == '\n' ? 2 : 1);
+            }
+
+            std::string include_file;
+            size_t      column;
+            ++line_no;
+            if(!match_include(line, include_file, column))
+            {
+                source.push_back({std::move(line), name, line_no});
+                continue;
+            }
+
+            std::vector<std::string> dirs{file_dir};
+            dirs.insert(dirs.end(), include_dirs.begin(), include_dirs.end());
+            bool found = false;
+            for(auto& dir : dirs)
+            {
+                auto path = (fs::path(dir) / include_file).string();
+                if(fs::exists(path))
+                {
+                    read_yaml_file(path, include_dirs, source);
+                    found = true;
+                    break;
+                }
+            }
+            if(!found)
+            {
+                line.erase(line.find_last_not_of(" \t\r\n") + 1);
+                std::ostringstream msg;
+                msg << "In file " << name << ", line " << line_no << ", column " << column + 1
+                    << ":\n"
+                    << line << "\n"
+                    << std::string(column, ' ') << "^\nCannot open " << include_file
+                    << "\n\nInclude paths:";
+                const char* sep = "\n";
+                for(auto& dir : dirs)
+                    msg << sep << dir;
+                throw rocblas_yaml_error(msg.str());
+            }
+        }
+    }
+
+    /****************************************************************************
+     * Parser for the subset of YAML used by rocBLAS test files: block and flow *
+     * collections, plain and quoted scalars, anchors, aliases and merge keys,  *
+     * and multiple documents. Plain scalars are resolved to null, bool, int,   *
+     * float or str with the YAML 1.1 rules which PyYAML uses.                  *
+     ****************************************************************************/
+    class yaml_parser
+    {
+        const std::string&                          m_text;
+        const std::vector<source_line>&             m_source;
+        size_t                                      m_pos = 0;
+        std::unordered_map<std::string, yaml_value> m_anchors;
+
+        char peek(size_t ahead = 0) const
+        {
+            return m_pos + ahead < m_text.size() ? m_text[m_pos + ahead] : '\0';
+        }
+
+        bool at_end() const
+        {
+            return m_pos >= m_text.size();
+        }
+
+        static bool is_blank(char c)
+        {
+            return c == ' ' || c == '\t';
+        }
+
+        static bool is_break(char c)
+        {
+            return c == '\n' || c == '\0';
+        }
+
+        static bool is_blank_or_break(char c)
+        {
+            return is_blank(c) || is_break(c);
+        }
+
+        static bool is_flow_indicator(char c)
+        {
+            return c && strchr(",[]{}", c);
+        }
+
+        int column(size_t pos) const
+        {
+            size_t start = pos ? m_text.rfind('\n', pos - 1) : std::string::npos;
+            return int(start == std::string::npos ? pos : pos - start - 1);
+        }
+
+        [[noreturn]] void error(const std::string& problem, size_t pos) const
+        {
+            pos           = std::min(pos, m_text.size());
+            size_t   line = std::count(m_text.begin(), m_text.begin() + pos, '\n');
+            int      col  = column(pos);
+            std::ostringstream msg;
+            if(line < m_source.size())
+            {
+                auto& src  = m_source[line];
+                auto  text = src.text.substr(0, src.text.find_last_not_of(" \t\r\n") + 1);
+                msg << "In file " << src.file << ", line " << src.line_no << ", column "
+                    << col + 1 << ":\n"
+                    << text << "\n"
+                    << std::string(col, ' ') << "^\n";
+            }
+            msg << problem;
+            throw rocblas_yaml_error(msg.str());
+        }
+
+        [[noreturn]] void error(const std::string& problem) const
+        {
+            error(problem, m_pos);
+        }
+
+        std::string found() const
+        {
+            return at_end() ? "<end of stream>" : std::string("'") + peek() + "'";
+        }
+
+        void skip_blanks()
+        {
+            while(is_blank(peek()))
+                ++m_pos;
+        }
+
+        // Skip blanks, comments and line breaks, stopping at the next content
+        void skip_lines()
+        {
+            for(;;)
+            {
+                skip_blanks();
+                if(peek() == '#')
+                    while(!is_break(peek()))
+                        ++m_pos;
+                if(peek() != '\n')
+                    break;
+                ++m_pos;
+            }
+        }
+
+        bool at_line_end()
+        {
+            skip_blanks();
+            return peek() == '#' || is_break(peek());
+        }
+
+        void expect_line_end()
+        {
+            if(!at_line_end())
+                error("expected <block end>, but found " + found());
+        }
+
+        bool at_marker(const char* marker) const
+        {
+            return column(m_pos) == 0 && !m_text.compare(m_pos, 3, marker)
+                   && is_blank_or_break(peek(3));
+        }
+
+        bool at_document_boundary() const
+        {
+            return at_end() || at_marker("---") || at_marker("...");
+        }
+
+        bool at_sequence_entry() const
+        {
+            return peek() == '-' && is_blank_or_break(peek(1));
+        }
+
+        std::string scan_anchor_name()
+        {
+            size_t start = ++m_pos;
+            while(isalnum((unsigned char)peek()) || peek() == '-' || peek() == '_')
+                ++m_pos;
+            if(m_pos == start)
+                error("expected alphabetic or numeric character, but found " + found());
+            return m_text.substr(start, m_pos - start);
+        }
+
+        yaml_value scan_alias()
+        {
+            size_t start = m_pos;
+            auto   name  = scan_anchor_name();
+            auto   it    = m_anchors.find(name);
+            if(it == m_anchors.end())
+                error("found undefined alias " + name, start);
+            return it->second;
+        }
+
+        static void append_utf8(std::string& s, uint32_t c)
+        {
+            if(c < 0x80)
+                s += char(c);
+            else if(c < 0x800)
+                s += char(0xc0 | c >> 6), s += char(0x80 | (c & 0x3f));
+            else if(c < 0x10000)
+                s += char(0xe0 | c >> 12), s += char(0x80 | (c >> 6 & 0x3f)),
+                    s += char(0x80 | (c & 0x3f));
+            else
+                s += char(0xf0 | c >> 18), s += char(0x80 | (c >> 12 & 0x3f)),
+                    s += char(0x80 | (c >> 6 & 0x3f)), s += char(0x80 | (c & 0x3f));
+        }
+
+        // Fold a line break inside a quoted scalar: one break becomes a space, and each
+        // additional break is kept
+        void fold_quoted_break(std::string& s)
+        {
+            s.erase(s.find_last_not_of(" \t") + 1);
+            size_t breaks = 0;
+            while(peek() == '\n')
+            {
+                ++breaks;
+                ++m_pos;
+                skip_blanks();
+            }
+            if(at_document_boundary() && !at_end())
+                error("found unexpected document separator");
+            if(breaks == 1)
+                s += ' ';
+            else
+                s.append(breaks - 1, '\n');
+        }
+
+        std::string scan_single_quoted()
+        {
+            size_t      start = m_pos++;
+            std::string s;
+            for(;;)
+            {
+                char c = peek();
+                if(at_end())
+                    error("found unexpected end of stream while scanning a quoted scalar", start);
+                if(c == '\'')
+                {
+                    if(peek(1) != '\'')
+                        break;
+                    s += '\'';
+                    m_pos += 2;
+                }
+                else if(c == '\n')
+                    fold_quoted_break(s);
+                else
+                    s += c, ++m_pos;
+            }
+            ++m_pos;
+            return s;
+        }
+
+        std::string scan_double_quoted()
+        {
+            size_t      start = m_pos++;
+            std::string s;
+            for(;;)
+            {
+                char c = peek();
+                if(at_end())
+                    error("found unexpected end of stream while scanning a quoted scalar", start);
+                if(c == '"')
+                    break;
+                if(c == '\n')
+                {
+                    fold_quoted_break(s);
+                    continue;
+                }
+                ++m_pos;
+                if(c != '\\')
+                {
+                    s += c;
+                    continue;
+                }
+
+                c = peek();
+                ++m_pos;
+                static const std::map<char, const char*> escapes
+                    = {{'0', "\0"},     {'a', "\a"},     {'b', "\b"},     {'t', "\t"},
+                       {'\t', "\t"},    {'n', "\n"},     {'v', "\v"},     {'f', "\f"},
+                       {'r', "\r"},     {'e', "\x1b"},   {' ', " "},      {'"', "\""},
+                       {'\\', "\\"},    {'/', "/"},      {'N', "\xc2\x85"}, {'_', "\xc2\xa0"},
+                       {'L', "\xe2\x80\xa8"}, {'P', "\xe2\x80\xa9"}};
+                auto e = escapes.find(c);
+                if(c == '0')
+                    s += '\0';
+                else if(e != escapes.end())
+                    s += e->second;
+                else if(c == 'x' || c == 'u' || c == 'U')
+                {
+                    size_t   len  = c == 'x' ? 2 : c == 'u' ? 4 : 8;
+                    uint32_t code = 0;
+                    for(size_t k = 0; k < len; ++k, ++m_pos)
+                    {
+                        if(!isxdigit((unsigned char)peek()))
+                            error("expected escape sequence of " + std::to_string(len)
+                                  + " hexadecimal numbers");
+                        code = code * 16 + std::stoi(std::string(1, peek()), nullptr, 16);
+                    }
+                    append_utf8(s, code);
+                }
+                else if(c == '\n')
+                {
+                    // An escaped line break joins the lines without a space
+                    skip_blanks();
+                    while(peek() == '\n')
+                    {
+                        s += '\n';
+                        ++m_pos;
+                        skip_blanks();
+                    }
+                }
+                else
+                    error(std::string("found unknown escape character '") + c + "'", m_pos - 1);
+            }
+            ++m_pos;
+            return s;
+        }
+
+        // Scan a plain scalar, which ends at ": ", " #", the end of the line, and in flow
+        // context at flow indicators
+        std::string scan_plain(bool flow)
+        {
+            char c = peek();
+            if((strchr("-?:", c) && is_blank_or_break(peek(1)))
+               || (c && strchr(",[]{}#&*!|>'\"%@`", c)))
+                error(std::string("found character '") + c
+                      + "' that cannot start any token");
+
+            size_t start = m_pos, end = m_pos;
+            for(;;)
+            {
+                c = peek();
+                if(is_break(c))
+                    break;
+                if(c == ':'
+                   && (is_blank_or_break(peek(1)) || (flow && is_flow_indicator(peek(1)))))
+                    break;
+                if(flow && (is_flow_indicator(c) || c == '?'))
+                    break;
+                if(c == '#' && m_pos > start && is_blank(m_text[m_pos - 1]))
+                    break;
+                ++m_pos;
+                if(!is_blank(c))
+                    end = m_pos;
+            }
+            m_pos = end;
+            return m_text.substr(start, end - start);
+        }
+
+        std::string scan_scalar(bool flow, bool& quoted)
+        {
+            quoted = peek() == '\'' || peek() == '"';
+            return peek() == '\'' ? scan_single_quoted()
+                   : peek() == '"' ? scan_double_quoted()
+                                   : scan_plain(flow);
+        }
+
+        // Resolve a plain scalar with the implicit resolvers of PyYAML
+        yaml_value resolve(const std::string& text, size_t pos) const
+        {
+            static const std::regex bool_re(
+                "yes|Yes|YES|no|No|NO|true|True|TRUE|false|False|FALSE|on|On|ON|off|Off|OFF");
+            static const std::regex float_re(
+                "[-+]?(?:[0-9][0-9_]*)\\.[0-9_]*(?:[eE][-+][0-9]+)?"
+                "|\\.[0-9][0-9_]*(?:[eE][-+][0-9]+)?"
+                "|[-+]?[0-9][0-9_]*(?::[0-5]?[0-9])+\\.[0-9_]*"
+                "|[-+]?\\.(?:inf|Inf|INF)"
+                "|\\.(?:nan|NaN|NAN)");
+            static const std::regex int_re("[-+]?0b[0-1_]+"
+                                           "|[-+]?0[0-7_]+"
+                                           "|[-+]?(?:0|[1-9][0-9_]*)"
+                                           "|[-+]?0x[0-9a-fA-F_]+"
+                                           "|[-+]?[1-9][0-9_]*(?::[0-5]?[0-9])+");
+            static const std::regex null_re("~|null|Null|NULL|");
+
+            if(text.empty() || std::regex_match(text, null_re))
+                return {};
+
+            if(std::regex_match(text, bool_re))
+            {
+                char c = char(tolower(text[0]));
+                return yaml_value::boolean(c == 'y' || c == 't' || (c == 'o' && text.size() == 2));
+            }
+
+            std::string digits;
+            for(char c : text)
+                if(c != '_')
+                    digits += c;
+            int sign = 1;
+            if(digits[0] == '-' || digits[0] == '+')
+            {
+                sign = digits[0] == '-' ? -1 : 1;
+                digits.erase(0, 1);
+            }
+
+            if(std::regex_match(text, float_re))
+            {
+                std::transform(digits.begin(), digits.end(), digits.begin(), ::tolower);
+                if(digits == ".inf")
+                    return yaml_value::real(sign * std::numeric_limits<double>::infinity());
+                if(digits == ".nan") // PyYAML's NaN is -inf/inf, which has the sign bit set
+                    return yaml_value::real(
+                        std::copysign(std::numeric_limits<double>::quiet_NaN(), -1.0));
+                double value = 0;
+                if(digits.find(':') != std::string::npos)
+                {
+                    std::istringstream parts(digits);
+                    std::string        part;
+                    while(std::getline(parts, part, ':'))
+                        value = value * 60 + std::strtod(part.c_str(), nullptr);
+                }
+                else
+                    value = std::strtod(digits.c_str(), nullptr);
+                return yaml_value::real(sign * value);
+            }
+
+            if(std::regex_match(text, int_re))
+            {
+                errno         = 0;
+                int64_t value = 0;
+                if(digits == "0")
+                    value = 0;
+                else if(!digits.compare(0, 2, "0b"))
+                    value = std::strtoll(digits.c_str() + 2, nullptr, 2);
+                else if(!digits.compare(0, 2, "0x"))
+                    value = std::strtoll(digits.c_str() + 2, nullptr, 16);
+                else if(digits[0] == '0')
+                    value = std::strtoll(digits.c_str(), nullptr, 8);
+                else if(digits.find(':') != std::string::npos)
+                {
+                    std::istringstream parts(digits);
+                    std::string        part;
+                    while(std::getline(parts, part, ':'))
+                        value = value * 60 + std::strtoll(part.c_str(), nullptr, 10);
+                }
+                else
+                    value = std::strtoll(digits.c_str(), nullptr, 10);
+                if(errno == ERANGE)
+                    error("integer " + text + " is out of range", pos);
+                return yaml_value::integer(sign * value);
+            }
+
+            return yaml_value::string(text);
+        }
+
+        /*****************
+         * Merge keys    *
+         *****************/
+        struct mapping_builder
+        {
+            yaml_mapping merged, explicit_pairs;
+
+            void add(const std::string& key, bool quoted, yaml_value value, size_t pos,
+                     const yaml_parser& parser)
+            {
+                if(quoted || key != "<<")
+                {
+                    explicit_pairs.emplace_back(key, std::move(value));
+                    return;
+                }
+
+                // Earlier mappings in a merged sequence take precedence over later ones
+                if(value.type == yaml_value::kind::mapping)
+                    merged.insert(merged.end(), value.map->begin(), value.map->end());
+                else if(value.type == yaml_value::kind::sequence)
+                    for(auto it = value.seq->rbegin(); it != value.seq->rend(); ++it)
+                    {
+                        if(it->type != yaml_value::kind::mapping)
+                            parser.error("expected a mapping for merging, but found "
+                                             + std::string(it->type_name()),
+                                         pos);
+                        merged.insert(merged.end(), it->map->begin(), it->map->end());
+                    }
+                else
+                    parser.error("expected a mapping or list of mappings for merging", pos);
+            }
+
+            yaml_value build() const
+            {
+                yaml_mapping map;
+                for(auto* pairs : {&merged, &explicit_pairs})
+                    for(auto& p : *pairs)
+                        mapping_set(map, p.first, p.second);
+                return yaml_value::mapping(std::move(map));
+            }
+        };
+
+        /*******************
+         * Flow collections *
+         *******************/
+        void skip_flow()
+        {
+            for(;;)
+            {
+                if(is_blank(peek()) || peek() == '\n')
+                    ++m_pos;
+                else if(peek() == '#')
+                    while(!is_break(peek()))
+                        ++m_pos;
+                else
+                    break;
+            }
+            if(at_document_boundary())
+                error("found unexpected end of flow collection");
+        }
+
+        yaml_value parse_flow_node()
+        {
+            skip_flow();
+            std::string anchor;
+            if(peek() == '&')
+            {
+                anchor = scan_anchor_name();
+                skip_flow();
+            }
+            if(peek() == '!')
+                error("tags are not supported");
+
+            yaml_value value;
+            size_t     pos = m_pos;
+            if(peek() == '*')
+                value = scan_alias();
+            else if(peek() == '[')
+                value = parse_flow_sequence();
+            else if(peek() == '{')
+                value = parse_flow_mapping();
+            else if(is_flow_indicator(peek()))
+                value = {};
+            else
+            {
+                bool quoted;
+                auto text = scan_scalar(true, quoted);
+                value     = quoted ? yaml_value::string(text) : resolve(text, pos);
+            }
+
+            if(!anchor.empty())
+                m_anchors[anchor] = value;
+            return value;
+        }
+
+        yaml_value parse_flow_sequence()
+        {
+            yaml_sequence seq;
+            ++m_pos;
+            for(;;)
+            {
+                skip_flow();
+                if(peek() == ']')
+                    break;
+                seq.push_back(parse_flow_node());
+                skip_flow();
+                if(peek() == ',')
+                    ++m_pos;
+                else if(peek() != ']')
+                    error("expected ',' or ']', but got " + found());
+            }
+            ++m_pos;
+            return yaml_value::sequence(std::move(seq));
+        }
+
+        yaml_value parse_flow_mapping()
+        {
+            mapping_builder map;
+            ++m_pos;
+            for(;;)
+            {
+                skip_flow();
+                if(peek() == '}')
+                    break;
+
+                size_t pos = m_pos;
+                if(strchr("&*[{!", peek()))
+                    error("only scalar keys are supported");
+                bool quoted;
+                auto key = scan_scalar(true, quoted);
+                skip_flow();
+
+                yaml_value value;
+                if(peek() == ':')
+                {
+                    ++m_pos;
+                    skip_flow();
+                    if(peek() != ',' && peek() != '}')
+                        value = parse_flow_node();
+                    skip_flow();
+                }
+                map.add(key, quoted, std::move(value), pos, *this);
+
+                if(peek() == ',')
+                    ++m_pos;
+                else if(peek() != '}')
+                    error("expected ',' or '}', but got " + found());
+            }
+            ++m_pos;
+            return map.build();
+        }
+
+        /*******************
+         * Block collections *
+         *******************/
+
+        // Whether a node continuing on a following line at the current position belongs
+        // to a parent at indent. A sequence may be at the same indent as its mapping key.
+        bool continues_node(int indent, bool sequence_at_indent) const
+        {
+            if(at_document_boundary())
+                return false;
+            int col = column(m_pos);
+            return col > indent || (sequence_at_indent && col == indent && at_sequence_entry());
+        }
+
+        yaml_value parse_block_node(int indent, bool sequence_at_indent, bool allow_key)
+        {
+            if(at_line_end())
+            {
+                skip_lines();
+                if(!continues_node(indent, sequence_at_indent))
+                    return {};
+                allow_key = true;
+            }
+
+            std::string anchor;
+            bool        anchor_on_key = false;
+            if(peek() == '&')
+            {
+                anchor = scan_anchor_name();
+                if(at_line_end())
+                {
+                    skip_lines();
+                    if(!continues_node(indent, sequence_at_indent))
+                    {
+                        m_anchors[anchor] = {};
+                        return {};
+                    }
+                    allow_key = true;
+                }
+                else
+                    anchor_on_key = true;
+            }
+            if(peek() == '!')
+                error("tags are not supported");
+
+            yaml_value value;
+            size_t     pos = m_pos;
+            int        col = column(m_pos);
+            if(peek() == '*')
+            {
+                value = scan_alias();
+                expect_line_end();
+            }
+            else if(at_sequence_entry())
+            {
+                if(!allow_key)
+                    error("sequence entries are not allowed here");
+                value = parse_block_sequence(col);
+            }
+            else if(peek() == '[' || peek() == '{')
+            {
+                value = parse_flow_node();
+                expect_line_end();
+            }
+            else if(peek() == '?')
+                error("complex keys are not supported");
+            else if(peek() == '|' || peek() == '>')
+                error("block scalars are not supported");
+            else
+            {
+                bool quoted;
+                auto text = scan_scalar(false, quoted);
+                skip_blanks();
+                if(peek() == ':' && is_blank_or_break(peek(1)))
+                {
+                    if(!allow_key)
+                        error("mapping values are not allowed here");
+                    if(anchor_on_key)
+                    {
+                        m_anchors[anchor] = yaml_value::string(text);
+                        anchor.clear();
+                    }
+                    value = parse_block_mapping(col, text, quoted, pos);
+                }
+                else
+                {
+                    value = quoted ? yaml_value::string(text) : resolve(text, pos);
+                    expect_line_end();
+                }
+            }
+
+            if(!anchor.empty())
+                m_anchors[anchor] = value;
+            return value;
+        }
+
+        yaml_value parse_block_sequence(int indent)
+        {
+            yaml_sequence seq;
+            for(;;)
+            {
+                ++m_pos; // '-'
+                seq.push_back(parse_block_node(indent, false, true));
+                skip_lines();
+                if(at_document_boundary() || column(m_pos) < indent)
+                    break;
+                if(column(m_pos) > indent)
+                    error("expected <block end>, but found " + found());
+                if(!at_sequence_entry())
+                    break;
+            }
+            return yaml_value::sequence(std::move(seq));
+        }
+
+        yaml_value
+            parse_block_mapping(int indent, std::string key, bool quoted, size_t key_pos)
+        {
+            mapping_builder map;
+            for(;;)
+            {
+                ++m_pos; // ':'
+                auto value = parse_block_node(indent, true, false);
+                map.add(key, quoted, std::move(value), key_pos, *this);
+
+                skip_lines();
+                if(at_document_boundary() || column(m_pos) < indent)
+                    break;
+                if(column(m_pos) > indent || at_sequence_entry())
+                    error("expected <block end>, but found " + found());
+                if(strchr("?&*!|>[{", peek()))
+                    error("only scalar keys are supported");
+
+                key_pos = m_pos;
+                key     = scan_scalar(false, quoted);
+                skip_blanks();
+                if(peek() != ':' || !is_blank_or_break(peek(1)))
+                    error("could not find expected ':'");
+            }
+            return map.build();
+        }
+
+    public:
+        yaml_parser(const std::string& text, const std::vector<source_line>& source)
+            : m_text(text)
+            , m_source(source)
+        {
+        }
+
+        // Parse all of the documents in the stream
+        std::vector<yaml_value> parse()
+        {
+            std::vector<yaml_value> docs;
+            for(;;)
+            {
+                skip_lines();
+                if(at_end())
+                    break;
+                if(at_marker("..."))
+                {
+                    m_pos += 3;
+                    continue;
+                }
+                if(at_marker("---"))
+                    m_pos += 3;
+
+                m_anchors.clear();
+                docs.push_back(parse_block_node(-1, false, true));
+                skip_lines();
+                if(!at_document_boundary())
+                    error("expected '<document start>', but found " + found());
+            }
+            return docs;
+        }
+    };
+
+    /**************************************************************************
+     * The ctypes types which may be used in Datatypes and Arguments, with     *
+     * their sizes on the platforms which rocBLAS supports                     *
+     **************************************************************************/
+    struct ctype
+    {
+        enum class kind
+        {
+            signed_int,
+            unsigned_int,
+            real,
+            boolean,
+            character,
+        };
+
+        kind   type;
+        size_t size;
+        bool   is_enum = false; // a class declared in Datatypes
+    };
+
+    const std::map<std::string, ctype>& ctypes_types()
+    {
+        using k                                          = ctype::kind;
+        static const std::map<std::string, ctype> types = {
+            {"c_bool", {k::boolean, 1}},        {"c_char", {k::character, 1}},
+            {"c_byte", {k::signed_int, 1}},     {"c_ubyte", {k::unsigned_int, 1}},
+            {"c_int8", {k::signed_int, 1}},     {"c_uint8", {k::unsigned_int, 1}},
+            {"c_short", {k::signed_int, 2}},    {"c_ushort", {k::unsigned_int, 2}},
+            {"c_int16", {k::signed_int, 2}},    {"c_uint16", {k::unsigned_int, 2}},
+            {"c_int", {k::signed_int, 4}},      {"c_uint", {k::unsigned_int, 4}},
+            {"c_int32", {k::signed_int, 4}},    {"c_uint32", {k::unsigned_int, 4}},
+            {"c_long", {k::signed_int, sizeof(long)}},
+            {"c_ulong", {k::unsigned_int, sizeof(long)}},
+            {"c_int64", {k::signed_int, 8}},    {"c_uint64", {k::unsigned_int, 8}},
+            {"c_longlong", {k::signed_int, 8}}, {"c_ulonglong", {k::unsigned_int, 8}},
+            {"c_size_t", {k::unsigned_int, sizeof(size_t)}},
+            {"c_ssize_t", {k::signed_int, sizeof(size_t)}},
+            {"c_float", {k::real, 4}},          {"c_double", {k::real, 8}},
+        };
+        return types;
+    }
+
+    // An entry of the Datatypes namespace: a ctypes type, or a constant such as an enum value
+    struct datatype
+    {
+        bool       is_type = false;
+        ctype      type{};
+        yaml_value constant;
+    };
+
+    // A field of the Arguments structure
+    struct field
+    {
+        std::string name;
+        ctype       type;
+        size_t      count; // number of elements if an array, or 0
+        size_t      offset;
+        size_t      size;
+    };
+
+    // Python's fnmatch.fnmatchcase()
+    bool fnmatchcase(const char* name, const char* pat)
+    {
+        for(; *pat; ++pat, ++name)
+        {
+            if(*pat == '*')
+            {
+                for(const char* n = name;; ++n)
+                {
+                    if(fnmatchcase(n, pat + 1))
+                        return true;
+                    if(!*n)
+                        return false;
+                }
+            }
+            if(!*name)
+                return false;
+            if(*pat == '[' && strchr(pat + 1 + (pat[1] == '!') + 1, ']'))
+            {
+                bool        negate = pat[1] == '!';
+                const char* p      = pat + 1 + negate;
+                bool        match  = false;
+                for(const char* first = p; *p != ']' || p == first; ++p)
+                {
+                    if(p[1] == '-' && p[2] && p[2] != ']')
+                    {
+                        match |= *p <= *name && *name <= p[2];
+                        p += 2;
+                    }
+                    else
+                        match |= *p == *name;
+                }
+                if(match == negate)
+                    return false;
+                pat = p;
+            }
+            else if(*pat != '?' && *pat != *name)
+                return false;
+        }
+        return !*name;
+    }
+
+    /***************************************************************************
+     * Python numbers, for the arithmetic in setdefaults() of rocblas_gentest.py *
+     ***************************************************************************/
+    struct py_number
+    {
+        bool    is_float = false;
+        int64_t i        = 0;
+        double  d        = 0;
+
+        double value() const
+        {
+            return is_float ? d : double(i);
+        }
+
+        py_number operator*(const py_number& rhs) const
+        {
+            if(is_float || rhs.is_float)
+                return {true, 0, value() * rhs.value()};
+            return {false, i * rhs.i, 0};
+        }
+
+        py_number abs() const
+        {
+            return is_float ? py_number{true, 0, std::fabs(d)} : py_number{false, std::abs(i), 0};
+        }
+    };
+
+    // Test cases are Python dictionaries from argument names to values
+    using test_case = std::map<std::string, yaml_value>;
+
+    struct undefined_value
+    {
+        std::string key;
+    };
+
+    /****************************************************************************
+     * One level of the recursive expansion of generate() in rocblas_gentest.py *
+     ****************************************************************************/
+    struct expansion
+    {
+        enum class kind
+        {
+            merge, // merge each mapping of items into base
+            values, // set key to each element of items
+            range, // set key to each integer of a range
+            pairs, // set key and target to each key and value of items
+        };
+
+        kind        type;
+        test_case   base;
+        std::string key, target;
+        yaml_value  items;
+        int64_t     start = 0, step = 1;
+        size_t      index = 0, count = 0;
+    };
+} // namespace
+
+/******************************************************************************
+ * The expander processes the documents one at a time, keeping a stack of the *
+ * expansions which generate() in rocblas_gentest.py would have recursed into *
+ ******************************************************************************/
+struct rocblas_yaml_expander::impl
+{
+    // Source text, until it is parsed by the first call to next()
+    std::string              text;
+    std::vector<source_line> source;
+    std::string              key;
+
+    std::vector<yaml_value> docs;
+    size_t                  doc_index = 0;
+    bool                    parsed    = false;
+
+    // Settings of the current document
+    std::unordered_map<std::string, datatype> datatypes;
+    std::vector<field>                        fields;
+    size_t                                    struct_size = 0;
+    yaml_sequence                             dict_lists_to_expand;
+    yaml_sequence                             lists_to_not_expand;
+    yaml_sequence                             known_bugs;
+    yaml_value                                functions;
+
+    std::vector<expansion>          stack;
+    std::unordered_set<std::string> testcases;
+    bool                            signature_written = false;
+
+    [[noreturn]] static void fail(const std::string& msg)
+    {
+        throw rocblas_yaml_error(msg);
+    }
+
+    static yaml_sequence sequence_or_empty(const yaml_value* v)
+    {
+        if(!v || !*v)
+            return {};
+        if(v->type != yaml_value::kind::sequence)
+            fail("Expected a list, but found " + std::string(v->type_name()));
+        return *v->seq;
+    }
+
+    // Evaluate a type expression of the form "name" or "name*count"
+    bool eval_type(const std::string& decl, ctype& type, size_t& count, bool check_only = false)
+    {
+        static const std::regex type_re("([a-z_A-Z]\\w*)(:?\\s*\\*\\s*(\\d+))?");
+        std::smatch             m;
+        if(!std::regex_match(decl, m, type_re))
+            return false;
+        if(check_only)
+            return true;
+        auto it = datatypes.find(m[1]);
+        if(it == datatypes.end())
+            fail("NameError: name '" + m[1].str() + "' is not defined");
+        if(!it->second.is_type)
+            fail(decl + " is not a ctypes type");
+        if(m[2].length() && m[2].str()[0] == ':')
+            fail("SyntaxError: invalid syntax in type " + decl);
+        type  = it->second.type;
+        count = m[3].length() ? std::stoul(m[3]) : 0;
+        return true;
+    }
+
+    void get_datatypes(const yaml_value& doc)
+    {
+        datatypes.clear();
+        for(auto& t : ctypes_types())
+            datatypes[t.first] = {true, t.second, {}};
+
+        for(auto& declaration : sequence_or_empty(doc.find("Datatypes")))
+        {
+            if(declaration.type != yaml_value::kind::mapping)
+                fail("Unrecognized data type declaration " + repr(declaration));
+            for(auto& p : *declaration.map)
+            {
+                auto& name = p.first;
+                auto& decl = p.second;
+                ctype  type;
+                size_t count;
+                if(decl.type == yaml_value::kind::mapping)
+                {
+                    // A class derived from its bases, whose attributes are imported
+                    datatype dt{true, {ctype::kind::unsigned_int, 0, true}, {}};
+                    bool     has_base = false;
+                    for(auto& base : sequence_or_empty(decl.find("bases")))
+                    {
+                        if(base.is_string() && eval_type(base.s, type, count, true))
+                        {
+                            eval_type(base.s, type, count);
+                            if(!has_base)
+                                dt.type = {type.type, type.size, true};
+                            has_base = true;
+                        }
+                    }
+                    if(!has_base)
+                        dt.type.size = 0;
+                    datatypes[name] = dt;
+
+                    auto* attr = decl.find("attr");
+                    if(attr && attr->type == yaml_value::kind::mapping)
+                        for(auto& a : *attr->map)
+                        {
+                            if(eval_type(a.first, type, count, true))
+                                datatypes[a.first] = {false, {}, a.second};
+                        }
+                }
+                else if(decl.is_string() && eval_type(decl.s, type, count, true))
+                {
+                    auto it = datatypes.find(decl.s);
+                    if(it == datatypes.end())
+                        fail("KeyError: '" + decl.s + "'");
+                    datatypes[name] = it->second;
+                }
+                else
+                    fail("Unrecognized data type " + name + ": " + repr(decl));
+            }
+        }
+    }
+
+    void get_arguments(const yaml_value& doc)
+    {
+        fields.clear();
+        size_t offset = 0, align = 1;
+        for(auto& decl : sequence_or_empty(doc.find("Arguments")))
+        {
+            if(decl.type != yaml_value::kind::mapping || decl.map->size() != 1)
+                continue;
+            auto& var = decl.map->front();
+            if(!var.second.is_string())
+                fail("TypeError: expected string for the type of " + var.first);
+            field f;
+            if(!eval_type(var.second.s, f.type, f.count, true))
+                continue;
+            eval_type(var.second.s, f.type, f.count);
+            if(!f.type.size)
+                fail("TypeError: " + var.second.s + " is not a ctypes type");
+            f.name   = var.first;
+            f.size   = f.type.size * (f.count ? f.count : 1);
+            offset   = (offset + f.type.size - 1) / f.type.size * f.type.size;
+            f.offset = offset;
+            offset += f.size;
+            align = std::max(align, f.type.size);
+            fields.push_back(std::move(f));
+        }
+        struct_size = (offset + align - 1) / align * align;
+    }
+
+    static std::string repr(const yaml_value& v)
+    {
+        std::ostringstream os;
+        os << v;
+        return os.str();
+    }
+
+    static std::string repr(const test_case& test)
+    {
+        std::ostringstream os;
+        const char*        sep = "";
+        os << "{";
+        for(auto& p : test)
+            os << sep << "'" << p.first << "': " << p.second, sep = ", ";
+        os << "}";
+        return os.str();
+    }
+
+    // Start the next document which has Tests, returning false if there are none
+    bool start_document()
+    {
+        while(doc_index < docs.size())
+        {
+            auto& doc = docs[doc_index++];
+            if(!doc)
+                continue;
+            if(doc.type != yaml_value::kind::mapping)
+                fail("AttributeError: a YAML document is a " + std::string(doc.type_name())
+                     + ", not a dictionary");
+            auto* tests = doc.find("Tests");
+            if(!tests || !*tests)
+                continue;
+            if(tests->type != yaml_value::kind::sequence)
+                fail("Tests must be a list of dictionaries");
+
+            get_datatypes(doc);
+            get_arguments(doc);
+            dict_lists_to_expand = sequence_or_empty(doc.find("Dictionary lists to expand"));
+            lists_to_not_expand  = sequence_or_empty(doc.find("Lists to not expand"));
+            known_bugs           = sequence_or_empty(doc.find("Known bugs"));
+
+            auto* funcs = doc.find("Functions");
+            functions   = funcs && *funcs ? *funcs : yaml_value::mapping({});
+
+            // Each test is merged into the defaults
+            expansion e{expansion::kind::merge};
+            auto*     defaults = doc.find("Defaults");
+            if(defaults && *defaults)
+            {
+                if(defaults->type != yaml_value::kind::mapping)
+                    fail("Defaults must be a dictionary");
+                for(auto& p : *defaults->map)
+                    e.base[p.first] = p.second;
+            }
+            e.items = *tests;
+            e.count = tests->seq->size();
+            stack.push_back(std::move(e));
+            return true;
+        }
+        return false;
+    }
+
+    // Construct the next test case of an expansion
+    static test_case child(expansion& e)
+    {
+        test_case test = e.base;
+        size_t    i    = e.index++;
+        switch(e.type)
+        {
+        case expansion::kind::merge:
+        {
+            auto& item = e.items.type == yaml_value::kind::sequence ? (*e.items.seq)[i] : e.items;
+            if(item.type != yaml_value::kind::mapping)
+                fail("TypeError: cannot update a dictionary with " + std::string(item.type_name())
+                     + (e.key.empty() ? std::string()
+                                      : " for " + e.key + ", which has type " + item.type_name()
+                                            + "\nA name listed in \"Dictionary lists to expand\""
+                                              " must be a defined as a dictionary.\n"));
+            for(auto& p : *item.map)
+                test[p.first] = p.second;
+            break;
+        }
+        case expansion::kind::values:
+            test[e.key] = (*e.items.seq)[i];
+            break;
+        case expansion::kind::range:
+            test[e.key] = yaml_value::integer(e.start + int64_t(i) * e.step);
+            break;
+        case expansion::kind::pairs:
+            test[e.key]    = yaml_value::string((*e.items.map)[i].first);
+            test[e.target] = (*e.items.map)[i].second;
+            break;
+        }
+        return test;
+    }
+
+    // Match an integer range A..B[..C], returning its parameters
+    static bool match_range(const std::string& s, int64_t& a, int64_t& b, int64_t& c)
+    {
+        static const std::regex range_re(
+            "\\s*(-?\\d+)\\s*\\.\\.\\s*(-?\\d+)\\s*(?:\\.\\.\\s*(-?\\d+)\\s*)?\\n?");
+        std::smatch m;
+        if(!std::regex_match(s, m, range_re))
+            return false;
+        a = std::stoll(m[1]);
+        b = std::stoll(m[2]);
+        c = m[3].length() ? std::stoll(m[3]) : 1;
+        return true;
+    }
+
+    // Expand a test case one level, pushing the expansion onto the stack. Returns false if
+    // the test case is fully expanded.
+    bool expand(test_case& test)
+    {
+        for(;;)
+        {
+            // Dictionary lists are merged into the test case, or paired with another argument
+            for(auto& argname : dict_lists_to_expand)
+            {
+                if(argname.type == yaml_value::kind::mapping)
+                {
+                    if(argname.map->size() != 1)
+                        continue;
+                    auto& arg    = argname.map->front().first;
+                    auto& target = argname.map->front().second;
+                    auto  it     = test.find(arg);
+                    if(it == test.end() || it->second.type != yaml_value::kind::mapping)
+                        continue;
+                    if(!target.is_string())
+                        fail("TypeError: the target of " + arg + " must be a string");
+
+                    auto pairs = *it->second.map;
+                    std::stable_sort(pairs.begin(), pairs.end(), [](auto& x, auto& y) {
+                        return x.first < y.first;
+                    });
+                    expansion e{expansion::kind::pairs, test, arg, target.s};
+                    e.items = yaml_value::mapping(std::move(pairs));
+                    e.count = e.items.map->size();
+                    stack.push_back(std::move(e));
+                    return true;
+                }
+                else if(argname.is_string())
+                {
+                    auto it = test.find(argname.s);
+                    if(it == test.end()
+                       || (it->second.type != yaml_value::kind::sequence
+                           && it->second.type != yaml_value::kind::mapping))
+                        continue;
+
+                    expansion e{expansion::kind::merge, test, argname.s};
+                    e.base.erase(argname.s);
+                    e.items = it->second;
+                    e.count = it->second.type == yaml_value::kind::mapping
+                                  ? 1
+                                  : it->second.seq->size();
+                    stack.push_back(std::move(e));
+                    return true;
+                }
+            }
+
+            // Integer ranges and lists are expanded in the order of their names
+            for(auto& p : test)
+            {
+                if(p.second.is_string())
+                {
+                    int64_t a, b, c;
+                    if(!match_range(p.second.s, a, b, c))
+                        continue;
+                    if(!c)
+                        fail("ValueError: range() arg 3 must not be zero");
+                    expansion e{expansion::kind::range, test, p.first};
+                    e.start = a;
+                    e.step  = c;
+                    int64_t stop = b + 1;
+                    e.count      = c > 0 ? (stop > a ? (stop - a + c - 1) / c : 0)
+                                         : (a > stop ? (a - stop - c - 1) / -c : 0);
+                    stack.push_back(std::move(e));
+                    return true;
+                }
+                else if(p.second.type == yaml_value::kind::sequence
+                        && std::find(lists_to_not_expand.begin(),
+                                     lists_to_not_expand.end(),
+                                     yaml_value::string(p.first))
+                               == lists_to_not_expand.end())
+                {
+                    expansion e{expansion::kind::values, test, p.first};
+                    e.items = p.second;
+                    e.count = p.second.seq->size();
+                    stack.push_back(std::move(e));
+                    return true;
+                }
+            }
+
+            // Typed function names are replaced with generic functions and types
+            auto it = test.find("rocblas_function");
+            if(it == test.end())
+                return false;
+            auto func = it->second;
+            test.erase(it);
+            if(!func.is_string())
+                fail("AttributeError: rocblas_function " + repr(func) + " is not a string");
+            auto* generic = functions.find(func.s);
+            if(generic)
+            {
+                if(generic->type != yaml_value::kind::mapping)
+                    fail("TypeError: Functions entry " + func.s + " is not a dictionary");
+                for(auto& p : *generic->map)
+                    test[p.first] = p.second;
+            }
+            else
+            {
+                auto pos           = func.s.rfind("rocblas_");
+                test["function"] = yaml_value::string(
+                    pos == std::string::npos ? func.s : func.s.substr(pos + 8));
+            }
+        }
+    }
+
+    /***************************************************************
+     * Dynamic defaults, ported from setdefaults() in rocblas_gentest.py *
+     ***************************************************************/
+    static const yaml_value& get(const test_case& test, const std::string& key)
+    {
+        auto it = test.find(key);
+        if(it == test.end())
+            throw undefined_value{key};
+        return it->second;
+    }
+
+    static py_number num(const test_case& test, const std::string& key)
+    {
+        auto& v = get(test, key);
+        if(v.type == yaml_value::kind::real)
+            return {true, 0, v.d};
+        if(v.is_number())
+            return {false, v.i, 0};
+        fail("TypeError: " + key + " is " + repr(v) + ", which is not a number");
+    }
+
+    static std::string upper(const test_case& test, const std::string& key)
+    {
+        auto& v = get(test, key);
+        if(!v.is_string())
+            fail("AttributeError: " + key + " is " + repr(v) + ", which is not a string");
+        std::string s = v.s;
+        std::transform(s.begin(), s.end(), s.begin(), ::toupper);
+        return s;
+    }
+
+    static int64_t to_int(const py_number& n)
+    {
+        if(!n.is_float)
+            return n.i;
+        if(!std::isfinite(n.d))
+            fail("ValueError: cannot convert float " + std::to_string(n.d) + " to integer");
+        return int64_t(std::trunc(n.d));
+    }
+
+    static bool all_in(const test_case& test, std::initializer_list<const char*> keys)
+    {
+        for(auto* k : keys)
+            if(!test.count(k))
+                return false;
+        return true;
+    }
+
+    static void setdefault(test_case& test, const char* key, int64_t value)
+    {
+        test.emplace(key, yaml_value::integer(value));
+    }
+
+    static void setkey_product(test_case&                         test,
+                               const char*                        key,
+                               std::initializer_list<const char*> vals)
+    {
+        if(!all_in(test, vals))
+            return;
+        py_number result{false, 1, 0};
+        for(auto* x : vals)
+        {
+            auto n = num(test, x);
+            result = result * (!strcmp(x, "incx") || !strcmp(x, "incy") ? n.abs() : n);
+        }
+        test[key] = yaml_value::integer(to_int(result));
+    }
+
+    static void setdefaults(test_case& test)
+    {
+        auto& function = get(test, "function");
+        if(!function.is_string())
+            fail("TypeError: function is " + repr(function) + ", which is not a string");
+        auto& func = function.s;
+
+        // rocblas_gentest.py tests some functions with "in" against a single string rather
+        // than a tuple, which tests whether the function is a substring of it
+        auto in_str = [&](const char* s) { return strstr(s, func.c_str()) != nullptr; };
+        auto in     = [&](std::initializer_list<const char*> names) {
+            for(auto* name : names)
+                if(func == name)
+                    return true;
+            return false;
+        };
+
+        if(in({"asum_strided_batched",    "nrm2_strided_batched",    "scal_strided_batched",
+               "swap_strided_batched",    "copy_strided_batched",    "dot_strided_batched",
+               "dotc_strided_batched",    "dot_strided_batched_ex",  "dotc_strided_batched_ex",
+               "rot_strided_batched",     "rot_strided_batched_ex",  "rotm_strided_batched",
+               "iamax_strided_batched",   "iamin_strided_batched",   "axpy_strided_batched",
+               "axpy_strided_batched_ex", "nrm2_strided_batched_ex", "scal_strided_batched_ex"}))
+        {
+            setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+            setkey_product(test, "stride_y", {"N", "incy", "stride_scale"});
+            // rocblas_gentest.py tests the characters of 'stride_scale' here, so it never
+            // sets the default of stride_c
+        }
+        else if(in_str("tpmv_strided_batched"))
+        {
+            setkey_product(test, "stride_x", {"M", "incx", "stride_scale"});
+            setkey_product(test, "stride_a", {"M", "M", "stride_scale"});
+        }
+        else if(in_str("trmv_strided_batched"))
+        {
+            setkey_product(test, "stride_x", {"M", "incx", "stride_scale"});
+            setkey_product(test, "stride_a", {"M", "lda", "stride_scale"});
+        }
+        else if(in({"gemv_strided_batched",
+                    "gbmv_strided_batched",
+                    "ger_strided_batched",
+                    "geru_strided_batched",
+                    "gerc_strided_batched",
+                    "trsv_strided_batched"}))
+        {
+            if(in({"ger_strided_batched",
+                   "geru_strided_batched",
+                   "gerc_strided_batched",
+                   "trsv_strided_batched"})
+               || get(test, "transA") == yaml_value::string("T")
+               || get(test, "transA") == yaml_value::string("C"))
+            {
+                setkey_product(test, "stride_x", {"M", "incx", "stride_scale"});
+                setkey_product(test, "stride_y", {"N", "incy", "stride_scale"});
+            }
+            else
+            {
+                setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+                setkey_product(test, "stride_y", {"M", "incy", "stride_scale"});
+            }
+            if(in_str("gbmv_strided_batched"))
+                setkey_product(test, "stride_a", {"lda", "N", "stride_scale"});
+            if(in_str("trsv_strided_batched"))
+                setkey_product(test, "stride_a", {"lda", "M", "stride_scale"});
+        }
+        else if(in({"hemv_strided_batched", "hbmv_strided_batched", "sbmv_strided_batched"}))
+        {
+            if(all_in(test, {"N", "incx", "incy", "stride_scale"}))
+            {
+                setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+                setkey_product(test, "stride_y", {"N", "incy", "stride_scale"});
+                setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+            }
+        }
+        else if(in_str("hpmv_strided_batched"))
+        {
+            if(all_in(test, {"N", "incx", "incy", "stride_scale"}))
+            {
+                setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+                setkey_product(test, "stride_y", {"N", "incy", "stride_scale"});
+                auto N  = num(test, "N");
+                auto N1 = N.is_float ? py_number{true, 0, N.d + 1} : py_number{false, N.i + 1, 0};
+                auto ldN = N * N1 * num(test, "stride_scale");
+                setdefault(test, "stride_a", to_int({true, 0, ldN.value() / 2}));
+            }
+        }
+        else if(in({"spr_strided_batched",
+                    "spr2_strided_batched",
+                    "hpr_strided_batched",
+                    "hpr2_strided_batched",
+                    "tpsv_strided_batched"}))
+        {
+            setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+            setkey_product(test, "stride_y", {"N", "incy", "stride_scale"});
+            setkey_product(test, "stride_a", {"N", "N", "stride_scale"});
+        }
+        else if(in({"her_strided_batched", "her2_strided_batched", "syr2_strided_batched"}))
+        {
+            setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+            setkey_product(test, "stride_y", {"N", "incy", "stride_scale"});
+            setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+        }
+        else if(in_str("rotg_strided_batched"))
+        {
+            if(test.count("stride_scale"))
+            {
+                int64_t scale = to_int(num(test, "stride_scale"));
+                setdefault(test, "stride_a", scale);
+                setdefault(test, "stride_b", scale);
+                setdefault(test, "stride_c", scale);
+                setdefault(test, "stride_d", scale);
+            }
+        }
+        else if(in_str("rotmg_strided_batched"))
+        {
+            if(test.count("stride_scale"))
+            {
+                int64_t scale = to_int(num(test, "stride_scale"));
+                setdefault(test, "stride_a", scale);
+                setdefault(test, "stride_b", scale);
+                setdefault(test, "stride_c", scale * 5);
+                setdefault(test, "stride_x", scale);
+                setdefault(test, "stride_y", scale);
+            }
+        }
+        else if(in_str("dgmm_strided_batched"))
+        {
+            setkey_product(test, "stride_c", {"N", "ldc", "stride_scale"});
+            setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+            if(upper(test, "side") == "L")
+                setkey_product(test, "stride_x", {"M", "incx", "stride_scale"});
+            else
+                setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+        }
+        else if(in_str("geam_strided_batched"))
+        {
+            setkey_product(test, "stride_c", {"N", "ldc", "stride_scale"});
+            if(upper(test, "transA") == "N")
+                setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+            else
+                setkey_product(test, "stride_a", {"M", "lda", "stride_scale"});
+            if(upper(test, "transB") == "N")
+                setkey_product(test, "stride_b", {"N", "ldb", "stride_scale"});
+            else
+                setkey_product(test, "stride_b", {"M", "ldb", "stride_scale"});
+        }
+        else if(in({"trmm_strided_batched", "trmm_outofplace_strided_batched"}))
+        {
+            setkey_product(test, "stride_b", {"N", "ldb", "stride_scale"});
+            setkey_product(test, "stride_c", {"N", "ldc", "stride_scale"});
+            if(upper(test, "side") == "L")
+                setkey_product(test, "stride_a", {"M", "lda", "stride_scale"});
+            else
+                setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+        }
+        else if(in({"trsm_strided_batched", "trsm_strided_batched_ex"}))
+        {
+            setkey_product(test, "stride_b", {"N", "ldb", "stride_scale"});
+            if(upper(test, "side") == "L")
+                setkey_product(test, "stride_a", {"M", "lda", "stride_scale"});
+            else
+                setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+        }
+        else if(in_str("tbmv_strided_batched"))
+        {
+            if(all_in(test, {"M", "lda", "stride_scale"}))
+                setdefault(test,
+                           "stride_a",
+                           to_int(num(test, "M") * num(test, "lda") * num(test, "stride_scale")));
+            if(all_in(test, {"M", "incx", "stride_scale"}))
+                setdefault(
+                    test,
+                    "stride_x",
+                    to_int(num(test, "M") * num(test, "incx").abs() * num(test, "stride_scale")));
+        }
+        else if(in_str("tbsv_strided_batched"))
+        {
+            setkey_product(test, "stride_a", {"N", "lda", "stride_scale"});
+            setkey_product(test, "stride_x", {"N", "incx", "stride_scale"});
+        }
+
+        setdefault(test, "stride_x", 0);
+        setdefault(test, "stride_y", 0);
+
+        auto star = yaml_value::string("*");
+        if(get(test, "transA") == star || get(test, "transB") == star)
+        {
+            setdefault(test, "lda", 0);
+            setdefault(test, "ldb", 0);
+            setdefault(test, "ldc", 0);
+            setdefault(test, "ldd", 0);
+        }
+        else
+        {
+            // Gemm defaults
+            auto nonzero = [&](const char* key) {
+                auto& v = get(test, key);
+                return v == yaml_value::integer(0) ? yaml_value::integer(1) : v;
+            };
+            bool notransA = upper(test, "transA") == "N";
+            test.emplace("lda", notransA ? nonzero("M") : nonzero("K"));
+            bool notransB = upper(test, "transB") == "N";
+            test.emplace("ldb", notransB ? nonzero("K") : nonzero("N"));
+            test.emplace("ldc", nonzero("M"));
+            test.emplace("ldd", nonzero("M"));
+            if(num(test, "batch_count").value() > 0)
+            {
+                auto product = [&](const char* x, const char* y) {
+                    auto n = num(test, x) * num(test, y);
+                    return n.is_float ? yaml_value::real(n.d) : yaml_value::integer(n.i);
+                };
+                test.emplace("stride_a", product("lda", notransA ? "K" : "M"));
+                test.emplace("stride_b", product("ldb", notransB ? "N" : "K"));
+                test.emplace("stride_c", product("ldc", "N"));
+                test.emplace("stride_d", product("ldd", "N"));
+                return;
+            }
+        }
+
+        setdefault(test, "stride_a", 0);
+        setdefault(test, "stride_b", 0);
+        setdefault(test, "stride_c", 0);
+        setdefault(test, "stride_d", 0);
+    }
+
+    /********************
+     * Binary records   *
+     ********************/
+
+    // The signature used to verify binary file compatibility
+    std::string signature() const
+    {
+        std::string byt("rocBLAS", 8);
+        size_t      last_ofs = 0;
+        unsigned    sig      = 0;
+        for(auto& f : fields)
+        {
+            byt.append(f.offset - last_ofs, '\0');
+            for(size_t i = 0; i < f.size; ++i)
+                byt += char(sig ^ i);
+            sig      = (sig + 89) % 256;
+            last_ofs = f.offset + f.size;
+        }
+        byt.append(struct_size - last_ofs, '\0');
+        byt.append("ROCblas", 8);
+        return byt;
+    }
+
+    // Store a value into a ctypes scalar, as the ctypes constructors convert it
+    static void store(char* dst, const ctype& type, const yaml_value& v, const std::string& name)
+    {
+        auto type_error = [&](const char* what) {
+            fail(std::string("TypeError: ") + what + " for " + name + ", which has type "
+                 + v.type_name() + "\n");
+        };
+        switch(type.type)
+        {
+        case ctype::kind::signed_int:
+        case ctype::kind::unsigned_int:
+        {
+            if(v.type != yaml_value::kind::integer && v.type != yaml_value::kind::boolean)
+                type_error("an integer is required");
+            uint64_t u = uint64_t(v.i);
+            memcpy(dst, &u, type.size); // little-endian truncation, as ctypes does
+            break;
+        }
+        case ctype::kind::real:
+        {
+            if(!v.is_number())
+                type_error("must be real number");
+            double d = v.type == yaml_value::kind::real ? v.d : double(v.i);
+            if(type.size == sizeof(float))
+            {
+                float f = float(d);
+                memcpy(dst, &f, sizeof(f));
+            }
+            else
+                memcpy(dst, &d, sizeof(d));
+            break;
+        }
+        case ctype::kind::boolean:
+            *dst = bool(v);
+            break;
+        case ctype::kind::character:
+            if(!v.is_string())
+                type_error("encoding without a string argument");
+            if(v.s.size() != 1)
+                type_error("one character bytes, bytearray or integer expected");
+            *dst = v.s[0];
+            break;
+        }
+    }
+
+    // Append the record of a test case, if it has not been seen already
+    bool write_test(const test_case& test, std::string& out)
+    {
+        std::string byt(struct_size, '\0');
+        for(auto& f : fields)
+        {
+            auto& v   = get(test, f.name);
+            char* dst = &byt[f.offset];
+            if(!f.count)
+                store(dst, f.type, v, f.name);
+            else if(f.type.type == ctype::kind::character)
+            {
+                if(!v.is_string())
+                    fail("TypeError: encoding without a string argument for " + f.name
+                         + ", which has type " + v.type_name() + "\n");
+                if(v.s.size() > f.count)
+                    fail("ValueError: bytes too long (" + std::to_string(v.s.size())
+                         + ", maximum length " + std::to_string(f.count) + ") for " + f.name);
+                memcpy(dst, v.s.data(), v.s.size());
+            }
+            else
+            {
+                if(v.type != yaml_value::kind::sequence)
+                    fail("TypeError: " + f.name + " must be a list, but has type "
+                         + v.type_name() + "\n");
+                if(v.seq->size() > f.count)
+                    fail("IndexError: too many initializers for " + f.name);
+                for(size_t i = 0; i < v.seq->size(); ++i)
+                    store(dst + i * f.type.size, f.type, (*v.seq)[i], f.name);
+            }
+        }
+
+        if(!testcases.insert(byt).second)
+            return false;
+        if(!signature_written)
+        {
+            out += signature();
+            signature_written = true;
+        }
+        out += byt;
+        return true;
+    }
+
+    // Instantiate a fully expanded test case, as instantiate() in rocblas_gentest.py does
+    bool instantiate(test_case test, std::string& out)
+    {
+        try
+        {
+            setdefaults(test);
+
+            // For enum arguments, replace names with values
+            for(auto& f : fields)
+            {
+                if(!f.type.is_enum)
+                    continue;
+                auto& v = get(test, f.name);
+                if(!v.is_string())
+                    continue;
+                auto it = datatypes.find(v.s);
+                if(it == datatypes.end())
+                    continue;
+                if(it->second.is_type)
+                    fail("TypeError: " + f.name + " is the type " + v.s);
+                test[f.name] = it->second.constant;
+            }
+
+            auto is_enum = [&](const std::string& key) {
+                for(auto& f : fields)
+                    if(f.name == key)
+                        return f.type.is_enum;
+                return false;
+            };
+
+            auto& category = get(test, "category");
+            if(!category.is_string())
+                fail("TypeError: category is " + repr(category) + ", which is not a string");
+            auto not_known_bug = [&] { return !strstr("known_bug", test["category"].s.c_str()); };
+
+            // Match known bugs
+            std::set<std::string> known_bug_platforms;
+            if(not_known_bug())
+            {
+                for(auto& bug : known_bugs)
+                {
+                    if(bug.type != yaml_value::kind::mapping)
+                        fail("AttributeError: a known bug is not a dictionary");
+                    bool match = true;
+                    for(auto& p : *bug.map)
+                    {
+                        auto& key   = p.first;
+                        auto& value = p.second;
+                        if(key == "known_bug_platforms" || key == "category")
+                            continue;
+                        auto it = test.find(key);
+                        if(it == test.end())
+                        {
+                            match = false;
+                            break;
+                        }
+                        if(key == "function")
+                        {
+                            if(!it->second.is_string() || !value.is_string())
+                                fail("TypeError: known bug function must be a string");
+                            if(!fnmatchcase(it->second.s.c_str(), value.s.c_str()))
+                            {
+                                match = false;
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            // For keys declared as enums, compare resulting values
+                            const yaml_value* expected = &value;
+                            if(is_enum(key) && value.is_string())
+                            {
+                                auto dt = datatypes.find(value.s);
+                                if(dt != datatypes.end() && !dt->second.is_type)
+                                    expected = &dt->second.constant;
+                            }
+                            if(it->second != *expected)
+                            {
+                                match = false;
+                                break;
+                            }
+                        }
+                    }
+                    if(!match)
+                        continue;
+
+                    // All values specified in the known bug match the test case
+                    auto*       platforms_value = bug.find("known_bug_platforms");
+                    std::string platforms;
+                    if(platforms_value)
+                    {
+                        if(!platforms_value->is_string())
+                            fail("AttributeError: known_bug_platforms must be a string");
+                        platforms = platforms_value->s;
+                    }
+
+                    // If at least one platform is specified, the test is a known bug only on
+                    // those platforms
+                    static const char seps[] = " :,\f\n\r\t\v";
+                    if(platforms.find_first_not_of(seps) != std::string::npos)
+                    {
+                        size_t p = 0;
+                        for(;;)
+                        {
+                            size_t e = platforms.find_first_of(seps, p);
+                            known_bug_platforms.insert(platforms.substr(p, e - p));
+                            if(e == std::string::npos)
+                                break;
+                            p = platforms.find_first_not_of(seps, e);
+                            if(p == std::string::npos)
+                            {
+                                known_bug_platforms.insert("");
+                                break;
+                            }
+                        }
+                    }
+                    else
+                        test["category"] = yaml_value::string("known_bug");
+                    break;
+                }
+            }
+
+            // Python joins a set, whose order is arbitrary for more than one platform; the
+            // platforms are sorted here
+            std::string joined;
+            if(not_known_bug())
+            {
+                const char* sep = "";
+                for(auto& platform : known_bug_platforms)
+                    joined += sep + platform, sep = " ";
+            }
+            test["known_bug_platforms"] = yaml_value::string(joined);
+
+            return write_test(test, out);
+        }
+        catch(const undefined_value& e)
+        {
+            fail("Undefined value '" + e.key + "'\n" + repr(test));
+        }
+    }
+};
+
+rocblas_yaml_expander::rocblas_yaml_expander(const std::string&              yaml_file,
+                                             const std::vector<std::string>& include_dirs,
+                                             const std::string&              template_file)
+    : m_impl(std::make_unique<impl>())
+{
+    auto& s = *m_impl;
+    if(!template_file.empty())
+        read_yaml_file(template_file, include_dirs, s.source);
+    read_yaml_file(yaml_file, include_dirs, s.source);
+
+    for(auto& line : s.source)
+        s.text += line.text;
+
+    // The records depend only on the source text, with the includes expanded, and on the
+    // sources of the expander. The key is the FNV-1a hash of the source text and of the hash
+    // of the expander's sources, which CMake computes, and the text length.
+    uint64_t hash = 0xcbf29ce484222325;
+    for(unsigned char c : ROCBLAS_YAML_EXPAND_SOURCE_HASH "\n" + s.text)
+        hash = (hash ^ c) * 0x100000001b3;
+    std::ostringstream key;
+    key << std::hex << std::setfill('0') << std::setw(16) << hash << '-' << s.text.size();
+    s.key = key.str();
+}
+
+rocblas_yaml_expander::~rocblas_yaml_expander() = default;
+
+const std::string& rocblas_yaml_expander::key() const
+{
+    return m_impl->key;
+}
+
+bool rocblas_yaml_expander::next(std::string& out)
+{
+    auto& s = *m_impl;
+    if(!s.parsed)
+    {
+        s.docs   = yaml_parser(s.text, s.source).parse();
+        s.parsed = true;
+        s.text.clear();
+        s.text.shrink_to_fit();
+        s.source.clear();
+        s.source.shrink_to_fit();
+    }
+
+    for(;;)
+    {
+        if(s.stack.empty() && !s.start_document())
+            return false;
+
+        auto& e = s.stack.back();
+        if(e.index == e.count)
+        {
+            s.stack.pop_back();
+            continue;
+        }
+
+        // Expand the next test case until it is fully expanded or pushes an expansion
+        test_case test = impl::child(e);
+        if(!s.expand(test) && s.instantiate(std::move(test), out))
+            return true;
+    }
+}
+
+/*******************************
+ * rocblas_yaml_istream        *
+ *******************************/
+namespace
+{
+    // Prefixes of the files in the cache of expanded YAML files, written by the clients and
+    // by rocblas_gentest.py --cache
+    constexpr const char* yaml_cache_prefixes[] = {"yaml-", "gentest-"};
+
+    // Remove the least recently used files from the cache, other than keep, until its size
+    // is at most ROCBLAS_TEST_DATA_CACHE_SIZE megabytes (4096 by default)
+    void prune_yaml_cache(const fs::path& dir, const fs::path& keep)
+    {
+        const char* env   = getenv("ROCBLAS_TEST_DATA_CACHE_SIZE");
+        uintmax_t   limit = (env && *env ? strtoull(env, nullptr, 10) : 4096) << 20;
+
+        struct entry
+        {
+            fs::file_time_type time;
+            uintmax_t          size;
+            fs::path           path;
+        };
+        std::vector<entry> entries;
+        std::error_code    ec;
+        for(fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+        {
+            std::string name = it->path().filename().string();
+            bool        ours = false;
+            for(const char* prefix : yaml_cache_prefixes)
+                ours |= !name.compare(0, strlen(prefix), prefix);
+            if(!ours || it->path().extension() != ".data")
+                continue;
+            std::error_code fec;
+            entry           e{fs::last_write_time(it->path(), fec), 0, it->path()};
+            e.size = fs::file_size(it->path(), fec);
+            if(!fec)
+                entries.push_back(std::move(e));
+        }
+
+        // Keep the most recently used files which fit in the limit
+        std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+            return a.time > b.time;
+        });
+        uintmax_t total = 0;
+        for(auto& e : entries)
+        {
+            total += e.size;
+            if(total > limit && e.path != keep)
+                fs::remove(e.path, ec);
+        }
+    }
+}
+
+std::string rocblas_yaml_cache_dir()
+{
+    const char* dir = getenv("ROCBLAS_TEST_DATA_CACHE");
+    return dir ? dir : "";
+}
+
+rocblas_yaml_istream::streambuf::streambuf(const std::string&              yaml_file,
+                                           const std::vector<std::string>& include_dirs,
+                                           const std::string&              template_file,
+                                           const std::string&              cache_dir)
+try : m_expander(yaml_file, include_dirs, template_file)
+{
+    if(!cache_dir.empty())
+    {
+        fs::path cache_file = fs::path(cache_dir) / ("yaml-" + m_expander.key() + ".data");
+
+        // Read the records from the cache if they are there, marking them as recently used
+        std::ifstream is(cache_file, std::ios::binary);
+        if(is)
+        {
+            m_data.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+            m_done = !is.bad();
+        }
+        m_cached = m_done;
+        if(m_done)
+        {
+            std::error_code ec;
+            fs::last_write_time(cache_file, fs::file_time_type::clock::now(), ec);
+        }
+        else
+        {
+            m_data.clear();
+            m_cache_file = cache_file.string();
+        }
+    }
+    setg(&m_data[0], &m_data[0], &m_data[0] + m_data.size());
+}
+catch(const std::exception& e)
+{
+    rocblas_cerr << e.what() << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+void rocblas_yaml_istream::streambuf::store_cache()
+{
+    // Write to a temporary file which is renamed, so that concurrent readers and writers of
+    // the cache only see complete files. Failures leave the cache unchanged.
+    fs::path        cache_file = std::move(m_cache_file);
+    fs::path        temp_file  = cache_file;
+    std::error_code ec;
+    temp_file += "." + std::to_string(std::random_device{}()) + ".tmp";
+    fs::create_directories(cache_file.parent_path(), ec);
+    {
+        std::ofstream os(temp_file, std::ios::binary);
+        if(!os.write(m_data.data(), m_data.size()) || !os.flush())
+        {
+            fs::remove(temp_file, ec);
+            return;
+        }
+    }
+    fs::rename(temp_file, cache_file, ec);
+    if(ec)
+        fs::remove(temp_file, ec);
+    else
+        prune_yaml_cache(cache_file.parent_path(), cache_file);
+}
+
+void rocblas_yaml_istream::streambuf::expand(size_t size)
+{
+    size_t offset = gptr() - eback();
+    try
+    {
+        while(!m_done && m_data.size() < size)
+            m_done = !m_expander.next(m_data);
+    }
+    catch(const std::exception& e)
+    {
+        rocblas_cerr << e.what() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // Once all of the records have been expanded, they can be cached
+    if(m_done && !m_cache_file.empty())
+        store_cache();
+    setg(&m_data[0], &m_data[0] + std::min(offset, m_data.size()), &m_data[0] + m_data.size());
+}
+
+rocblas_yaml_istream::streambuf::int_type rocblas_yaml_istream::streambuf::underflow()
+{
+    if(gptr() == egptr())
+        expand(m_data.size() + 1);
+    return gptr() == egptr() ? traits_type::eof() : traits_type::to_int_type(*gptr());
+}
+
+rocblas_yaml_istream::streambuf::pos_type rocblas_yaml_istream::streambuf::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if(dir == std::ios_base::end)
+    {
+        expand(std::numeric_limits<size_t>::max());
+        off += m_data.size();
+    }
+    else if(dir == std::ios_base::cur)
+        off += gptr() - eback();
+    return seekpos(pos_type(off), which);
+}
+
+rocblas_yaml_istream::streambuf::pos_type
+    rocblas_yaml_istream::streambuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    off_type off = pos;
+    if(!(which & std::ios_base::in) || off < 0)
+        return pos_type(off_type(-1));
+    expand(size_t(off));
+    if(size_t(off) > m_data.size())
+        return pos_type(off_type(-1));
+    setg(&m_data[0], &m_data[0] + off, &m_data[0] + m_data.size());
+    return pos;
+}
+
+rocblas_yaml_istream::rocblas_yaml_istream(const std::string&              yaml_file,
+                                           const std::vector<std::string>& include_dirs,
+                                           const std::string&              template_file,
+                                           const std::string&              cache_dir)
+    : std::istream(nullptr)
+    , m_buf(std::make_unique<streambuf>(yaml_file, include_dirs, template_file, cache_dir))
+{
+    rdbuf(m_buf.get());
+}
@@ -63,7 +63,8 @@ namespace
             switch(TRSM_TYPE)
             {
             case TRSM:
-                return !strcmp(arg.function, "trsm") || !strcmp(arg.function, "trsm_bad_arg");
+                return !strcmp(arg.function, "trsm") || !strcmp(arg.function, "trsm_bad_arg")
+                       || !strcmp(arg.function, "trsm_blksize");
             case TRSM_EX:
                 return !strcmp(arg.function, "trsm_ex") || !strcmp(arg.function, "trsm_ex_bad_arg");
             case TRSM_BATCHED:
@@ -142,6 +143,8 @@ namespace
                 testing_trsm<T>(arg);
             else if(!strcmp(arg.function, "trsm_bad_arg"))
                 testing_trsm_bad_arg<T>(arg);
+            else if(!strcmp(arg.function, "trsm_blksize"))
+                testing_trsm_blksize<T>(arg);
             else if(!strcmp(arg.function, "trsm_ex"))
                 testing_trsm_ex<T>(arg);
             else if(!strcmp(arg.function, "trsm_ex_bad_arg"))
@@ -0,0 +1,304 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "lapack_utilities.hpp"
+#include "near.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+#include <cmath>
+#include <cstring>
+#include <gtest/internal/gtest-internal.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using testing::internal::FloatingPoint;
+
+    // Values at the edges of the floating point types: signed zeros, denormals, the smallest
+    // normals, values a few ULPs apart, the largest finite values, infinities and NaNs
+    template <typename T>
+    std::vector<T> edge_values()
+    {
+        using L = std::numeric_limits<T>;
+        std::vector<T> v{T(0),
+                         -T(0),
+                         L::denorm_min(),
+                         -L::denorm_min(),
+                         T(2) * L::denorm_min(),
+                         T(5) * L::denorm_min(),
+                         std::nextafter(L::min(), T(0)),
+                         L::min(),
+                         -L::min(),
+                         L::max(),
+                         -L::max(),
+                         L::infinity(),
+                         -L::infinity(),
+                         L::quiet_NaN(),
+                         -L::quiet_NaN()};
+        for(T x : {T(1), T(-3)})
+        {
+            T y = x;
+            for(int ulp = 0; ulp <= 6; ulp++, y = std::nextafter(y, L::infinity()))
+                v.push_back(y);
+        }
+        return v;
+    }
+
+    // The assertions of UNIT_CHECK: a NaN reference requires a NaN result, and other values are
+    // compared with ASSERT_FLOAT_EQ or ASSERT_DOUBLE_EQ
+    template <typename T>
+    bool gtest_unit(T a, T b)
+    {
+        return std::isnan(a) ? std::isnan(b)
+                             : FloatingPoint<T>(a).AlmostEquals(FloatingPoint<T>(b));
+    }
+
+    // The assertions of NEAR_CHECK: a NaN reference requires a NaN result, and other values are
+    // compared with ASSERT_NEAR
+    bool gtest_near(double a, double b, double err)
+    {
+        return std::isnan(a)
+                   ? std::isnan(b)
+                   : bool(testing::internal::DoubleNearPredFormat("a", "b", "err", a, b, err));
+    }
+
+    // A norm agrees with xlange to rounding, and NaN and infinite norms are the same
+    void expect_norm(double norm, double xlange, const char* what, char norm_type)
+    {
+        if(std::isnan(xlange))
+            EXPECT_TRUE(std::isnan(norm)) << what << " norm " << norm_type;
+        else if(std::isinf(xlange) || xlange == 0)
+            EXPECT_EQ(norm, xlange) << what << " norm " << norm_type;
+        else
+            EXPECT_NEAR(norm, xlange, xlange * 1e-13) << what << " norm " << norm_type;
+    }
+
+    template <typename...>
+    struct testing_compare : rocblas_test_valid
+    {
+        template <typename T>
+        static void test_real_elements()
+        {
+            std::vector<T> values = edge_values<T>();
+            for(T a : values)
+                for(T b : values)
+                {
+                    EXPECT_EQ(unit_check_element(a, b), gtest_unit(a, b)) << a << " " << b;
+                    for(double err : {0.0,
+                                      double(std::numeric_limits<T>::denorm_min()),
+                                      double(std::numeric_limits<T>::epsilon()),
+                                      1.0,
+                                      std::numeric_limits<double>::infinity()})
+                        EXPECT_EQ(near_check_element(a, b, err), gtest_near(a, b, err))
+                            << a << " " << b << " " << err;
+                }
+        }
+
+        template <typename T>
+        static void test_complex_elements()
+        {
+            using R = real_t<T>;
+            std::vector<R> values = edge_values<R>();
+            for(R ar : values)
+                for(R br : values)
+                    for(R i : {R(0), -R(0), R(1), std::numeric_limits<R>::quiet_NaN()})
+                    {
+                        T a{ar, i}, b{br, i}, c{i, ar}, d{i, br};
+                        EXPECT_EQ(unit_check_element(a, b),
+                                  rocblas_isnan(a) ? rocblas_isnan(b)
+                                                   : gtest_unit(ar, br) && gtest_unit(i, i))
+                            << ar << " " << br << " " << i;
+                        EXPECT_EQ(unit_check_element(c, d),
+                                  rocblas_isnan(c) ? rocblas_isnan(d)
+                                                   : gtest_unit(i, i) && gtest_unit(ar, br))
+                            << ar << " " << br << " " << i;
+                        EXPECT_EQ(near_check_element(a, b, 1.0),
+                                  rocblas_isnan(a)
+                                      ? rocblas_isnan(b)
+                                      : gtest_near(ar, br, 1.0) && gtest_near(i, i, 1.0))
+                            << ar << " " << br << " " << i;
+                    }
+        }
+
+        // rocblas_half and rocblas_bfloat16 are compared as floats
+        template <typename T>
+        static void test_16bit_elements()
+        {
+            std::vector<float> values = edge_values<float>();
+            for(float af : values)
+                for(float bf : values)
+                {
+                    T a(af), b(bf);
+                    EXPECT_EQ(unit_check_element(a, b),
+                              rocblas_isnan(a) ? rocblas_isnan(b) : gtest_unit(float(a), float(b)))
+                        << af << " " << bf;
+                    EXPECT_EQ(near_check_element(a, b, 1.0),
+                              gtest_near(double(a), double(b), 1.0))
+                        << af << " " << bf;
+                }
+        }
+
+        // A float reference may be matched by its truncated or rounded rocblas_bfloat16
+        static void test_float_bfloat16_elements()
+        {
+            std::vector<float> values = edge_values<float>();
+            for(float a : values)
+                for(float bf : values)
+                {
+                    rocblas_bfloat16 b(bf);
+                    rocblas_bfloat16 truncated(
+                        a, rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
+                    bool unit = std::isnan(a)
+                                    ? rocblas_isnan(b)
+                                    : gtest_unit(float(b), float(truncated))
+                                          || gtest_unit(float(b), float(rocblas_bfloat16(a)));
+                    EXPECT_EQ(unit_check_element(a, b), unit) << a << " " << bf;
+                    EXPECT_EQ(near_check_element(a, b, 1.0),
+                              gtest_near(double(rocblas_bfloat16(a)), double(b), 1.0))
+                        << a << " " << bf;
+                }
+        }
+
+        // The norms of the reference and of the difference gathered by rocblas_compare agree with
+        // lapack_xlange for matrices holding edge values
+        template <typename T>
+        static void test_norms()
+        {
+            using R = real_t<T>;
+            using D = std::conditional_t<rocblas_is_complex<T>, rocblas_double_complex, double>;
+            constexpr rocblas_int M   = 7;
+            constexpr rocblas_int N   = 5;
+            constexpr rocblas_int lda = 9;
+
+            // Signed zeros, denormals, the smallest normals and values a few ULPs apart, scaled
+            // by 1, and so that their squares overflow or underflow, then with an infinity, with
+            // a NaN, and all zero
+            std::vector<R> values;
+            for(R x : edge_values<R>())
+                if(std::abs(x) < 4)
+                    values.push_back(x);
+            size_t n     = values.size();
+            R      large = std::sqrt(std::numeric_limits<R>::max()) * 4;
+            R      small = std::sqrt(std::numeric_limits<R>::min()) / 4;
+
+            for(int matrix = 0; matrix < 6; matrix++)
+            {
+                R scale = matrix == 1 ? large : matrix == 2 ? small : R(1);
+
+                host_vector<T> ref(size_t(lda) * N), res(size_t(lda) * N);
+                for(size_t k = 0; k < ref.size(); k++)
+                {
+                    R a = values[k % n] * scale, b = values[(k * 7 + 3) % n] * scale;
+                    if constexpr(rocblas_is_complex<T>)
+                    {
+                        ref[k] = T(a, values[(k + 5) % n] * scale);
+                        res[k] = k % 3 ? ref[k] : T(b, a);
+                    }
+                    else
+                    {
+                        ref[k] = a;
+                        res[k] = k % 3 ? a : b;
+                    }
+                }
+                if(matrix == 3)
+                    ref[lda + 2] = std::numeric_limits<R>::infinity();
+                if(matrix == 4)
+                    res[2 * lda + 4] = std::numeric_limits<R>::quiet_NaN();
+                if(matrix == 5)
+                    for(size_t k = 0; k < ref.size(); k++)
+                        ref[k] = res[k] = T(0);
+
+                // The difference is taken in double precision, like in rocblas_compare
+                host_vector<D> error(ref.size());
+                for(size_t k = 0; k < ref.size(); k++)
+                    error[k] = D(res[k]) - D(ref[k]);
+
+                auto stats = rocblas_compare(
+                    M,
+                    N,
+                    lda,
+                    1,
+                    [&](size_t) { return ref.data(); },
+                    [&](size_t) { return res.data(); });
+
+                std::vector<double> work(M);
+                for(char norm_type : {'M', 'O', 'F'})
+                {
+                    expect_norm(stats.ref_norm(norm_type),
+                                lapack_xlange(norm_type, M, N, ref.data(), lda, work.data()),
+                                "reference",
+                                norm_type);
+                    expect_norm(stats.error_norm(norm_type),
+                                lapack_xlange(norm_type, M, N, error.data(), lda, work.data()),
+                                "error",
+                                norm_type);
+                }
+            }
+        }
+
+        void operator()(const Arguments&)
+        {
+            test_real_elements<float>();
+            test_real_elements<double>();
+            test_complex_elements<rocblas_float_complex>();
+            test_complex_elements<rocblas_double_complex>();
+            test_16bit_elements<rocblas_half>();
+            test_16bit_elements<rocblas_bfloat16>();
+            test_float_bfloat16_elements();
+            test_norms<float>();
+            test_norms<double>();
+            test_norms<rocblas_double_complex>();
+        }
+    };
+
+    struct compare : RocBLAS_Test<compare, testing_compare>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "compare");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<compare>(arg.name);
+        }
+    };
+
+    TEST_P(compare, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_compare<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(compare)
+
+} // namespace
@@ -0,0 +1,531 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../library/src/include/rocblas_device_arena.hpp"
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <map>
+#include <string>
+
+namespace
+{
+    // Mock backend which allocates host memory, counts calls, and fails
+    // allocations which would take the total above a limit
+    struct mock_device
+    {
+        std::map<void*, size_t> live;
+        size_t                  limit       = ~size_t{0};
+        size_t                  total       = 0;
+        size_t                  allocations = 0;
+        size_t                  frees       = 0;
+
+        int allocate(void** ptr, size_t size)
+        {
+            if(total + size > limit)
+                return 2;
+            *ptr = malloc(size);
+            live[*ptr] = size;
+            total += size;
+            ++allocations;
+            return 0;
+        }
+
+        int deallocate(void* ptr)
+        {
+            auto it = live.find(ptr);
+            if(it == live.end())
+                return 1;
+            total -= it->second;
+            live.erase(it);
+            free(ptr);
+            ++frees;
+            return 0;
+        }
+
+        rocblas_device_arena make_arena()
+        {
+            return rocblas_device_arena(
+                [this](void** ptr, size_t size) { return allocate(ptr, size); },
+                [this](void* ptr) { return deallocate(ptr); });
+        }
+
+        rocblas_device_arena_pool make_pool()
+        {
+            return rocblas_device_arena_pool(
+                [this](void** ptr, size_t size) { return allocate(ptr, size); },
+                [this](void* ptr) { return deallocate(ptr); });
+        }
+    };
+
+    // Size of each slab in the host-only tests
+    constexpr size_t SLAB = 1024;
+
+    template <typename...>
+    struct testing_device_arena : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // Allocations within one slab are contiguous and released in LIFO order
+            {
+                mock_device          dev;
+                rocblas_device_arena arena = dev.make_arena();
+                ASSERT_EQ(arena.reserve(SLAB), 0);
+
+                char* a = static_cast<char*>(arena.allocate(256, false));
+                char* b = static_cast<char*>(arena.allocate(512, false));
+                ASSERT_NE(a, nullptr);
+                EXPECT_EQ(b, a + 256);
+                EXPECT_EQ(arena.in_use(), 768u);
+                EXPECT_EQ(arena.available(), SLAB - 768);
+
+                // Without growth, an allocation which does not fit fails
+                EXPECT_EQ(arena.allocate(512, false), nullptr);
+
+                // Releasing out of LIFO order is detected
+                EXPECT_EQ(arena.release(256), rocblas_device_arena::LIFO_VIOLATION);
+                EXPECT_EQ(arena.release(512), 256u);
+                EXPECT_EQ(arena.release(256), 0u);
+                EXPECT_EQ(arena.peak(), 768u);
+                EXPECT_EQ(arena.reallocations(), 0u);
+                EXPECT_EQ(arena.clear(), 0);
+                EXPECT_EQ(dev.frees, 1u);
+            }
+
+            // Growth appends a slab, keeping live allocations in place, and later
+            // allocations reuse the appended slab when it is kept
+            {
+                mock_device          dev;
+                rocblas_device_arena arena = dev.make_arena();
+                arena.set_high_water(8 * SLAB);
+                ASSERT_EQ(arena.reserve(SLAB), 0);
+
+                void* a = arena.allocate(768, true);
+                void* b = arena.allocate(4 * SLAB, true);
+                ASSERT_NE(b, nullptr);
+                EXPECT_EQ(arena.slabs(), 2u);
+                EXPECT_EQ(arena.reallocations(), 1u);
+                EXPECT_EQ(arena.capacity(), 5 * SLAB);
+
+                EXPECT_NE(a, nullptr);
+                EXPECT_EQ(arena.release(4 * SLAB), 768u);
+                EXPECT_EQ(arena.release(768), 0u);
+
+                // Later allocations skip the base slab and reuse the appended slab
+                EXPECT_EQ(arena.allocate(2 * SLAB, true), b);
+                EXPECT_EQ(arena.allocate(2 * SLAB, true), static_cast<char*>(b) + 2 * SLAB);
+                EXPECT_EQ(arena.release(2 * SLAB), 2 * SLAB);
+                EXPECT_EQ(arena.release(2 * SLAB), 0u);
+                EXPECT_EQ(arena.reallocations(), 1u);
+                EXPECT_EQ(arena.peak(), 768 + 4 * SLAB);
+
+                // User-owned memory is never passed to the backend
+                char user[64];
+                EXPECT_EQ(arena.clear(), 0);
+                arena.adopt(user, sizeof(user), false);
+                EXPECT_EQ(arena.allocate(64, false), static_cast<void*>(user));
+                EXPECT_EQ(arena.release(64), 0u);
+                EXPECT_EQ(arena.clear(), 0);
+                EXPECT_EQ(dev.frees, dev.allocations);
+                EXPECT_TRUE(dev.live.empty());
+            }
+
+            // Slabs appended on demand are released when idle above the high-water mark
+            {
+                mock_device          dev;
+                rocblas_device_arena arena = dev.make_arena();
+                arena.set_high_water(2 * SLAB);
+                ASSERT_EQ(arena.reserve(SLAB), 0);
+
+                arena.allocate(SLAB, true);
+                arena.allocate(SLAB, true);
+                arena.allocate(SLAB, true);
+                EXPECT_EQ(arena.slabs(), 3u);
+                EXPECT_EQ(arena.release(SLAB), 2 * SLAB);
+                EXPECT_EQ(arena.release(SLAB), SLAB);
+                EXPECT_EQ(arena.slabs(), 3u);
+                EXPECT_EQ(arena.release(SLAB), 0u);
+                EXPECT_EQ(arena.slabs(), 2u);
+                EXPECT_EQ(arena.capacity(), 2 * SLAB);
+
+                // The high-water mark of 0 is the size of the base slab
+                arena.set_high_water(0);
+                arena.allocate(SLAB, true);
+                EXPECT_EQ(arena.release(SLAB), 0u);
+                EXPECT_EQ(arena.slabs(), 1u);
+                EXPECT_EQ(arena.clear(), 0);
+            }
+
+            // By default, an idle arena keeps the slabs it grew, so later calls which need
+            // them allocate nothing
+            {
+                mock_device          dev;
+                rocblas_device_arena arena = dev.make_arena();
+                ASSERT_EQ(arena.reserve(2 * SLAB), 0);
+
+                arena.allocate(SLAB, true);
+                arena.allocate(4 * SLAB, true);
+                EXPECT_EQ(arena.capacity(), 6 * SLAB);
+                EXPECT_EQ(arena.release(4 * SLAB), SLAB);
+                EXPECT_EQ(arena.release(SLAB), 0u);
+                EXPECT_EQ(arena.slabs(), 2u);
+                EXPECT_EQ(arena.capacity(), 6 * SLAB);
+
+                size_t allocations = dev.allocations;
+                for(int i = 0; i < 3; ++i)
+                {
+                    arena.allocate(SLAB, true);
+                    arena.allocate(4 * SLAB, true);
+                    EXPECT_EQ(arena.release(4 * SLAB), SLAB);
+                    EXPECT_EQ(arena.release(SLAB), 0u);
+                }
+                EXPECT_EQ(dev.allocations, allocations);
+                EXPECT_EQ(dev.frees, 0u);
+                EXPECT_EQ(arena.reallocations(), 1u);
+
+                // With a high-water mark of 0, an idle arena returns to its base slab
+                arena.set_high_water(0);
+                arena.allocate(SLAB, true);
+                EXPECT_EQ(arena.release(SLAB), 0u);
+                EXPECT_EQ(arena.slabs(), 1u);
+                EXPECT_EQ(arena.capacity(), 2 * SLAB);
+                EXPECT_EQ(dev.total, 2 * SLAB);
+
+                // A slab which the backend fails to free is reported and kept
+                int status;
+                void* slab = arena.allocate(4 * SLAB, true);
+                auto  size = dev.live.at(slab);
+                dev.live.erase(slab);
+                EXPECT_EQ(arena.release(4 * SLAB, &status), 0u);
+                EXPECT_EQ(status, 1);
+                EXPECT_EQ(arena.slabs(), 2u);
+                dev.live[slab] = size;
+                EXPECT_EQ(arena.allocate(4 * SLAB, true), slab);
+                EXPECT_EQ(arena.release(4 * SLAB, &status), 0u);
+                EXPECT_EQ(status, 0);
+                EXPECT_EQ(arena.slabs(), 1u);
+                EXPECT_EQ(arena.clear(), 0);
+                EXPECT_TRUE(dev.live.empty());
+            }
+
+            // When the backend is out of memory, empty slabs are released and the
+            // allocation is retried
+            {
+                mock_device          dev;
+                rocblas_device_arena arena = dev.make_arena();
+                dev.limit                  = 4 * SLAB;
+                arena.set_high_water(8 * SLAB);
+                ASSERT_EQ(arena.reserve(SLAB), 0);
+
+                arena.allocate(2 * SLAB, true);
+                EXPECT_EQ(arena.release(2 * SLAB), 0u);
+                EXPECT_EQ(arena.slabs(), 2u);
+
+                EXPECT_NE(arena.allocate(3 * SLAB, true), nullptr);
+                EXPECT_EQ(arena.slabs(), 2u);
+                EXPECT_EQ(arena.capacity(), 4 * SLAB);
+                EXPECT_EQ(arena.allocate(SLAB, true), nullptr);
+                EXPECT_EQ(arena.release(3 * SLAB), 0u);
+                EXPECT_EQ(arena.clear(), 0);
+            }
+
+            // A rocBLAS-managed handle grows its device memory while it is in use
+            {
+                rocblas_local_handle handle;
+                CHECK_ROCBLAS_ERROR(rocblas_set_device_memory_size(handle, 0));
+
+                size_t peak, slabs, reallocations;
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_device_memory_stats(handle, &peak, &slabs, &reallocations));
+                EXPECT_EQ(slabs, 0u);
+
+                rocblas_device_malloc_base* outer;
+                rocblas_device_malloc_base* inner;
+                void*                       outer_ptr;
+                void*                       inner_ptr;
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_device_malloc_alloc(handle, &outer, 1, size_t(1 << 20)));
+                CHECK_ROCBLAS_ERROR(rocblas_device_malloc_ptr(outer, &outer_ptr));
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_device_malloc_alloc(handle, &inner, 1, size_t(8 << 20)));
+                CHECK_ROCBLAS_ERROR(rocblas_device_malloc_ptr(inner, &inner_ptr));
+                EXPECT_NE(inner_ptr, outer_ptr);
+
+                size_t size;
+                CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_size(handle, &size));
+                EXPECT_EQ(size, size_t(9 << 20));
+
+                CHECK_ROCBLAS_ERROR(rocblas_device_malloc_free(inner));
+                CHECK_ROCBLAS_ERROR(rocblas_device_malloc_free(outer));
+
+                size_t new_reallocations;
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_device_memory_stats(handle, &peak, &slabs, &new_reallocations));
+                EXPECT_EQ(new_reallocations, reallocations + 2);
+                EXPECT_GE(peak, size_t(9 << 20));
+
+                EXPECT_EQ(rocblas_get_device_memory_stats(handle, nullptr, &slabs, &peak),
+                          rocblas_status_invalid_pointer);
+                EXPECT_EQ(rocblas_get_device_memory_stats(nullptr, &peak, &slabs, &peak),
+                          rocblas_status_invalid_handle);
+            }
+        }
+    };
+
+    template <typename...>
+    struct testing_workspace_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            int streams[4];
+
+            // Each key has its own arena, and idle arenas are evicted in LRU order
+            {
+                mock_device               dev;
+                rocblas_device_arena_pool pool = dev.make_pool();
+                pool.set_budget(3 * SLAB);
+                pool.set_high_water(8 * SLAB);
+                EXPECT_TRUE(pool.enabled());
+
+                void* p[3];
+                for(int i = 0; i < 3; ++i)
+                {
+                    auto& arena = pool.acquire(&streams[i]);
+                    p[i]        = arena.allocate(SLAB, true);
+                    EXPECT_EQ(arena.release(SLAB), 0u);
+                }
+                EXPECT_NE(p[0], p[1]);
+                EXPECT_NE(p[1], p[2]);
+                EXPECT_EQ(pool.size(), 3u);
+                EXPECT_EQ(pool.misses(), 3u);
+                EXPECT_EQ(pool.capacity(), 3 * SLAB);
+
+                // Switching back reuses the arena of the stream, and its memory
+                auto& arena0 = pool.acquire(&streams[0]);
+                EXPECT_EQ(pool.hits(), 1u);
+                EXPECT_EQ(arena0.allocate(SLAB, true), p[0]);
+                EXPECT_EQ(&pool.acquire(&streams[0]), &arena0);
+                EXPECT_EQ(pool.hits(), 2u);
+
+                // A fourth stream exceeds the budget once it has allocated; the next switch
+                // evicts the least recently used idle arena (stream 1). Stream 0 is in use.
+                auto& arena3 = pool.acquire(&streams[3]);
+                arena3.allocate(SLAB, true);
+                EXPECT_EQ(arena3.release(SLAB), 0u);
+                pool.acquire(&streams[0]);
+                EXPECT_EQ(pool.evictions(), 1u);
+                EXPECT_EQ(pool.size(), 3u);
+                EXPECT_EQ(pool.capacity(), 3 * SLAB);
+                EXPECT_EQ(pool.hits(), 3u);
+                pool.acquire(&streams[1]);
+                EXPECT_EQ(pool.misses(), 5u);
+                EXPECT_EQ(pool.hits(), 3u);
+
+                // Arenas in use are not cleared
+                EXPECT_NE(pool.clear(), 0);
+                EXPECT_EQ(arena0.release(SLAB), 0u);
+                EXPECT_EQ(pool.clear(), 0);
+                EXPECT_EQ(pool.size(), 0u);
+                EXPECT_TRUE(dev.live.empty());
+            }
+
+            // New arenas start with a base slab, and lookups by find() neither create arenas
+            // nor change the order in which they are evicted
+            {
+                mock_device               dev;
+                rocblas_device_arena_pool pool = dev.make_pool();
+                pool.set_budget(2 * SLAB);
+                pool.set_base_size(SLAB);
+
+                EXPECT_EQ(pool.find(&streams[0]), nullptr);
+                auto& arena0 = pool.acquire(&streams[0]);
+                EXPECT_EQ(arena0.capacity(), SLAB);
+                EXPECT_EQ(arena0.available(), SLAB);
+                EXPECT_NE(arena0.allocate(SLAB, false), nullptr);
+                EXPECT_EQ(arena0.release(SLAB), 0u);
+
+                pool.acquire(&streams[1]);
+                EXPECT_EQ(pool.find(&streams[0]), &arena0);
+                EXPECT_EQ(pool.find(&streams[2]), nullptr);
+                EXPECT_EQ(pool.size(), 2u);
+                EXPECT_EQ(pool.hits(), 0u);
+                EXPECT_EQ(pool.misses(), 2u);
+
+                // Stream 0 is still the least recently acquired, so it is evicted
+                pool.acquire(&streams[2]);
+                EXPECT_EQ(pool.evictions(), 1u);
+                EXPECT_EQ(pool.find(&streams[0]), nullptr);
+                EXPECT_NE(pool.find(&streams[1]), nullptr);
+                EXPECT_EQ(pool.clear(), 0);
+                EXPECT_TRUE(dev.live.empty());
+            }
+
+            // A handle gives each stream its own device memory when the budget is nonzero.
+            // Allocations within the base workspace of a stream reuse it.
+            {
+                rocblas_local_handle handle;
+                if(rocblas_is_user_managing_device_memory(handle))
+                    return;
+                size_t base_size;
+                CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_size(handle, &base_size));
+                if(base_size < size_t(1 << 20))
+                    return;
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_set_workspace_pool_budget(handle, 2 * base_size + size_t(64 << 20)));
+
+                hipStream_t stream[2];
+                void*       ptr[2];
+                for(int i = 0; i < 2; ++i)
+                    CHECK_HIP_ERROR(hipStreamCreate(&stream[i]));
+
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    for(int i = 0; i < 2; ++i)
+                    {
+                        CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, stream[i]));
+                        rocblas_device_malloc_base* mem;
+                        void*                       p;
+                        CHECK_ROCBLAS_ERROR(
+                            rocblas_device_malloc_alloc(handle, &mem, 1, size_t(1 << 20)));
+                        CHECK_ROCBLAS_ERROR(rocblas_device_malloc_ptr(mem, &p));
+                        CHECK_ROCBLAS_ERROR(rocblas_device_malloc_free(mem));
+                        if(pass)
+                            EXPECT_EQ(p, ptr[i]);
+                        else
+                            ptr[i] = p;
+                    }
+                }
+                EXPECT_NE(ptr[0], ptr[1]);
+
+                size_t pools, hits, misses, evictions;
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_workspace_pool_stats(handle, &pools, &hits, &misses, &evictions));
+                EXPECT_EQ(pools, 2u);
+                EXPECT_EQ(misses, 2u);
+                EXPECT_EQ(hits, 2u);
+                EXPECT_EQ(evictions, 0u);
+
+                CHECK_ROCBLAS_ERROR(rocblas_set_workspace_pool_budget(handle, 0));
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_workspace_pool_stats(handle, &pools, &hits, &misses, &evictions));
+                EXPECT_EQ(pools, 0u);
+
+                CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, 0));
+                for(int i = 0; i < 2; ++i)
+                    CHECK_HIP_ERROR(hipStreamDestroy(stream[i]));
+            }
+
+            // The device memory of each stream starts with the handle's base size, and
+            // device memory size queries do not create it
+            {
+                rocblas_local_handle handle;
+                size_t               base_size;
+                CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_size(handle, &base_size));
+                CHECK_ROCBLAS_ERROR(rocblas_set_workspace_pool_budget(handle, 4 * base_size + 1));
+
+                hipStream_t stream;
+                CHECK_HIP_ERROR(hipStreamCreate(&stream));
+                CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, stream));
+
+                const rocblas_int    N = 64;
+                const float          alpha = 1, beta = 0;
+                device_vector<float> dA(N * N), dB(N * N), dC(N * N);
+                CHECK_DEVICE_ALLOCATION(dA.memcheck());
+                CHECK_DEVICE_ALLOCATION(dB.memcheck());
+                CHECK_DEVICE_ALLOCATION(dC.memcheck());
+                auto sgemm = [&] {
+                    return rocblas_sgemm(handle,
+                                         rocblas_operation_none,
+                                         rocblas_operation_none,
+                                         N,
+                                         N,
+                                         N,
+                                         &alpha,
+                                         dA,
+                                         N,
+                                         dB,
+                                         N,
+                                         &beta,
+                                         dC,
+                                         N);
+                };
+
+                size_t size, pools, hits, misses, evictions;
+                CHECK_ROCBLAS_ERROR(rocblas_start_device_memory_size_query(handle));
+                EXPECT_NE(sgemm(), rocblas_status_internal_error);
+                CHECK_ROCBLAS_ERROR(rocblas_stop_device_memory_size_query(handle, &size));
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_workspace_pool_stats(handle, &pools, &hits, &misses, &evictions));
+                EXPECT_EQ(pools, 0u);
+                EXPECT_EQ(misses, 0u);
+
+                CHECK_ROCBLAS_ERROR(sgemm());
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_workspace_pool_stats(handle, &pools, &hits, &misses, &evictions));
+                EXPECT_EQ(pools, 1u);
+                EXPECT_EQ(misses, 1u);
+                CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_size(handle, &size));
+                EXPECT_GE(size, base_size);
+
+                CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+                CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, 0));
+                CHECK_HIP_ERROR(hipStreamDestroy(stream));
+            }
+        }
+    };
+
+    struct device_arena : RocBLAS_Test<device_arena, testing_device_arena>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "device_arena")
+                   || !strcmp(arg.function, "workspace_pool");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<device_arena>(arg.name);
+        }
+    };
+
+    TEST_P(device_arena, auxiliary)
+    {
+        const Arguments& arg = GetParam();
+        if(!strcmp(arg.function, "device_arena"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_device_arena<>{}(arg));
+        else if(!strcmp(arg.function, "workspace_pool"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_workspace_pool<>{}(arg));
+    }
+    INSTANTIATE_TEST_CATEGORIES(device_arena)
+
+} // namespace
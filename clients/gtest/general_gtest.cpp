@@ -22,6 +22,7 @@
 
 #include "rocblas_test.hpp"
 
+#include "../../library/src/blas2/rocblas_level2_threshold.hpp"
 #include "../../library/src/include/check_numerics_matrix.hpp"
 #include "../../library/src/include/check_numerics_vector.hpp"
 #include "rocblas_data.hpp"
@@ -1149,4 +1150,131 @@ namespace
     }
     INSTANTIATE_TEST_CATEGORIES(check_numerics_matrix);
 
+    //
+    // Level 2 dispatch thresholds, checked on the host against a synthetic table
+
+    template <typename T>
+    void testing_level2_thresholds(const Arguments& arg)
+    {
+        const char  p = "sdcz"[rocblas_level2_precision_index<T>];
+        std::string table = "# synthetic\nrocblas_level2_threshold 1\n";
+        for(const char* arch : {"gfx1", "gfx2", "gfx30"})
+            table += std::string(arch) + ' ' + p + " gemvn_upper 100\n";
+        table += std::string("gfx1 ") + p + " gemvn_lower 1000\n" + "gfx1 " + p
+                 + " gemvt_double_buffered_lower 500\n" + "gfx1 " + p
+                 + " gemvt_warp_reduce_upper 200\n" + "gfx1 " + p
+                 + " gemvt_shared_reduce_upper 300\n" + "gfx1 " + p + " symv_U_upper 64\n"
+                 + "gfx1 " + p + " symv_U_generic_upper 50\n" + "gfx1 " + p
+                 + " symv_U_generic_lower 70\n" + "gfx1 " + p + " symv_L_lower 640\n";
+
+        rocblas_level2_threshold_db db;
+        std::istringstream          is(table);
+        ASSERT_TRUE(rocblas_level2_thresholds_read(is, db));
+
+        const rocblas_level2_thresholds& t = db.lookup("gfx1")[rocblas_level2_precision_index<T>];
+
+        EXPECT_TRUE(rocblas_gemvn_use_small_blocks(t, 100, 100));
+        EXPECT_FALSE(rocblas_gemvn_use_small_blocks(t, 101, 100));
+        EXPECT_FALSE(rocblas_gemvn_use_small_blocks(t, 999, 1000));
+        EXPECT_TRUE(rocblas_gemvn_use_small_blocks(t, 1000, 1000));
+
+        EXPECT_FALSE(rocblas_gemvt_use_double_buffered(t, 500));
+        EXPECT_TRUE(rocblas_gemvt_use_double_buffered(t, 501));
+
+        EXPECT_TRUE(rocblas_gemvt_use_warp_reduce(t, 199, 5000));
+        EXPECT_FALSE(rocblas_gemvt_use_warp_reduce(t, 200, 200));
+        EXPECT_TRUE(rocblas_gemvt_use_shared_reduce(t, 5000, 299));
+        EXPECT_FALSE(rocblas_gemvt_use_shared_reduce(t, 300, 300));
+
+        EXPECT_TRUE(rocblas_symv_use_double_buffered(t, rocblas_fill_upper, 32));
+        EXPECT_FALSE(rocblas_symv_use_double_buffered(t, rocblas_fill_upper, 64));
+        EXPECT_TRUE(rocblas_symv_use_double_buffered(t, rocblas_fill_upper, 49));
+        EXPECT_FALSE(rocblas_symv_use_double_buffered(t, rocblas_fill_upper, 65));
+        EXPECT_TRUE(rocblas_symv_use_double_buffered(t, rocblas_fill_upper, 71));
+        EXPECT_FALSE(rocblas_symv_use_double_buffered(t, rocblas_fill_lower, 640));
+        EXPECT_TRUE(rocblas_symv_use_double_buffered(t, rocblas_fill_lower, 672));
+        EXPECT_FALSE(rocblas_symv_use_double_buffered(t, rocblas_fill_lower, 671));
+
+        // gfx3001 takes the entry of its family gfx30, and gfx4 takes the default
+        const auto& family = db.lookup("gfx3001")[rocblas_level2_precision_index<T>];
+        const auto& other  = db.lookup("gfx4")[rocblas_level2_precision_index<T>];
+        EXPECT_TRUE(rocblas_gemvn_use_small_blocks(family, 100, 100));
+        EXPECT_FALSE(rocblas_gemvn_use_small_blocks(other, 1, 1));
+        EXPECT_FALSE(rocblas_symv_use_double_buffered(other, rocblas_fill_lower, 32));
+
+        // The table round trips, and malformed tables are rejected without changes
+        std::stringstream ss;
+        rocblas_level2_thresholds_write(ss, db);
+        rocblas_level2_threshold_db copy;
+        ASSERT_TRUE(rocblas_level2_thresholds_read(ss, copy));
+        std::stringstream ss2;
+        rocblas_level2_thresholds_write(ss2, copy);
+        EXPECT_EQ(ss.str(), ss2.str());
+
+        for(const char* bad : {"rocblas_level2_threshold 2\n",
+                               "rocblas_level2_threshold 1\ngfx1 q gemvn_upper 1\n",
+                               "rocblas_level2_threshold 1\ngfx1 s gemvn_middle 1\n",
+                               "rocblas_level2_threshold 1\ngfx1 s gemvn_upper -1\n",
+                               "rocblas_level2_threshold 1\ngfx1 s gemvn_upper 1 2\n"})
+        {
+            std::istringstream bad_is(bad);
+            EXPECT_FALSE(rocblas_level2_thresholds_read(bad_is, copy));
+        }
+        EXPECT_TRUE(rocblas_gemvn_use_small_blocks(
+            copy.lookup("gfx1")[rocblas_level2_precision_index<T>], 100, 100));
+    }
+
+    // By default, arbitrary type combinations are invalid.
+    // The unnamed second parameter is used for enable_if_t below.
+    template <typename, typename = void>
+    struct level2_thresholds_testing : rocblas_test_invalid
+    {
+    };
+
+    template <typename T>
+    struct level2_thresholds_testing<
+        T,
+        std::enable_if_t<std::is_same<T, float>{} || std::is_same<T, double>{}
+                         || std::is_same<T, rocblas_float_complex>{}
+                         || std::is_same<T, rocblas_double_complex>{}>> : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            if(!strcmp(arg.function, "level2_thresholds"))
+                testing_level2_thresholds<T>(arg);
+            else
+                FAIL() << "Internal error: Test called with unknown function: " << arg.function;
+        }
+    };
+
+    struct level2_thresholds : RocBLAS_Test<level2_thresholds, level2_thresholds_testing>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments& arg)
+        {
+            return rocblas_simple_dispatch<level2_thresholds::template type_filter_functor>(arg);
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "level2_thresholds");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            RocBLAS_TestName<level2_thresholds> name(arg.name);
+            name << rocblas_datatype2string(arg.a_type);
+            return std::move(name);
+        }
+    };
+
+    TEST_P(level2_thresholds, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_simple_dispatch<level2_thresholds_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(level2_thresholds);
+
 } // namespace
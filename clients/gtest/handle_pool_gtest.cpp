@@ -0,0 +1,192 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template <typename...>
+    struct testing_clone_handle : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            rocblas_handle             handle, clone;
+            rocblas_pointer_mode       pointer_mode;
+            rocblas_atomics_mode       atomics_mode;
+            rocblas_performance_metric metric;
+            size_t                     size;
+
+            EXPECT_EQ(rocblas_clone_handle(nullptr, &clone), rocblas_status_invalid_handle);
+
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+            EXPECT_EQ(rocblas_clone_handle(handle, nullptr), rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+            CHECK_ROCBLAS_ERROR(rocblas_set_atomics_mode(handle, rocblas_atomics_not_allowed));
+            CHECK_ROCBLAS_ERROR(
+                rocblas_set_performance_metric(handle, rocblas_cu_efficiency_performance_metric));
+            CHECK_ROCBLAS_ERROR(rocblas_set_device_memory_size(handle, 4 << 20));
+
+            // The clone has the settings and workspace size of the handle
+            CHECK_ROCBLAS_ERROR(rocblas_clone_handle(handle, &clone));
+            CHECK_ROCBLAS_ERROR(rocblas_get_pointer_mode(clone, &pointer_mode));
+            CHECK_ROCBLAS_ERROR(rocblas_get_atomics_mode(clone, &atomics_mode));
+            CHECK_ROCBLAS_ERROR(rocblas_get_performance_metric(clone, &metric));
+            CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_size(clone, &size));
+            EXPECT_EQ(pointer_mode, rocblas_pointer_mode_device);
+            EXPECT_EQ(atomics_mode, rocblas_atomics_not_allowed);
+            EXPECT_EQ(metric, rocblas_cu_efficiency_performance_metric);
+            EXPECT_EQ(size, size_t(4 << 20));
+            EXPECT_TRUE(rocblas_is_user_managing_device_memory(clone));
+
+            // Changing the settings of the clone does not change the handle
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(clone, rocblas_pointer_mode_host));
+            CHECK_ROCBLAS_ERROR(rocblas_get_pointer_mode(handle, &pointer_mode));
+            EXPECT_EQ(pointer_mode, rocblas_pointer_mode_device);
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(clone));
+
+            // A workspace owned by the user is not shared with the clone
+            void* workspace;
+            CHECK_HIP_ERROR((hipMalloc)(&workspace, 1 << 20));
+            CHECK_ROCBLAS_ERROR(rocblas_set_workspace(handle, workspace, 1 << 20));
+            CHECK_ROCBLAS_ERROR(rocblas_clone_handle(handle, &clone));
+            EXPECT_FALSE(rocblas_is_user_managing_device_memory(clone));
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(clone));
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(handle));
+            CHECK_HIP_ERROR((hipFree)(workspace));
+        }
+    };
+
+    template <typename...>
+    struct testing_handle_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            constexpr size_t NTHREAD = 8;
+            constexpr size_t NITER   = 50;
+
+            rocblas_handle_pool  pool;
+            rocblas_handle       handles[3];
+            rocblas_pointer_mode pointer_mode;
+            size_t               hits, misses, parked;
+
+            EXPECT_EQ(rocblas_create_handle_pool(nullptr, 2), rocblas_status_invalid_pointer);
+            EXPECT_EQ(rocblas_destroy_handle_pool(nullptr), rocblas_status_invalid_pointer);
+
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle_pool(&pool, 2));
+            EXPECT_EQ(rocblas_handle_pool_acquire(pool, nullptr), rocblas_status_invalid_pointer);
+            EXPECT_EQ(rocblas_handle_pool_release(pool, nullptr), rocblas_status_invalid_handle);
+
+            // At most 2 released handles are parked
+            for(auto& handle : handles)
+                CHECK_ROCBLAS_ERROR(rocblas_handle_pool_acquire(pool, &handle));
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handles[0], rocblas_pointer_mode_device));
+            for(auto& handle : handles)
+                CHECK_ROCBLAS_ERROR(rocblas_handle_pool_release(pool, handle));
+            CHECK_ROCBLAS_ERROR(rocblas_get_handle_pool_stats(pool, &hits, &misses, &parked));
+            EXPECT_EQ(hits, 0u);
+            EXPECT_EQ(misses, 3u);
+            EXPECT_EQ(parked, 2u);
+
+            // A parked handle is reset to the default settings
+            for(size_t i = 0; i < 2; ++i)
+            {
+                CHECK_ROCBLAS_ERROR(rocblas_handle_pool_acquire(pool, &handles[i]));
+                CHECK_ROCBLAS_ERROR(rocblas_get_pointer_mode(handles[i], &pointer_mode));
+                EXPECT_EQ(pointer_mode, rocblas_pointer_mode_host);
+            }
+            CHECK_ROCBLAS_ERROR(rocblas_get_handle_pool_stats(pool, &hits, nullptr, &parked));
+            EXPECT_EQ(hits, 2u);
+            EXPECT_EQ(parked, 0u);
+
+            // A handle whose workspace was resized is destroyed rather than parked
+            CHECK_ROCBLAS_ERROR(rocblas_set_device_memory_size(handles[0], 1 << 20));
+            for(size_t i = 0; i < 2; ++i)
+                CHECK_ROCBLAS_ERROR(rocblas_handle_pool_release(pool, handles[i]));
+            CHECK_ROCBLAS_ERROR(rocblas_get_handle_pool_stats(pool, nullptr, nullptr, &parked));
+            EXPECT_EQ(parked, 1u);
+
+            // Concurrent acquisitions never return the same handle to two threads
+            int device;
+            CHECK_HIP_ERROR(hipGetDevice(&device));
+            std::vector<std::thread> threads;
+            for(size_t t = 0; t < NTHREAD; ++t)
+                threads.emplace_back([&] {
+                    CHECK_HIP_ERROR(hipSetDevice(device));
+                    for(size_t i = 0; i < NITER; ++i)
+                    {
+                        rocblas_handle       handle;
+                        rocblas_pointer_mode mode;
+                        CHECK_ROCBLAS_ERROR(rocblas_handle_pool_acquire(pool, &handle));
+                        CHECK_ROCBLAS_ERROR(rocblas_get_pointer_mode(handle, &mode));
+                        EXPECT_EQ(mode, rocblas_pointer_mode_host);
+                        CHECK_ROCBLAS_ERROR(
+                            rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+                        CHECK_ROCBLAS_ERROR(rocblas_handle_pool_release(pool, handle));
+                    }
+                });
+            for(auto& t : threads)
+                t.join();
+
+            CHECK_ROCBLAS_ERROR(rocblas_get_handle_pool_stats(pool, &hits, &misses, &parked));
+            EXPECT_EQ(hits + misses, 5 + NTHREAD * NITER);
+            EXPECT_LE(parked, 2u);
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle_pool(pool));
+        }
+    };
+
+    struct handle_pool : RocBLAS_Test<handle_pool, testing_handle_pool>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "clone_handle") || !strcmp(arg.function, "handle_pool");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<handle_pool>(arg.name);
+        }
+    };
+
+    TEST_P(handle_pool, auxiliary)
+    {
+        const Arguments& arg = GetParam();
+        if(!strcmp(arg.function, "clone_handle"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_clone_handle<>{}(arg));
+        else if(!strcmp(arg.function, "handle_pool"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_handle_pool<>{}(arg));
+    }
+    INSTANTIATE_TEST_CATEGORIES(handle_pool)
+
+} // namespace
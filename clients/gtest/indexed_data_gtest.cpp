@@ -0,0 +1,179 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_data.hpp"
+#include "rocblas_indexed_data.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Several functions, categories and precisions, so that the index has many keys
+    const char indexed_yaml[] = R"(---
+include: rocblas_common.yaml
+
+Tests:
+- name: indexed_scal
+  category: quick
+  function: [ scal, scal_batched ]
+  precision: *single_double_precisions
+  N: [ 1, 10, 100 ]
+  incx: [ 1, 2 ]
+  batch_count: 2
+
+- name: indexed_gemm
+  category: [ pre_checkin, nightly ]
+  function: gemm
+  precision: *single_double_precisions
+  M: 1..4
+  N: 3
+  K: 2
+  transA: [ N, T ]
+  flags: [ 0, 4 ]
+
+- name: indexed_scal_bug
+  category: quick
+  function: scal
+  precision: *single_precision
+  N: 5
+  known_bug_platforms: gfx000
+...
+)";
+
+    // Run rocblas_gentest.py, returning false if it cannot be run
+    bool python_generate(const std::string& yaml, const std::string& out, bool index)
+    {
+        std::string cmd = rocblas_exepath() + "rocblas_gentest.py -I " + rocblas_exepath()
+                          + (index ? " --index" : "") + " -o " + out + " " + yaml;
+        return std::system(cmd.c_str()) == 0;
+    }
+
+    template <typename...>
+    struct testing_indexed_data : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            std::string yaml = rocblas_tempname();
+            std::ofstream(yaml, std::ios::binary) << indexed_yaml;
+
+            std::string indexed_file = rocblas_tempname();
+            std::string data_file    = rocblas_tempname();
+            bool        generated    = python_generate(yaml, indexed_file, true)
+                                 && python_generate(yaml, data_file, false);
+            fs::remove(yaml);
+            if(!generated)
+            {
+                fs::remove(indexed_file);
+                fs::remove(data_file);
+                GTEST_SKIP() << "rocblas_gentest.py could not be run";
+            }
+
+            EXPECT_TRUE(rocblas_indexed_data::is_indexed(indexed_file));
+            EXPECT_FALSE(rocblas_indexed_data::is_indexed(data_file));
+
+            // The indexed file holds the same records, in the same order
+            std::vector<Arguments> records;
+            {
+                std::ifstream is(data_file, std::ios::binary);
+                Arguments::validate(is);
+                records.assign(std::istream_iterator<Arguments>(is),
+                               std::istream_iterator<Arguments>());
+            }
+            {
+                rocblas_indexed_data data(indexed_file);
+                ASSERT_EQ(data.size(), records.size());
+                for(size_t i = 0; i < records.size(); ++i)
+                    EXPECT_EQ(memcmp(&data[i], &records[i], sizeof(Arguments)), 0) << i;
+
+                // Selecting by key fields gives the records which a scan would filter
+                auto filter = [](const Arguments& arg) {
+                    return !strcmp(arg.function, "scal") && arg.a_type == rocblas_datatype_f64_r;
+                };
+                std::vector<size_t> expected;
+                for(size_t i = 0; i < records.size(); ++i)
+                    if(filter(records[i]))
+                        expected.push_back(i);
+                EXPECT_FALSE(expected.empty());
+                EXPECT_EQ(data.select(filter), expected);
+
+                auto category = [](const Arguments& arg) {
+                    return !strcmp(arg.category, "nightly") || *arg.known_bug_platforms;
+                };
+                expected.clear();
+                for(size_t i = 0; i < records.size(); ++i)
+                    if(category(records[i]))
+                        expected.push_back(i);
+                EXPECT_FALSE(expected.empty());
+                EXPECT_EQ(data.select(category), expected);
+
+                // The gemm type filter depends on the flags, which are part of the key
+                auto flags = [](const Arguments& arg) {
+                    return !strcmp(arg.function, "gemm")
+                           && (arg.flags & rocblas_gemm_flags_fp16_alt_impl);
+                };
+                expected.clear();
+                for(size_t i = 0; i < records.size(); ++i)
+                    if(flags(records[i]))
+                        expected.push_back(i);
+                EXPECT_FALSE(expected.empty());
+                EXPECT_EQ(data.select(flags), expected);
+            }
+
+            fs::remove(indexed_file);
+            fs::remove(data_file);
+        }
+    };
+
+    struct indexed_data : RocBLAS_Test<indexed_data, testing_indexed_data>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "indexed_data");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<indexed_data>(arg.name);
+        }
+    };
+
+    TEST_P(indexed_data, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_indexed_data<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(indexed_data)
+
+} // namespace
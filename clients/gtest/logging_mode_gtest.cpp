@@ -49,6 +49,10 @@ namespace
         {
             if(!strcmp(arg.function, "logging"))
                 testing_logging<T>(arg);
+            else if(!strcmp(arg.function, "logging_binary"))
+                testing_logging_binary<T>(arg);
+            else if(!strcmp(arg.function, "logging_latency"))
+                testing_logging_latency<T>(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -65,7 +69,8 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
-            return !strcmp(arg.function, "logging");
+            return !strcmp(arg.function, "logging") || !strcmp(arg.function, "logging_binary")
+                   || !strcmp(arg.function, "logging_latency");
         }
 
         // Google Test name suffix based on parameters
@@ -200,6 +200,48 @@ namespace
             thread[id].join();
     }
 
+    void testing_initialize_async(const Arguments& arg)
+    {
+        int count;
+        CHECK_HIP_ERROR(hipGetDeviceCount(&count));
+
+        rocblas_int bad_device = count;
+        EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(nullptr, -1), rocblas_status_invalid_size);
+        EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(nullptr, 1),
+                              rocblas_status_invalid_pointer);
+        EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(&bad_device, 1),
+                              rocblas_status_invalid_value);
+        EXPECT_ROCBLAS_STATUS(rocblas_query_initialize_progress(nullptr),
+                              rocblas_status_invalid_pointer);
+
+        rocblas_initialize_progress before;
+        CHECK_ROCBLAS_ERROR(rocblas_query_initialize_progress(&before));
+
+        // Every device, in reverse order, so that devices other than the current one come first
+        std::vector<rocblas_int> devices(count);
+        for(int id = 0; id < count; ++id)
+            devices[id] = count - 1 - id;
+        CHECK_ROCBLAS_ERROR(rocblas_initialize_async(devices.data(), count));
+
+        rocblas_initialize_progress progress;
+        CHECK_ROCBLAS_ERROR(rocblas_query_initialize_progress(&progress));
+        EXPECT_EQ(progress.devices, before.devices + count);
+        EXPECT_LE(progress.completed + progress.failed, progress.devices);
+
+        // All devices once more, to check that initialized devices are skipped
+        CHECK_ROCBLAS_ERROR(rocblas_initialize_async(nullptr, 0));
+        CHECK_ROCBLAS_ERROR(rocblas_initialize_wait());
+
+        CHECK_ROCBLAS_ERROR(rocblas_query_initialize_progress(&progress));
+        EXPECT_EQ(progress.devices, before.devices + 2 * count);
+        EXPECT_EQ(progress.failed, before.failed);
+        EXPECT_EQ(progress.completed, progress.devices - progress.failed);
+        EXPECT_GE(progress.parse_ms, before.parse_ms);
+        EXPECT_GE(progress.code_object_load_ms, before.code_object_load_ms);
+        EXPECT_GE(progress.adapter_init_ms, before.adapter_init_ms);
+        EXPECT_TRUE(rocblas_internal_tensile_is_initialized());
+    }
+
     template <typename...>
     struct multiheaded_testing : rocblas_test_valid
     {
@@ -207,6 +249,8 @@ namespace
         {
             if(!strcmp(arg.function, "multiheaded"))
                 testing_multiheaded(arg);
+            else if(!strcmp(arg.function, "initialize_async"))
+                testing_initialize_async(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -223,7 +267,8 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
-            return !strcmp(arg.function, "multiheaded");
+            return !strcmp(arg.function, "multiheaded")
+                   || !strcmp(arg.function, "initialize_async");
         }
 
         // Google Test name suffix based on parameters
@@ -0,0 +1,152 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_vector.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+#include <string>
+
+namespace
+{
+    template <typename...>
+    struct testing_random_init : rocblas_test_valid
+    {
+        // Known-answer tests of Philox4x32-10 from the Random123 distribution (kat_vectors):
+        // counter c0..c3 and key k0, k1, and the expected output
+        static void test_philox()
+        {
+            static const uint32_t kat[][10] = {
+                {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+                 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1},
+            };
+
+            for(const auto& v : kat)
+            {
+                rocblas_random_bits bits
+                    = rocblas_philox4x32_10(v[0], v[1], v[2], v[3], v[4], v[5]);
+                for(int w = 0; w < 4; w++)
+                    EXPECT_EQ(bits.w[w], v[6 + w]) << "counter " << v[0] << ", word " << w;
+            }
+        }
+
+        // Initialize a matrix, vector or batch with 1 and with several OpenMP threads after
+        // rocblas_seedrand, and check that the bytes are identical
+        template <typename T, typename INIT>
+        static void test_threads(const char* what, size_t size, INIT init)
+        {
+            host_vector<T> serial(size), parallel(size);
+
+            int saved_threads = omp_get_max_threads();
+            omp_set_num_threads(1);
+            rocblas_seedrand();
+            init(serial);
+            omp_set_num_threads(4);
+            rocblas_seedrand();
+            init(parallel);
+            omp_set_num_threads(saved_threads);
+
+            EXPECT_EQ(memcmp(serial.data(), parallel.data(), sizeof(T) * size), 0) << what;
+        }
+
+        template <typename T>
+        static void test_threads()
+        {
+            const size_t M = 100, N = 70, lda = 103, batch_count = 3;
+            const size_t stride = lda * N, size = stride * batch_count;
+
+            test_threads<T>("rocblas_init", size, [&](host_vector<T>& A) {
+                rocblas_init(A, M, N, lda, stride, batch_count);
+            });
+            test_threads<T>("rocblas_init_matrix", size, [&](host_vector<T>& A) {
+                rocblas_init_matrix(rocblas_client_general_matrix,
+                                    'U',
+                                    random_hpl_generator<T>,
+                                    A,
+                                    M,
+                                    N,
+                                    lda,
+                                    stride,
+                                    batch_count);
+            });
+            test_threads<T>("rocblas_init_matrix_alternating_sign", size, [&](host_vector<T>& A) {
+                rocblas_init_matrix_alternating_sign(rocblas_client_triangular_matrix,
+                                                     'L',
+                                                     random_generator<T>,
+                                                     A,
+                                                     M,
+                                                     N,
+                                                     lda,
+                                                     stride,
+                                                     batch_count);
+            });
+            test_threads<T>("rocblas_init_vector", 2 * M * N, [&](host_vector<T>& x) {
+                rocblas_init_vector(random_generator<T>, x.data(), rocblas_int(M * N), 2);
+            });
+        }
+
+        void operator()(const Arguments&)
+        {
+            test_philox();
+            test_threads<float>();
+            test_threads<double>();
+            test_threads<rocblas_double_complex>();
+        }
+    };
+
+    struct random_init : RocBLAS_Test<random_init, testing_random_init>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "random_init");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<random_init>(arg.name);
+        }
+    };
+
+    TEST_P(random_init, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_random_init<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(random_init)
+
+} // namespace
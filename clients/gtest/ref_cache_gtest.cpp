@@ -0,0 +1,265 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_vector.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_ref_cache.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef WIN32
+#include <stdlib.h>
+#define setenv(A, B, C) _putenv_s(A, B)
+#define unsetenv(A) _putenv_s(A, "")
+#endif
+
+namespace
+{
+    // Point ROCBLAS_REF_CACHE to a new directory, and restore it and remove the directory on
+    // every exit, including failed assertions
+    struct scoped_ref_cache_dir
+    {
+        fs::path    dir = rocblas_tempname();
+        bool        was_set;
+        std::string saved;
+
+        scoped_ref_cache_dir()
+        {
+            const char* env = getenv("ROCBLAS_REF_CACHE");
+            was_set         = env != nullptr;
+            saved           = env ? env : "";
+            setenv("ROCBLAS_REF_CACHE", dir.string().c_str(), true);
+        }
+
+        ~scoped_ref_cache_dir()
+        {
+            if(was_set)
+                setenv("ROCBLAS_REF_CACHE", saved.c_str(), true);
+            else
+                unsetenv("ROCBLAS_REF_CACHE");
+            std::error_code ec;
+            fs::remove_all(dir, ec);
+        }
+    };
+
+    template <typename...>
+    struct testing_ref_cache : rocblas_test_valid
+    {
+        // Encode the bytes of data, check that they decode to the same bytes, and return the
+        // encoding
+        static std::string round_trip(const std::vector<char>& data)
+        {
+            std::string encoded;
+            rocblas_ref_cache::encode(encoded, data.data(), data.size());
+
+            std::vector<char> decoded(data.size() + 1, '\x5a');
+            size_t            pos = 0;
+            EXPECT_TRUE(rocblas_ref_cache::decode(encoded, pos, nullptr, data.size()));
+            EXPECT_EQ(pos, encoded.size());
+            pos = 0;
+            EXPECT_TRUE(rocblas_ref_cache::decode(encoded, pos, decoded.data(), data.size()));
+            EXPECT_EQ(pos, encoded.size());
+            EXPECT_TRUE(std::equal(data.begin(), data.end(), decoded.begin()));
+            EXPECT_EQ(decoded.back(), '\x5a'); // nothing is written past the end
+
+            // A truncated encoding is rejected
+            if(!encoded.empty())
+            {
+                std::string truncated = encoded.substr(0, encoded.size() - 1);
+                pos                   = 0;
+                EXPECT_FALSE(rocblas_ref_cache::decode(truncated, pos, nullptr, data.size()));
+            }
+            return encoded;
+        }
+
+        // Bytes of the 32-bit words, followed by tail trailing bytes
+        static std::vector<char> bytes(const std::vector<uint32_t>& words, size_t tail = 0)
+        {
+            std::vector<char> data(words.size() * sizeof(uint32_t) + tail);
+            memcpy(data.data(), words.data(), words.size() * sizeof(uint32_t));
+            for(size_t i = 0; i < tail; i++)
+                data[words.size() * sizeof(uint32_t) + i] = char(0xf0 + i);
+            return data;
+        }
+
+        static void test_encoding()
+        {
+            // Empty data has an empty encoding
+            EXPECT_TRUE(round_trip({}).empty());
+
+            // Trailing bytes which do not fill a word are stored after the tokens
+            for(size_t tail = 1; tail < sizeof(uint32_t); tail++)
+            {
+                EXPECT_EQ(round_trip(bytes({}, tail)).size(), tail);
+                EXPECT_EQ(round_trip(bytes({7, 7, 7, 7, 7}, tail)).size(), 8 + tail);
+                EXPECT_EQ(round_trip(bytes({1, 2, 3}, tail)).size(), 16 + tail);
+            }
+
+            // A run is one count and one word, however long it is
+            EXPECT_EQ(round_trip(bytes(std::vector<uint32_t>(100000, 0))).size(), 8u);
+
+            // Words which differ, or repeat fewer than 4 times, are literals after one count
+            EXPECT_EQ(round_trip(bytes({1, 2, 3, 4, 5})).size(), 24u);
+            EXPECT_EQ(round_trip(bytes({1, 1, 1, 2, 2, 2})).size(), 28u);
+
+            // Literals, runs and trailing bytes mixed: literals {1, 2}, run of 4 x 9,
+            // literals {3, 3, 3, 4}, run of 5 x 0, literal {5}, and 2 trailing bytes
+            std::vector<uint32_t> mixed{1, 2, 9, 9, 9, 9, 3, 3, 3, 4, 0, 0, 0, 0, 0, 5};
+            EXPECT_EQ(round_trip(bytes(mixed, 2)).size(), 12 + 8 + 20 + 8 + 8 + 2);
+
+            // Consecutive encodings are decoded one after the other
+            std::vector<char> first = bytes(mixed, 3), second = bytes({6, 6, 6, 6, 8});
+            std::string       encoded;
+            rocblas_ref_cache::encode(encoded, first.data(), first.size());
+            rocblas_ref_cache::encode(encoded, second.data(), second.size());
+            std::vector<char> out1(first.size()), out2(second.size());
+            size_t            pos = 0;
+            EXPECT_TRUE(rocblas_ref_cache::decode(encoded, pos, out1.data(), out1.size()));
+            EXPECT_TRUE(rocblas_ref_cache::decode(encoded, pos, out2.data(), out2.size()));
+            EXPECT_EQ(pos, encoded.size());
+            EXPECT_EQ(out1, first);
+            EXPECT_EQ(out2, second);
+        }
+
+        // Timed runs neither read nor write the cache
+        static void test_timing(const Arguments& arg)
+        {
+            scoped_ref_cache_dir cache_dir;
+            ASSERT_STREQ(getenv("ROCBLAS_REF_CACHE"), cache_dir.dir.string().c_str());
+
+            Arguments untimed = arg, timed = arg;
+            untimed.timing = 0;
+            timed.timing   = 1;
+            rocblas_ref_cache untimed_cache(untimed), timed_cache(timed);
+
+            host_vector<float> gold(100), result(100);
+            for(size_t i = 0; i < gold.size(); i++)
+                gold[i] = float(i);
+
+            // The untimed run stores and reads the results, the timed run does not see them
+            timed_cache.store(gold);
+            EXPECT_FALSE(untimed_cache.load(result));
+            untimed_cache.store(gold);
+            EXPECT_TRUE(untimed_cache.load(result));
+            EXPECT_EQ(memcmp(&result[0], &gold[0], gold.size() * sizeof(float)), 0);
+            EXPECT_FALSE(timed_cache.load(result));
+        }
+
+        // Results are found only for the same Arguments fields which affect them, seed and
+        // generator state
+        static void test_key(const Arguments& arg)
+        {
+            scoped_ref_cache_dir cache_dir;
+            ASSERT_STREQ(getenv("ROCBLAS_REF_CACHE"), cache_dir.dir.string().c_str());
+
+            // The generators are process-wide, so restore them on every exit
+            struct restore_rng
+            {
+                rocblas_rng_t seed = g_rocblas_seed, rng = t_rocblas_rng;
+                ~restore_rng()
+                {
+                    g_rocblas_seed = seed;
+                    t_rocblas_rng  = rng;
+                }
+            } saved_rng;
+
+            Arguments base = arg;
+            base.timing    = 0;
+
+            host_vector<float> gold(100), result(100);
+            for(size_t i = 0; i < gold.size(); i++)
+                gold[i] = float(i);
+            rocblas_ref_cache(base).store(gold);
+
+            // The same key, and a change to a field which only affects how the test is run
+            EXPECT_TRUE(rocblas_ref_cache(base).load(result));
+            Arguments iters = base;
+            iters.iters     = base.iters + 1;
+            EXPECT_TRUE(rocblas_ref_cache(iters).load(result));
+
+            // Changes to fields which affect the results
+            Arguments size = base;
+            size.M         = base.M + 1;
+            EXPECT_FALSE(rocblas_ref_cache(size).load(result));
+            Arguments alpha = base;
+            alpha.alpha     = base.alpha + 1;
+            EXPECT_FALSE(rocblas_ref_cache(alpha).load(result));
+            Arguments uplo = base;
+            uplo.uplo      = base.uplo == 'U' ? 'L' : 'U';
+            EXPECT_FALSE(rocblas_ref_cache(uplo).load(result));
+
+            // A change to the state of the generator
+            t_rocblas_rng.discard(1);
+            EXPECT_FALSE(rocblas_ref_cache(base).load(result));
+            t_rocblas_rng = saved_rng.rng;
+
+            // A change to the seed
+            g_rocblas_seed.discard(1);
+            EXPECT_FALSE(rocblas_ref_cache(base).load(result));
+            g_rocblas_seed = saved_rng.seed;
+
+            // With both restored the results are found again
+            EXPECT_TRUE(rocblas_ref_cache(base).load(result));
+            EXPECT_EQ(memcmp(&result[0], &gold[0], gold.size() * sizeof(float)), 0);
+        }
+
+        void operator()(const Arguments& arg)
+        {
+            test_encoding();
+            test_timing(arg);
+            test_key(arg);
+        }
+    };
+
+    struct ref_cache : RocBLAS_Test<ref_cache, testing_ref_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "ref_cache");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<ref_cache>(arg.name);
+        }
+    };
+
+    TEST_P(ref_cache, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_ref_cache<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(ref_cache)
+
+} // namespace
@@ -22,6 +22,7 @@
 
 #include <string>
 
+#include "host_alloc.hpp"
 #include "rocblas_data.hpp"
 #include "rocblas_parse_data.hpp"
 #include "rocblas_test.hpp"
@@ -143,6 +144,14 @@ public:
     {
         if(skipped_tests)
             rocblas_cout << "[ SKIPPED  ] " << skipped_tests << " tests." << std::endl;
+
+        // Peak of the host memory held by test allocations, to size the budget of sharded runs
+        ptrdiff_t budget = host_bytes_budget();
+        rocblas_cout << "[ HOST MEM ] peak " << (host_bytes_peak_reserved() >> 20) << " MB";
+        if(budget >= 0)
+            rocblas_cout << " of " << (budget >> 20) << " MB budget";
+        rocblas_cout << std::endl;
+
         eventListener->OnTestProgramEnd(unit_test);
     }
 };
@@ -34,6 +34,7 @@ namespace
     {
         SET_GET_VECTOR_SYNC,
         SET_GET_VECTOR_ASYNC,
+        SET_GET_VECTOR_STAGING_CACHE,
     };
 
     template <template <typename...> class FILTER, sync_type TRANSFER_TYPE>
@@ -54,6 +55,8 @@ namespace
                 return !strcmp(arg.function, "set_get_vector_sync");
             case SET_GET_VECTOR_ASYNC:
                 return !strcmp(arg.function, "set_get_vector_async");
+            case SET_GET_VECTOR_STAGING_CACHE:
+                return !strcmp(arg.function, "set_get_vector_staging_cache");
             }
             return false;
         }
@@ -98,6 +101,8 @@ namespace
                 testing_set_get_vector<T>(arg);
             else if(!strcmp(arg.function, "set_get_vector_async"))
                 testing_set_get_vector_async<T>(arg);
+            else if(!strcmp(arg.function, "set_get_vector_staging_cache"))
+                testing_set_get_vector_staging_cache<T>(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -119,4 +124,13 @@ namespace
     }
     INSTANTIATE_TEST_CATEGORIES(set_get_vector_async);
 
+    using set_get_vector_staging_cache
+        = vec_set_get_template<set_get_vector_testing, SET_GET_VECTOR_STAGING_CACHE>;
+    TEST_P(set_get_vector_staging_cache, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_simple_dispatch<set_get_vector_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(set_get_vector_staging_cache);
+
 } // namespace
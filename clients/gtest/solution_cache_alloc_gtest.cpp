@@ -0,0 +1,140 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*******************************************************************************
+ * rocblas-alloc-test checks that warm solution selection makes no heap        *
+ * allocations. It counts them by replacing the global operator new, so it is  *
+ * built as its own executable rather than as part of rocblas-test.           *
+ *******************************************************************************/
+
+#include "rocblas.h"
+#include "rocblas_solution_cache_mock.hpp"
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <new>
+
+namespace
+{
+    // Number of heap allocations made by the current thread, counted by operator new below
+    thread_local size_t thread_allocations = 0;
+}
+
+void* operator new(size_t size)
+{
+    ++thread_allocations;
+    if(void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+// Warm lookups reuse the cached solution and problem without allocating
+TEST(solution_cache_alloc, warm_lookup)
+{
+    constexpr size_t NSHAPES = 40;
+    constexpr size_t NCALLS  = 10000;
+
+    auto                   sigs = make_signatures(NSHAPES);
+    rocblas_solution_cache cache(NSHAPES);
+    mock_solution_library  library;
+    for(auto& sig : sigs)
+        select_solution(cache, library, sig);
+
+    size_t allocations = thread_allocations;
+    for(size_t i = 0; i < NCALLS; ++i)
+        select_solution(cache, library, sigs[i % NSHAPES]);
+    EXPECT_EQ(thread_allocations - allocations, 0u);
+    EXPECT_EQ(library.selections, NSHAPES);
+}
+
+#if BUILD_WITH_TENSILE
+// A warm GEMM reuses the Tensile problem constructed on the first call, and selects its
+// solution without allocating. check_solution_index skips the kernel launch, whose arguments
+// Tensile allocates.
+TEST(solution_cache_alloc, warm_gemm)
+{
+    const rocblas_int M = 64, N = 64, K = 64;
+    const float       alpha = 1, beta = 0;
+    float *           dA, *dB, *dC;
+    ASSERT_EQ(hipMalloc(&dA, sizeof(float) * M * K), hipSuccess);
+    ASSERT_EQ(hipMalloc(&dB, sizeof(float) * K * N), hipSuccess);
+    ASSERT_EQ(hipMalloc(&dC, sizeof(float) * M * N), hipSuccess);
+
+    rocblas_handle handle;
+    ASSERT_EQ(rocblas_create_handle(&handle), rocblas_status_success);
+    ASSERT_EQ(rocblas_set_solution_cache_size(handle, 64), rocblas_status_success);
+
+    auto gemm = [&] {
+        return rocblas_gemm_ex(handle,
+                               rocblas_operation_none,
+                               rocblas_operation_none,
+                               M,
+                               N,
+                               K,
+                               &alpha,
+                               dA,
+                               rocblas_datatype_f32_r,
+                               M,
+                               dB,
+                               rocblas_datatype_f32_r,
+                               K,
+                               &beta,
+                               dC,
+                               rocblas_datatype_f32_r,
+                               M,
+                               dC,
+                               rocblas_datatype_f32_r,
+                               M,
+                               rocblas_datatype_f32_r,
+                               rocblas_gemm_algo_standard,
+                               0,
+                               rocblas_gemm_flags_check_solution_index);
+    };
+
+    EXPECT_EQ(gemm(), rocblas_status_success);
+    size_t         allocations = thread_allocations;
+    rocblas_status status      = rocblas_status_success;
+    for(size_t i = 0; i < 100; ++i)
+        if(status == rocblas_status_success)
+            status = gemm();
+    allocations = thread_allocations - allocations;
+    EXPECT_EQ(status, rocblas_status_success);
+    EXPECT_EQ(allocations, 0u);
+
+    size_t hits, misses, entries;
+    EXPECT_EQ(rocblas_get_solution_cache_info(handle, &hits, &misses, &entries),
+              rocblas_status_success);
+    EXPECT_EQ(hits, 100u);
+    EXPECT_EQ(misses, 1u);
+    EXPECT_EQ(entries, 1u);
+
+    EXPECT_EQ(rocblas_destroy_handle(handle), rocblas_status_success);
+    EXPECT_EQ(hipFree(dA), hipSuccess);
+    EXPECT_EQ(hipFree(dB), hipSuccess);
+    EXPECT_EQ(hipFree(dC), hipSuccess);
+}
+#endif
@@ -0,0 +1,634 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#define ROCBLAS_BETA_FEATURES_API
+#include "../../library/src/include/handle.hpp"
+#include "../../library/src/include/rocblas_gemm_override.hpp"
+#include "../../library/src/include/rocblas_solution_cache.hpp"
+#ifdef BUILD_WITH_TENSILE
+#include "../../library/src/include/rocblas_solution_db.hpp"
+#endif
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_solution_cache_mock.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef WIN32
+#include <stdlib.h>
+#define setenv(A, B, C) _putenv_s(A, B)
+#endif
+
+namespace
+{
+    void expect_same_entry(const rocblas_solution_cache_entry& cached,
+                           const rocblas_solution_cache_entry& uncached)
+    {
+        auto* c  = static_cast<const mock_solution*>(cached.solution.get());
+        auto* u  = static_cast<const mock_solution*>(uncached.solution.get());
+        auto* cp = static_cast<const rocblas_solution_signature*>(cached.problem.get());
+        auto* up = static_cast<const rocblas_solution_signature*>(uncached.problem.get());
+        ASSERT_NE(c, nullptr);
+        ASSERT_NE(u, nullptr);
+        ASSERT_NE(cp, nullptr);
+        ASSERT_NE(up, nullptr);
+        EXPECT_EQ(c->index, u->index);
+        EXPECT_TRUE(*cp == *up);
+        EXPECT_EQ(cached.workspace_size, uncached.workspace_size);
+        EXPECT_EQ(cached.can_solve, uncached.can_solve);
+    }
+
+    template <typename...>
+    struct testing_solution_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            constexpr size_t NSHAPES = 40;
+            constexpr size_t NCALLS  = 10000;
+            constexpr size_t NTHREAD = 8;
+
+            auto                   sigs = make_signatures(NSHAPES);
+            std::mt19937           rng(0);
+            mock_solution_library  uncached_library;
+            rocblas_solution_cache disabled;
+
+            // Cached results must match uncached results, whether or not entries are evicted
+            for(size_t capacity : {size_t(NSHAPES), size_t(NSHAPES / 4)})
+            {
+                rocblas_solution_cache cache(capacity);
+                mock_solution_library  library;
+                for(size_t i = 0; i < NCALLS; ++i)
+                {
+                    auto& sig = sigs[rng() % NSHAPES];
+                    expect_same_entry(select_solution(cache, library, sig),
+                                      select_solution(disabled, uncached_library, sig));
+                    ASSERT_LE(cache.size(), capacity);
+                }
+                EXPECT_EQ(cache.hits() + cache.misses(), NCALLS);
+                EXPECT_EQ(cache.misses(), library.selections);
+                if(capacity == NSHAPES)
+                {
+                    EXPECT_EQ(library.selections, NSHAPES);
+                }
+            }
+
+            // A changed field must not hit an existing entry
+            {
+                rocblas_solution_cache       cache(NSHAPES);
+                rocblas_solution_cache_entry entry;
+                auto                         sig = sigs[0];
+                cache.insert(sig, uncached_library.findBestSolution(sig));
+                sig.workspace_size = 1;
+                EXPECT_FALSE(cache.find(sig, entry));
+                sig.workspace_size = 0;
+                EXPECT_TRUE(cache.find(sig, entry));
+            }
+
+            // Concurrent lookups select each shape at most once when everything fits
+            {
+                rocblas_solution_cache cache(NSHAPES);
+                mock_solution_library  library;
+                std::thread            threads[NTHREAD];
+                for(size_t t = 0; t < NTHREAD; ++t)
+                    threads[t] = std::thread([&, t] {
+                        for(size_t i = 0; i < NCALLS / NTHREAD; ++i)
+                            select_solution(cache, library, sigs[(i * 7 + t) % NSHAPES]);
+                    });
+                for(auto& t : threads)
+                    t.join();
+                EXPECT_EQ(cache.hits() + cache.misses(), NCALLS);
+                EXPECT_EQ(cache.size(), NSHAPES);
+                EXPECT_LE(library.selections, NSHAPES * NTHREAD);
+            }
+
+            // Handle API
+            rocblas_handle handle;
+            size_t         hits, misses, entries;
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+            EXPECT_EQ(rocblas_get_solution_cache_info(handle, nullptr, &misses, &entries),
+                      rocblas_status_invalid_pointer);
+            EXPECT_EQ(rocblas_set_solution_cache_size(nullptr, 64), rocblas_status_invalid_handle);
+            CHECK_ROCBLAS_ERROR(rocblas_set_solution_cache_size(handle, 64));
+            CHECK_ROCBLAS_ERROR(rocblas_get_solution_cache_info(handle, &hits, &misses, &entries));
+            EXPECT_EQ(hits, 0u);
+            EXPECT_EQ(misses, 0u);
+            EXPECT_EQ(entries, 0u);
+
+#ifdef BUILD_WITH_TENSILE
+            // Repeated GEMMs of one shape select their Tensile solution in runContractionProblem
+            // once, and a GEMM of another shape selects its own
+            {
+                const rocblas_int    N = 64, K = 64;
+                const float          alpha = 1, beta = 0;
+                device_vector<float> dA(2 * N * K), dB(K * N), dC(2 * N * N);
+                CHECK_DEVICE_ALLOCATION(dA.memcheck());
+                CHECK_DEVICE_ALLOCATION(dB.memcheck());
+                CHECK_DEVICE_ALLOCATION(dC.memcheck());
+
+                rocblas_handle cached;
+                CHECK_ROCBLAS_ERROR(rocblas_create_handle(&cached));
+                CHECK_ROCBLAS_ERROR(rocblas_set_solution_cache_size(cached, 64));
+
+                auto sgemm = [&](rocblas_int M) {
+                    return rocblas_sgemm(cached,
+                                         rocblas_operation_none,
+                                         rocblas_operation_none,
+                                         M,
+                                         N,
+                                         K,
+                                         &alpha,
+                                         dA,
+                                         M,
+                                         dB,
+                                         K,
+                                         &beta,
+                                         dC,
+                                         M);
+                };
+
+                for(int i = 0; i < 10; ++i)
+                    CHECK_ROCBLAS_ERROR(sgemm(N));
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_solution_cache_info(cached, &hits, &misses, &entries));
+                EXPECT_EQ(hits, 9u);
+                EXPECT_EQ(misses, 1u);
+                EXPECT_EQ(entries, 1u);
+
+                CHECK_ROCBLAS_ERROR(sgemm(2 * N));
+                CHECK_ROCBLAS_ERROR(sgemm(2 * N));
+                CHECK_ROCBLAS_ERROR(
+                    rocblas_get_solution_cache_info(cached, &hits, &misses, &entries));
+                EXPECT_EQ(hits, 10u);
+                EXPECT_EQ(misses, 2u);
+                EXPECT_EQ(entries, 2u);
+
+                CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(cached));
+            }
+#endif
+
+
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(handle));
+        }
+    };
+
+#ifdef BUILD_WITH_TENSILE
+    template <typename...>
+    struct testing_solution_db : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            constexpr size_t NSHAPES = 40;
+
+            auto                  sigs = make_signatures(NSHAPES);
+            mock_solution_library library;
+            int64_t               index;
+            size_t                workspace_size;
+
+            auto path
+                = (std::filesystem::temp_directory_path() / "rocblas-solution-db-test").string();
+            remove(path.c_str());
+
+            // Record selections, which are written when the database is destroyed
+            {
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42);
+                EXPECT_FALSE(db.is_loaded());
+                for(auto& sig : sigs)
+                {
+                    auto sel = library.findBestSolution(sig);
+                    db.record(sig,
+                              static_cast<mock_solution*>(sel.solution.get())->index,
+                              sel.workspace_size);
+                }
+                EXPECT_TRUE(db.find(sigs[0], index, workspace_size));
+            }
+
+            // A later process finds every selection in the mapped file
+            {
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42, true);
+                ASSERT_TRUE(db.is_loaded());
+                EXPECT_EQ(db.loaded_records(), NSHAPES);
+                for(auto& sig : sigs)
+                {
+                    auto sel = library.findBestSolution(sig);
+                    ASSERT_TRUE(db.find(sig, index, workspace_size));
+                    EXPECT_EQ(size_t(index),
+                              static_cast<mock_solution*>(sel.solution.get())->index);
+                    EXPECT_EQ(workspace_size, sel.workspace_size);
+                }
+                auto sig = sigs[0];
+                sig.k++;
+                EXPECT_FALSE(db.find(sig, index, workspace_size));
+            }
+
+            // A new process starts with a cold, lazily loaded library, which holds no solutions
+            // until the code object for a problem is loaded. The database's selections are
+            // still found, by loading them.
+            {
+                struct lazy_library
+                {
+                    mock_solution_library                       library;
+                    std::vector<std::shared_ptr<mock_solution>> loaded;
+                    size_t                                      loads = 0;
+
+                    std::shared_ptr<mock_solution> getSolutionByIndex(int64_t index) const
+                    {
+                        for(auto& sol : loaded)
+                            if(int64_t(sol->index) == index)
+                                return sol;
+                        return nullptr;
+                    }
+
+                    void findAllSolutions(const rocblas_solution_signature& sig, int)
+                    {
+                        ++loads;
+                        auto sel = library.findBestSolution(sig);
+                        loaded.push_back(std::static_pointer_cast<mock_solution>(sel.solution));
+                    }
+                };
+
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42, true);
+                ASSERT_TRUE(db.is_loaded());
+                lazy_library      cold;
+                std::set<int64_t> indices;
+                for(auto& sig : sigs)
+                {
+                    ASSERT_TRUE(db.find(sig, index, workspace_size));
+                    bool is_loaded = indices.count(index);
+                    EXPECT_EQ(cold.getSolutionByIndex(index) != nullptr, is_loaded);
+                    auto sol = rocblas_get_solution_by_index(cold, index, sig, 0);
+                    ASSERT_NE(sol, nullptr);
+                    EXPECT_EQ(int64_t(sol->index), index);
+                    indices.insert(index);
+                }
+
+                // Solutions are only loaded once
+                EXPECT_EQ(cold.loads, indices.size());
+                ASSERT_TRUE(db.find(sigs[0], index, workspace_size));
+                EXPECT_NE(rocblas_get_solution_by_index(cold, index, sigs[0], 0), nullptr);
+                EXPECT_EQ(cold.loads, indices.size());
+            }
+
+            // A stale selection is discarded: it is no longer found, a new selection replaces
+            // it, and the file no longer holds it once flushed
+            {
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42);
+                ASSERT_TRUE(db.is_loaded());
+                db.discard(sigs[0]);
+                db.discard(sigs[1]);
+                EXPECT_FALSE(db.find(sigs[0], index, workspace_size));
+                EXPECT_FALSE(db.find(sigs[1], index, workspace_size));
+                EXPECT_TRUE(db.find(sigs[2], index, workspace_size));
+                db.record(sigs[0], 1000, 7);
+                ASSERT_TRUE(db.find(sigs[0], index, workspace_size));
+                EXPECT_EQ(index, 1000);
+                EXPECT_EQ(workspace_size, 7u);
+            }
+            {
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42, true);
+                ASSERT_TRUE(db.is_loaded());
+                EXPECT_EQ(db.loaded_records(), NSHAPES - 1);
+                ASSERT_TRUE(db.find(sigs[0], index, workspace_size));
+                EXPECT_EQ(index, 1000);
+                EXPECT_FALSE(db.find(sigs[1], index, workspace_size));
+            }
+
+            // A file for another architecture, rocBLAS version or Tensile library is stale
+            EXPECT_FALSE(rocblas_solution_db(path, "gfx942", "1.0.0.0", 42, true).is_loaded());
+            EXPECT_FALSE(rocblas_solution_db(path, "gfx90a", "1.0.1.0", 42, true).is_loaded());
+            EXPECT_FALSE(rocblas_solution_db(path, "gfx90a", "1.0.0.0", 43, true).is_loaded());
+
+            // A corrupted table or header is detected by the checksum
+            for(auto offset : {std::streamoff(-8),
+                               std::streamoff(offsetof(rocblas_solution_db::header_t,
+                                                       record_count))})
+            {
+                rocblas_solution_db(path, "gfx90a", "1.0.0.0", 42).record(sigs[0], 1, 0);
+                ASSERT_TRUE(rocblas_solution_db(path, "gfx90a", "1.0.0.0", 42, true).is_loaded());
+                {
+                    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+                    f.seekp(offset, offset < 0 ? std::ios::end : std::ios::beg);
+                    f.put('\x5a');
+                }
+                EXPECT_FALSE(rocblas_solution_db(path, "gfx90a", "1.0.0.0", 42, true).is_loaded());
+            }
+
+            // Processes which record selections concurrently merge them when they flush
+            remove(path.c_str());
+            {
+                rocblas_solution_db first(path, "gfx90a", "1.0.0.0", 42);
+                rocblas_solution_db second(path, "gfx90a", "1.0.0.0", 42);
+                for(size_t i = 0; i < NSHAPES; ++i)
+                    (i % 2 ? second : first).record(sigs[i], i, i);
+                EXPECT_TRUE(first.flush());
+                EXPECT_TRUE(second.flush());
+            }
+            {
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42, true);
+                ASSERT_TRUE(db.is_loaded());
+                EXPECT_EQ(db.loaded_records(), NSHAPES);
+                for(size_t i = 0; i < NSHAPES; ++i)
+                {
+                    ASSERT_TRUE(db.find(sigs[i], index, workspace_size));
+                    EXPECT_EQ(size_t(index), i);
+                }
+            }
+
+            // A lookup in a table without empty buckets terminates
+            {
+                using header_t = rocblas_solution_db::header_t;
+                using record_t = rocblas_solution_db::record_t;
+                header_t header{};
+                memcpy(header.magic, rocblas_solution_db::MAGIC, sizeof(header.magic));
+                header.format_version = rocblas_solution_db::FORMAT_VERSION;
+                header.record_size    = sizeof(record_t);
+                strcpy(header.arch, "gfx90a");
+                strcpy(header.rocblas_version, "1.0.0.0");
+                header.library_hash = 42;
+                header.bucket_count = 16;
+                header.record_count = 15;
+                std::vector<record_t> table(header.bucket_count);
+                for(size_t i = 0; i < table.size(); ++i)
+                    table[i] = {sigs[i], int64_t(i), 0};
+                header.checksum = rocblas_solution_db::checksum(header, table.data());
+                {
+                    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+                    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                    os.write(reinterpret_cast<const char*>(table.data()),
+                             table.size() * sizeof(record_t));
+                }
+                rocblas_solution_db db(path, "gfx90a", "1.0.0.0", 42, true);
+                ASSERT_TRUE(db.is_loaded());
+                EXPECT_FALSE(db.find(sigs[table.size()], index, workspace_size));
+            }
+
+            remove(path.c_str());
+            remove((path + ".lock").c_str());
+        }
+    };
+#endif
+
+    template <typename...>
+    struct testing_gemm_override : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            rocblas_gemm_override_key key{rocblas_datatype_f32_r,
+                                          rocblas_datatype_f32_r,
+                                          rocblas_datatype_f32_r,
+                                          rocblas_operation_none,
+                                          rocblas_operation_transpose,
+                                          64,
+                                          48,
+                                          32,
+                                          64,
+                                          48,
+                                          64,
+                                          64,
+                                          1};
+
+            // Overrides survive a round trip through the text format, and later lines win
+            {
+                std::stringstream ss("# comment\nrocblas_gemm_override 1\n\n"
+                                     "gfx90a f32_r f32_r f32_r N T 64 48 32 64 48 64 64 1 5\n"
+                                     "gfx90a f16_r f16_r f32_r T N 8 8 8 8 8 8 8 2 7\n"
+                                     "gfx90a f32_r f32_r f32_r N T 64 48 32 64 48 64 64 1 9\n"
+                                     "gfx942 f64_r f64_r f64_r C N 1 2 3 3 3 1 1 4 11\n");
+                rocblas_gemm_override_db db;
+                ASSERT_TRUE(rocblas_gemm_overrides_read(ss, db));
+                auto* table = db.lookup("gfx90a");
+                ASSERT_NE(table, nullptr);
+                EXPECT_EQ(table->size(), 2u);
+                EXPECT_EQ(table->at(key), 9);
+                EXPECT_EQ(db.lookup("gfx908"), nullptr);
+
+                std::stringstream out;
+                rocblas_gemm_overrides_write(out, db);
+                rocblas_gemm_override_db copy;
+                ASSERT_TRUE(rocblas_gemm_overrides_read(out, copy));
+                EXPECT_EQ(copy.archs, db.archs);
+            }
+
+            // Malformed streams leave the database unchanged
+            for(const char* text :
+                {"",
+                 "rocblas_gemm_override 2\n",
+                 "rocblas_gemm_override 1\ngfx90a f32_r f32_r f32_r N X 1 1 1 1 1 1 1 1 1\n",
+                 "rocblas_gemm_override 1\ngfx90a f32_r f32_r f32_r N N 1 1 1 1 1 1 1 1 0\n",
+                 "rocblas_gemm_override 1\ngfx90a f32_r f32_r f32_r N N 1 1 1 1 1 1 1 1\n",
+                 "rocblas_gemm_override 1\ngfx90a f32_r f32_r xx N N 1 1 1 1 1 1 1 1 1\n"})
+            {
+                std::stringstream        ss(text);
+                rocblas_gemm_override_db db;
+                db.archs["gfx90a"][key] = 3;
+                EXPECT_FALSE(rocblas_gemm_overrides_read(ss, db)) << text;
+                EXPECT_EQ(db.archs.size(), 1u);
+                EXPECT_EQ(db.archs["gfx90a"].at(key), 3);
+            }
+
+#ifdef BUILD_WITH_TENSILE
+            // An override file named by ROCBLAS_GEMM_OVERRIDE_PATH selects its solution, which
+            // the handle reports as the last solution run. An invalid solution falls back to the
+            // library's selection. Either way the result is unchanged, and small integers make
+            // it exact.
+            const rocblas_int M = key.m, N = key.n, K = key.k;
+            const float       alpha = 1, beta = 0;
+
+            std::vector<float> hA(M * K), hB(N * K), hC(M * N), hC_default(M * N);
+            for(size_t i = 0; i < hA.size(); ++i)
+                hA[i] = float(i % 5);
+            for(size_t i = 0; i < hB.size(); ++i)
+                hB[i] = float(i % 3);
+
+            device_vector<float> dA(hA.size()), dB(hB.size()), dC(hC.size());
+            CHECK_DEVICE_ALLOCATION(dA.memcheck());
+            CHECK_DEVICE_ALLOCATION(dB.memcheck());
+            CHECK_DEVICE_ALLOCATION(dC.memcheck());
+            CHECK_HIP_ERROR(
+                hipMemcpy(dA, hA.data(), sizeof(float) * hA.size(), hipMemcpyHostToDevice));
+            CHECK_HIP_ERROR(
+                hipMemcpy(dB, hB.data(), sizeof(float) * hB.size(), hipMemcpyHostToDevice));
+
+            auto sgemm = [&](rocblas_handle handle, std::vector<float>& result) {
+                CHECK_ROCBLAS_ERROR(rocblas_sgemm(handle,
+                                                  key.trans_a,
+                                                  key.trans_b,
+                                                  M,
+                                                  N,
+                                                  K,
+                                                  &alpha,
+                                                  dA,
+                                                  key.lda,
+                                                  dB,
+                                                  key.ldb,
+                                                  &beta,
+                                                  dC,
+                                                  key.ldc));
+                CHECK_HIP_ERROR(hipMemcpy(
+                    result.data(), dC, sizeof(float) * result.size(), hipMemcpyDeviceToHost));
+            };
+
+            rocblas_local_handle handle;
+            sgemm(handle, hC_default);
+            rocblas_int default_solution = rocblas_internal_last_gemm_solution_index(handle);
+            EXPECT_GT(default_solution, 0);
+
+            rocblas_int size = 0;
+            CHECK_ROCBLAS_ERROR(rocblas_gemm_ex_get_solutions(handle,
+                                                              key.trans_a,
+                                                              key.trans_b,
+                                                              M,
+                                                              N,
+                                                              K,
+                                                              &alpha,
+                                                              dA,
+                                                              key.a_type,
+                                                              key.lda,
+                                                              dB,
+                                                              key.a_type,
+                                                              key.ldb,
+                                                              &beta,
+                                                              dC,
+                                                              key.c_type,
+                                                              key.ldc,
+                                                              dC,
+                                                              key.c_type,
+                                                              key.ldd,
+                                                              key.compute_type,
+                                                              rocblas_gemm_algo_solution_index,
+                                                              rocblas_gemm_flags_none,
+                                                              nullptr,
+                                                              &size));
+            std::vector<rocblas_int> solutions(size);
+            CHECK_ROCBLAS_ERROR(rocblas_gemm_ex_get_solutions(handle,
+                                                              key.trans_a,
+                                                              key.trans_b,
+                                                              M,
+                                                              N,
+                                                              K,
+                                                              &alpha,
+                                                              dA,
+                                                              key.a_type,
+                                                              key.lda,
+                                                              dB,
+                                                              key.a_type,
+                                                              key.ldb,
+                                                              &beta,
+                                                              dC,
+                                                              key.c_type,
+                                                              key.ldc,
+                                                              dC,
+                                                              key.c_type,
+                                                              key.ldd,
+                                                              key.compute_type,
+                                                              rocblas_gemm_algo_solution_index,
+                                                              rocblas_gemm_flags_none,
+                                                              solutions.data(),
+                                                              &size));
+            solutions.resize(std::min<size_t>(size, 4));
+            solutions.push_back(std::numeric_limits<rocblas_int>::max());
+
+            // The override file is read once per path, so each solution gets its own file
+            auto dir = std::filesystem::temp_directory_path() / "rocblas-gemm-override-test";
+            std::filesystem::create_directories(dir);
+
+            for(rocblas_int solution : solutions)
+            {
+                auto path = (dir / ("override_" + std::to_string(solution))).string();
+                {
+                    rocblas_gemm_override_db db;
+                    db.archs[rocblas_internal_get_arch_name()][key] = solution;
+                    std::ofstream os(path);
+                    rocblas_gemm_overrides_write(os, db);
+                }
+
+                // Handles read the environment when they are created
+                ASSERT_EQ(setenv("ROCBLAS_GEMM_OVERRIDE_PATH", path.c_str(), true), 0);
+                rocblas_int selected;
+                {
+                    rocblas_local_handle override_handle;
+                    sgemm(override_handle, hC);
+                    selected = rocblas_internal_last_gemm_solution_index(override_handle);
+                }
+                ASSERT_EQ(setenv("ROCBLAS_GEMM_OVERRIDE_PATH", "", true), 0);
+
+                EXPECT_EQ(hC, hC_default) << "solution " << solution;
+                EXPECT_EQ(selected,
+                          solution != std::numeric_limits<rocblas_int>::max() ? solution
+                                                                              : default_solution)
+                    << "solution " << solution;
+            }
+
+            std::filesystem::remove_all(dir);
+#endif
+        }
+    };
+
+    struct solution_cache : RocBLAS_Test<solution_cache, testing_solution_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "solution_cache") || !strcmp(arg.function, "solution_db")
+                   || !strcmp(arg.function, "gemm_override");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<solution_cache>(arg.name);
+        }
+    };
+
+    TEST_P(solution_cache, auxiliary)
+    {
+        const Arguments& arg = GetParam();
+        if(!strcmp(arg.function, "solution_cache"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_solution_cache<>{}(arg));
+#ifdef BUILD_WITH_TENSILE
+        else if(!strcmp(arg.function, "solution_db"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_solution_db<>{}(arg));
+#endif
+        else if(!strcmp(arg.function, "gemm_override"))
+            CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_gemm_override<>{}(arg));
+    }
+    INSTANTIATE_TEST_CATEGORIES(solution_cache)
+
+} // namespace
@@ -0,0 +1,242 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_data.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_yaml_expand.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // A document exercising the YAML features and expansions which test files use
+    const char features_yaml[] = R"(---
+include: rocblas_common.yaml
+
+Definitions:
+  - &sizes
+    - { M: 0x10, N: 010, K: 1_000 }
+    - { M: -1, N: 0b11, K: 1:30 }
+  - &scalars
+    [ { alpha: .5, beta: -1.5e+3 },   # comment within a flow sequence
+      { alpha: .nan, beta: -.inf,
+        alphai: 1.,  betai: 190:20:30.15 } ]
+  - &transposes { transA: 'T', transB: "C" }
+  -
+    &scale
+    stride_scale: 2
+
+Tests:
+- name: "features\ttest"
+  category: quick
+  function: gemm_strided_batched
+  precision: *single_precision
+  matrix_size: *sizes
+  arguments: *scalars
+  batch_count: [ 1, 3..7..2, -2..-6..-2 ]
+  <<: [ *transposes, { transA: N, side: L } ]
+  <<: *scale
+  incx: "-3 .. 3 .. 3"
+  pointer_mode_host: off
+
+- name: 'it''s'
+  category: pre_checkin
+  rocblas_function: rocblas_sgemm_strided_batched
+  precision: *single_precision
+  transA: [ N, T ]
+  transB: C
+  M: 3
+  N: 4
+  K: 5
+  lda: 5
+  batch_count: 2
+
+- {name: flow, category: nightly, function: scal, precision: *double_precision, N: 7,
+   incx: [-1, 2], transA: '*', transB: N}
+...
+)";
+
+    // Problems logged in the format used with rocblas-bench --yaml
+    const char logged_yaml[] = R"(
+- { rocblas_function: "rocblas_dgemm", transA: "N", transB: "T", M: 64, N: 32, K: 16 }
+- { rocblas_function: "rocblas_sgemv", transA: "T", M: 100, N: 50, lda: 100, incx: 1, incy: 1 }
+- { rocblas_function: "rocblas_dscal", N: 1000, incx: -2, alpha: 2.5 }
+- { rocblas_function: "rocblas_daxpy_strided_batched", N: 10, incx: 1, incy: 2,
+    stride_scale: 1, batch_count: 3 }
+)";
+
+    std::string write_temp(const char* contents)
+    {
+        std::string   name = rocblas_tempname();
+        std::ofstream os(name, std::ios::binary);
+        os << contents;
+        return name;
+    }
+
+    std::string read_file(const std::string& name)
+    {
+        std::ifstream is(name, std::ios::binary);
+        return {std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+    }
+
+    // Expand a YAML file with rocblas_gentest.py, returning false if it cannot be run
+    bool python_expand(const std::string& yaml,
+                       const std::string& include_dir,
+                       const std::string& template_file,
+                       std::string&       data)
+    {
+        std::string out = rocblas_tempname();
+        std::string cmd = rocblas_exepath() + "rocblas_gentest.py -I " + include_dir
+                          + (template_file.empty() ? "" : " --template " + template_file)
+                          + " -o " + out + " " + yaml;
+        int status = std::system(cmd.c_str());
+        data       = read_file(out);
+        fs::remove(out);
+        return status == 0;
+    }
+
+    template <typename...>
+    struct testing_yaml_expand : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            std::string exepath = rocblas_exepath();
+            test_cache(exepath);
+
+            std::string features = write_temp(features_yaml);
+            std::string logged   = write_temp(logged_yaml);
+
+            struct
+            {
+                std::string yaml, template_file;
+            } inputs[] = {{features, ""}, {logged, exepath + "rocblas_template.yaml"}};
+
+            for(auto& input : inputs)
+            {
+                SCOPED_TRACE(input.yaml);
+
+                rocblas_yaml_istream is(input.yaml, {exepath}, input.template_file);
+                std::string          native{std::istreambuf_iterator<char>(is),
+                                   std::istreambuf_iterator<char>()};
+                EXPECT_FALSE(native.empty());
+
+                // Rewinding the stream reads the same records without expanding them again
+                is.clear();
+                is.seekg(0);
+                std::string reread{std::istreambuf_iterator<char>(is),
+                                   std::istreambuf_iterator<char>()};
+                EXPECT_TRUE(native == reread);
+
+                // The records are byte-identical to those written by rocblas_gentest.py
+                std::string python;
+                if(!python_expand(input.yaml, exepath, input.template_file, python))
+                {
+                    fs::remove(features);
+                    fs::remove(logged);
+                    GTEST_SKIP() << "rocblas_gentest.py could not be run";
+                }
+                EXPECT_EQ(native.size(), python.size());
+                EXPECT_TRUE(native == python);
+            }
+
+            fs::remove(features);
+            fs::remove(logged);
+        }
+
+        // Expansions are cached by the content of the YAML file and of its includes
+        static void test_cache(const std::string& exepath)
+        {
+            fs::path dir = rocblas_tempname();
+            fs::create_directories(dir);
+            fs::path   cache = dir / "cache";
+            fs::path   yaml  = dir / "cached.yaml";
+            fs::path   inc   = dir / "cached_include.yaml";
+            const auto write = [](const fs::path& file, const std::string& contents) {
+                std::ofstream(file, std::ios::binary) << contents;
+            };
+            // Returns the records, and whether they were read from the cache
+            const auto expand = [&] {
+                rocblas_yaml_istream is(yaml.string(), {exepath}, "", cache.string());
+                std::string          records(std::istreambuf_iterator<char>(is), {});
+                return std::make_pair(std::move(records), is.from_cache());
+            };
+            const auto cached_files = [&] {
+                return std::distance(fs::directory_iterator(cache), fs::directory_iterator());
+            };
+
+            write(yaml, "include: cached_include.yaml\n" + std::string(features_yaml));
+            write(inc, "# first version\n");
+            auto first = expand();
+            EXPECT_FALSE(first.first.empty());
+            EXPECT_FALSE(first.second);
+            EXPECT_EQ(cached_files(), 1);
+
+            // The cached records are read again
+            auto second = expand();
+            EXPECT_TRUE(second.first == first.first);
+            EXPECT_TRUE(second.second);
+            EXPECT_EQ(cached_files(), 1);
+
+            // Changing an included file changes the key
+            write(inc, "# second version\n");
+            auto third = expand();
+            EXPECT_TRUE(third.first == first.first);
+            EXPECT_FALSE(third.second);
+            EXPECT_EQ(cached_files(), 2);
+
+            fs::remove_all(dir);
+        }
+    };
+
+    struct yaml_expand : RocBLAS_Test<yaml_expand, testing_yaml_expand>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "yaml_expand");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<yaml_expand>(arg.name);
+        }
+    };
+
+    TEST_P(yaml_expand, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_yaml_expand<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(yaml_expand)
+
+} // namespace
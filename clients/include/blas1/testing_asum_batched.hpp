@@ -166,10 +166,9 @@ void testing_asum_batched(const Arguments& arg)
         // CPU BLAS
         cpu_time_used = get_time_us_no_sync();
 
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_asum<T>(N, hx[b], incx, cpu_result + b);
-        }
+        });
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
         if(arg.unit_check)
@@ -156,10 +156,9 @@ void template_testing_reduction_batched(
         {
             cpu_time_used = get_time_us_no_sync();
 
-            for(rocblas_int batch_index = 0; batch_index < batch_count; ++batch_index)
-            {
+            cblas_batched(batch_count, [&](rocblas_int batch_index) {
                 REFBLAS_FUNC(N, hx[batch_index], incx, cpu_result + batch_index);
-            }
+            });
 
             cpu_time_used = get_time_us_no_sync() - cpu_time_used;
         }
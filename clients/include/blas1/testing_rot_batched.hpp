@@ -159,10 +159,9 @@ void testing_rot_batched(const Arguments& arg)
     // cx[0] = hx[0];
     // cy[0] = hy[0];
     cpu_time_used = get_time_us_no_sync();
-    for(int b = 0; b < batch_count; b++)
-    {
+    cblas_batched(batch_count, [&](rocblas_int b) {
         cblas_rot<T, T, U, V>(N, cx[b], incx, cy[b], incy, hc, hs);
-    }
+    });
     cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
     if(arg.unit_check || arg.norm_check)
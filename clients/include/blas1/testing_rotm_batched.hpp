@@ -146,14 +146,13 @@ void testing_rotm_batched(const Arguments& arg)
     rocblas_init_vector(hy, arg, rocblas_client_alpha_sets_nan, false);
     rocblas_init_vector(hdata, arg, rocblas_client_alpha_sets_nan, false);
 
-    for(int b = 0; b < batch_count; b++)
-    {
+    cblas_batched(batch_count, [&](rocblas_int b) {
         // generating simply one set of hparam which will not be appropriate for testing
         // that it zeros out the second element of the rotm vector parameter
         memset(hparam[b], 0, 5 * sizeof(T));
 
         cblas_rotmg<T>(&hdata[b][0], &hdata[b][1], &hdata[b][2], &hdata[b][3], hparam[b]);
-    }
+    });
 
     constexpr int FLAG_COUNT        = 4;
     const T       FLAGS[FLAG_COUNT] = {-1, 0, 1, -2};
@@ -171,10 +170,9 @@ void testing_rotm_batched(const Arguments& arg)
         hy_gold.copy_from(hy);
 
         cpu_time_used = get_time_us_no_sync();
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_rotm<T>(N, hx_gold[b], incx, hy_gold[b], incy, hparam[b]);
-        }
+        });
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
         if(arg.unit_check || arg.norm_check)
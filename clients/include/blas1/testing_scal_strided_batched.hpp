@@ -151,10 +151,9 @@ void testing_scal_strided_batched(const Arguments& arg)
 
         // CPU BLAS
         cpu_time_used = get_time_us_no_sync();
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_scal(N, h_alpha, (T*)hx_gold[b], incx);
-        }
+        });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
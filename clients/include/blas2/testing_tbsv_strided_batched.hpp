@@ -216,10 +216,9 @@ void testing_tbsv_strided_batched(const Arguments& arg)
     hb.copy_from(hx);
 
     // Calculate hb = hA*hx;
-    for(int b = 0; b < batch_count; b++)
-    {
+    cblas_batched(batch_count, [&](rocblas_int b) {
         cblas_tbmv<T>(uplo, transA, diag, N, K, hAb[b], lda, hb[b], incx);
-    }
+    });
 
     cpu_x_or_b.copy_from(hb);
     hx_or_b_1.copy_from(hb);
@@ -291,11 +290,10 @@ void testing_tbsv_strided_batched(const Arguments& arg)
         }
 
         // hx_or_b contains A * (calculated X), so res = A * (calculated x) - b = hx_or_b - hb
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_tbmv<T>(uplo, transA, diag, N, K, hAb[b], lda, hx_or_b_1[b], incx);
             cblas_tbmv<T>(uplo, transA, diag, N, K, hAb[b], lda, hx_or_b_2[b], incx);
-        }
+        });
 
         //calculate norm 1 of res
         for(int b = 0; b < batch_count; b++)
@@ -359,8 +357,9 @@ void testing_tbsv_strided_batched(const Arguments& arg)
         cpu_time_used = get_time_us_no_sync();
 
         if(arg.norm_check)
-            for(int b = 0; b < batch_count; b++)
+            cblas_batched(batch_count, [&](rocblas_int b) {
                 cblas_tbsv<T>(uplo, transA, diag, N, K, hAb[b], lda, cpu_x_or_b[b], incx);
+            });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
@@ -182,10 +182,9 @@ void testing_tpmv_strided_batched(const Arguments& arg)
         // CPU BLAS
         {
             cpu_time_used = get_time_us_no_sync();
-            for(rocblas_int b = 0; b < batch_count; ++b)
-            {
+            cblas_batched(batch_count, [&](rocblas_int b) {
                 cblas_tpmv<T>(uplo, transA, diag, M, hAp[b], hx[b], incx);
-            }
+            });
             cpu_time_used = get_time_us_no_sync() - cpu_time_used;
         }
 
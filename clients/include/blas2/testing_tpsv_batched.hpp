@@ -162,11 +162,10 @@ void testing_tpsv_batched(const Arguments& arg)
     }
 
     hb.copy_from(hx);
-    for(int b = 0; b < batch_count; b++)
-    {
+    cblas_batched(batch_count, [&](rocblas_int b) {
         // Calculate hb = hA*hx;
         cblas_trmv<T>(uplo, transA, diag, N, hA[b], N, hb[b], incx);
-    }
+    });
 
     // helper function to convert Regular matrix `hA` to packed matrix `hAp`
     regular_to_packed(uplo == rocblas_fill_upper, hA, hAp, N);
@@ -230,11 +229,10 @@ void testing_tpsv_batched(const Arguments& arg)
         }
 
         // hx_or_b contains A * (calculated X), so res = A * (calculated x) - b = hx_or_b - hb
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_trmv<T>(uplo, transA, diag, N, hA[b], N, hx_or_b_1[b], incx);
             cblas_trmv<T>(uplo, transA, diag, N, hA[b], N, hx_or_b_2[b], incx);
-        }
+        });
 
         //calculate norm 1 of res
         for(int b = 0; b < batch_count; b++)
@@ -290,8 +288,9 @@ void testing_tpsv_batched(const Arguments& arg)
         cpu_time_used = get_time_us_no_sync();
 
         if(arg.norm_check)
-            for(int b = 0; b < batch_count; b++)
+            cblas_batched(batch_count, [&](rocblas_int b) {
                 cblas_tpsv<T>(uplo, transA, diag, N, hAp[b], cpu_x_or_b[b], incx);
+            });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
@@ -480,8 +480,7 @@ void testing_geam_batched(const Arguments& arg)
         // reference calculation for golden result
         cpu_time_used = get_time_us_no_sync();
 
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             auto hA_copy_p = hA_copy[b];
             auto hB_copy_p = hB_copy[b];
             auto hC_gold_p = hC_gold[b];
@@ -498,7 +497,7 @@ void testing_geam_batched(const Arguments& arg)
                        ldb,
                        (T*)hC_gold_p,
                        ldc);
-        }
+        });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
@@ -549,8 +548,7 @@ void testing_geam_batched(const Arguments& arg)
                 CHECK_HIP_ERROR(dA.transfer_from(hA));
 
                 // reference calculation
-                for(int b = 0; b < batch_count; b++)
-                {
+                cblas_batched(batch_count, [&](rocblas_int b) {
                     auto hA_copy_p = hA_copy[b];
                     auto hB_copy_p = hB_copy[b];
                     auto hC_gold_p = hC_gold[b];
@@ -567,7 +565,7 @@ void testing_geam_batched(const Arguments& arg)
                                ldb,
                                (T*)hC_gold_p,
                                ldc);
-                }
+                });
 
                 if(arg.unit_check)
                 {
@@ -614,8 +612,7 @@ void testing_geam_batched(const Arguments& arg)
                 CHECK_HIP_ERROR(hC_1.transfer_from(dC_in_place));
 
                 // reference calculation
-                for(int b = 0; b < batch_count; b++)
-                {
+                cblas_batched(batch_count, [&](rocblas_int b) {
                     auto hA_copy_p = hA_copy[b];
                     auto hB_copy_p = hB_copy[b];
                     auto hC_gold_p = hC_gold[b];
@@ -632,7 +629,7 @@ void testing_geam_batched(const Arguments& arg)
                                ldb,
                                (T*)hC_gold_p,
                                ldc);
-                }
+                });
 
                 if(arg.unit_check)
                 {
@@ -558,8 +558,7 @@ void testing_geam_strided_batched(const Arguments& arg)
         // reference calculation for golden result
         cpu_time_used = get_time_us_no_sync();
 
-        for(size_t b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_geam(transA,
                        transB,
                        M,
@@ -572,7 +571,7 @@ void testing_geam_strided_batched(const Arguments& arg)
                        ldb,
                        hC_gold[b],
                        ldc);
-        }
+        });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
@@ -628,8 +627,7 @@ void testing_geam_strided_batched(const Arguments& arg)
                 CHECK_HIP_ERROR(dA.transfer_from(hA));
 
                 // reference calculation
-                for(int b = 0; b < batch_count; b++)
-                {
+                cblas_batched(batch_count, [&](rocblas_int b) {
                     cblas_geam(transA,
                                transB,
                                M,
@@ -642,7 +640,7 @@ void testing_geam_strided_batched(const Arguments& arg)
                                ldb,
                                hC_gold[b],
                                ldc);
-                }
+                });
 
                 if(arg.unit_check)
                 {
@@ -691,8 +689,7 @@ void testing_geam_strided_batched(const Arguments& arg)
 
                 CHECK_HIP_ERROR(hC_1.transfer_from(dC_in_place));
                 // reference calculation
-                for(int b = 0; b < batch_count; b++)
-                {
+                cblas_batched(batch_count, [&](rocblas_int b) {
                     cblas_geam(transA,
                                transB,
                                M,
@@ -705,7 +702,7 @@ void testing_geam_strided_batched(const Arguments& arg)
                                ldb,
                                hC_gold[b],
                                ldc);
-                }
+                });
 
                 if(arg.unit_check)
                 {
@@ -563,8 +563,7 @@ void testing_her2k_strided_batched(const Arguments& arg)
         }
 
         // cpu reference
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             // herkx: B equals A to ensure a symmetric result
             herXX_ref_fn(uplo,
                          transA,
@@ -578,7 +577,7 @@ void testing_her2k_strided_batched(const Arguments& arg)
                          &h_beta[0],
                          hC_gold[b],
                          ldc);
-        }
+        });
 
         if(arg.timing)
         {
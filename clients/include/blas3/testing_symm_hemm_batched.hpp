@@ -389,8 +389,7 @@ void testing_symm_hemm_batched(const Arguments& arg)
         }
 
         // cpu reference
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             if(HERM)
             {
                 cblas_hemm<T>(
@@ -411,7 +410,7 @@ void testing_symm_hemm_batched(const Arguments& arg)
                               hC_gold[b],
                               ldc);
             }
-        }
+        });
 
         if(arg.timing)
         {
@@ -472,8 +472,7 @@ void testing_symm_hemm_strided_batched(const Arguments& arg)
         }
 
         // cpu reference
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             if(HERM)
             {
                 cblas_hemm<T>(
@@ -494,7 +493,7 @@ void testing_symm_hemm_strided_batched(const Arguments& arg)
                               hC_gold[b],
                               ldc);
             }
-        }
+        });
 
         if(arg.timing)
         {
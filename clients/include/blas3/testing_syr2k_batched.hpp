@@ -476,8 +476,7 @@ void testing_syr2k_batched(const Arguments& arg)
         }
 
         // cpu reference
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             if(TWOK)
             {
                 cblas_syr2k<T>(uplo,
@@ -498,7 +497,7 @@ void testing_syr2k_batched(const Arguments& arg)
                 cblas_syrk<T>(
                     uplo, transA, N, K, h_alpha[0], hA[b], lda, h_beta[0], hC_gold[b], ldc);
             }
-        }
+        });
 
         if(arg.timing)
         {
@@ -539,8 +539,7 @@ void testing_syr2k_strided_batched(const Arguments& arg)
         }
 
         // cpu reference
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             if(TWOK)
             {
                 cblas_syr2k<T>(uplo,
@@ -569,7 +568,7 @@ void testing_syr2k_strided_batched(const Arguments& arg)
                               hC_gold[b],
                               ldc); // B must == A to use syrk as reference
             }
-        }
+        });
 
         if(arg.timing)
         {
@@ -545,10 +545,9 @@ void testing_trmm_strided_batched(const Arguments& arg)
             cpu_time_used = get_time_us_no_sync();
         }
 
-        for(int b = 0; b < batch_count; b++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_trmm<T>(side, uplo, transA, diag, M, N, alpha, hA[b], lda, hB_gold[b], ldb);
-        }
+        });
 
         if(arg.timing)
         {
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../../library/src/include/rocblas_trsm_blksize.hpp"
 #include "cblas_interface.hpp"
 #include "flops.hpp"
 #include "norm.hpp"
@@ -35,6 +36,7 @@
 #include "rocblas_vector.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
+#include <sstream>
 
 #define ERROR_EPS_MULTIPLIER 40
 #define RESIDUAL_EPS_MULTIPLIER 40
@@ -414,3 +416,42 @@ void testing_trsm(const Arguments& arg)
                          max_err_2);
     }
 }
+
+// Check that the block size tables survive a round trip through their text format, and that
+// trsm is correct with each block size which a tuned table may select
+template <typename T>
+void testing_trsm_blksize(const Arguments& arg)
+{
+#ifdef GOOGLE_TEST
+    const rocblas_trsm_blksize_tables& defaults = rocblas_trsm_default_blksize_tables();
+    const std::string                  arch     = rocblas_internal_get_arch_name();
+
+    std::stringstream ss;
+    rocblas_trsm_blksize_tables_write(ss, arch, defaults);
+    const std::string text = ss.str();
+
+    rocblas_trsm_blksize_tables tables;
+    EXPECT_TRUE(rocblas_trsm_blksize_tables_read(ss, arch, tables));
+    for(const auto* t :
+        {&tables.real, &tables.real_batched, &tables.complex, &tables.complex_batched})
+        EXPECT_TRUE(t->valid());
+    EXPECT_EQ(tables.real.blksizes, defaults.real.blksizes);
+    EXPECT_EQ(tables.complex_batched.intervals_col, defaults.complex_batched.intervals_col);
+
+    // Tables for another architecture, or with a truncated table, are rejected unchanged
+    ss.clear();
+    ss.str(text);
+    EXPECT_FALSE(rocblas_trsm_blksize_tables_read(ss, arch + "_other", tables));
+    ss.clear();
+    ss.str(text.substr(0, text.size() - 4));
+    EXPECT_FALSE(rocblas_trsm_blksize_tables_read(ss, arch, tables));
+    EXPECT_EQ(tables.complex_batched.blksizes, defaults.complex_batched.blksizes);
+#endif
+
+    for(rocblas_int blksize : {0, 1, 16, 32, 80})
+    {
+        rocblas_internal_trsm_set_blksize_override(blksize);
+        testing_trsm<T>(arg);
+    }
+    rocblas_internal_trsm_set_blksize_override(-1);
+}
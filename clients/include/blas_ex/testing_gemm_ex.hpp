@@ -33,6 +33,7 @@
 #include "rocblas_math.hpp"
 #include "rocblas_matrix.hpp"
 #include "rocblas_random.hpp"
+#include "rocblas_ref_cache.hpp"
 #include "rocblas_test.hpp"
 #include "rocblas_vector.hpp"
 #include "type_dispatch.hpp"
@@ -422,6 +423,10 @@ void testing_gemm_ex(const Arguments& arg)
 
     bool alt = (rocblas_gemm_flags_fp16_alt_impl & flags);
 
+    // Reference results may be read from the cache, which is keyed by the state before the
+    // inputs are initialized
+    rocblas_ref_cache ref_cache(arg);
+
     // Initialize data on host memory
     rocblas_init_matrix<Ti>(
         hA, arg, rocblas_client_alpha_sets_nan, rocblas_client_general_matrix, true);
@@ -582,8 +587,24 @@ void testing_gemm_ex(const Arguments& arg)
         // CPU BLAS
         cpu_time_used = get_time_us_no_sync();
 
-        cblas_gemm<Ti, To_hpa, Tc>(
-            transA, transB, M, N, K, h_alpha_Tc, hA, lda, hB, ldb, h_beta_Tc, hD_gold, ldd, alt);
+        if(!ref_cache.load(hD_gold))
+        {
+            cblas_gemm<Ti, To_hpa, Tc>(transA,
+                                       transB,
+                                       M,
+                                       N,
+                                       K,
+                                       h_alpha_Tc,
+                                       hA,
+                                       lda,
+                                       hB,
+                                       ldb,
+                                       h_beta_Tc,
+                                       hD_gold,
+                                       ldd,
+                                       alt);
+            ref_cache.store(hD_gold);
+        }
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
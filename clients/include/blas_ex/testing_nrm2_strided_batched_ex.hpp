@@ -231,8 +231,9 @@ void testing_nrm2_strided_batched_ex(const Arguments& arg)
         // CPU BLAS
         cpu_time_used = get_time_us_no_sync();
 
-        for(int b = 0; b < batch_count; b++)
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_nrm2<Tx>(N, hx[b], incx, cpu_result + b);
+        });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
@@ -216,10 +216,9 @@ void testing_rot_batched_ex(const Arguments& arg)
     // hx_gold[0] = hx[0];
     // hy_gold[0] = hy[0];
     cpu_time_used = get_time_us_no_sync();
-    for(int b = 0; b < batch_count; b++)
-    {
+    cblas_batched(batch_count, [&](rocblas_int b) {
         cblas_rot<Tx, Ty, Tcs, Tcs>(N, hx_gold[b], incx, hy_gold[b], incy, hc, hs);
-    }
+    });
     cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
     if(arg.unit_check || arg.norm_check)
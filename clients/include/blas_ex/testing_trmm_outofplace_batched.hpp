@@ -588,10 +588,9 @@ void testing_trmm_outofplace_batched(const Arguments& arg)
             cpu_time_used = get_time_us_no_sync();
         }
 
-        for(rocblas_int i = 0; i < batch_count; i++)
-        {
+        cblas_batched(batch_count, [&](rocblas_int i) {
             cblas_trmm<T>(side, uplo, transA, diag, M, N, alpha, hA[i], lda, hB_gold[i], ldb);
-        }
+        });
 
         if(arg.timing)
         {
@@ -403,7 +403,7 @@ void testing_trsm_strided_batched_ex(const Arguments& arg)
     }
 
     // Calculate hB = hA*hX;
-    for(int b = 0; b < batch_count; b++)
+    cblas_batched(batch_count, [&](rocblas_int b) {
         cblas_trmm<T>(side,
                       uplo,
                       transA,
@@ -415,6 +415,7 @@ void testing_trsm_strided_batched_ex(const Arguments& arg)
                       lda,
                       hB + b * stride_B,
                       ldb);
+    });
 
     hXorB_1.copy_from(hB);
     hXorB_2.copy_from(hB);
@@ -608,13 +609,18 @@ void testing_trsm_strided_batched_ex(const Arguments& arg)
             //unit check
             trsm_err_res_check<T>(max_err_1, M, error_eps_multiplier, eps);
             trsm_err_res_check<T>(max_err_2, M, error_eps_multiplier, eps);
+        }
 
-            // hx_or_b contains A * (calculated X), so res = A * (calculated x) - b = hx_or_b - hb
+        // hx_or_b contains A * (calculated X), so res = A * (calculated x) - b = hx_or_b - hb
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_trmm<T>(
                 side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA[b], lda, hXorB_1[b], ldb);
             cblas_trmm<T>(
                 side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA[b], lda, hXorB_2[b], ldb);
+        });
 
+        for(int b = 0; b < batch_count; b++)
+        {
             // calculate vector-induced-norm 1 of matrix res
             max_err_1 = rocblas_abs(matrix_norm_1<T>(M, N, ldb, hXorB_1[b], hB[b]));
             max_err_2 = rocblas_abs(matrix_norm_1<T>(M, N, ldb, hXorB_2[b], hB[b]));
@@ -690,8 +696,9 @@ void testing_trsm_strided_batched_ex(const Arguments& arg)
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
 
-        for(int b = 0; b < batch_count; b++)
+        cblas_batched(batch_count, [&](rocblas_int b) {
             cblas_trsm<T>(side, uplo, transA, diag, M, N, alpha_h, hA[b], lda, cpuXorB[b], ldb);
+        });
 
         cpu_time_used = get_time_us_no_sync() - cpu_time_used;
 
@@ -45,6 +45,13 @@ constexpr double set_get_matrix_gbyte_count(rocblas_int m, rocblas_int n)
     return (sizeof(T) * m * n * 2.0) / 1e9;
 }
 
+/* \brief byte counts of a single SET_MATRIX or GET_MATRIX */
+template <typename T>
+constexpr double set_matrix_gbyte_count(rocblas_int m, rocblas_int n)
+{
+    return (sizeof(T) * m * double(n)) / 1e9;
+}
+
 /* \brief byte counts of SET/GET_VECTOR/_ASYNC */
 template <typename T>
 constexpr double set_get_vector_gbyte_count(rocblas_int n)
@@ -27,8 +27,47 @@
 #include "lapack_utilities.hpp"
 #include "rocblas.h"
 #include "rocblas.hpp"
+#include <algorithm>
+#include <omp.h>
 #include <type_traits>
 
+/*
+ * ===========================================================================
+ *    batched reference
+ * ===========================================================================
+ */
+
+// Run the CPU reference ref(b) for every batch b on the OpenMP threads. The threads are shared
+// out between the batches, so a cblas which uses OpenMP threads runs each batch with its share
+// (a single thread when there are at least as many batches as threads) and does not
+// oversubscribe the cores. Only OpenMP threading is limited, through omp_set_num_threads: a
+// cblas built with its own pthreads, such as BLIS or OpenBLAS configured for pthreads, still
+// starts its own number of threads for each batch, and should be limited with its environment
+// variable (BLIS_NUM_THREADS or OPENBLAS_NUM_THREADS) when the batches are run in parallel.
+template <typename F>
+void cblas_batched(rocblas_int batch_count, F ref)
+{
+    int threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+    int workers = std::min(threads, std::max(batch_count, 1));
+
+    if(workers <= 1)
+    {
+        for(rocblas_int b = 0; b < batch_count; b++)
+            ref(b);
+        return;
+    }
+
+#pragma omp parallel num_threads(workers)
+    {
+        // Threads of the parallel regions started by cblas on this worker
+        omp_set_num_threads(threads / workers);
+
+#pragma omp for
+        for(rocblas_int b = 0; b < batch_count; b++)
+            ref(b);
+    }
+}
+
 /*
  * ===========================================================================
  *    level 1 BLAS
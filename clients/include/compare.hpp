@@ -0,0 +1,447 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*!\file
+ * \brief one pass comparison of a result with its reference: pass/fail checks run in parallel
+ * over the columns of all matrices of a batch with vectorized inner loops, and the statistics of
+ * the differences (maximum absolute and relative errors, ULP distances and norms) are gathered
+ * without copying the matrices.
+ */
+
+#pragma once
+
+#include "rocblas.h"
+#include "rocblas_math.hpp"
+#include "rocblas_vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Minimum number of compared elements for which the comparison is parallelized
+constexpr size_t rocblas_compare_parallel_min = 1 << 16;
+
+/* ============== ULP distance ============= */
+
+// Maps the bits of a floating point value to an integer with the same ordering as the value,
+// so that the difference of two mapped values is their distance in units in the last place
+template <typename I, typename T>
+inline int64_t rocblas_ulp_order(T x)
+{
+    I bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits < 0 ? int64_t(std::numeric_limits<I>::min()) - bits : bits;
+}
+
+inline uint64_t rocblas_ulp_difference(int64_t a, int64_t b)
+{
+    // Computed modulo 2^64 since the difference of two doubles may not fit in int64_t
+    return a < b ? uint64_t(b) - uint64_t(a) : uint64_t(a) - uint64_t(b);
+}
+
+// Distance between two values in units in the last place of their type. The distance to or
+// from NaN is the maximum value.
+template <typename T, std::enable_if_t<std::is_integral<T>{}, int> = 0>
+inline uint64_t rocblas_ulp_distance(T a, T b)
+{
+    return rocblas_ulp_difference(a, b);
+}
+
+inline uint64_t rocblas_ulp_distance(float a, float b)
+{
+    if(std::isnan(a) || std::isnan(b))
+        return std::numeric_limits<uint64_t>::max();
+    return rocblas_ulp_difference(rocblas_ulp_order<int32_t>(a), rocblas_ulp_order<int32_t>(b));
+}
+
+inline uint64_t rocblas_ulp_distance(double a, double b)
+{
+    if(std::isnan(a) || std::isnan(b))
+        return std::numeric_limits<uint64_t>::max();
+    return rocblas_ulp_difference(rocblas_ulp_order<int64_t>(a), rocblas_ulp_order<int64_t>(b));
+}
+
+inline uint64_t rocblas_ulp_distance(rocblas_half a, rocblas_half b)
+{
+    if(rocblas_isnan(a) || rocblas_isnan(b))
+        return std::numeric_limits<uint64_t>::max();
+    return rocblas_ulp_difference(rocblas_ulp_order<int16_t>(a), rocblas_ulp_order<int16_t>(b));
+}
+
+inline uint64_t rocblas_ulp_distance(rocblas_bfloat16 a, rocblas_bfloat16 b)
+{
+    if(rocblas_isnan(a) || rocblas_isnan(b))
+        return std::numeric_limits<uint64_t>::max();
+    return rocblas_ulp_difference(rocblas_ulp_order<int16_t>(a.data),
+                                  rocblas_ulp_order<int16_t>(b.data));
+}
+
+template <typename T, std::enable_if_t<rocblas_is_complex<T>, int> = 0>
+inline uint64_t rocblas_ulp_distance(const T& a, const T& b)
+{
+    return std::max(rocblas_ulp_distance(std::real(a), std::real(b)),
+                    rocblas_ulp_distance(std::imag(a), std::imag(b)));
+}
+
+/* ============== Parallel pass/fail check ============= */
+
+// Pointer to the first element of a matrix of a batch given as an array of host vectors or of
+// pointers
+template <typename T>
+inline const T* rocblas_compare_data(const host_vector<T>& x)
+{
+    return x.data();
+}
+
+template <typename T>
+inline const T* rocblas_compare_data(const T* x)
+{
+    return x;
+}
+
+/*! \brief  Returns whether pass(ref[i], res[i]) holds for every element of the M x N matrices
+    ref(b) and res(b), b < batch_count. The columns of all matrices are checked in parallel and
+    the rows of each column with a vectorized loop. Once an element fails, the remaining columns
+    are skipped.
+*/
+template <typename FR, typename FG, typename P>
+bool rocblas_compare_all(size_t M, size_t N, size_t lda, size_t batch_count, FR ref, FG res, P pass)
+{
+    size_t            columns = N * batch_count;
+    std::atomic<bool> failed{false};
+
+#pragma omp parallel for schedule(dynamic, 16) if(M * columns >= rocblas_compare_parallel_min)
+    for(size_t c = 0; c < columns; c++)
+    {
+        if(failed.load(std::memory_order_relaxed))
+            continue;
+
+        auto* r   = ref(c / N) + c % N * lda;
+        auto* g   = res(c / N) + c % N * lda;
+        int   bad = 0;
+
+#pragma omp simd reduction(| : bad)
+        for(size_t i = 0; i < M; i++)
+            bad |= !pass(r[i], g[i]);
+
+        if(bad)
+            failed.store(true, std::memory_order_relaxed);
+    }
+
+    return !failed;
+}
+
+/* ============== Statistics of the differences ============= */
+
+template <typename T, std::enable_if_t<!rocblas_is_complex<T>, int> = 0>
+inline double rocblas_compare_real(const T& x)
+{
+    return double(x);
+}
+
+template <typename T, std::enable_if_t<!rocblas_is_complex<T>, int> = 0>
+inline double rocblas_compare_imag(const T&)
+{
+    return 0;
+}
+
+template <typename T, std::enable_if_t<rocblas_is_complex<T>, int> = 0>
+inline double rocblas_compare_real(const T& x)
+{
+    return std::real(x);
+}
+
+template <typename T, std::enable_if_t<rocblas_is_complex<T>, int> = 0>
+inline double rocblas_compare_imag(const T& x)
+{
+    return std::imag(x);
+}
+
+// Sum of squares kept as scale^2 * sumsq, as in LAPACK's xlassq, so that the Frobenius norm
+// neither overflows for elements above sqrt(DBL_MAX) nor underflows to 0 for denormals
+struct rocblas_compare_ssq
+{
+    double scale = 0;
+    double sumsq = 1;
+
+    void add(double x)
+    {
+        if(x != 0 || std::isnan(x))
+        {
+            double a = std::abs(x);
+            if(scale < a)
+            {
+                sumsq = 1 + sumsq * (scale / a) * (scale / a);
+                scale = a;
+            }
+            else
+                sumsq += (a / scale) * (a / scale);
+        }
+    }
+
+    // Combine with the sum of squares of other, as in LAPACK's xcombssq
+    void add(const rocblas_compare_ssq& other)
+    {
+        if(scale >= other.scale)
+        {
+            if(scale != 0)
+                sumsq += (other.scale / scale) * (other.scale / scale) * other.sumsq;
+            else
+                sumsq += other.sumsq;
+        }
+        else
+        {
+            sumsq = other.sumsq + (scale / other.scale) * (scale / other.scale) * sumsq;
+            scale = other.scale;
+        }
+    }
+
+    double norm() const
+    {
+        return scale * std::sqrt(sumsq);
+    }
+};
+
+struct rocblas_compare_stats
+{
+    // Bin 0 counts exact matches, bin b < ulp_bins - 1 counts ULP distances in [2^(b-1), 2^b),
+    // and the last bin counts larger distances and NaN mismatches
+    static constexpr int ulp_bins = 16;
+
+    size_t   count                   = 0; // compared elements
+    size_t   nan_count               = 0; // elements where the reference or the result is NaN
+    size_t   nan_mismatches          = 0; // elements where only one of them is NaN
+    double   max_abs_error           = 0;
+    double   max_rel_error           = 0; // relative to nonzero reference elements
+    uint64_t max_ulp                 = 0;
+    size_t   ulp_histogram[ulp_bins] = {};
+
+    // Norms of the reference and of the difference, of all matrices as one matrix of
+    // N * batch_count columns. NaN elements propagate like in LAPACK's xlange.
+    double ref_norm_max    = 0;
+    double error_norm_max  = 0;
+    double ref_norm_one    = 0;
+    double error_norm_one  = 0;
+    double ref_norm_frob   = 0;
+    double error_norm_frob = 0;
+
+    static int ulp_bin(uint64_t ulp)
+    {
+        int bin = 0;
+        while(ulp && bin < ulp_bins - 1)
+        {
+            ulp >>= 1;
+            bin++;
+        }
+        return ulp ? ulp_bins - 1 : bin;
+    }
+
+    // Accumulates the counts and maxima of other; the norms are combined by rocblas_compare
+    void merge(const rocblas_compare_stats& other)
+    {
+        count += other.count;
+        nan_count += other.nan_count;
+        nan_mismatches += other.nan_mismatches;
+        max_abs_error = std::max(max_abs_error, other.max_abs_error);
+        max_rel_error = std::max(max_rel_error, other.max_rel_error);
+        max_ulp       = std::max(max_ulp, other.max_ulp);
+        for(int b = 0; b < ulp_bins; b++)
+            ulp_histogram[b] += other.ulp_histogram[b];
+    }
+
+    // Norms of the reference and of the difference for the LAPACK norm types 'M', 'O' and 'F'
+    double ref_norm(char norm_type) const
+    {
+        return norm_type == 'M' || norm_type == 'm' ? ref_norm_max
+               : norm_type == 'F' || norm_type == 'f' || norm_type == 'E' || norm_type == 'e'
+                   ? ref_norm_frob
+                   : ref_norm_one;
+    }
+
+    double error_norm(char norm_type) const
+    {
+        return norm_type == 'M' || norm_type == 'm' ? error_norm_max
+               : norm_type == 'F' || norm_type == 'f' || norm_type == 'E' || norm_type == 'e'
+                   ? error_norm_frob
+                   : error_norm_one;
+    }
+
+    friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream&    os,
+                                                const rocblas_compare_stats& s)
+    {
+        os << "compared " << s.count << " elements, max abs error " << s.max_abs_error
+           << ", max rel error " << s.max_rel_error << ", max ULP " << s.max_ulp;
+        if(s.nan_mismatches)
+            os << ", " << s.nan_mismatches << " NaN mismatches";
+        os << ", ULP histogram";
+        for(int b = 0; b < ulp_bins; b++)
+            os << (b ? " " : " [") << s.ulp_histogram[b];
+        return os << "]";
+    }
+};
+
+/*! \brief  Gathers the statistics of the differences of the M x N matrices res(b) from ref(b),
+    b < batch_count, in one pass. ULP distances are measured in the type of the result, after
+    converting the reference to it. The columns are compared in parallel; the norms are summed
+    over each column in order and combined in column order, so that they do not depend on the
+    number of threads. The Frobenius norms are scaled sums of squares, accumulated over each
+    column and combined like in xlange, so they do not overflow or underflow where xlange
+    does not; they agree with it to rounding.
+*/
+template <typename FR, typename FG>
+rocblas_compare_stats rocblas_compare(
+    size_t M, size_t N, size_t lda, size_t batch_count, FR ref, FG res)
+{
+    using T = std::remove_cv_t<std::remove_reference_t<decltype(*res(0))>>;
+
+    struct column_norm
+    {
+        double              ref_sum = 0, error_sum = 0;
+        rocblas_compare_ssq ref_ssq, error_ssq;
+    };
+
+    size_t                   columns = N * batch_count;
+    rocblas_compare_stats    stats;
+    std::vector<column_norm> column_norms(columns);
+
+#pragma omp parallel if(M * columns >= rocblas_compare_parallel_min)
+    {
+        rocblas_compare_stats local;
+
+#pragma omp for schedule(dynamic, 16) nowait
+        for(size_t c = 0; c < columns; c++)
+        {
+            auto*   r    = ref(c / N) + c % N * lda;
+            auto*   g    = res(c / N) + c % N * lda;
+            auto&   norm = column_norms[c];
+
+            for(size_t i = 0; i < M; i++)
+            {
+                double rr = rocblas_compare_real(r[i]), ri = rocblas_compare_imag(r[i]);
+                double dr = rocblas_compare_real(g[i]) - rr;
+                double di = rocblas_compare_imag(g[i]) - ri;
+                double ra = ri ? std::hypot(rr, ri) : std::abs(rr);
+                double da = di ? std::hypot(dr, di) : std::abs(dr);
+
+                norm.ref_sum += ra;
+                norm.error_sum += da;
+                norm.ref_ssq.add(rr);
+                norm.ref_ssq.add(ri);
+                norm.error_ssq.add(dr);
+                norm.error_ssq.add(di);
+
+                if(local.ref_norm_max < ra || std::isnan(ra))
+                    local.ref_norm_max = ra;
+                if(local.error_norm_max < da || std::isnan(da))
+                    local.error_norm_max = da;
+
+                bool ref_nan = rocblas_isnan(r[i]), res_nan = rocblas_isnan(g[i]);
+                if(ref_nan || res_nan)
+                {
+                    local.nan_count++;
+                    if(ref_nan != res_nan)
+                    {
+                        local.nan_mismatches++;
+                        local.max_ulp = std::numeric_limits<uint64_t>::max();
+                        local.ulp_histogram[rocblas_compare_stats::ulp_bins - 1]++;
+                    }
+                    continue;
+                }
+
+                uint64_t ulp  = rocblas_ulp_distance(T(r[i]), g[i]);
+                local.max_ulp = std::max(local.max_ulp, ulp);
+                local.ulp_histogram[rocblas_compare_stats::ulp_bin(ulp)]++;
+                local.max_abs_error = std::max(local.max_abs_error, da);
+                if(ra)
+                    local.max_rel_error = std::max(local.max_rel_error, da / ra);
+            }
+            local.count += M;
+        }
+
+#pragma omp critical
+        {
+            stats.merge(local);
+            if(stats.ref_norm_max < local.ref_norm_max || std::isnan(local.ref_norm_max))
+                stats.ref_norm_max = local.ref_norm_max;
+            if(stats.error_norm_max < local.error_norm_max || std::isnan(local.error_norm_max))
+                stats.error_norm_max = local.error_norm_max;
+        }
+    }
+
+    // A NaN column sum propagates like in xlange
+    rocblas_compare_ssq ref_ssq, error_ssq;
+    for(auto& norm : column_norms)
+    {
+        if(stats.ref_norm_one < norm.ref_sum || std::isnan(norm.ref_sum))
+            stats.ref_norm_one = norm.ref_sum;
+        if(stats.error_norm_one < norm.error_sum || std::isnan(norm.error_sum))
+            stats.error_norm_one = norm.error_sum;
+        ref_ssq.add(norm.ref_ssq);
+        error_ssq.add(norm.error_ssq);
+    }
+    stats.ref_norm_frob   = ref_ssq.norm();
+    stats.error_norm_frob = error_ssq.norm();
+
+    return stats;
+}
+
+// Summary of the differences of a strided batch, or of a batch given as an array of host vectors
+// or pointers, which is added to the messages of failed checks
+template <typename Tr, typename T>
+std::string rocblas_compare_trace(size_t         M,
+                                  size_t         N,
+                                  size_t         lda,
+                                  rocblas_stride stride,
+                                  const Tr*      ref,
+                                  const T*       res,
+                                  size_t         batch_count)
+{
+    rocblas_internal_ostream os;
+    os << rocblas_compare(
+        M,
+        N,
+        lda,
+        batch_count,
+        [=](size_t b) { return ref + b * stride; },
+        [=](size_t b) { return res + b * stride; });
+    return os.str();
+}
+
+template <typename VR, typename VG>
+std::string rocblas_compare_trace(
+    size_t M, size_t N, size_t lda, const VR ref[], const VG res[], size_t batch_count)
+{
+    rocblas_internal_ostream os;
+    os << rocblas_compare(
+        M,
+        N,
+        lda,
+        batch_count,
+        [=](size_t b) { return rocblas_compare_data(ref[b]); },
+        [=](size_t b) { return rocblas_compare_data(res[b]); });
+    return os.str();
+}
@@ -22,18 +22,33 @@
 
 #pragma once
 
+#include <cstddef>
+#include <new>
+
 //!
-//! @brief Host free memory w/o swap.  Returns kB or -1 if unknown.
+//! @brief Host memory available w/o swap, limited by the memory cgroup of the process.
+//! Returns bytes or -1 if unknown.
 //!
 ptrdiff_t host_bytes_available();
 
 //!
-//! @brief Allocates memory which can be freed with free.  Returns nullptr if swap required.
+//! @brief Largest number of bytes allocated at once by host_malloc and host_calloc.
+//!
+size_t host_bytes_peak_reserved();
+
+//!
+//! @brief Budget of the checked allocations of host_malloc and host_calloc.  Returns bytes or
+//! -1 if unknown or not yet set by a large allocation.
+//!
+ptrdiff_t host_bytes_budget();
+
+//!
+//! @brief Allocates memory which can be freed with host_free.  Returns nullptr if swap required.
 //!
 void* host_malloc(size_t size);
 
 //!
-//! @brief Allocates memory which can be freed with free.  Throws exception if swap required.
+//! @brief Allocates memory which can be freed with host_free.  Throws exception if swap required.
 //!
 inline void* host_malloc_throw(size_t nmemb, size_t size)
 {
@@ -46,12 +61,14 @@ inline void* host_malloc_throw(size_t nmemb, size_t size)
 }
 
 //!
-//! @brief Allocates cleared memory which can be freed with free.  Returns nullptr if swap required.
+//! @brief Allocates cleared memory which can be freed with host_free.  Returns nullptr if swap
+//! required.
 //!
 void* host_calloc(size_t nmemb, size_t size);
 
 //!
-//! @brief Allocates cleared memory which can be freed with free.  Throws exception if swap required.
+//! @brief Allocates cleared memory which can be freed with host_free.  Throws exception if swap
+//! required.
 //!
 inline void* host_calloc_throw(size_t nmemb, size_t size)
 {
@@ -63,6 +80,11 @@ inline void* host_calloc_throw(size_t nmemb, size_t size)
     return ptr;
 }
 
+//!
+//! @brief Frees memory allocated by host_malloc or host_calloc, releasing its reservation.
+//!
+void host_free(void* ptr);
+
 //!
 //! @brief  Allocator which allocates with host_calloc
 //!
@@ -85,7 +107,7 @@ struct host_memory_allocator
 
     void deallocate(T* ptr, std::size_t n)
     {
-        free(ptr);
+        host_free(ptr);
     }
 };
 
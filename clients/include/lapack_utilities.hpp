@@ -81,7 +81,7 @@ void lapack_xcombssq(T* ssq, T* colssq)
     {
         if(ssq[0] != 0)
         {
-            ssq[1] = ssq[1] + std::sqrt(colssq[0] / ssq[0]) * colssq[1];
+            ssq[1] = ssq[1] + (colssq[0] / ssq[0]) * (colssq[0] / ssq[0]) * colssq[1];
         }
         else
         {
@@ -90,7 +90,7 @@ void lapack_xcombssq(T* ssq, T* colssq)
     }
     else
     {
-        ssq[1] = colssq[1] + std::sqrt(ssq[0] / colssq[0]) * ssq[1];
+        ssq[1] = colssq[1] + (ssq[0] / colssq[0]) * (ssq[0] / colssq[0]) * ssq[1];
         ssq[0] = colssq[0];
     }
     return;
@@ -110,12 +110,12 @@ void lapack_xlassq(rocblas_int n, T* X, rocblas_int incx, double& scale, double&
             {
                 if(scale < abs_X)
                 {
-                    sumsq = 1 + sumsq * std::sqrt(scale / abs_X);
+                    sumsq = 1 + sumsq * (scale / abs_X) * (scale / abs_X);
                     scale = abs_X;
                 }
                 else
                 {
-                    sumsq = sumsq + std::sqrt(abs_X / scale);
+                    sumsq = sumsq + (abs_X / scale) * (abs_X / scale);
                 }
             }
             if(rocblas_is_complex<T>)
@@ -125,19 +125,19 @@ void lapack_xlassq(rocblas_int n, T* X, rocblas_int incx, double& scale, double&
                 {
                     if(scale < abs_X || rocblas_isnan(abs_X))
                     {
-                        sumsq = 1 + sumsq * std::sqrt(scale / abs_X);
+                        sumsq = 1 + sumsq * (scale / abs_X) * (scale / abs_X);
                         scale = abs_X;
                     }
                     else
                     {
-                        sumsq = sumsq + std::sqrt(abs_X / scale);
+                        sumsq = sumsq + (abs_X / scale) * (abs_X / scale);
                     }
                 }
             }
         }
     }
 }
-/*! \brief lapack_xlange-returns the value of the one norm,  or the Frobenius norm, or the  infinity norm of the matrix A.*/
+/*! \brief lapack_xlange-returns the value of the one norm,  or the Frobenius norm, or the  infinity norm, or the largest absolute value of the matrix A.*/
 template <typename T>
 double
     lapack_xlange(char norm_type, rocblas_int m, rocblas_int n, T* A, rocblas_int lda, double* work)
@@ -160,6 +160,17 @@ double
                 value = sum;
         }
     }
+    else if(norm_type == 'M' || norm_type == 'm')
+    {
+        //Find the largest absolute value of Matrix A.
+        for(int j = 0; j < n; j++)
+            for(int i = 0; i < m; i++)
+            {
+                double abs_A = rocblas_abs(A[i + j * lda]);
+                if(value < abs_A || rocblas_isnan(abs_A))
+                    value = abs_A;
+            }
+    }
     else if(norm_type == 'I' || norm_type == 'i')
     {
         //Find the infinity norm of Matrix A.
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include "compare.hpp"
 #include "rocblas.h"
 #include "rocblas_math.hpp"
 #include "rocblas_test.hpp"
@@ -97,9 +98,14 @@ ROCBLAS_CLANG_STATIC constexpr double
 #define NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, err, NEAR_ASSERT)
 #else
 
+// All elements are first checked in parallel; the assertions are only evaluated to report a
+// failure, together with a summary of the differences
 #define NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, err, NEAR_ASSERT)            \
     do                                                                                       \
     {                                                                                        \
+        if(near_check_pass(M, N, lda, strideA, hCPU, hGPU, batch_count, err))                \
+            break;                                                                           \
+        SCOPED_TRACE(rocblas_compare_trace(M, N, lda, strideA, hCPU, hGPU, batch_count));    \
         for(size_t k = 0; k < batch_count; k++)                                              \
             for(size_t j = 0; j < N; j++)                                                    \
                 for(size_t i = 0; i < M; i++)                                                \
@@ -118,6 +124,9 @@ ROCBLAS_CLANG_STATIC constexpr double
 #define NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, err, NEAR_ASSERT)                    \
     do                                                                                        \
     {                                                                                         \
+        if(near_check_pass(M, N, lda, hCPU, hGPU, batch_count, err))                          \
+            break;                                                                            \
+        SCOPED_TRACE(rocblas_compare_trace(M, N, lda, hCPU, hGPU, batch_count));              \
         for(size_t k = 0; k < batch_count; k++)                                               \
             for(size_t j = 0; j < N; j++)                                                     \
                 for(size_t i = 0; i < M; i++)                                                 \
@@ -146,6 +155,68 @@ ROCBLAS_CLANG_STATIC constexpr double
         ASSERT_NEAR(std::imag(ta), std::imag(tb), err); \
     } while(0)
 
+// Element checks with the semantics of the assertions of NEAR_CHECK and NEAR_CHECK_B
+template <typename Tr, typename T, std::enable_if_t<!rocblas_is_complex<T>, int> = 0>
+inline bool near_check_element(const Tr& a, const T& b, double err)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b) : std::abs(double(a) - double(b)) <= err;
+}
+
+inline bool near_check_element(const float& a, const rocblas_bfloat16& b, double err)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b)
+                            : std::abs(double(rocblas_bfloat16(a)) - double(b)) <= err;
+}
+
+template <typename T, std::enable_if_t<rocblas_is_complex<T>, int> = 0>
+inline bool near_check_element(const T& a, const T& b, double err)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b)
+                            : std::abs(double(std::real(a)) - double(std::real(b))) <= err
+                                  && std::abs(double(std::imag(a)) - double(std::imag(b))) <= err;
+}
+
+// Returns whether all elements of a strided batch pass the check
+template <typename Tr, typename T>
+bool near_check_pass(size_t         M,
+                     size_t         N,
+                     size_t         lda,
+                     rocblas_stride strideA,
+                     const Tr*      hCPU,
+                     const T*       hGPU,
+                     size_t         batch_count,
+                     double         err)
+{
+    return rocblas_compare_all(
+        M,
+        N,
+        lda,
+        batch_count,
+        [=](size_t k) { return hCPU + k * strideA; },
+        [=](size_t k) { return hGPU + k * strideA; },
+        [=](const Tr& a, const T& b) { return near_check_element(a, b, err); });
+}
+
+// Returns whether all elements of a batch of host vectors or pointers pass the check
+template <typename VR, typename VG>
+bool near_check_pass(size_t   M,
+                     size_t   N,
+                     size_t   lda,
+                     const VR hCPU[],
+                     const VG hGPU[],
+                     size_t   batch_count,
+                     double   err)
+{
+    return rocblas_compare_all(
+        M,
+        N,
+        lda,
+        batch_count,
+        [=](size_t k) { return rocblas_compare_data(hCPU[k]); },
+        [=](size_t k) { return rocblas_compare_data(hGPU[k]); },
+        [=](const auto& a, const auto& b) { return near_check_element(a, b, err); });
+}
+
 // TODO: Replace std::remove_cv_t with std::type_identity_t in C++20
 // It is only used to make T_hpa non-deduced
 template <typename T, typename T_hpa = T>
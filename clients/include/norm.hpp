@@ -22,6 +22,7 @@
 #pragma once
 
 #include "cblas.h"
+#include "compare.hpp"
 #include "lapack_utilities.hpp"
 #include "norm.hpp"
 #include "rocblas.h"
@@ -30,6 +31,7 @@
 #include <cstdio>
 #include <limits>
 #include <memory>
+#include <vector>
 
 /* =====================================================================
         Norm check: norm(A-B)/norm(A), evaluate relative error
@@ -62,6 +64,14 @@ double norm_check_general(
     // one norm is max column sum
     // infinity norm is max row sum
     // Frobenius is l2 norm of matrix entries
+    if(norm_type != 'I' && norm_type != 'i')
+    {
+        // computed in one pass over both matrices, without converting them to double first
+        auto stats = rocblas_compare(
+            M, N, lda, 1, [=](size_t) { return hCPU; }, [=](size_t) { return hGPU; });
+        return stats.error_norm(norm_type) / stats.ref_norm(norm_type);
+    }
+
     size_t size = N * (size_t)lda;
 
     host_vector<double> hCPU_double(size);
@@ -135,6 +145,33 @@ double norm_check_general(
 }
 
 /* ============== Norm Check for strided_batched case ============= */
+// Computes the errors of the matrices of a batch in parallel, and combines them in batch order
+template <typename F>
+double norm_check_batched(char norm_type, rocblas_int batch_count, F batch_error)
+{
+    std::vector<double> errors(std::max(batch_count, 0));
+
+#pragma omp parallel for schedule(dynamic) if(batch_count > 1)
+    for(rocblas_int i = 0; i < batch_count; i++)
+        errors[i] = batch_error(i);
+
+    double cumulative_error = 0.0;
+
+    for(auto error : errors)
+    {
+        if(norm_type == 'F' || norm_type == 'f')
+        {
+            cumulative_error += error;
+        }
+        else if(norm_type == 'O' || norm_type == 'o' || norm_type == 'I' || norm_type == 'i')
+        {
+            cumulative_error = cumulative_error > error ? cumulative_error : error;
+        }
+    }
+
+    return cumulative_error;
+}
+
 template <typename T, template <typename> class VEC, typename T_hpa>
 double norm_check_general(char           norm_type,
                           rocblas_int    M,
@@ -153,25 +190,10 @@ double norm_check_general(char           norm_type,
     // use triangle inequality ||a+b|| <= ||a|| + ||b|| to calculate upper limit for Frobenius norm
     // of strided batched matrix
 
-    double cumulative_error = 0.0;
-
-    for(size_t i = 0; i < batch_count; i++)
-    {
+    return norm_check_batched(norm_type, batch_count, [&](rocblas_int i) {
         auto index = i * stride_a;
-
-        auto error = norm_check_general(norm_type, M, N, lda, (T_hpa*)hCPU + index, hGPU + index);
-
-        if(norm_type == 'F' || norm_type == 'f')
-        {
-            cumulative_error += error;
-        }
-        else if(norm_type == 'O' || norm_type == 'o' || norm_type == 'I' || norm_type == 'i')
-        {
-            cumulative_error = cumulative_error > error ? cumulative_error : error;
-        }
-    }
-
-    return cumulative_error;
+        return norm_check_general(norm_type, M, N, lda, (T_hpa*)hCPU + index, hGPU + index);
+    });
 }
 
 template <typename T, typename U>
@@ -184,29 +206,16 @@ double norm_check_general(char norm_type, T& hCPU, U& hGPU)
     //
     // use triangle inequality ||a+b|| <= ||a|| + ||b|| to calculate upper limit for Frobenius norm
     // of strided batched matrix
-    rocblas_int M                = hCPU.m();
-    rocblas_int N                = hCPU.n();
-    size_t      lda              = hCPU.lda();
-    rocblas_int batch_count      = hCPU.batch_count();
-    double      cumulative_error = 0.0;
-
-    for(rocblas_int b = 0; b < batch_count; b++)
-    {
-        auto* CPU   = hCPU[b];
-        auto* GPU   = hGPU[b];
-        auto  error = norm_check_general(norm_type, M, N, lda, CPU, GPU);
-
-        if(norm_type == 'F' || norm_type == 'f')
-        {
-            cumulative_error += error;
-        }
-        else if(norm_type == 'O' || norm_type == 'o' || norm_type == 'I' || norm_type == 'i')
-        {
-            cumulative_error = cumulative_error > error ? cumulative_error : error;
-        }
-    }
-
-    return cumulative_error;
+    rocblas_int M           = hCPU.m();
+    rocblas_int N           = hCPU.n();
+    size_t      lda         = hCPU.lda();
+    rocblas_int batch_count = hCPU.batch_count();
+
+    return norm_check_batched(norm_type, batch_count, [&](rocblas_int b) {
+        auto* CPU = hCPU[b];
+        auto* GPU = hGPU[b];
+        return norm_check_general(norm_type, M, N, lda, CPU, GPU);
+    });
 }
 
 /* ============== Norm Check for batched case ============= */
@@ -228,25 +237,9 @@ double norm_check_general(char                      norm_type,
     // use triangle inequality ||a+b|| <= ||a|| + ||b|| to calculate upper limit for Frobenius norm
     // of strided batched matrix
 
-    double cumulative_error = 0.0;
-
-    for(rocblas_int i = 0; i < batch_count; i++)
-    {
-        auto index = i;
-
-        auto error = norm_check_general<T>(norm_type, M, N, lda, hCPU[index], hGPU[index]);
-
-        if(norm_type == 'F' || norm_type == 'f')
-        {
-            cumulative_error += error;
-        }
-        else if(norm_type == 'O' || norm_type == 'o' || norm_type == 'I' || norm_type == 'i')
-        {
-            cumulative_error = cumulative_error > error ? cumulative_error : error;
-        }
-    }
-
-    return cumulative_error;
+    return norm_check_batched(norm_type, batch_count, [&](rocblas_int i) {
+        return norm_check_general<T>(norm_type, M, N, lda, hCPU[i], hGPU[i]);
+    });
 }
 
 template <typename T>
@@ -266,25 +259,9 @@ double norm_check_general(char        norm_type,
     // use triangle inequality ||a+b|| <= ||a|| + ||b|| to calculate upper limit for Frobenius norm
     // of strided batched matrix
 
-    double cumulative_error = 0.0;
-
-    for(rocblas_int i = 0; i < batch_count; i++)
-    {
-        auto index = i;
-
-        auto error = norm_check_general<T>(norm_type, M, N, lda, hCPU[index], hGPU[index]);
-
-        if(norm_type == 'F' || norm_type == 'f')
-        {
-            cumulative_error += error;
-        }
-        else if(norm_type == 'O' || norm_type == 'o' || norm_type == 'I' || norm_type == 'i')
-        {
-            cumulative_error = cumulative_error > error ? cumulative_error : error;
-        }
-    }
-
-    return cumulative_error;
+    return norm_check_batched(norm_type, batch_count, [&](rocblas_int i) {
+        return norm_check_general<T>(norm_type, M, N, lda, hCPU[i], hGPU[i]);
+    });
 }
 
 /* ============== Norm Check for Symmetric Matrix ============= */
@@ -23,6 +23,8 @@
 #pragma once
 
 #include "rocblas_arguments.hpp"
+#include "rocblas_indexed_data.hpp"
+#include "rocblas_yaml_expand.hpp"
 #include "test_cleanup.hpp"
 #include <cerrno>
 #include <cstdio>
@@ -32,8 +34,10 @@
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if __has_include(<filesystem>)
 #include <filesystem>
@@ -56,25 +60,84 @@ class RocBLAS_TestData
         return filename;
     }
 
-    // filter iterator
-    class iterator : public std::istream_iterator<Arguments>
+    // YAML template prepended to filename, when filename is a YAML file to expand
+    static auto& yaml_template()
     {
-        bool (*const filter)(const Arguments&) = nullptr;
+        static std::string yaml_template;
+        return yaml_template;
+    }
+
+    // Directory where expanded YAML files are cached, or empty
+    static auto& yaml_cache_dir()
+    {
+        static std::string yaml_cache_dir;
+        return yaml_cache_dir;
+    }
+
+    static bool& expand_yaml()
+    {
+        static bool expand_yaml = false;
+        return expand_yaml;
+    }
+
+    using filter_t = std::function<bool(const Arguments&)>;
+
+    // filter iterator, over records read from a stream or selected from an indexed file
+    class iterator
+    {
+        using stream_iterator = std::istream_iterator<Arguments>;
+
+        filter_t                                   filter;
+        stream_iterator                            stream;
+        const rocblas_indexed_data*                data = nullptr;
+        std::shared_ptr<const std::vector<size_t>> selection;
+        size_t                                     pos = 0;
+
+        bool at_end() const
+        {
+            return data ? pos == (selection ? selection->size() : data->size())
+                        : stream == stream_iterator{};
+        }
+
+        void advance()
+        {
+            if(data)
+                ++pos;
+            else
+                ++stream;
+        }
 
         // Skip entries for which filter is false
         void skip_filter()
         {
-            static auto endIter = std::istream_iterator<Arguments>{};
             if(filter)
-                while(*this != endIter && !filter(**this))
-                    ++*static_cast<std::istream_iterator<Arguments>*>(this);
+                while(!at_end() && !filter(**this))
+                    advance();
         }
 
     public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Arguments;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Arguments*;
+        using reference         = const Arguments&;
+
         // Constructor takes a filter and iterator
-        iterator(bool filter(const Arguments&), std::istream_iterator<Arguments> iter)
-            : std::istream_iterator<Arguments>(iter)
-            , filter(filter)
+        iterator(filter_t filter, stream_iterator iter)
+            : filter(std::move(filter))
+            , stream(iter)
+        {
+            skip_filter();
+        }
+
+        // Constructor takes a filter and the selected records of an indexed file, or all of
+        // its records if selection is nullptr
+        iterator(filter_t                                   filter,
+                 const rocblas_indexed_data&                data,
+                 std::shared_ptr<const std::vector<size_t>> selection)
+            : filter(std::move(filter))
+            , data(&data)
+            , selection(std::move(selection))
         {
             skip_filter();
         }
@@ -82,39 +145,71 @@ class RocBLAS_TestData
         // Default end iterator and nullptr filter
         iterator() = default;
 
+        reference operator*() const
+        {
+            return data ? (*data)[selection ? (*selection)[pos] : pos] : *stream;
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
         // Preincrement iterator operator with filtering
         iterator& operator++()
         {
-            ++*static_cast<std::istream_iterator<Arguments>*>(this);
+            advance();
             skip_filter();
             return *this;
         }
 
         // We do not need a postincrement iterator operator
-        // We delete it here so that the base class's isn't silently called
         // To implement it, use "auto old = *this; ++*this; return old;"
         iterator operator++(int) = delete;
-    };
 
-public:
-    // Initialize filename, optionally removing it at exit
-    static void set_filename(std::string name, bool remove_atexit = false)
-    {
-        filename() = std::move(name);
-        if(remove_atexit)
+        bool operator==(const iterator& rhs) const
         {
-            auto cleanup = [] { fs::remove(filename().c_str()); };
-            atexit(cleanup);
-            at_quick_exit(cleanup);
+            if(at_end() || rhs.at_end())
+                return at_end() == rhs.at_end();
+            return data ? data == rhs.data && pos == rhs.pos : stream == rhs.stream;
         }
-    }
 
-    // begin() iterator which accepts an optional filter.
-    static iterator begin(bool filter(const Arguments&) = nullptr)
+        bool operator!=(const iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    // Open the data file, returning its records as an indexed file or a stream
+    static std::istream* open(const rocblas_indexed_data*& indexed)
     {
-        static std::ifstream* ifs = nullptr;
+        static std::ifstream*        ifs = nullptr;
+        static rocblas_yaml_istream* yis = nullptr;
+        static rocblas_indexed_data* idx = nullptr;
 
         // If this is the first time, or after test_cleanup::cleanup() has been called
+        if(expand_yaml())
+        {
+            // Allocate a rocblas_yaml_istream and register it to be deleted during cleanup
+            if(!yis)
+                yis = test_cleanup::allocate(&yis,
+                                             filename(),
+                                             std::vector<std::string>{},
+                                             yaml_template(),
+                                             yaml_cache_dir());
+            indexed = nullptr;
+            return yis;
+        }
+
+        if(idx || (!ifs && rocblas_indexed_data::is_indexed(filename())))
+        {
+            // Map the indexed file and register it to be unmapped during cleanup
+            if(!idx)
+                idx = test_cleanup::allocate(&idx, filename());
+            indexed = idx;
+            return nullptr;
+        }
+
         if(!ifs)
         {
             std::string fileToOpen = filename();
@@ -128,17 +223,67 @@ public:
                 exit(EXIT_FAILURE);
             }
         }
+        indexed = nullptr;
+        return ifs;
+    }
+
+public:
+    // Initialize filename, optionally removing it at exit
+    static void set_filename(std::string name, bool remove_atexit = false)
+    {
+        filename() = std::move(name);
+        if(remove_atexit)
+        {
+            auto cleanup = [] { fs::remove(filename().c_str()); };
+            atexit(cleanup);
+            at_quick_exit(cleanup);
+        }
+    }
+
+    // Initialize a YAML filename, which is expanded into Arguments records as they are read,
+    // or read from cache_dir if it has been expanded before
+    static void
+        set_yaml(std::string name, std::string template_file = "", std::string cache_dir = "")
+    {
+        filename()       = std::move(name);
+        yaml_template()  = std::move(template_file);
+        yaml_cache_dir() = std::move(cache_dir);
+        expand_yaml()    = true;
+    }
+
+    // begin() iterator which accepts an optional filter.
+    static iterator begin(filter_t filter = nullptr)
+    {
+        const rocblas_indexed_data* indexed;
+        std::istream*               is = open(indexed);
+        if(indexed)
+            return iterator(std::move(filter), *indexed, nullptr);
 
         // We re-seek the file back to position 0
-        ifs->clear();
-        ifs->seekg(0);
+        is->clear();
+        is->seekg(0);
 
         // Validate the data file format
-        Arguments::validate(*ifs);
+        Arguments::validate(*is);
 
         // We create a filter iterator which will choose only the test cases we want right now.
         // This is to preserve Gtest structure while not creating no-op tests which "always pass".
-        return iterator(filter, std::istream_iterator<Arguments>(*ifs));
+        return iterator(std::move(filter), std::istream_iterator<Arguments>(*is));
+    }
+
+    // begin() iterator with a filter which depends only on the function, category,
+    // known_bug_platforms, data types and flags. With an indexed data file, only the records
+    // whose combination of them is accepted by the filter are visited.
+    static iterator begin_indexed(filter_t filter)
+    {
+        const rocblas_indexed_data* indexed;
+        open(indexed);
+        if(!indexed || !filter)
+            return begin(std::move(filter));
+
+        // The filter is still applied to each selected record, since it may update it
+        auto selection = std::make_shared<std::vector<size_t>>(indexed->select(filter));
+        return iterator(std::move(filter), *indexed, std::move(selection));
     }
 
     // end() iterator
@@ -0,0 +1,101 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas_arguments.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+ * Indexed test data files, written by rocblas_gentest.py --index, hold the    *
+ * same Arguments records as the sequential format, preceded by a header and   *
+ * followed by an index. The index groups the record numbers by key: records   *
+ * with the same function, category, known_bug_platforms, data types (a_type, *
+ * b_type, c_type, d_type and compute_type) and flags share a key. Within a   *
+ * key, record numbers are in file order. All integers are little-endian.     *
+ *******************************************************************************/
+constexpr char     ROCBLAS_INDEXED_DATA_MAGIC[8] = {'r', 'o', 'c', 'B', 'L', 'A', 'S', 'I'};
+constexpr uint32_t ROCBLAS_INDEXED_DATA_VERSION  = 2;
+
+struct rocblas_indexed_data_header
+{
+    char     magic[8]; // ROCBLAS_INDEXED_DATA_MAGIC
+    uint32_t version; // ROCBLAS_INDEXED_DATA_VERSION
+    uint32_t record_size; // sizeof(Arguments)
+    uint64_t record_count;
+    uint64_t key_count;
+    uint64_t signature_offset; // signature of the sequential format, for Arguments::validate
+    uint64_t records_offset; // record_count records, aligned to 64 bytes
+    uint64_t keys_offset; // key_count rocblas_indexed_data_key entries
+    uint64_t indices_offset; // record_count record numbers, grouped by key
+};
+
+static_assert(sizeof(rocblas_indexed_data_header) == 64, "Unexpected indexed data header size");
+
+struct rocblas_indexed_data_key
+{
+    uint64_t first; // position of the key's first record number in the indices
+    uint64_t count; // number of records with the key
+};
+
+/*****************************************************************************
+ * rocblas_indexed_data memory-maps an indexed test data file. Errors in the *
+ * file are printed and exit the program, as with sequential data files.    *
+ *****************************************************************************/
+class rocblas_indexed_data
+{
+    const char*                        m_base = nullptr;
+    size_t                             m_size = 0;
+    std::vector<char>                  m_buffer; // contents when the file cannot be mapped
+    const rocblas_indexed_data_header* m_header  = nullptr;
+    const Arguments*                   m_records = nullptr;
+    const rocblas_indexed_data_key*    m_keys    = nullptr;
+    const uint64_t*                    m_indices = nullptr;
+
+public:
+    // Return whether file is an indexed data file, by its magic number
+    static bool is_indexed(const std::string& file);
+
+    explicit rocblas_indexed_data(const std::string& file);
+    ~rocblas_indexed_data();
+
+    rocblas_indexed_data(const rocblas_indexed_data&) = delete;
+    rocblas_indexed_data& operator=(const rocblas_indexed_data&) = delete;
+
+    size_t size() const
+    {
+        return m_header->record_count;
+    }
+
+    const Arguments& operator[](size_t i) const
+    {
+        return m_records[i];
+    }
+
+    // Record numbers, in file order, of the keys whose first record is accepted by filter.
+    // filter must depend only on the fields which form the key.
+    std::vector<size_t> select(const std::function<bool(const Arguments&)>& filter) const;
+};
@@ -57,16 +57,18 @@ typedef enum rocblas_check_nan_init_
 // mantissa 10 bits.
 
 template <typename T>
-void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
-                                          const char                uplo,
-                                          T                         rand_gen(),
-                                          host_vector<T>&           A,
-                                          size_t                    M,
-                                          size_t                    N,
-                                          size_t                    lda,
-                                          rocblas_stride            stride      = 0,
-                                          rocblas_int               batch_count = 1)
-{
+void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type   matrix_type,
+                                          const char                  uplo,
+                                          rocblas_random_generator<T> rand_gen,
+                                          host_vector<T>&             A,
+                                          size_t                      M,
+                                          size_t                      N,
+                                          size_t                      lda,
+                                          rocblas_stride              stride      = 0,
+                                          rocblas_int                 batch_count = 1)
+{
+    const rocblas_random_stream random;
+
     if(matrix_type == rocblas_client_general_matrix)
     {
         for(size_t b = 0; b < batch_count; b++)
@@ -74,7 +76,7 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value                  = rand_gen();
+                    auto value                  = rand_gen(random(i, j, b));
                     A[i + j * lda + b * stride] = (i ^ j) & 1 ? T(value) : T(negate(value));
                 }
     }
@@ -85,19 +87,21 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value
-                        = uplo == 'U' ? (j >= i ? rand_gen() : 0) : (j <= i ? rand_gen() : 0);
+                    bool in_triangle            = uplo == 'U' ? j >= i : j <= i;
+                    auto value                  = in_triangle ? rand_gen(random(i, j, b)) : 0;
                     A[i + j * lda + b * stride] = (i ^ j) & 1 ? T(value) : T(negate(value));
                 }
     }
 }
 
 template <typename U, typename T>
-void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
-                                          const char                uplo,
-                                          T                         rand_gen(),
-                                          U&                        hA)
+void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type   matrix_type,
+                                          const char                  uplo,
+                                          rocblas_random_generator<T> rand_gen,
+                                          U&                          hA)
 {
+    const rocblas_random_stream random;
+
     for(rocblas_int batch_index = 0; batch_index < hA.batch_count(); ++batch_index)
     {
         auto* A   = hA[batch_index];
@@ -111,7 +115,7 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value     = rand_gen();
+                    auto value     = rand_gen(random(i, j, batch_index));
                     A[i + j * lda] = (i ^ j) & 1 ? T(value) : T(negate(value));
                 }
         }
@@ -121,9 +125,9 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value
-                        = uplo == 'U' ? (j >= i ? rand_gen() : 0) : (j <= i ? rand_gen() : 0);
-                    A[i + j * lda] = (i ^ j) & 1 ? T(value) : T(negate(value));
+                    bool in_triangle = uplo == 'U' ? j >= i : j <= i;
+                    auto value       = in_triangle ? rand_gen(random(i, j, batch_index)) : 0;
+                    A[i + j * lda]   = (i ^ j) & 1 ? T(value) : T(negate(value));
                 }
         }
     }
@@ -131,15 +135,20 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
 
 // Initialize vector so adjacent entries have alternating sign.
 template <typename T>
-void rocblas_init_vector_alternating_sign(T rand_gen(), T* x, rocblas_int N, rocblas_stride incx)
+void rocblas_init_vector_alternating_sign(rocblas_random_generator<T> rand_gen,
+                                          T*                          x,
+                                          rocblas_int                 N,
+                                          rocblas_stride              incx)
 {
+    const rocblas_random_stream random;
+
     if(incx < 0)
         x -= (N - 1) * incx;
 
 #pragma omp parallel for
     for(rocblas_int j = 0; j < N; ++j)
     {
-        auto value  = rand_gen();
+        auto value  = rand_gen(random(j));
         x[j * incx] = j & 1 ? T(value) : T(negate(value));
     }
 }
@@ -149,23 +158,25 @@ void rocblas_init_vector_alternating_sign(T rand_gen(), T* x, rocblas_int N, roc
 // Initialize matrix with rand_int/hpl/NaN values
 
 template <typename T>
-void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
-                         const char                uplo,
-                         T                         rand_gen(),
-                         host_vector<T>&           A,
-                         size_t                    M,
-                         size_t                    N,
-                         size_t                    lda,
-                         rocblas_stride            stride      = 0,
-                         rocblas_int               batch_count = 1)
-{
+void rocblas_init_matrix(rocblas_check_matrix_type   matrix_type,
+                         const char                  uplo,
+                         rocblas_random_generator<T> rand_gen,
+                         host_vector<T>&             A,
+                         size_t                      M,
+                         size_t                      N,
+                         size_t                      lda,
+                         rocblas_stride              stride      = 0,
+                         rocblas_int                 batch_count = 1)
+{
+    const rocblas_random_stream random;
+
     if(matrix_type == rocblas_client_general_matrix)
     {
         for(size_t b = 0; b < batch_count; b++)
 #pragma omp parallel for
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
-                    A[i + j * lda + b * stride] = rand_gen();
+                    A[i + j * lda + b * stride] = rand_gen(random(i, j, b));
     }
     else if(matrix_type == rocblas_client_hermitian_matrix)
     {
@@ -174,7 +185,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
-                    auto value = rand_gen();
+                    auto value = rand_gen(random(i, j, b));
                     if(i == j)
                         A[b * stride + j + i * lda] = std::real(value);
                     else if(uplo == 'U')
@@ -201,7 +212,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
-                    auto value = rand_gen();
+                    auto value = rand_gen(random(i, j, b));
                     if(i == j)
                         A[b * stride + j + i * lda] = value;
                     else if(uplo == 'U')
@@ -228,8 +239,8 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value
-                        = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
+                    bool in_triangle            = uplo == 'U' ? j >= i : j <= i;
+                    auto value                  = in_triangle ? rand_gen(random(i, j, b)) : T(0);
                     A[i + j * lda + b * stride] = value;
                 }
     }
@@ -245,9 +256,9 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
         for(size_t i = 0; i < M; ++i)
             for(size_t j = 0; j < N; ++j)
             {
-                auto value
-                    = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
-                A[i + j * lda] = value;
+                bool in_triangle = uplo == 'U' ? j >= i : j <= i;
+                auto value       = in_triangle ? rand_gen(random(i, j)) : T(0);
+                A[i + j * lda]   = value;
             }
 
         const T multiplier = T(
@@ -300,11 +311,13 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 }
 
 template <typename U, typename T>
-void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
-                         const char                uplo,
-                         T                         rand_gen(),
-                         U&                        hA)
+void rocblas_init_matrix(rocblas_check_matrix_type   matrix_type,
+                         const char                  uplo,
+                         rocblas_random_generator<T> rand_gen,
+                         U&                          hA)
 {
+    const rocblas_random_stream random;
+
     for(rocblas_int batch_index = 0; batch_index < hA.batch_count(); ++batch_index)
     {
         auto* A   = hA[batch_index];
@@ -316,7 +329,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 #pragma omp parallel for
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
-                    A[i + j * lda] = rand_gen();
+                    A[i + j * lda] = rand_gen(random(i, j, batch_index));
         }
         else if(matrix_type == rocblas_client_hermitian_matrix)
         {
@@ -324,7 +337,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
-                    auto value = rand_gen();
+                    auto value = rand_gen(random(i, j, batch_index));
                     if(i == j)
                         A[j + i * lda] = std::real(value);
                     else if(uplo == 'U')
@@ -350,7 +363,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
-                    auto value = rand_gen();
+                    auto value = rand_gen(random(i, j, batch_index));
                     if(i == j)
                         A[j + i * lda] = value;
                     else if(uplo == 'U')
@@ -376,9 +389,9 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value
-                        = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
-                    A[i + j * lda] = value;
+                    bool in_triangle = uplo == 'U' ? j >= i : j <= i;
+                    auto value       = in_triangle ? rand_gen(random(i, j, batch_index)) : T(0);
+                    A[i + j * lda]   = value;
                 }
         }
 
@@ -393,9 +406,9 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < M; ++i)
                 for(size_t j = 0; j < N; ++j)
                 {
-                    auto value
-                        = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
-                    A[i + j * lda] = value;
+                    bool in_triangle = uplo == 'U' ? j >= i : j <= i;
+                    auto value       = in_triangle ? rand_gen(random(i, j, batch_index)) : T(0);
+                    A[i + j * lda]   = value;
                 }
 
             const T multiplier = T(
@@ -452,14 +465,19 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 // Initialize vectors with rand_int/hpl/NaN values
 
 template <typename T>
-void rocblas_init_vector(T rand_gen(), T* x, rocblas_int N, rocblas_stride incx)
+void rocblas_init_vector(rocblas_random_generator<T> rand_gen,
+                         T*                          x,
+                         rocblas_int                 N,
+                         rocblas_stride              incx)
 {
+    const rocblas_random_stream random;
+
     if(incx < 0)
         x -= (N - 1) * incx;
 
 #pragma omp parallel for
     for(rocblas_int j = 0; j < N; ++j)
-        x[j * incx] = rand_gen();
+        x[j * incx] = rand_gen(random(j));
 }
 
 /* ============================================================================================ */
@@ -675,21 +693,14 @@ void rocblas_init_vector_trig(T* x, rocblas_int N, rocblas_stride incx, bool see
 template <typename T>
 void rocblas_init(T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    const rocblas_random_stream random;
+
+    // Small matrices, which are often initialized an element at a time, are not worth a thread team
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-    {
-        size_t b_idx = i_batch * stride;
+#pragma omp parallel for if(M * N >= 4096)
         for(size_t j = 0; j < N; ++j)
-        {
-            size_t col_idx = b_idx + j * lda;
-            if(M > 4)
-                random_run_generator<T>(A + col_idx, M);
-            else
-            {
-                for(size_t i = 0; i < M; ++i)
-                    A[col_idx + i] = random_generator<T>();
-            }
-        }
-    }
+            for(size_t i = 0; i < M; ++i)
+                A[i + j * lda + i_batch * stride] = random_generator<T>(random(i, j, i_batch));
 }
 
 // Initialize matrices with random values
@@ -37,15 +37,6 @@ extern rocblas_rng_t   g_rocblas_seed;
 extern std::thread::id g_main_thread_id;
 
 extern thread_local rocblas_rng_t t_rocblas_rng;
-extern thread_local int           t_rocblas_rand_idx;
-
-// optimized helper
-float rocblas_uniform_int_1_10();
-
-void rocblas_uniform_int_1_10_run_float(float* ptr, size_t num);
-void rocblas_uniform_int_1_10_run_double(double* ptr, size_t num);
-void rocblas_uniform_int_1_10_run_float_complex(rocblas_float_complex* ptr, size_t num);
-void rocblas_uniform_int_1_10_run_double_complex(rocblas_double_complex* ptr, size_t num);
 
 // For the main thread, we use g_rocblas_seed; for other threads, we start with a different seed but
 // deterministically based on the thread id's hash function.
@@ -59,17 +50,99 @@ inline rocblas_rng_t get_seed()
 // Reset the seed (mainly to ensure repeatability of failures in a given suite)
 inline void rocblas_seedrand()
 {
-    t_rocblas_rng      = get_seed();
-    t_rocblas_rand_idx = 0;
+    t_rocblas_rng = get_seed();
+}
+
+/* ============================================================================================ */
+/*! \brief  Counter-based random numbers */
+// Matrices and vectors are initialized with the Philox4x32-10 generator (Salmon et al., "Parallel
+// random numbers: as easy as 1, 2, 3", SC11), which maps a key and a counter directly to random
+// bits. The value of each element depends only on its coordinates, so initialization loops can
+// run in parallel and produce the same values whatever the number of threads.
+
+struct rocblas_random_bits
+{
+    uint32_t w[4];
+};
+
+inline rocblas_random_bits rocblas_philox4x32_10(
+    uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t k0, uint32_t k1)
+{
+    for(int round = 0; round < 10; ++round)
+    {
+        uint64_t p0 = uint64_t(0xD2511F53) * c0;
+        uint64_t p1 = uint64_t(0xCD9E8D57) * c2;
+        c0          = uint32_t(p1 >> 32) ^ c1 ^ k0;
+        c1          = uint32_t(p1);
+        c2          = uint32_t(p0 >> 32) ^ c3 ^ k1;
+        c3          = uint32_t(p0);
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    return {{c0, c1, c2, c3}};
+}
+
+// A stream of random bits indexed by element coordinates. Each stream takes its key from the
+// calling thread's generator, so successive initializations differ, and are repeated after
+// rocblas_seedrand().
+class rocblas_random_stream
+{
+    uint32_t m_key[2];
+
+public:
+    rocblas_random_stream()
+        : m_key{uint32_t(t_rocblas_rng()), uint32_t(t_rocblas_rng())}
+    {
+    }
+
+    // Random bits of element (i, j) of matrix b of a batch
+    rocblas_random_bits operator()(size_t i, size_t j = 0, size_t b = 0) const
+    {
+        return rocblas_philox4x32_10(
+            uint32_t(i), uint32_t(j), uint32_t(b), uint32_t(i >> 32), m_key[0], m_key[1]);
+    }
+};
+
+// Function which generates a random value from counter-based random bits
+template <typename T>
+using rocblas_random_generator = T (*)(const rocblas_random_bits&);
+
+// Uniform random integer in [lo, hi] from 32 random bits
+inline int rocblas_uniform_int(uint32_t bits, int lo, int hi)
+{
+    return lo + int((uint64_t(bits) * uint32_t(hi - lo + 1)) >> 32);
+}
+
+// Uniform random double in [lo, hi) from 64 random bits
+inline double rocblas_uniform_real(uint32_t hi_bits, uint32_t lo_bits, double lo, double hi)
+{
+    uint64_t bits = (uint64_t(hi_bits) << 32 | lo_bits) >> 11;
+    return lo + (hi - lo) * (double(bits) * 0x1.0p-53);
 }
 
 /* ============================================================================================ */
 /*! \brief  Random number generator which generates NaN values */
+// The values come from the thread's generator, or from counter-based random bits if given
 class rocblas_nan_rng
 {
+    const rocblas_random_bits* m_bits = nullptr;
+    int                        m_word = 0;
+
+    // Next random bits
+    template <typename UINT_T>
+    UINT_T random_bits()
+    {
+        if(!m_bits)
+            return std::uniform_int_distribution<UINT_T>{}(t_rocblas_rng);
+        UINT_T u = UINT_T(m_bits->w[m_word++ & 3]);
+        if constexpr(sizeof(UINT_T) > sizeof(uint32_t))
+            u = u << 32 | m_bits->w[m_word++ & 3];
+        return u;
+    }
+
     // Generate random NaN values
     template <typename T, typename UINT_T, int SIG, int EXP>
-    static T random_nan_data()
+    T random_nan_data()
     {
         static_assert(sizeof(UINT_T) == sizeof(T), "Type sizes do not match");
         union
@@ -77,25 +150,33 @@ class rocblas_nan_rng
             UINT_T u;
             T      fp;
         } x;
-        do
-            x.u = std::uniform_int_distribution<UINT_T>{}(t_rocblas_rng);
-        while(!(x.u & (((UINT_T)1 << SIG) - 1))); // Reject Inf (mantissa == 0)
+        x.u = random_bits<UINT_T>();
+        while(!(x.u & (((UINT_T)1 << SIG) - 1))) // Reject Inf (mantissa == 0)
+            x.u = m_bits ? x.u | 1 : random_bits<UINT_T>();
         x.u |= (((UINT_T)1 << EXP) - 1) << SIG; // Exponent = all 1's
         return x.fp; // NaN with random bits
     }
 
 public:
+    rocblas_nan_rng() = default;
+
+    explicit rocblas_nan_rng(const rocblas_random_bits& bits)
+        : m_bits(&bits)
+    {
+    }
+
     // Random integer
     template <typename T, std::enable_if_t<std::is_integral<T>{}, int> = 0>
     explicit operator T()
     {
-        return std::uniform_int_distribution<T>{}(t_rocblas_rng);
+        return m_bits ? T(m_bits->w[0]) : std::uniform_int_distribution<T>{}(t_rocblas_rng);
     }
 
     // Random signed char
     explicit operator signed char()
     {
-        return static_cast<signed char>(std::uniform_int_distribution<int>{}(t_rocblas_rng));
+        return static_cast<signed char>(
+            m_bits ? int(m_bits->w[0]) : std::uniform_int_distribution<int>{}(t_rocblas_rng));
     }
 
     // Random NaN double
@@ -251,9 +332,9 @@ public:
 
 /*! \brief  generate a random NaN number */
 template <typename T>
-inline T random_nan_generator()
+inline T random_nan_generator(const rocblas_random_bits& bits)
 {
-    return T(rocblas_nan_rng{});
+    return T(rocblas_nan_rng{bits});
 }
 
 /*! \brief  generate a random Inf number */
@@ -279,103 +360,67 @@ inline T random_denorm_generator()
 
 /*! \brief  generate a random number in range [1,2,3,4,5,6,7,8,9,10] */
 template <typename T>
-inline T random_generator()
+inline T random_generator(const rocblas_random_bits& bits)
 {
-    return T(rocblas_uniform_int_1_10());
-}
-
-template <>
-inline float random_generator()
-{
-    return rocblas_uniform_int_1_10();
+    return T(float(rocblas_uniform_int(bits.w[0], 1, 10)));
 }
 
 // for rocblas_float_complex, generate two random ints (same behaviour as for floats)
 template <>
-inline rocblas_float_complex random_generator<rocblas_float_complex>()
+inline rocblas_float_complex
+    random_generator<rocblas_float_complex>(const rocblas_random_bits& bits)
 {
-    return {float(rocblas_uniform_int_1_10()), float(rocblas_uniform_int_1_10())};
+    return {float(rocblas_uniform_int(bits.w[0], 1, 10)),
+            float(rocblas_uniform_int(bits.w[1], 1, 10))};
 };
 
 // for rocblas_double_complex, generate two random ints (same behaviour as for doubles)
 template <>
-inline rocblas_double_complex random_generator<rocblas_double_complex>()
+inline rocblas_double_complex
+    random_generator<rocblas_double_complex>(const rocblas_random_bits& bits)
 {
-    return {double(rocblas_uniform_int_1_10()), double(rocblas_uniform_int_1_10())};
+    return {double(rocblas_uniform_int(bits.w[0], 1, 10)),
+            double(rocblas_uniform_int(bits.w[1], 1, 10))};
 };
 
 // for rocblas_half, generate float, and convert to rocblas_half
 /*! \brief  generate a random number in range [-2,-1,0,1,2] */
 template <>
-inline rocblas_half random_generator<rocblas_half>()
+inline rocblas_half random_generator<rocblas_half>(const rocblas_random_bits& bits)
 {
-    return rocblas_half(std::uniform_int_distribution<int>(-2, 2)(t_rocblas_rng));
+    return rocblas_half(rocblas_uniform_int(bits.w[0], -2, 2));
 };
 
 // for rocblas_bfloat16, generate float, and convert to rocblas_bfloat16
 /*! \brief  generate a random number in range [-2,-1,0,1,2] */
 template <>
-inline rocblas_bfloat16 random_generator<rocblas_bfloat16>()
+inline rocblas_bfloat16 random_generator<rocblas_bfloat16>(const rocblas_random_bits& bits)
 {
-    return rocblas_bfloat16(std::uniform_int_distribution<int>(-2, 2)(t_rocblas_rng));
+    return rocblas_bfloat16(rocblas_uniform_int(bits.w[0], -2, 2));
 };
 
 /*! \brief  generate a random number in range [1,2,3] */
 template <>
-inline int8_t random_generator<int8_t>()
-{
-    return static_cast<int8_t>(std::uniform_int_distribution<unsigned short>(1, 3)(t_rocblas_rng));
-};
-
-/*! \brief  generate a sequence of random number in range [1,2,3,4,5,6,7,8,9,10] */
-template <typename T>
-inline void random_run_generator(T* ptr, size_t num)
-{
-    for(size_t i = 0; i < num; i++)
-    {
-        ptr[i] = random_generator<T>();
-    }
-}
-
-template <>
-inline void random_run_generator<float>(float* ptr, size_t num)
-{
-    rocblas_uniform_int_1_10_run_float(ptr, num);
-};
-
-template <>
-inline void random_run_generator<double>(double* ptr, size_t num)
-{
-    rocblas_uniform_int_1_10_run_double(ptr, num);
-};
-
-template <>
-inline void random_run_generator<rocblas_float_complex>(rocblas_float_complex* ptr, size_t num)
-{
-    rocblas_uniform_int_1_10_run_float_complex(ptr, num);
-};
-
-template <>
-inline void random_run_generator<rocblas_double_complex>(rocblas_double_complex* ptr, size_t num)
+inline int8_t random_generator<int8_t>(const rocblas_random_bits& bits)
 {
-    rocblas_uniform_int_1_10_run_double_complex(ptr, num);
+    return static_cast<int8_t>(rocblas_uniform_int(bits.w[0], 1, 3));
 };
 
 // HPL
 
 /*! \brief  generate a random number in HPL-like [-0.5,0.5] doubles  */
 template <typename T>
-inline T random_hpl_generator()
+inline T random_hpl_generator(const rocblas_random_bits& bits)
 {
-    return std::uniform_real_distribution<double>(-0.5, 0.5)(t_rocblas_rng);
+    return rocblas_uniform_real(bits.w[0], bits.w[1], -0.5, 0.5);
 }
 
 // for rocblas_bfloat16, generate float, and convert to rocblas_bfloat16
 /*! \brief  generate a random number in HPL-like [-0.5,0.5] doubles  */
 template <>
-inline rocblas_bfloat16 random_hpl_generator()
+inline rocblas_bfloat16 random_hpl_generator(const rocblas_random_bits& bits)
 {
-    return rocblas_bfloat16(std::uniform_real_distribution<float>(-0.5, 0.5)(t_rocblas_rng));
+    return rocblas_bfloat16(float(rocblas_uniform_real(bits.w[0], bits.w[1], -0.5, 0.5)));
 }
 
 /*! \brief  generate a random ASCII string of up to length n */
@@ -0,0 +1,122 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas_arguments.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*******************************************************************************
+ * rocblas_ref_cache stores the results of CPU reference computations on disk, *
+ * so that tests which are run again with the same inputs read them instead    *
+ * of calling cblas. It is enabled by setting ROCBLAS_REF_CACHE to a           *
+ * directory. The results are keyed by the Arguments which affect them, the    *
+ * state of the random number generator when the test starts, the version of  *
+ * the input initialization and references, and the identity of the reference *
+ * BLAS library. Files are run-length encoded, and the least recently used are *
+ * removed when the directory holds more than ROCBLAS_REF_CACHE_SIZE megabytes *
+ * (4096 by default). Tests run on threads other than the main thread, whose   *
+ * random seeds differ between runs, and timed runs, which report the time of  *
+ * the CPU reference, are not cached.                                          *
+ *******************************************************************************/
+// Version of the cached results, which must be incremented whenever the initialization of the
+// inputs or a CPU reference changes the results computed for the same Arguments
+constexpr int ROCBLAS_REF_CACHE_VERSION = 1;
+
+class rocblas_ref_cache
+{
+    using span = std::pair<void*, size_t>;
+
+    std::string m_file; // empty when the cache is disabled
+    uint64_t    m_check; // second hash of the key, stored in the file to detect collisions
+
+    template <typename U, typename = void>
+    struct has_lda : std::false_type
+    {
+    };
+
+    template <typename U>
+    struct has_lda<U, std::void_t<decltype(std::declval<U&>().lda())>> : std::true_type
+    {
+    };
+
+    // Add the storage of each batch of a host vector or matrix to spans
+    template <typename U>
+    static void add_spans(std::vector<span>& spans, U& x)
+    {
+        if constexpr(std::is_pointer<std::decay_t<decltype(x[0])>>{})
+        {
+            size_t size = x.n() * sizeof(*x[0]);
+            if constexpr(has_lda<U>{})
+                size *= x.lda();
+            else
+                size *= std::abs(x.inc());
+            for(rocblas_int b = 0; b < x.batch_count(); b++)
+                spans.emplace_back(x[b], size);
+        }
+        else
+            spans.emplace_back(x.data(), x.size() * sizeof(x[0])); // host_vector
+    }
+
+    bool load_spans(const std::vector<span>& spans) const;
+    void store_spans(const std::vector<span>& spans) const;
+
+public:
+    // Key the results of the test described by arg. This must be constructed before the
+    // inputs are initialized.
+    explicit rocblas_ref_cache(const Arguments& arg);
+
+    // Read the cached results into the host vectors and matrices outputs. Returns false,
+    // leaving the outputs unchanged, if they are not in the cache.
+    template <typename... U>
+    bool load(U&... outputs) const
+    {
+        if(m_file.empty())
+            return false;
+        std::vector<span> spans;
+        (add_spans(spans, outputs), ...);
+        return load_spans(spans);
+    }
+
+    // Write the results in outputs to the cache
+    template <typename... U>
+    void store(U&... outputs) const
+    {
+        if(m_file.empty())
+            return;
+        std::vector<span> spans;
+        (add_spans(spans, outputs), ...);
+        store_spans(spans);
+    }
+
+    // Append the run-length encoding of the size bytes at data to out
+    static void encode(std::string& out, const void* data, size_t size);
+
+    // Decode size bytes from in at pos into data, advancing pos, or only check that they can
+    // be decoded if data is nullptr. Returns false if in is too short.
+    static bool decode(const std::string& in, size_t& pos, void* data, size_t size);
+};
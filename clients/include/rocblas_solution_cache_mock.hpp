@@ -0,0 +1,96 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "../../library/src/include/rocblas_solution_cache.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ * A mock of the Tensile solution library for testing rocblas_solution_cache   *
+ * without a device, shared by rocblas-test and rocblas-alloc-test             *
+ *******************************************************************************/
+
+// Solution returned by the mock solution library
+struct mock_solution
+{
+    size_t index;
+    size_t workspace_size;
+};
+
+// Mock solution library which makes a deterministic selection depending on every field
+// of the signature, and counts the number of selections it performs. The problem it was
+// selected for is a copy of the signature.
+struct mock_solution_library
+{
+    std::atomic<size_t> selections{0};
+
+    rocblas_solution_cache_entry findBestSolution(const rocblas_solution_signature& sig)
+    {
+        ++selections;
+        size_t h   = rocblas_solution_signature_hash{}(sig);
+        auto   sol = std::make_shared<mock_solution>(mock_solution{h % 997, (h >> 16) % 4096});
+        return {sol,
+                std::make_shared<rocblas_solution_signature>(sig),
+                sol->workspace_size,
+                h % 3 != 0};
+    }
+};
+
+// Same selection logic as runContractionProblem()
+inline rocblas_solution_cache_entry select_solution(rocblas_solution_cache&           cache,
+                                                    mock_solution_library&            library,
+                                                    const rocblas_solution_signature& sig)
+{
+    rocblas_solution_cache_entry entry;
+    bool                         use_cache = cache.enabled();
+    if(use_cache && cache.find(sig, entry))
+        return entry;
+    entry = library.findBestSolution(sig);
+    if(use_cache)
+        cache.insert(sig, entry);
+    return entry;
+}
+
+// A set of distinct problem shapes
+inline std::vector<rocblas_solution_signature> make_signatures(size_t count)
+{
+    std::vector<rocblas_solution_signature> sigs(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        auto& sig        = sigs[i];
+        sig.arch         = 910;
+        sig.cu_count     = 104;
+        sig.trans_b      = i & 1;
+        sig.m            = 64 * (i % 7 + 1);
+        sig.n            = 32 * (i / 7 + 1);
+        sig.k            = 128;
+        sig.batch_count  = 1;
+        sig.col_stride_a = sig.m;
+        sig.col_stride_b = sig.k;
+        sig.col_stride_c = sig.m;
+        sig.col_stride_d = sig.m;
+    }
+    return sigs;
+}
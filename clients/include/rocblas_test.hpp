@@ -159,16 +159,17 @@ bool match_test_category(const Arguments& arg, const char* category);
 // The tests are instantiated by filtering through the RocBLAS_Data stream
 // The filter is by category and by the type_filter() and function_filter()
 // functions in the testclass
-#define INSTANTIATE_TEST_CATEGORY(testclass, category)                                            \
-    INSTANTIATE_TEST_SUITE_P(category,                                                            \
-                             testclass,                                                           \
-                             testing::ValuesIn(RocBLAS_TestData::begin([](const Arguments& arg) { \
-                                                   return match_test_category(arg, #category)     \
-                                                          && testclass::function_filter(arg)      \
-                                                          && testclass::type_filter(arg);         \
-                                               }),                                                \
-                                               RocBLAS_TestData::end()),                          \
-                             testclass::PrintToStringParamName());
+#define INSTANTIATE_TEST_CATEGORY(testclass, category)                               \
+    INSTANTIATE_TEST_SUITE_P(                                                        \
+        category,                                                                    \
+        testclass,                                                                   \
+        testing::ValuesIn(RocBLAS_TestData::begin_indexed([](const Arguments& arg) { \
+                              return match_test_category(arg, #category)             \
+                                     && testclass::function_filter(arg)              \
+                                     && testclass::type_filter(arg);                 \
+                          }),                                                        \
+                          RocBLAS_TestData::end()),                                  \
+        testclass::PrintToStringParamName());
 
 #if defined(GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST)
 #define ROCBLAS_ALLOW_UNINSTANTIATED_GTEST(testclass) \
@@ -0,0 +1,135 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+ * rocblas_yaml_expander expands a rocBLAS YAML test data file into binary     *
+ * Arguments records. It implements the same semantics as rocblas_gentest.py   *
+ * (include: lines, Datatypes, Arguments, Defaults, Functions, Known bugs,     *
+ * dictionary lists, integer ranges and lists) and produces byte-identical     *
+ * output, but generates the records one at a time, as they are requested.    *
+ * Errors in the YAML file throw rocblas_yaml_error.                           *
+ *******************************************************************************/
+class rocblas_yaml_error : public std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+class rocblas_yaml_expander
+{
+    struct impl;
+    std::unique_ptr<impl> m_impl;
+
+public:
+    // Read yaml_file, preceded by template_file if it is not empty. include: lines are
+    // resolved relative to the including file, and then relative to include_dirs. The
+    // source is parsed by the first call to next().
+    explicit rocblas_yaml_expander(const std::string&              yaml_file,
+                                   const std::vector<std::string>& include_dirs  = {},
+                                   const std::string&              template_file = "");
+
+    ~rocblas_yaml_expander();
+
+    rocblas_yaml_expander(const rocblas_yaml_expander&) = delete;
+    rocblas_yaml_expander& operator=(const rocblas_yaml_expander&) = delete;
+
+    // Key which identifies the records generated from the source by this build of the expander
+    const std::string& key() const;
+
+    // Append the next distinct record to out, preceded by the file signature if it is the
+    // first record. Returns false when all of the records have been generated.
+    bool next(std::string& out);
+};
+
+/*******************************************************************************
+ * rocblas_yaml_istream reads the records of a YAML file as a binary test data *
+ * stream, expanding them as they are read. The records already read are kept *
+ * so that the stream can be rewound with seekg() without expanding it again. *
+ * Errors in the YAML file are printed and exit the program, as with           *
+ * rocblas_gentest.py.                                                         *
+ *                                                                             *
+ * If cache_dir is not empty, the records are read from the file named by the *
+ * expander's key in cache_dir if it exists, and otherwise are written to it  *
+ * once they have all been expanded. from_cache() tells whether they were    *
+ * read from the cache.                                                       *
+ *******************************************************************************/
+class rocblas_yaml_istream : public std::istream
+{
+    class streambuf : public std::streambuf
+    {
+        rocblas_yaml_expander m_expander;
+        std::string           m_data;
+        bool                  m_done   = false;
+        bool                  m_cached = false;
+        std::string           m_cache_file;
+
+        // Expand records until at least size bytes are available, or there are no more
+        void expand(size_t size);
+
+        // Write all of the records to m_cache_file
+        void store_cache();
+
+    protected:
+        int_type underflow() override;
+        pos_type seekoff(off_type                off,
+                         std::ios_base::seekdir  dir,
+                         std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+    public:
+        streambuf(const std::string&              yaml_file,
+                  const std::vector<std::string>& include_dirs,
+                  const std::string&              template_file,
+                  const std::string&              cache_dir);
+
+        bool from_cache() const
+        {
+            return m_cached;
+        }
+    };
+
+    std::unique_ptr<streambuf> m_buf;
+
+public:
+    explicit rocblas_yaml_istream(const std::string&              yaml_file,
+                                  const std::vector<std::string>& include_dirs  = {},
+                                  const std::string&              template_file = "",
+                                  const std::string&              cache_dir     = "");
+
+    // Whether the records were read from the cache instead of being expanded
+    bool from_cache() const
+    {
+        return m_buf->from_cache();
+    }
+};
+
+// Directory of the cache of expanded YAML files: ROCBLAS_TEST_DATA_CACHE, or empty if it is
+// not set, in which case nothing is cached.
+std::string rocblas_yaml_cache_dir();
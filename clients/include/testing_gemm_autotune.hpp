@@ -0,0 +1,397 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#define ROCBLAS_NO_DEPRECATED_WARNINGS
+#define ROCBLAS_BETA_FEATURES_API
+#include "../../library/src/include/rocblas_gemm_override.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_matrix.hpp"
+#include "rocblas_test.hpp"
+#include "type_dispatch.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/* ============================================================================================ */
+/*  Offline GEMM autotuning: time every Tensile solution of each problem, and write the fastest */
+/*  to a file of overrides which the library reads from ROCBLAS_GEMM_OVERRIDE_PATH.             */
+/* ============================================================================================ */
+
+// Statistics of the times of one solution, in microseconds
+struct gemm_autotune_stats
+{
+    double median = 0, mean = 0, stddev = 0, min = 0;
+
+    explicit gemm_autotune_stats(std::vector<double> times)
+    {
+        if(times.empty())
+            return;
+        std::sort(times.begin(), times.end());
+        size_t n = times.size();
+        median   = n % 2 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+        min      = times[0];
+        for(double t : times)
+            mean += t;
+        mean /= n;
+        for(double t : times)
+            stddev += (t - mean) * (t - mean);
+        stddev = std::sqrt(stddev / n);
+    }
+};
+
+/* ============================================================================================ */
+/*  Read GEMM problems from CSV. The header row names the Arguments fields of the columns, of  */
+/*  transA, transB, M, N, K, lda, ldb, ldc, ldd, stride_a, stride_b, stride_c, stride_d,       */
+/*  batch_count, alpha, beta, precision, a_type, b_type, c_type, d_type and compute_type.      */
+/*  Fields without a column keep their values in defaults.                                     */
+/* ============================================================================================ */
+inline std::vector<Arguments> gemm_autotune_read_csv(std::istream& is, const Arguments& defaults)
+{
+    using setter = std::function<void(Arguments&, const std::string&)>;
+
+    auto set_type = [](rocblas_datatype Arguments::*field) -> setter {
+        return [=](Arguments& arg, const std::string& value) {
+            arg.*field = string2rocblas_datatype(value);
+            if(arg.*field == rocblas_datatype_invalid)
+                throw std::invalid_argument("Invalid datatype " + value);
+        };
+    };
+
+    const std::map<std::string, setter> setters = {
+        {"transA", [](Arguments& arg, const std::string& v) { arg.transA = v.at(0); }},
+        {"transB", [](Arguments& arg, const std::string& v) { arg.transB = v.at(0); }},
+        {"M", [](Arguments& arg, const std::string& v) { arg.M = std::stoi(v); }},
+        {"N", [](Arguments& arg, const std::string& v) { arg.N = std::stoi(v); }},
+        {"K", [](Arguments& arg, const std::string& v) { arg.K = std::stoi(v); }},
+        {"lda", [](Arguments& arg, const std::string& v) { arg.lda = std::stoi(v); }},
+        {"ldb", [](Arguments& arg, const std::string& v) { arg.ldb = std::stoi(v); }},
+        {"ldc", [](Arguments& arg, const std::string& v) { arg.ldc = std::stoi(v); }},
+        {"ldd", [](Arguments& arg, const std::string& v) { arg.ldd = std::stoi(v); }},
+        {"stride_a", [](Arguments& arg, const std::string& v) { arg.stride_a = std::stoll(v); }},
+        {"stride_b", [](Arguments& arg, const std::string& v) { arg.stride_b = std::stoll(v); }},
+        {"stride_c", [](Arguments& arg, const std::string& v) { arg.stride_c = std::stoll(v); }},
+        {"stride_d", [](Arguments& arg, const std::string& v) { arg.stride_d = std::stoll(v); }},
+        {"batch_count",
+         [](Arguments& arg, const std::string& v) { arg.batch_count = std::stoi(v); }},
+        {"alpha", [](Arguments& arg, const std::string& v) { arg.alpha = std::stod(v); }},
+        {"beta", [](Arguments& arg, const std::string& v) { arg.beta = std::stod(v); }},
+        {"precision",
+         [](Arguments& arg, const std::string& v) {
+             rocblas_datatype type = string2rocblas_datatype(v);
+             if(type == rocblas_datatype_invalid)
+                 throw std::invalid_argument("Invalid datatype " + v);
+             arg.a_type = arg.b_type = arg.c_type = arg.d_type = arg.compute_type = type;
+         }},
+        {"a_type", set_type(&Arguments::a_type)},
+        {"b_type", set_type(&Arguments::b_type)},
+        {"c_type", set_type(&Arguments::c_type)},
+        {"d_type", set_type(&Arguments::d_type)},
+        {"compute_type", set_type(&Arguments::compute_type)},
+    };
+
+    auto split = [](const std::string& line) {
+        std::vector<std::string> fields;
+        std::istringstream       in(line);
+        for(std::string field; std::getline(in, field, ',');)
+        {
+            field.erase(0, field.find_first_not_of(" \t"));
+            field.erase(field.find_last_not_of(" \t\r") + 1);
+            fields.push_back(field);
+        }
+        return fields;
+    };
+
+    std::vector<const setter*> columns;
+    std::vector<Arguments>     problems;
+
+    for(std::string line; std::getline(is, line);)
+    {
+        if(line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#')
+            continue;
+
+        auto fields = split(line);
+        if(columns.empty())
+        {
+            for(const auto& name : fields)
+            {
+                auto it = setters.find(name);
+                if(it == setters.end())
+                    throw std::invalid_argument("Unknown GEMM problem column " + name);
+                columns.push_back(&it->second);
+            }
+            continue;
+        }
+
+        if(fields.size() != columns.size())
+            throw std::invalid_argument("Wrong number of columns in GEMM problem: " + line);
+
+        Arguments arg = defaults;
+        for(size_t i = 0; i < fields.size(); ++i)
+            (*columns[i])(arg, fields[i]);
+        problems.push_back(arg);
+    }
+
+    return problems;
+}
+
+/* ============================================================================================ */
+/*  Time the default selection and every solution of one problem with strided_batched_ex, and  */
+/*  return the fastest solution by median time, or 0 if none is faster than the default.      */
+/*  Each solution is run cold_iters times, then timed iters times.                             */
+/* ============================================================================================ */
+// The key of a tuned problem, and its fastest solution
+struct gemm_autotune_result
+{
+    rocblas_gemm_override_key key;
+    rocblas_int               solution;
+};
+
+template <typename Ti, typename To = Ti, typename Tc = To>
+gemm_autotune_result testing_gemm_autotune(const Arguments& arg)
+{
+    const rocblas_operation transA = char2rocblas_operation(arg.transA);
+    const rocblas_operation transB = char2rocblas_operation(arg.transB);
+    const rocblas_int       M = arg.M, N = arg.N, K = arg.K;
+    const rocblas_int       batch_count = std::max(arg.batch_count, 1);
+    const rocblas_int       lda = arg.lda, ldb = arg.ldb, ldc = arg.ldc;
+    const rocblas_int       ldd = arg.c_noalias_d ? arg.ldd : ldc;
+
+    const rocblas_int A_row = transA == rocblas_operation_none ? M : std::max(K, 1);
+    const rocblas_int A_col = transA == rocblas_operation_none ? std::max(K, 1) : M;
+    const rocblas_int B_row = transB == rocblas_operation_none ? std::max(K, 1) : N;
+    const rocblas_int B_col = transB == rocblas_operation_none ? N : std::max(K, 1);
+
+    if(M <= 0 || N <= 0 || K < 0 || lda < A_row || ldb < B_row || ldc < M || ldd < M)
+        throw std::invalid_argument("Invalid GEMM problem size for --autotune");
+
+    // Strides too small for the matrices are replaced by the matrix sizes
+    const rocblas_stride stride_a = std::max(arg.stride_a, rocblas_stride(lda) * A_col);
+    const rocblas_stride stride_b = std::max(arg.stride_b, rocblas_stride(ldb) * B_col);
+    const rocblas_stride stride_c = std::max(arg.stride_c, rocblas_stride(ldc) * N);
+    const rocblas_stride stride_d = std::max(arg.stride_d, rocblas_stride(ldd) * N);
+
+    gemm_autotune_result result{};
+    result.key.a_type       = arg.a_type;
+    result.key.c_type       = arg.c_type;
+    result.key.compute_type = arg.compute_type;
+    result.key.trans_a      = transA;
+    result.key.trans_b      = transB;
+    result.key.m            = M;
+    result.key.n            = N;
+    result.key.k            = K;
+    result.key.lda          = lda;
+    result.key.ldb          = ldb;
+    result.key.ldc          = ldc;
+    result.key.ldd          = ldd;
+    result.key.batch_count  = batch_count;
+
+    const Tc alpha = arg.get_alpha<Tc>();
+    const Tc beta  = arg.get_beta<Tc>();
+
+    rocblas_local_handle handle{arg};
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+
+    hipStream_t stream;
+    CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+
+    host_strided_batch_matrix<Ti>   hA(A_row, A_col, lda, stride_a, batch_count);
+    host_strided_batch_matrix<Ti>   hB(B_row, B_col, ldb, stride_b, batch_count);
+    host_strided_batch_matrix<To>   hC(M, N, ldc, stride_c, batch_count);
+    device_strided_batch_matrix<Ti> dA(A_row, A_col, lda, stride_a, batch_count);
+    device_strided_batch_matrix<Ti> dB(B_row, B_col, ldb, stride_b, batch_count);
+    device_strided_batch_matrix<To> dC(M, N, ldc, stride_c, batch_count);
+    device_strided_batch_matrix<To> dD
+        = arg.c_noalias_d ? device_strided_batch_matrix<To>(M, N, ldd, stride_d, batch_count)
+                          : device_strided_batch_matrix<To>(0, 1, 1, 1, 1);
+    device_strided_batch_matrix<To>& dDref = arg.c_noalias_d ? dD : dC;
+
+    CHECK_HIP_ERROR(hA.memcheck());
+    CHECK_HIP_ERROR(hB.memcheck());
+    CHECK_HIP_ERROR(hC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+
+    rocblas_init_matrix<Ti>(
+        hA, arg, rocblas_client_never_set_nan, rocblas_client_general_matrix, true);
+    rocblas_init_matrix<Ti>(
+        hB, arg, rocblas_client_never_set_nan, rocblas_client_general_matrix, false, true);
+    rocblas_init_matrix<To>(hC, arg, rocblas_client_never_set_nan, rocblas_client_general_matrix);
+
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+    CHECK_HIP_ERROR(dC.transfer_from(hC));
+
+#define GEMM_AUTOTUNE_ARGS                                                                   \
+    handle, transA, transB, M, N, K, &alpha, dA, arg.a_type, lda, stride_a, dB, arg.b_type, \
+        ldb, stride_b, &beta, dC, arg.c_type, ldc, stride_c, dDref, arg.d_type, ldd,         \
+        stride_d, batch_count, arg.compute_type, rocblas_gemm_algo_solution_index
+#define rocblas_gemm_strided_batched_exM(...) rocblas_gemm_strided_batched_ex(__VA_ARGS__)
+
+    rocblas_int size = 0;
+    CHECK_ROCBLAS_ERROR(rocblas_gemm_strided_batched_ex_get_solutions(
+        GEMM_AUTOTUNE_ARGS, arg.flags, nullptr, &size));
+    std::vector<rocblas_int> solutions(size);
+    CHECK_ROCBLAS_ERROR(rocblas_gemm_strided_batched_ex_get_solutions(
+        GEMM_AUTOTUNE_ARGS, arg.flags, solutions.data(), &size));
+    solutions.resize(size);
+
+    // Solution 0 is the library's own selection
+    solutions.insert(solutions.begin(), 0);
+
+    hipEvent_t start, stop;
+    CHECK_HIP_ERROR(hipEventCreate(&start));
+    CHECK_HIP_ERROR(hipEventCreate(&stop));
+
+    double best_median = 0;
+
+    for(rocblas_int solution : solutions)
+    {
+        auto gemm = [&] {
+            return rocblas_gemm_strided_batched_exM(GEMM_AUTOTUNE_ARGS, solution, arg.flags);
+        };
+
+        // Solutions which fail, such as ones which need more workspace, are skipped
+        if(gemm() != rocblas_status_success)
+            continue;
+
+        for(int i = 1; i < arg.cold_iters; i++)
+            CHECK_ROCBLAS_ERROR(gemm());
+
+        std::vector<double> times;
+        for(int i = 0; i < std::max(arg.iters, 1); i++)
+        {
+            float ms = 0;
+            CHECK_HIP_ERROR(hipEventRecord(start, stream));
+            CHECK_ROCBLAS_ERROR(gemm());
+            CHECK_HIP_ERROR(hipEventRecord(stop, stream));
+            CHECK_HIP_ERROR(hipEventSynchronize(stop));
+            CHECK_HIP_ERROR(hipEventElapsedTime(&ms, start, stop));
+            times.push_back(ms * 1000.0);
+        }
+
+        gemm_autotune_stats stats(std::move(times));
+        rocblas_cout << arg.transA << ',' << arg.transB << ',' << M << ',' << N << ',' << K << ','
+                     << lda << ',' << ldb << ',' << ldc << ',' << ldd << ',' << batch_count << ','
+                     << rocblas_datatype2string(arg.a_type) << ','
+                     << rocblas_datatype2string(arg.c_type) << ','
+                     << rocblas_datatype2string(arg.compute_type) << ',' << solution << ','
+                     << stats.median << ',' << stats.mean << ',' << stats.stddev << ','
+                     << stats.min << std::endl;
+
+        // Ties keep the default selection
+        if(solution == 0 || stats.median < best_median)
+        {
+            result.solution = solution;
+            best_median     = stats.median;
+        }
+    }
+
+#undef GEMM_AUTOTUNE_ARGS
+#undef rocblas_gemm_strided_batched_exM
+
+    CHECK_HIP_ERROR(hipEventDestroy(start));
+    CHECK_HIP_ERROR(hipEventDestroy(stop));
+
+    return result;
+}
+
+template <typename Ti, typename To = Ti, typename Tc = To, typename = void>
+struct gemm_autotune_testing
+{
+    gemm_autotune_result operator()(const Arguments& arg)
+    {
+        throw std::invalid_argument(std::string("Invalid types for --autotune of ")
+                                    + arg.function);
+    }
+};
+
+template <typename Ti, typename To, typename Tc>
+struct gemm_autotune_testing<Ti, To, Tc, std::enable_if_t<!std::is_same<Ti, void>{}>>
+{
+    gemm_autotune_result operator()(const Arguments& arg)
+    {
+        return testing_gemm_autotune<Ti, To, Tc>(arg);
+    }
+};
+
+/* ============================================================================================ */
+/*  Tune each GEMM problem, and write the fastest solutions for the current architecture to    */
+/*  path. If path already holds overrides, they are updated, so that tuning runs on several    */
+/*  architectures or problem lists can be collected in one file.                               */
+/* ============================================================================================ */
+inline void testing_gemm_autotune(const std::vector<Arguments>& problems, const std::string& path)
+{
+    const std::string arch = rocblas_internal_get_arch_name();
+
+    rocblas_gemm_override_db db;
+    {
+        std::ifstream is(path);
+        if(is && !rocblas_gemm_overrides_read(is, db))
+            throw std::invalid_argument("Invalid GEMM override file " + path);
+    }
+    auto& table = db.archs[arch];
+
+    rocblas_cout << "transA,transB,M,N,K,lda,ldb,ldc,ldd,batch_count,a_type,c_type,compute_type,"
+                    "solution,median_us,mean_us,stddev_us,min_us"
+                 << std::endl;
+
+    size_t tuned = 0;
+    for(const Arguments& arg : problems)
+    {
+        if(!strstr(arg.function, "gemm") || strstr(arg.function, "_bad_arg"))
+        {
+            rocblas_cerr << "Skipping " << arg.function << ", which is not a GEMM" << std::endl;
+            continue;
+        }
+
+        auto result = rocblas_gemm_dispatch<gemm_autotune_testing>(arg);
+
+        // A problem whose default selection is fastest has no override
+        if(result.solution > 0)
+        {
+            table[result.key] = result.solution;
+            ++tuned;
+        }
+        else
+            table.erase(result.key);
+    }
+
+    std::ofstream os(path);
+    rocblas_gemm_overrides_write(os, db);
+    if(!os.flush())
+        throw std::invalid_argument("Cannot write GEMM override file " + path);
+
+    rocblas_cout << "Wrote " << tuned << " GEMM overrides for " << arch << " to " << path
+                 << "; set ROCBLAS_GEMM_OVERRIDE_PATH to this file to use them" << std::endl;
+}
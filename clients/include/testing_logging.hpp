@@ -23,15 +23,19 @@
 #pragma once
 
 #include "cblas_interface.hpp"
+#include "rocblas_binary_log.hpp"
 #include "rocblas.hpp"
 #include "rocblas_math.hpp"
 #include "rocblas_test.hpp"
 #include "rocblas_vector.hpp"
+#include "type_dispatch.hpp"
 #include "utility.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <sstream>
 #ifdef WIN32
 #include <stdlib.h>
 #define setenv(A, B, C) _putenv_s(A, B)
@@ -1198,3 +1202,232 @@ void testing_logging(const Arguments& arg)
         }
     }
 }
+
+// decodes the trace and bench records of a binary log, which may not exist yet
+static void decode_binary_log(const std::string&        path,
+                              rocblas_internal_ostream& trace,
+                              rocblas_internal_ostream& bench)
+{
+    rocblas_binary_log_summary summary;
+    std::ifstream              trace_in(path, std::ios::binary);
+    std::ifstream              bench_in(path, std::ios::binary);
+    if(trace_in && bench_in)
+    {
+        rocblas_binary_log_decode(trace_in, rocblas_binary_log_kind::trace, trace, false, summary);
+        rocblas_binary_log_decode(bench_in, rocblas_binary_log_kind::bench, bench, false, summary);
+    }
+}
+
+template <typename T>
+void testing_logging_binary(const Arguments& arg)
+{
+    // ROCBLAS_LAYER = 11 turns on log_trace and log_bench, written to the binary log.
+    // The binary log file is opened once per process, so all runs of this test share it
+    // and compare only the records they add.
+    static std::string binary_path = rocblas_tempname() + "_binary.bin";
+
+    int setenv_status = setenv("ROCBLAS_LOG_BINARY_PATH", binary_path.c_str(), true);
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(setenv_status, 0);
+#endif
+
+    rocblas_binary_log_flush();
+    rocblas_internal_ostream trace_before, bench_before;
+    decode_binary_log(binary_path, trace_before, bench_before);
+
+    rocblas_int n     = 1;
+    rocblas_int incx  = 1;
+    rocblas_int incy  = 1;
+    T           alpha = 1.0;
+
+    device_vector<T> dx(n * incx);
+    device_vector<T> dy(n * incy);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+
+    setenv_status = setenv("ROCBLAS_LAYER", "11", true);
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(setenv_status, 0);
+#endif
+
+    // enclose in {} so rocblas_local_handle destructor called as it goes out of scope
+    {
+        rocblas_local_handle handle;
+
+        rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host);
+        rocblas_axpy<T>(handle, n, &alpha, dx, incx, dy, incy);
+        rocblas_scal<T>(handle, n, &alpha, dx, incx);
+    }
+
+    setenv_status = setenv("ROCBLAS_LAYER", "0", true);
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(setenv_status, 0);
+#endif
+
+    // The decoded records must match the text of log_trace and log_bench
+    rocblas_internal_ostream trace_expected, bench_expected;
+    trace_expected << trace_before << "rocblas_create_handle,atomics_allowed\n"
+                   << "rocblas_set_pointer_mode,0,atomics_allowed\n"
+                   << replaceX<T>("rocblas_Xaxpy") << "," << n << "," << alpha << ","
+                   << (void*)dx << "," << incx << "," << (void*)dy << "," << incy
+                   << ",atomics_allowed\n"
+                   << replaceX<T>("rocblas_Xscal") << "," << n << "," << alpha << ","
+                   << (void*)dx << "," << incx << ",atomics_allowed\n"
+                   << "rocblas_destroy_handle,atomics_allowed\n";
+    bench_expected << bench_before << "./rocblas-bench -f axpy -r " << rocblas_precision_string<T>
+                   << " -n " << n << " --alpha " << alpha << " --incx " << incx << " --incy "
+                   << incy << "\n"
+                   << "./rocblas-bench -f scal --a_type " << rocblas_precision_string<T>
+                   << " --b_type " << rocblas_precision_string<T> << " -n " << n << " --alpha "
+                   << alpha << " --incx " << incx << "\n";
+
+    rocblas_binary_log_flush();
+    rocblas_internal_ostream trace_after, bench_after;
+    decode_binary_log(binary_path, trace_after, bench_after);
+
+#ifdef GOOGLE_TEST
+    EXPECT_EQ(trace_after.str(), trace_expected.str());
+    EXPECT_EQ(bench_after.str(), bench_expected.str());
+#endif
+}
+
+// Call count of a function and its data types in a latency histogram CSV file, or 0 if it has
+// no row. The types are separated by spaces, and are empty for functions without type arguments.
+static uint64_t latency_call_count(const std::string& path,
+                                   const std::string& func,
+                                   const std::string& types = "")
+{
+    std::string   key = func + "," + types + ",";
+    std::ifstream is(path);
+    for(std::string line; std::getline(is, line);)
+        if(!line.compare(0, key.size(), key))
+            return std::stoull(line.substr(key.size()));
+    return 0;
+}
+
+// Total recorded time in ns of a function without type arguments in a latency histogram CSV
+// file, from its call count and mean, or 0 if it has no row
+static double latency_total_ns(const std::string& path, const std::string& func)
+{
+    std::string   key = func + ",,";
+    std::ifstream is(path);
+    for(std::string line; std::getline(is, line);)
+        if(!line.compare(0, key.size(), key))
+        {
+            // count,min_ns,mean_ns,...
+            std::istringstream row(line.substr(key.size()));
+            uint64_t           count, min_ns, mean_ns;
+            char               sep;
+            row >> count >> sep >> min_ns >> sep >> mean_ns;
+            return double(count) * mean_ns;
+        }
+    return 0;
+}
+
+template <typename T>
+void testing_logging_latency(const Arguments& arg)
+{
+    // ROCBLAS_LAYER = 16 turns on latency logging. The histograms are kept for the whole
+    // process, so this compares the call counts before and after the calls made here.
+    std::string   latency_path = rocblas_tempname() + "_latency.csv";
+    std::string   func         = replaceX<T>("rocblas_Xaxpy");
+    std::string   symv_func    = replaceX<T>("rocblas_Xsymv");
+    constexpr int calls        = 10;
+
+    // axpy_ex has a histogram per combination of its 4 data types, so its calls in this
+    // precision are not counted in the histogram of the other precision
+    using T_other = std::conditional_t<std::is_same<T, float>{}, double, float>;
+    auto ex_types = [](rocblas_datatype type) {
+        std::string name = rocblas_datatype_string(type);
+        return name + " " + name + " " + name + " " + name;
+    };
+    constexpr auto type        = rocblas_type2datatype<T>();
+    std::string    types       = ex_types(type);
+    std::string    other_types = ex_types(rocblas_type2datatype<T_other>());
+
+    rocblas_status write_status = rocblas_write_latency_histograms(latency_path.c_str());
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(write_status, rocblas_status_success);
+#endif
+    uint64_t count_before       = latency_call_count(latency_path, func);
+    uint64_t ex_count_before    = latency_call_count(latency_path, "rocblas_axpy_ex", types);
+    uint64_t other_count_before = latency_call_count(latency_path, "rocblas_axpy_ex", other_types);
+    double   symv_total_before  = latency_total_ns(latency_path, symv_func);
+
+    rocblas_int n     = 1;
+    rocblas_int incx  = 1;
+    rocblas_int incy  = 1;
+    T           alpha = 1.0;
+    T           beta  = 1.0;
+
+    device_vector<T> dx(n * incx);
+    device_vector<T> dy(n * incy);
+    CHECK_DEVICE_ALLOCATION(dx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dy.memcheck());
+
+    rocblas_int      symv_n = 256;
+    device_vector<T> dA(size_t(symv_n) * symv_n);
+    device_vector<T> dsx(symv_n);
+    device_vector<T> dsy(symv_n);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dsx.memcheck());
+    CHECK_DEVICE_ALLOCATION(dsy.memcheck());
+    double symv_wall_ns = 0;
+
+    int setenv_status = setenv("ROCBLAS_LAYER", "16", true);
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(setenv_status, 0);
+#endif
+
+    // enclose in {} so rocblas_local_handle destructor called as it goes out of scope
+    {
+        rocblas_local_handle handle;
+
+        rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host);
+        for(int i = 0; i < calls; ++i)
+        {
+            rocblas_axpy<T>(handle, n, &alpha, dx, incx, dy, incy);
+            rocblas_axpy_ex(handle, n, &alpha, type, dx, type, incx, dy, type, incy, type);
+        }
+
+        // The recorded time covers the whole call, including the argument checks and the
+        // kernel launch, so it is most of the host time measured around the call
+        for(int i = 0; i < calls; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            rocblas_symv<T>(
+                handle, rocblas_fill_upper, symv_n, &alpha, dA, symv_n, dsx, 1, &beta, dsy, 1);
+            auto stop = std::chrono::steady_clock::now();
+            symv_wall_ns += std::chrono::duration<double, std::nano>(stop - start).count();
+        }
+    }
+
+    setenv_status = setenv("ROCBLAS_LAYER", "0", true);
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(setenv_status, 0);
+#endif
+
+    // A handle without latency logging records nothing
+    {
+        rocblas_local_handle handle;
+
+        rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host);
+        rocblas_axpy<T>(handle, n, &alpha, dx, incx, dy, incy);
+    }
+
+    write_status               = rocblas_write_latency_histograms(latency_path.c_str());
+    uint64_t count_after       = latency_call_count(latency_path, func);
+    uint64_t ex_count_after    = latency_call_count(latency_path, "rocblas_axpy_ex", types);
+    uint64_t other_count_after = latency_call_count(latency_path, "rocblas_axpy_ex", other_types);
+    double   symv_recorded_ns  = latency_total_ns(latency_path, symv_func) - symv_total_before;
+
+#ifdef GOOGLE_TEST
+    ASSERT_EQ(write_status, rocblas_status_success);
+    EXPECT_EQ(count_after - count_before, uint64_t(calls));
+    EXPECT_EQ(ex_count_after - ex_count_before, uint64_t(calls));
+    EXPECT_EQ(other_count_after, other_count_before);
+    EXPECT_GE(symv_recorded_ns, symv_wall_ns / 2);
+#endif
+
+    fs::remove(latency_path);
+}
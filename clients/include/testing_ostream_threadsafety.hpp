@@ -153,3 +153,70 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
         fs::remove(path);
     }
 }
+
+// Throughput of many threads writing short messages to one file through rocblas_internal_ostream
+inline void testing_ostream_throughput(const Arguments& arg)
+{
+    constexpr size_t NLINES = 20000; // Number of lines each thread outputs
+    constexpr size_t LEN    = 100; // Length of each line, including the newline
+
+    const std::string line(LEN - 1, 'x');
+
+    rocblas_cout << "threads,messages_per_sec,MB_per_sec" << std::endl;
+
+    for(size_t nthread : {1, 4, 16, 64})
+    {
+        fs::path path = fs::temp_directory_path()
+                        / ("rocblas-throughput-" + std::to_string(nthread) + ".txt");
+        int fd = OPEN(path.generic_string().c_str());
+        if(fd == -1)
+        {
+            FAIL() << "Cannot open temporary file " << path;
+            return;
+        }
+
+        // Each thread flushes every line as a separate message
+        auto thread_func = [&] {
+            rocblas_internal_ostream os(fd);
+            for(size_t i = 0; i < NLINES; ++i)
+                os << line << std::endl;
+        };
+
+        double start = get_time_us_no_sync();
+
+        std::vector<std::thread> threads;
+        for(size_t t = 0; t < nthread; ++t)
+            threads.emplace_back(thread_func);
+
+        for(auto& t : threads)
+            t.join();
+
+        double seconds = (get_time_us_no_sync() - start) * 1e-6;
+
+        if(CLOSE(fd))
+            FAIL() << "Could not close filehandle for " << path;
+
+        // Every message must have been written whole
+        size_t nlines = 0;
+        {
+            std::ifstream is(path);
+            for(std::string s; std::getline(is, s); ++nlines)
+                if(s != line)
+                {
+                    FAIL() << " detected garbled output in " << path << ":\n\n" << s << "\n";
+                    return;
+                }
+        }
+        EXPECT_EQ(nlines, nthread * NLINES);
+
+        size_t messages = nthread * NLINES;
+        rocblas_cout << nthread << "," << messages / seconds << ","
+                     << messages * LEN / seconds * 1e-6 << std::endl;
+
+#ifdef WIN32
+        // need all file descriptors closed to allow file removal on windows before process exits
+        rocblas_internal_ostream::clear_workers();
+#endif
+        fs::remove(path);
+    }
+}
@@ -0,0 +1,130 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "flops.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+/* ============================================================================================ */
+/*! \brief Times rocblas_set_matrix (HOST_TO_DEVICE) or rocblas_get_matrix alone, so that the
+    throughput of each direction is reported separately. The host matrix has leading
+    dimension lda and the device matrix has leading dimension ldc.                              */
+template <typename T, bool HOST_TO_DEVICE>
+void testing_matrix_transfer(const Arguments& arg)
+{
+    rocblas_int rows = arg.M;
+    rocblas_int cols = arg.N;
+    rocblas_int lda  = arg.lda;
+    rocblas_int ldc  = arg.ldc;
+
+    // argument sanity check, quick return if input parameters are invalid before allocating invalid
+    // memory
+    if(rows < 0 || cols < 0 || lda <= 0 || lda < rows || ldc <= 0 || ldc < rows)
+    {
+        EXPECT_ROCBLAS_STATUS(
+            HOST_TO_DEVICE ? rocblas_set_matrix(rows, cols, sizeof(T), nullptr, lda, nullptr, ldc)
+                           : rocblas_get_matrix(rows, cols, sizeof(T), nullptr, ldc, nullptr, lda),
+            rocblas_status_invalid_size);
+        return;
+    }
+
+    // Naming: dK is in GPU (device) memory. hK is in CPU (host) memory
+    host_vector<T>   ha(cols * size_t(lda));
+    host_vector<T>   hb(cols * size_t(lda));
+    device_vector<T> dc(cols * size_t(ldc));
+    CHECK_DEVICE_ALLOCATION(dc.memcheck());
+
+    double gpu_time_used, cpu_time_used = ArgumentLogging::NA_value;
+    double rocblas_error = 0.0;
+
+    rocblas_seedrand();
+    rocblas_init<T>(ha, rows, cols, lda);
+
+    auto transfer = [&] {
+        return HOST_TO_DEVICE ? rocblas_set_matrix(rows, cols, sizeof(T), ha, lda, dc, ldc)
+                              : rocblas_get_matrix(rows, cols, sizeof(T), dc, ldc, hb, lda);
+    };
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // Round trip through the device, checking that the host matrix is unchanged
+        hb = ha;
+        CHECK_ROCBLAS_ERROR(rocblas_set_matrix(rows, cols, sizeof(T), ha, lda, dc, ldc));
+        CHECK_ROCBLAS_ERROR(rocblas_get_matrix(rows, cols, sizeof(T), dc, ldc, hb, lda));
+
+        if(arg.unit_check)
+            unit_check_general<T>(rows, cols, lda, hb, ha);
+
+        if(arg.norm_check)
+            rocblas_error = norm_check_general<T>('F', rows, cols, lda, hb, ha);
+    }
+    else if(!HOST_TO_DEVICE)
+    {
+        CHECK_ROCBLAS_ERROR(rocblas_set_matrix(rows, cols, sizeof(T), ha, lda, dc, ldc));
+    }
+
+    if(arg.timing)
+    {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
+        for(int iter = 0; iter < number_cold_calls; iter++)
+            transfer();
+
+        gpu_time_used = get_time_us_sync_device(); // in microseconds
+
+        for(int iter = 0; iter < number_hot_calls; iter++)
+            transfer();
+
+        gpu_time_used = get_time_us_sync_device() - gpu_time_used;
+
+        ArgumentModel<e_M, e_N, e_lda, e_ldc>{}.log_args<T>(rocblas_cout,
+                                                            arg,
+                                                            gpu_time_used,
+                                                            ArgumentLogging::NA_value,
+                                                            set_matrix_gbyte_count<T>(rows, cols),
+                                                            cpu_time_used,
+                                                            rocblas_error);
+    }
+}
+
+template <typename T>
+void testing_set_matrix(const Arguments& arg)
+{
+    testing_matrix_transfer<T, true>(arg);
+}
+
+template <typename T>
+void testing_get_matrix(const Arguments& arg)
+{
+    testing_matrix_transfer<T, false>(arg);
+}
@@ -138,3 +138,62 @@ void testing_set_get_vector(const Arguments& arg)
                                                                  rocblas_error);
     }
 }
+
+template <typename T>
+void testing_set_get_vector_staging_cache(const Arguments& arg)
+{
+    rocblas_int M    = arg.M;
+    rocblas_int incx = arg.incx;
+    rocblas_int incy = arg.incy;
+    rocblas_int incb = arg.incb;
+
+    host_vector<T>   hx(M * size_t(incx));
+    host_vector<T>   hy(M * size_t(incy));
+    device_vector<T> db(M * size_t(incb));
+    CHECK_DEVICE_ALLOCATION(db.memcheck());
+
+    rocblas_seedrand();
+    rocblas_init<T>(hx, 1, M, incx);
+
+    // The cache is process-wide, so restore its limit on every exit, including failed assertions
+    struct restore_staging_cache_limit
+    {
+        size_t bytes;
+        ~restore_staging_cache_limit()
+        {
+            rocblas_set_staging_cache_limit(bytes);
+        }
+    } saved_limit{size_t(64) << 20};
+    CHECK_ROCBLAS_ERROR(rocblas_get_staging_cache_limit(&saved_limit.bytes));
+    EXPECT_ROCBLAS_STATUS(rocblas_get_staging_cache_limit(nullptr), rocblas_status_invalid_pointer);
+
+    size_t hits, misses, bytes_held, limit;
+    CHECK_ROCBLAS_ERROR(rocblas_set_staging_cache_limit(64 << 20));
+    CHECK_ROCBLAS_ERROR(rocblas_get_staging_cache_limit(&limit));
+    EXPECT_EQ(limit, size_t(64 << 20));
+
+    // The first transfers may allocate staging blocks, which are cached on release
+    CHECK_ROCBLAS_ERROR(rocblas_set_vector(M, sizeof(T), hx, incx, db, incb));
+    CHECK_ROCBLAS_ERROR(rocblas_get_vector(M, sizeof(T), db, incb, hy, incy));
+    CHECK_ROCBLAS_ERROR(rocblas_get_staging_cache_stats(&hits, &misses, &bytes_held));
+    EXPECT_GT(bytes_held, 0);
+
+    // Repeated transfers of the same size reuse the cached blocks
+    size_t hits_before = hits, misses_before = misses;
+    CHECK_ROCBLAS_ERROR(rocblas_set_vector(M, sizeof(T), hx, incx, db, incb));
+    CHECK_ROCBLAS_ERROR(rocblas_get_vector(M, sizeof(T), db, incb, hy, incy));
+    CHECK_ROCBLAS_ERROR(rocblas_get_staging_cache_stats(&hits, &misses, &bytes_held));
+    EXPECT_GT(hits, hits_before);
+    EXPECT_EQ(misses, misses_before);
+
+    for(rocblas_int i = 0; i < M; i++)
+        ASSERT_EQ(hy[i * incy], hx[i * incx]);
+
+    // A limit of 0 frees the idle blocks, and transfers still succeed without caching
+    CHECK_ROCBLAS_ERROR(rocblas_set_staging_cache_limit(0));
+    CHECK_ROCBLAS_ERROR(rocblas_get_staging_cache_stats(nullptr, nullptr, &bytes_held));
+    EXPECT_EQ(bytes_held, 0);
+    CHECK_ROCBLAS_ERROR(rocblas_set_vector(M, sizeof(T), hx, incx, db, incb));
+    CHECK_ROCBLAS_ERROR(rocblas_get_staging_cache_stats(nullptr, nullptr, &bytes_held));
+    EXPECT_EQ(bytes_held, 0);
+}
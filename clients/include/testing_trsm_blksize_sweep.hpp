@@ -0,0 +1,204 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "../../library/src/include/rocblas_trsm_blksize.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_matrix.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <fstream>
+#include <stdexcept>
+
+/* ============================================================================================ */
+/*  Sweep the block sizes of the substitution method of trsm for one precision, and write the  */
+/*  tuned tables for the current architecture to path. Each (m, n) of a table is timed at the  */
+/*  upper bound of its intervals, or twice the last bound above them, with side left, so that  */
+/*  m is the order of A. A batch_count above 1 tunes the batched table with strided_batched.   */
+/*  If path already holds tables for this architecture, they are updated, so that the sweeps   */
+/*  of all precisions can be collected in one file.                                            */
+/* ============================================================================================ */
+template <typename T>
+void testing_trsm_blksize_sweep(const Arguments& arg, const std::string& path)
+{
+    static constexpr rocblas_int candidates[] = {0, 1, 16, 24, 32, 40, 48, 56, 64, 72, 80};
+
+    const std::string arch        = rocblas_internal_get_arch_name();
+    const rocblas_int batch_count = std::max(arg.batch_count, 1);
+    const bool        batched     = batch_count > 1;
+
+    int device;
+    CHECK_HIP_ERROR(hipGetDevice(&device));
+
+    rocblas_trsm_blksize_tables tables = rocblas_trsm_current_blksize_tables(device);
+    {
+        std::ifstream is(path);
+        if(is && !rocblas_trsm_blksize_tables_read(is, arch, tables))
+            throw std::invalid_argument("Invalid trsm block size file " + path + " for " + arch);
+    }
+
+    rocblas_trsm_blksize_table& table
+        = rocblas_is_complex<T> ? batched ? tables.complex_batched : tables.complex
+                                : batched ? tables.real_batched : tables.real;
+
+    auto dim = [](const std::vector<rocblas_int>& intervals, size_t i) {
+        return i < intervals.size() ? intervals[i] : 2 * intervals.back();
+    };
+
+    const rocblas_int max_m = dim(table.intervals_row, table.intervals_row.size());
+    const rocblas_int max_n = dim(table.intervals_col, table.intervals_col.size());
+
+    const rocblas_side      side   = rocblas_side_left;
+    const rocblas_fill      uplo   = char2rocblas_fill(arg.uplo);
+    const rocblas_operation transA = char2rocblas_operation(arg.transA);
+    const rocblas_diagonal  diag   = char2rocblas_diagonal(arg.diag);
+    const T                 alpha  = T(1);
+
+    rocblas_local_handle handle{arg};
+    CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+
+    hipStream_t stream;
+    CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+
+    // Allocate for the largest sizes, and solve the leading submatrices
+    const rocblas_stride stride_A = rocblas_stride(max_m) * max_m;
+    const rocblas_stride stride_B = rocblas_stride(max_m) * max_n;
+
+    host_strided_batch_matrix<T>   hA(max_m, max_m, max_m, stride_A, batch_count);
+    host_strided_batch_matrix<T>   hB(max_m, max_n, max_m, stride_B, batch_count);
+    device_strided_batch_matrix<T> dA(max_m, max_m, max_m, stride_A, batch_count);
+    device_strided_batch_matrix<T> dB(max_m, max_n, max_m, stride_B, batch_count);
+
+    CHECK_HIP_ERROR(hA.memcheck());
+    CHECK_HIP_ERROR(hB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+
+    rocblas_init_matrix(hA,
+                        arg,
+                        rocblas_client_never_set_nan,
+                        rocblas_client_diagonally_dominant_triangular_matrix,
+                        true);
+    rocblas_init_matrix(
+        hB, arg, rocblas_client_never_set_nan, rocblas_client_general_matrix, false, true);
+
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+
+    auto time_us = [&](rocblas_int m, rocblas_int n, rocblas_int blksize) {
+        rocblas_internal_trsm_set_blksize_override(blksize);
+
+        auto trsm = [&] {
+            CHECK_ROCBLAS_ERROR(
+                batched ? rocblas_trsm_strided_batched<T>(handle,
+                                                          side,
+                                                          uplo,
+                                                          transA,
+                                                          diag,
+                                                          m,
+                                                          n,
+                                                          &alpha,
+                                                          dA,
+                                                          max_m,
+                                                          stride_A,
+                                                          dB,
+                                                          max_m,
+                                                          stride_B,
+                                                          batch_count)
+                        : rocblas_trsm<T>(
+                            handle, side, uplo, transA, diag, m, n, &alpha, dA, max_m, dB, max_m));
+        };
+
+        for(int i = 0; i < arg.cold_iters; i++)
+            trsm();
+
+        double gpu_time_used = get_time_us_sync(stream);
+        for(int i = 0; i < arg.iters; i++)
+            trsm();
+        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+
+        rocblas_internal_trsm_set_blksize_override(-1);
+        return gpu_time_used / std::max(arg.iters, 1);
+    };
+
+    rocblas_cout << "m,n,blksize,us" << std::endl;
+
+    for(size_t r = 0; r < table.rows(); ++r)
+    {
+        for(size_t c = 0; c < table.cols(); ++c)
+        {
+            const rocblas_int m       = dim(table.intervals_row, r);
+            const rocblas_int n       = dim(table.intervals_col, c);
+            rocblas_int&      blksize = table.blksizes[r * table.cols() + c];
+
+            // Ties keep the current block size
+            double best_time = time_us(m, n, blksize);
+            rocblas_cout << m << ',' << n << ',' << blksize << ',' << best_time << std::endl;
+
+            for(rocblas_int candidate : candidates)
+            {
+                // Block sizes of at least m are all equivalent to 1
+                if(candidate == blksize || (candidate > 1 && candidate >= m))
+                    continue;
+
+                double time = time_us(m, n, candidate);
+                rocblas_cout << m << ',' << n << ',' << candidate << ',' << time << std::endl;
+
+                if(time < best_time)
+                {
+                    best_time = time;
+                    blksize   = candidate;
+                }
+            }
+        }
+    }
+
+    std::ofstream os(path);
+    rocblas_trsm_blksize_tables_write(os, arch, tables);
+    if(!os.flush())
+        throw std::invalid_argument("Cannot write trsm block size file " + path);
+
+    rocblas_cout << "Wrote trsm block sizes for " << arch << " to " << path
+                 << "; install as trsm_blksize_" << arch
+                 << ".txt in the directory given by ROCBLAS_TRSM_BLKSIZE_PATH" << std::endl;
+}
+
+inline void testing_trsm_blksize_sweep(const Arguments& arg, const std::string& path)
+{
+    switch(arg.a_type)
+    {
+    case rocblas_datatype_f32_r:
+        return testing_trsm_blksize_sweep<float>(arg, path);
+    case rocblas_datatype_f64_r:
+        return testing_trsm_blksize_sweep<double>(arg, path);
+    case rocblas_datatype_f32_c:
+        return testing_trsm_blksize_sweep<rocblas_float_complex>(arg, path);
+    case rocblas_datatype_f64_c:
+        return testing_trsm_blksize_sweep<rocblas_double_complex>(arg, path);
+    default:
+        throw std::invalid_argument("Invalid precision for --trsm_blksize_sweep");
+    }
+}
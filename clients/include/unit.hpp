@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "compare.hpp"
 #include "rocblas.h"
 #include "rocblas_math.hpp"
 #include "rocblas_test.hpp"
@@ -37,9 +38,14 @@
 #define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)
 #define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)
 #else
+// All elements are first checked in parallel, stopping at the first mismatch; the assertions
+// are only evaluated to report a failure, together with a summary of the differences
 #define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)              \
     do                                                                                       \
     {                                                                                        \
+        if(unit_check_pass(M, N, lda, strideA, hCPU, hGPU, batch_count))                     \
+            break;                                                                           \
+        SCOPED_TRACE(rocblas_compare_trace(M, N, lda, strideA, hCPU, hGPU, batch_count));    \
         for(size_t k = 0; k < batch_count; k++)                                              \
             for(size_t j = 0; j < N; j++)                                                    \
                 for(size_t i = 0; i < M; i++)                                                \
@@ -57,6 +63,9 @@
 #define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)          \
     do                                                                            \
     {                                                                             \
+        if(unit_check_pass(M, N, lda, hCPU, hGPU, batch_count))                   \
+            break;                                                                \
+        SCOPED_TRACE(rocblas_compare_trace(M, N, lda, hCPU, hGPU, batch_count));  \
         for(size_t k = 0; k < batch_count; k++)                                   \
             for(size_t j = 0; j < N; j++)                                         \
                 for(size_t i = 0; i < M; i++)                                     \
@@ -105,6 +114,90 @@
 
 #endif // GOOGLE_TEST
 
+// Element checks with the semantics of the assertions of UNIT_CHECK and UNIT_CHECK_B: floating
+// point values are equal within the 4 ULPs of ASSERT_FLOAT_EQ and ASSERT_DOUBLE_EQ
+constexpr uint64_t unit_check_max_ulps = 4;
+
+template <typename T, std::enable_if_t<std::is_integral<T>{}, int> = 0>
+inline bool unit_check_element(T a, T b)
+{
+    return a == b;
+}
+
+inline bool unit_check_element(float a, float b)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b) : rocblas_ulp_distance(a, b) <= unit_check_max_ulps;
+}
+
+inline bool unit_check_element(double a, double b)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b) : rocblas_ulp_distance(a, b) <= unit_check_max_ulps;
+}
+
+inline bool unit_check_element(rocblas_half a, rocblas_half b)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b)
+                            : rocblas_ulp_distance(float(a), float(b)) <= unit_check_max_ulps;
+}
+
+inline bool unit_check_element(rocblas_bfloat16 a, rocblas_bfloat16 b)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b)
+                            : rocblas_ulp_distance(float(a), float(b)) <= unit_check_max_ulps;
+}
+
+// The rocblas_bfloat16 may match the truncated or the rounded value of the float
+inline bool unit_check_element(float a, rocblas_bfloat16 b)
+{
+    rocblas_bfloat16 truncated(a, rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
+    return rocblas_isnan(a)
+               ? rocblas_isnan(b)
+               : rocblas_ulp_distance(float(b), float(truncated)) <= unit_check_max_ulps
+                     || rocblas_ulp_distance(float(b), float(rocblas_bfloat16(a)))
+                            <= unit_check_max_ulps;
+}
+
+template <typename T, std::enable_if_t<rocblas_is_complex<T>, int> = 0>
+inline bool unit_check_element(const T& a, const T& b)
+{
+    return rocblas_isnan(a) ? rocblas_isnan(b) : rocblas_ulp_distance(a, b) <= unit_check_max_ulps;
+}
+
+// Returns whether all elements of a strided batch pass the check
+template <typename Tr, typename T>
+bool unit_check_pass(size_t         M,
+                     size_t         N,
+                     size_t         lda,
+                     rocblas_stride strideA,
+                     const Tr*      hCPU,
+                     const T*       hGPU,
+                     size_t         batch_count)
+{
+    return rocblas_compare_all(
+        M,
+        N,
+        lda,
+        batch_count,
+        [=](size_t k) { return hCPU + k * strideA; },
+        [=](size_t k) { return hGPU + k * strideA; },
+        [](const Tr& a, const T& b) { return unit_check_element(a, b); });
+}
+
+// Returns whether all elements of a batch of host vectors or pointers pass the check
+template <typename VR, typename VG>
+bool unit_check_pass(
+    size_t M, size_t N, size_t lda, const VR hCPU[], const VG hGPU[], size_t batch_count)
+{
+    return rocblas_compare_all(
+        M,
+        N,
+        lda,
+        batch_count,
+        [=](size_t k) { return rocblas_compare_data(hCPU[k]); },
+        [=](size_t k) { return rocblas_compare_data(hGPU[k]); },
+        [](const auto& a, const auto& b) { return unit_check_element(a, b); });
+}
+
 // TODO: Replace std::remove_cv_t with std::type_identity_t in C++20
 // It is only used to make T_hpa non-deduced
 template <typename T, typename T_hpa = T>
@@ -55,6 +55,100 @@ ROCBLAS_EXPORT rocblas_status rocblas_create_handle(rocblas_handle* handle);
  */
 ROCBLAS_EXPORT rocblas_status rocblas_destroy_handle(rocblas_handle handle);
 
+/*! \brief Create a handle with the settings of another handle
+    \details
+    The new handle is on the device of handle, with copies of its pointer mode, atomics mode,
+    performance metric, numerical checking mode, logging mode and solution cache capacity, and a
+    workspace of the same size (or of the default size if the workspace of handle is owned by the
+    user). It uses the default stream. The device properties queried when handle was created are
+    reused and its log files are shared rather than reopened, so cloning is cheaper than
+    rocblas_create_handle. Later changes to the settings of either handle do not affect the other.
+    Returns rocblas_status_invalid_handle if handle is nullptr, and rocblas_status_invalid_pointer
+    if clone is nullptr.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle to clone
+    @param[out]
+    clone       [rocblas_handle*]
+                the new handle, which is destroyed with rocblas_destroy_handle
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_clone_handle(rocblas_handle handle, rocblas_handle* clone);
+
+/*! \brief Create a pool of reusable handles
+    \details
+    A handle pool serves programs which use a short-lived handle per task or per thread. Handles
+    acquired from the pool are cloned from a prototype created on first use on each device, with
+    the settings of rocblas_create_handle. Released handles keep their workspace and are parked,
+    reset to the settings of the prototype, for later acquisitions on the same device.
+    @param[out]
+    pool        [rocblas_handle_pool*]
+                the new pool
+    @param[in]
+    max_parked  [size_t]
+                the maximum number of handles parked for each device. Handles released when
+                this many are parked are destroyed.
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_create_handle_pool(rocblas_handle_pool* pool,
+                                                         size_t               max_parked);
+
+/*! \brief Destroy a handle pool and the handles parked in it
+    \details
+    Handles acquired from the pool and not yet released remain valid, and are destroyed with
+    rocblas_destroy_handle.
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_destroy_handle_pool(rocblas_handle_pool pool);
+
+/*! \brief Acquire a handle on the current device from a handle pool
+    \details
+    Returns rocblas_status_invalid_pointer if pool or handle is nullptr.
+    @param[in]
+    pool        [rocblas_handle_pool]
+                the handle pool
+    @param[out]
+    handle      [rocblas_handle*]
+                a parked handle, or a new handle if none is parked for the current device
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_handle_pool_acquire(rocblas_handle_pool pool,
+                                                          rocblas_handle*     handle);
+
+/*! \brief Release a handle to a handle pool
+    \details
+    The stream of handle is synchronized, so that its workspace can be reused, and the handle is
+    parked. It is destroyed instead if the pool is full, or if its workspace was changed with
+    rocblas_set_device_memory_size, rocblas_set_workspace or rocblas_set_workspace_pool_budget, or
+    it was used in stream capture. Work on other streams which used handle must be complete. The
+    handle must not be used after it is released.
+    @param[in]
+    pool        [rocblas_handle_pool]
+                the handle pool
+    @param[in]
+    handle      [rocblas_handle]
+                the handle to release, which need not have been acquired from pool
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_handle_pool_release(rocblas_handle_pool pool,
+                                                          rocblas_handle      handle);
+
+/*! \brief returns statistics of a handle pool
+    \details
+    Any pointer may be null.
+    @param[in]
+    pool        [rocblas_handle_pool]
+                the handle pool
+    @param[out]
+    hits        [size_t*]
+                number of acquisitions served by a parked handle
+    @param[out]
+    misses      [size_t*]
+                number of acquisitions which created a new handle
+    @param[out]
+    parked      [size_t*]
+                number of handles currently parked on all devices
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_handle_pool_stats(rocblas_handle_pool pool,
+                                                            size_t*             hits,
+                                                            size_t*             misses,
+                                                            size_t*             parked);
+
 /*! \brief Set stream for handle
  */
 ROCBLAS_EXPORT rocblas_status rocblas_set_stream(rocblas_handle handle, hipStream_t stream);
@@ -352,6 +446,66 @@ ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_async(rocblas_int rows,
                                                        rocblas_int ldb,
                                                        hipStream_t stream);
 
+/*! \brief sets the limit of the staging block cache
+     \details
+    rocblas_set_vector and rocblas_get_vector copy non-contiguous vectors through pinned host and
+    device staging blocks. The blocks are kept in a process-wide cache, bucketed by power-of-two
+    size, so repeated transfers do not allocate and pin memory. A released block is kept while the
+    idle blocks held by the cache total at most bytes, and freed otherwise. Lowering the limit
+    frees idle blocks, largest first, until the limit is met. A limit of 0 disables the cache.
+
+    The limit defaults to 64 MiB and can also be set with the environment variable
+    ROCBLAS_STAGING_CACHE_LIMIT.
+    @param[in]
+    bytes       [size_t]
+                the maximum number of bytes held by idle staging blocks
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_staging_cache_limit(size_t bytes);
+
+/*! \brief returns the limit of the staging block cache
+     \details
+    Returns the maximum number of bytes held by idle staging blocks, as set by
+    rocblas_set_staging_cache_limit or the environment variable ROCBLAS_STAGING_CACHE_LIMIT.
+    Returns rocblas_status_invalid_pointer if bytes is nullptr.
+    @param[out]
+    bytes       [size_t*]
+                the maximum number of bytes held by idle staging blocks
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_staging_cache_limit(size_t* bytes);
+
+/*! \brief returns statistics of the staging block cache
+     \details
+    Returns the number of staging blocks reused from the cache, the number allocated because the
+    cache had no block of the required size, and the bytes currently held by idle blocks. The hit
+    rate is hits / (hits + misses). Any pointer may be null.
+    @param[out]
+    hits        [size_t*]
+                number of staging blocks reused from the cache
+    @param[out]
+    misses      [size_t*]
+                number of staging blocks allocated
+    @param[out]
+    bytes_held  [size_t*]
+                number of bytes held by idle staging blocks
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_staging_cache_stats(size_t* hits,
+                                                              size_t* misses,
+                                                              size_t* bytes_held);
+
+/*! \brief writes the host latency histograms recorded by latency logging
+     \details
+    When ROCBLAS_LAYER includes rocblas_layer_mode_log_latency (16), each rocBLAS function call
+    records the host time it spends, from its entry to its return, in a histogram of the calling
+    thread for that function. This merges the histograms of all threads and writes one CSV row per
+    function, with the count, minimum, mean, 50th, 90th, 99th and 99.9th percentiles, and maximum,
+    in nanoseconds. The histograms are also written when the program exits.
+    @param[in]
+    path        [const char*]
+                file to write, or nullptr for the file named by ROCBLAS_LOG_LATENCY_PATH, or by
+                ROCBLAS_LOG_PROFILE_PATH with .latency.csv appended, or else standard error
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_write_latency_histograms(const char* path);
+
 /*******************************************************************************
  * Function to set start/stop event handlers (for internal use only)
  ******************************************************************************/
@@ -398,6 +552,48 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_performance_metric(rocblas_handle
 ROCBLAS_EXPORT rocblas_status rocblas_get_performance_metric(rocblas_handle              handle,
                                                              rocblas_performance_metric* metric);
 
+/*! \brief sets the capacity of the handle's solution selection cache
+     \details
+    When the cache is enabled, the solution selected by Tensile for a gemm problem is remembered,
+    keyed on every property of the problem which can affect the selection (sizes, strides, data
+    types, transposes, flags, atomics mode, performance metric, workspace size, architecture and
+    CU count). Later calls with the same properties skip solution selection and reuse the Tensile
+    problem description built for the first call, rebinding only the pointers and scalars, so that
+    they make no heap allocations before the kernel launch. The cache holds at most size entries,
+    evicting the least recently used entry when full. A size of 0 disables the cache. Changing the
+    size discards all entries and resets the statistics.
+
+    The cache is disabled by default. The initial size can also be set with the environment
+    variable ROCBLAS_SOLUTION_CACHE_SIZE.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[in]
+    size        [size_t]
+                the maximum number of cached solutions
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_solution_cache_size(rocblas_handle handle, size_t size);
+
+/*! \brief returns statistics of the handle's solution selection cache
+     \details
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[out]
+    hits        [size_t*]
+                number of gemm calls whose solution was found in the cache
+    @param[out]
+    misses      [size_t*]
+                number of gemm calls whose solution was not found in the cache
+    @param[out]
+    entries     [size_t*]
+                number of solutions currently held in the cache
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_solution_cache_info(rocblas_handle handle,
+                                                              size_t*        hits,
+                                                              size_t*        misses,
+                                                              size_t*        entries);
+
 #ifdef __cplusplus
 }
 #endif
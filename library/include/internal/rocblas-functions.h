@@ -18290,6 +18290,46 @@ ROCBLAS_EXPORT const char* rocblas_status_to_string(rocblas_status status);
  ******************************************************************************/
 ROCBLAS_EXPORT void rocblas_initialize(void);
 
+/*! \brief Start initializing rocBLAS on several HIP devices in the background.
+    \details
+
+    Devices are initialized in parallel on worker threads, each doing the work of `rocblas_initialize()` for its device.
+    This function returns without waiting. Use `rocblas_query_initialize_progress()` to poll, and `rocblas_initialize_wait()` to block until initialization completes.
+    It may be called again to queue more devices; already initialized devices are not initialized twice.
+
+    @param[in]
+    devices   HIP device IDs to initialize. May be nullptr if count is 0.
+    @param[in]
+    count     number of entries in devices. If 0, all HIP devices are initialized.
+
+    @retval rocblas_status_success the initialization has been started.
+    @retval rocblas_status_invalid_size count is negative.
+    @retval rocblas_status_invalid_pointer devices is nullptr and count is positive.
+    @retval rocblas_status_invalid_value a device ID is out of range.
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_initialize_async(const rocblas_int* devices,
+                                                       rocblas_int        count);
+
+/*! \brief Query the progress of initialization started by rocblas_initialize_async() without blocking.
+    \details
+
+    @param[out]
+    progress  number of requested, completed and failed devices, and the time spent in each initialization phase.
+
+    @retval rocblas_status_success progress has been written.
+    @retval rocblas_status_invalid_pointer progress is nullptr.
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status
+    rocblas_query_initialize_progress(rocblas_initialize_progress* progress);
+
+/*! \brief Wait for all initialization started by rocblas_initialize_async() to complete.
+    \details
+
+    @retval rocblas_status_success every requested device is initialized.
+    @retval rocblas_status_internal_error a requested device could not be set or initialized.
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_initialize_wait(void);
+
 /*
  * ===========================================================================
  *    build information
@@ -18427,6 +18467,70 @@ ROCBLAS_EXPORT bool rocblas_is_managing_device_memory(rocblas_handle handle);
  ******************************************************************************/
 ROCBLAS_EXPORT bool rocblas_is_user_managing_device_memory(rocblas_handle handle);
 
+/*! \brief
+    \details
+    Gets statistics of the device memory held by the handle.
+
+    When rocBLAS manages device memory, requests which do not fit are served by appending
+    slabs of device memory rather than reallocating it. Slabs appended on demand are released
+    when no device memory is in use and more than ROCBLAS_DEVICE_MEMORY_HIGH_WATER bytes are held.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if any pointer is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    peak            maximum number of bytes of device memory in use at one time
+    @param[out]
+    slabs           number of slabs of device memory currently held by the handle
+    @param[out]
+    reallocations   number of slabs allocated on demand
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_device_memory_stats(rocblas_handle handle,
+                                                              size_t*        peak,
+                                                              size_t*        slabs,
+                                                              size_t*        reallocations);
+
+/*! \brief
+    \details
+    Sets the byte budget of the handle's per-stream workspace pools.
+
+    When the budget is nonzero and rocBLAS manages device memory, each stream used with the handle
+    has its own device memory, so that kernels on different streams never share temporary memory.
+    The device memory of a stream is allocated on its first use, other than by a device memory
+    size query, with the size of the handle's initial device memory. When switching to a stream, the device memory of the least recently used idle streams is freed
+    while the total exceeds the budget. A budget of 0 frees the per-stream device memory, and all
+    streams share the handle's device memory. The initial budget is taken from the environment
+    variable ROCBLAS_WORKSPACE_POOL_BUDGET, and is 0 if it is unset.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_internal_error if
+    device memory is in use; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    budget          total size in bytes of the per-stream device memory to keep
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_workspace_pool_budget(rocblas_handle handle,
+                                                                size_t         budget);
+
+/*! \brief
+    \details
+    Gets statistics of the handle's per-stream workspace pools.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if any pointer is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    pools           number of streams which currently have their own device memory
+    @param[out]
+    hits            number of workspace requests on a stream which already had its own device memory
+    @param[out]
+    misses          number of times device memory was created for a stream
+    @param[out]
+    evictions       number of times the device memory of a stream was freed to stay within the budget
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_workspace_pool_stats(rocblas_handle handle,
+                                                               size_t*        pools,
+                                                               size_t*        hits,
+                                                               size_t*        misses,
+                                                               size_t*        evictions);
+
 /*! \brief
     \details
     Abort function which safely flushes all IO
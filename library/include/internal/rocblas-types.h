@@ -58,6 +58,12 @@
  */
 typedef struct _rocblas_handle* rocblas_handle;
 
+/*! \brief rocblas_handle_pool keeps released handles for reuse by later acquisitions.
+ * It must be created using rocblas_create_handle_pool(),
+ * and destroyed using rocblas_destroy_handle_pool().
+ */
+typedef struct _rocblas_handle_pool* rocblas_handle_pool;
+
 /*! \brief Forward declaration of hipStream_t */
 typedef struct ihipStream_t* hipStream_t;
 
@@ -262,6 +268,10 @@ typedef enum rocblas_layer_mode_
     rocblas_layer_mode_log_bench = 0x2,
     /*! \brief Outputs a YAML description of each rocBLAS function called, along with its arguments and number of times it was called. */
     rocblas_layer_mode_log_profile = 0x4,
+    /*! \brief Trace and bench logging write fixed-size binary records to per-thread buffers, which are drained to a file in the background and decoded with rocblas-log-decode. */
+    rocblas_layer_mode_log_binary = 0x8,
+    /*! \brief Records histograms of the host time spent in each rocBLAS function, written at exit or by rocblas_write_latency_histograms. */
+    rocblas_layer_mode_log_latency = 0x10,
 } rocblas_layer_mode;
 
 /*! \brief Indicates if layer is active with bitmask*/
@@ -337,4 +347,17 @@ typedef enum rocblas_check_numerics_mode_
 
 } rocblas_check_numerics_mode;
 
+/*! \brief Progress of the background initialization started by rocblas_initialize_async().
+ * Phase times are summed over devices, so they may exceed the elapsed time.
+ */
+typedef struct rocblas_initialize_progress_
+{
+    rocblas_int devices; /**< Number of devices requested so far. */
+    rocblas_int completed; /**< Number of requested devices which are initialized. */
+    rocblas_int failed; /**< Number of requested devices which could not be initialized. */
+    double      parse_ms; /**< Milliseconds spent parsing the Tensile master library. */
+    double      code_object_load_ms; /**< Milliseconds spent loading code objects. */
+    double      adapter_init_ms; /**< Milliseconds spent setting up device adapters. */
+} rocblas_initialize_progress;
+
 #endif /* ROCBLAS_TYPES_H */
@@ -70,6 +70,8 @@ rocblas_status rocblas_asum_template(rocblas_handle handle,
                                      const char*    name,
                                      const char*    name_bench)
 {
+    auto latency = log_latency(handle, name);
+
     size_t         dev_bytes     = 0;
     rocblas_status checks_status = rocblas_reduction_setup<NB, ISBATCHED, Tw>(
         handle, n, x, incx, stridex, batch_count, results, name, name_bench, dev_bytes);
@@ -62,6 +62,8 @@ namespace
 
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
+        auto latency = log_latency(handle, name);
+
         auto layer_mode     = handle->layer_mode;
         auto check_numerics = handle->check_numerics;
 
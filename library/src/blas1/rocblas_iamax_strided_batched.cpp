@@ -54,6 +54,8 @@ namespace
         static constexpr int            NB        = ROCBLAS_IAMAX_NB;
         static constexpr rocblas_stride shiftx_0  = 0;
 
+        auto latency = log_latency(handle, rocblas_iamax_strided_batched_name<T>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, rocblas_index_value_t<S>>(
@@ -49,6 +49,8 @@ namespace
         static constexpr rocblas_int    batch_count_1 = 1;
         static constexpr int            NB            = ROCBLAS_IAMAX_NB;
 
+        auto latency = log_latency(handle, rocblas_iamin_name<T>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, rocblas_index_value_t<S>>(
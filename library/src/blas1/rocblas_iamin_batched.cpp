@@ -52,6 +52,8 @@ namespace
         static constexpr rocblas_stride stridex_0 = 0;
         static constexpr int            NB        = ROCBLAS_IAMAX_NB;
 
+        auto latency = log_latency(handle, rocblas_iamin_batched_name<T>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, rocblas_index_value_t<S>>(
@@ -56,6 +56,8 @@ namespace
         static constexpr bool           isbatched = true;
         static constexpr rocblas_stride shiftx_0  = 0;
 
+        auto latency = log_latency(handle, rocblas_nrm2_strided_batched_name<Ti>);
+
         size_t         dev_bytes = 0;
         rocblas_status checks_status
             = rocblas_reduction_setup<NB, isbatched, To>(handle,
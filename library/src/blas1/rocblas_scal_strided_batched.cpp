@@ -59,6 +59,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        auto latency = log_latency(handle, rocblas_scal_name<T, U>);
+
         auto layer_mode     = handle->layer_mode;
         auto check_numerics = handle->check_numerics;
 
@@ -155,18 +155,15 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     bool i64_indices = n * size_t(lda) > std::numeric_limits<rocblas_int>::max();
 
     //Identifying the precision to have an appropriate optimization
-    static constexpr bool is_float          = std::is_same<T, float>{};
-    static constexpr bool is_double         = std::is_same<T, double>{};
-    static constexpr bool is_complex_float  = std::is_same<T, rocblas_float_complex>{};
-    static constexpr bool is_complex_double = std::is_same<T, rocblas_double_complex>{};
+    static constexpr bool is_float  = std::is_same<T, float>{};
+    static constexpr bool is_double = std::is_same<T, double>{};
     const bool is_atomics_allowed = handle->atomics_mode == rocblas_atomics_allowed ? true : false;
 
     //Identifying the architecture to have an appropriate optimization
-    int  arch_major       = handle->getArchMajor();
-    bool is_arch_10_or_11 = arch_major == 10 || arch_major == 11 ? true : false;
-    bool is_gfx908        = handle->getArch() == 908 ? true : false;
-    bool is_gfx906        = handle->getArch() == 906 ? true : false;
-    bool is_gfx90a        = handle->getArch() == 910 ? true : false;
+    bool is_gfx90a = handle->getArch() == 910 ? true : false;
+
+    //Thresholds of (m, n) between the kernels, for the architecture and precision
+    const rocblas_level2_thresholds& thresholds = rocblas_level2_thresholds_of<T>(handle);
 
     if(transA == rocblas_operation_none)
     {
@@ -322,22 +319,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
             }
 #undef gemvn_double_buffered_KARGS
         }
-        //optimized gemvn kernel for gfx906 and gfx908.
-        else if((is_gfx908
-                 && (((is_float || is_double || is_complex_float) && m <= gemvn_gfx908_threshold
-                      && n <= gemvn_gfx908_threshold)
-                     || (is_complex_double && m <= zgemvn_gfx908_threshold
-                         && n <= zgemvn_gfx908_threshold)))
-
-                || (is_gfx906
-                    && (is_complex_float
-                        || ((is_float || is_double) && m <= gemvn_gfx906_threshold
-                            && n <= gemvn_gfx906_threshold)
-                        || (is_double
-                            && ((m >= dgemvn_gfx906_lower_threshold
-                                 && n >= dgemvn_gfx906_lower_threshold)
-                                || (m <= dgemvn_gfx906_upper_threshold
-                                    && n <= dgemvn_gfx906_upper_threshold))))))
+        //optimized gemvn kernel, tuned for gfx906 and gfx908.
+        else if(rocblas_gemvn_use_small_blocks(thresholds, m, n))
         {
             static constexpr int GEMVN_DIM_X = 32;
             static constexpr int GEMVN_DIM_Y = 16;
@@ -539,11 +522,9 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
 #undef gemvt_sn_KARGS
         }
-        //optimized gemvt kernel with double buffered loads for gfx908.
+        //optimized gemvt kernel with double buffered loads, tuned for gfx908.
         else if(is_atomics_allowed && (m == n) && (m % rocblas_gemv_bx() == 0)
-                && (is_gfx908
-                    && ((is_float && m > sgemvt_gfx908_lower_threshold)
-                        || (is_double && m > dgemvt_gfx908_lower_threshold))))
+                && (is_float || is_double) && rocblas_gemvt_use_double_buffered(thresholds, m))
         {
             // The following rocblas_gemv_scal_kernel does the `y = y*beta` computation
             static constexpr int NB               = 256;
@@ -623,12 +604,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     gemvt_grid, gemvt_threads, 0, rocblas_stream, m, n, alpha_, stride_alpha, A, offseta, lda, \
         strideA, x, shiftx, incx, stridex, beta_, stride_beta, y, shifty, incy, stridey
 
-        //Using kernel code with warp reduction for gfx1030.
-        else if(is_arch_10_or_11
-                && (is_double || is_complex_float
-                    || (is_float
-                        && (m < sgemvt_gfx_arch_10_11_threshold
-                            || n < sgemvt_gfx_arch_10_11_threshold))))
+        //Using kernel code with warp reduction, tuned for gfx10 and gfx11.
+        else if(rocblas_gemvt_use_warp_reduce(thresholds, m, n))
         {
             //Number of threads per block
             static constexpr int NB = 256;
@@ -649,9 +626,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                                    gemvt_KARGS(*alpha, *beta));
             }
         }
-        //Using kernel code with shared memory reduction for single precision as well as for other precisions when m or n is less than 6000 and for complex double in gfx1030.
-        else if((is_float || m < gemvt_threshold || n < gemvt_threshold)
-                || (is_arch_10_or_11 && is_complex_double))
+        //Using kernel code with shared memory reduction for single precision as well as for other precisions when m or n is less than 6000 and for complex double in gfx10 and gfx11.
+        else if(rocblas_gemvt_use_shared_reduce(thresholds, m, n))
         {
             //Number of threads per block
             static constexpr int NB = 256;
@@ -827,11 +803,9 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
 #undef gemvt_sn_KARGS
         }
-        //optimized gemvt kernel with double buffered loads for gfx908.
+        //optimized gemvt kernel with double buffered loads, tuned for gfx908.
         else if(is_atomics_allowed && (m == n) && (m % rocblas_gemv_bx() == 0)
-                && (is_gfx908
-                    && ((is_float && m > sgemvt_gfx908_lower_threshold)
-                        || (is_double && m > dgemvt_gfx908_lower_threshold))))
+                && (is_float || is_double) && rocblas_gemvt_use_double_buffered(thresholds, m))
         {
             // The following rocblas_gemv_scal_kernel does the `y = y*beta` computation
             static constexpr int NB               = 256;
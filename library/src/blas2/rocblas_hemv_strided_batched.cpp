@@ -51,6 +51,9 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
         auto check_numerics = handle->check_numerics;
+
+        auto latency = log_latency(handle, rocblas_hemv_name<T>);
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
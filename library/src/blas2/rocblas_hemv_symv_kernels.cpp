@@ -3035,9 +3035,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
     const bool is_atomics_allowed = handle->atomics_mode == rocblas_atomics_allowed ? true : false;
 
-    //Identifying the specific architecture to have an appropriate optimization
-    bool is_gfx90a = handle->getArch() == 910 ? true : false;
-    bool is_gfx908 = handle->getArch() == 908 ? true : false;
+    //Thresholds of n between the kernels, for the architecture and precision
+    const rocblas_level2_thresholds& thresholds = rocblas_level2_thresholds_of<U>(handle);
 
     static constexpr int HEMV_DIM_X         = rocblas_hemv_DIM_X();
     static constexpr int HEMV_DIM_Y         = 4;
@@ -3060,17 +3059,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
     if(uplo == rocblas_fill_upper)
     {
-        if(is_atomics_allowed
-           && ((is_gfx90a
-                && ((is_float && n < ssymv_U_gfx908_gfx90a_higher_threshold)
-                    || (is_double && n < dsymv_U_gfx90a_higher_threshold)))
-               || (is_gfx908
-                   && ((is_float && n < ssymv_U_gfx908_gfx90a_higher_threshold)
-                       || (is_double
-                           && (((n % 32 == 0) && n < dsymv_U_gfx908_higher_threshold)
-                               || ((n % 32 != 0)
-                                   && (n < dsymv_U_gfx908_generic_higher_threshold
-                                       || n > dsymv_U_gfx908_generic_lower_threshold))))))))
+        if(is_atomics_allowed && (is_float || is_double)
+           && rocblas_symv_use_double_buffered(thresholds, uplo, n))
         {
             bool host_ptr_mode = handle->pointer_mode == rocblas_pointer_mode_host;
             rocblas_internal_val_ptr<U> alpha_device_host(host_ptr_mode, alpha);
@@ -3274,13 +3264,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     }
     else
     {
-        if(is_atomics_allowed
-           && ((is_gfx908 && (is_float || is_double))
-               || (is_gfx90a
-                   && (((is_float && n < ssymv_L_gfx90a_higher_threshold)
-                        || ((n % 32 == 0 && is_double && n < dsymv_L_gfx90a_higher_threshold)
-                            || (n % 32 != 0 && is_double
-                                && n < dsymv_L_gfx90a_generic_higher_threshold)))))))
+        if(is_atomics_allowed && (is_float || is_double)
+           && rocblas_symv_use_double_buffered(thresholds, uplo, n))
         {
             //The following symv_kernel_upper_double_buffered is only valid for the multiples of DIM_X
             static constexpr rocblas_int DIM_X               = 32;
@@ -0,0 +1,219 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_level2_threshold.hpp"
+#include "rocblas_ostream.hpp"
+#include "rocblas_tuning_file.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    constexpr int  ROCBLAS_LEVEL2_THRESHOLD_VERSION = 1;
+    constexpr char precisions[]                     = "sdcz";
+
+    // Fields of rocblas_level2_thresholds by name, in the order written
+    struct threshold_field
+    {
+        const char* name;
+        rocblas_int rocblas_level2_thresholds::*member;
+    };
+
+#define THRESHOLD_FIELD(name_) {#name_, &rocblas_level2_thresholds::name_}
+    constexpr threshold_field fields[] = {
+        THRESHOLD_FIELD(gemvn_upper),
+        THRESHOLD_FIELD(gemvn_lower),
+        THRESHOLD_FIELD(gemvt_double_buffered_lower),
+        THRESHOLD_FIELD(gemvt_warp_reduce_upper),
+        THRESHOLD_FIELD(gemvt_shared_reduce_upper),
+        THRESHOLD_FIELD(symv_U_upper),
+        THRESHOLD_FIELD(symv_U_lower),
+        THRESHOLD_FIELD(symv_U_generic_upper),
+        THRESHOLD_FIELD(symv_U_generic_lower),
+        THRESHOLD_FIELD(symv_L_upper),
+        THRESHOLD_FIELD(symv_L_lower),
+        THRESHOLD_FIELD(symv_L_generic_upper),
+        THRESHOLD_FIELD(symv_L_generic_lower),
+    };
+#undef THRESHOLD_FIELD
+
+    rocblas_level2_threshold_db make_default_db()
+    {
+        // Single precision gemvt always reduces in shared memory unless a faster kernel applies
+        rocblas_level2_arch_thresholds generic{};
+        generic[0].gemvt_shared_reduce_upper = INT_MAX;
+
+        // Threshold values of (m, n) in gfx908 and gfx906 below which the threads per block
+        // should be 512 or less to get better performance
+        rocblas_level2_arch_thresholds gfx906 = generic;
+        gfx906[0].gemvn_upper                 = 6000;
+        gfx906[1].gemvn_upper                 = 24000;
+        gfx906[1].gemvn_lower                 = 15000;
+        gfx906[2].gemvn_upper                 = INT_MAX;
+
+        rocblas_level2_arch_thresholds gfx908 = generic;
+        gfx908[0].gemvn_upper                 = 15000;
+        gfx908[1].gemvn_upper                 = 15000;
+        gfx908[2].gemvn_upper                 = 15000;
+        gfx908[3].gemvn_upper                 = 18000;
+
+        // Double buffered load optimized for single and double precision for gemv (transpose)
+        gfx908[0].gemvt_double_buffered_lower = 7000;
+        gfx908[1].gemvt_double_buffered_lower = 3000;
+
+        // Double buffered load optimized for single and double precision for symv
+        gfx908[0].symv_U_upper         = 22000;
+        gfx908[0].symv_U_generic_upper = 22000;
+        gfx908[1].symv_U_upper         = 23000;
+        gfx908[1].symv_U_generic_upper = 14000;
+        gfx908[1].symv_U_generic_lower = 19000;
+        gfx908[0].symv_L_upper         = INT_MAX;
+        gfx908[0].symv_L_generic_upper = INT_MAX;
+        gfx908[1].symv_L_upper         = INT_MAX;
+        gfx908[1].symv_L_generic_upper = INT_MAX;
+
+        rocblas_level2_arch_thresholds gfx90a = generic;
+        gfx90a[0].symv_U_upper                = 22000;
+        gfx90a[0].symv_U_generic_upper        = 22000;
+        gfx90a[1].symv_U_upper                = 16000;
+        gfx90a[1].symv_U_generic_upper        = 16000;
+        gfx90a[0].symv_L_upper                = 29000;
+        gfx90a[0].symv_L_generic_upper        = 29000;
+        gfx90a[1].symv_L_upper                = 20000;
+        gfx90a[1].symv_L_generic_upper        = 26000;
+
+        // gemvt with warp reduction in gfx10 and gfx11, except for complex double, which
+        // always reduces in shared memory
+        rocblas_level2_arch_thresholds gfx10_11 = generic;
+        gfx10_11[0].gemvt_warp_reduce_upper     = 4000;
+        gfx10_11[1].gemvt_warp_reduce_upper     = INT_MAX;
+        gfx10_11[2].gemvt_warp_reduce_upper     = INT_MAX;
+        gfx10_11[3].gemvt_shared_reduce_upper   = INT_MAX;
+
+        rocblas_level2_threshold_db db;
+        db.archs["default"] = generic;
+        db.archs["gfx906"]  = gfx906;
+        db.archs["gfx908"]  = gfx908;
+        db.archs["gfx90a"]  = gfx90a;
+        db.archs["gfx10"]   = gfx10_11;
+        db.archs["gfx11"]   = gfx10_11;
+        return db;
+    }
+
+    bool read_line(const std::string& line, rocblas_level2_threshold_db& db)
+    {
+        std::istringstream in(line);
+        std::string        arch, precision, name, extra;
+        long long          value;
+        if(!(in >> arch >> precision >> name >> value) || (in >> extra) || precision.size() != 1
+           || value < 0 || value > INT_MAX)
+            return false;
+
+        const char* p = strchr(precisions, precision[0]);
+        if(!p)
+            return false;
+
+        for(const auto& field : fields)
+        {
+            if(name == field.name)
+            {
+                // A new architecture starts from the thresholds it had before
+                auto it = db.archs.find(arch);
+                if(it == db.archs.end())
+                    it = db.archs.emplace(arch, db.lookup(arch)).first;
+                it->second[p - precisions].*field.member = rocblas_int(value);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+const rocblas_level2_arch_thresholds&
+    rocblas_level2_threshold_db::lookup(const std::string& arch) const
+{
+    auto it = archs.find(arch);
+    if(it == archs.end() && arch.size() > 2)
+        it = archs.find(arch.substr(0, arch.size() - 2));
+    if(it == archs.end())
+        it = archs.find("default");
+    if(it == archs.end())
+    {
+        static const rocblas_level2_arch_thresholds generic{};
+        return generic;
+    }
+    return it->second;
+}
+
+const rocblas_level2_threshold_db& rocblas_level2_default_threshold_db()
+{
+    static const rocblas_level2_threshold_db db = make_default_db();
+    return db;
+}
+
+rocblas_level2_threshold_db& rocblas_level2_current_threshold_db()
+{
+    static rocblas_level2_threshold_db db = [] {
+        rocblas_level2_threshold_db db = rocblas_level2_default_threshold_db();
+
+        const char* path = getenv("ROCBLAS_LEVEL2_THRESHOLD_PATH");
+        if(path)
+        {
+            std::ifstream is(path);
+            if(!is || !rocblas_level2_thresholds_read(is, db))
+                rocblas_cerr << "\nrocBLAS warning: Ignoring invalid Level 2 threshold file "
+                             << path << std::endl;
+        }
+        return db;
+    }();
+    return db;
+}
+
+bool rocblas_level2_thresholds_read(std::istream& is, rocblas_level2_threshold_db& db)
+{
+    rocblas_level2_threshold_db result = db;
+    if(!rocblas_read_tuning_file(is,
+                                 "rocblas_level2_threshold",
+                                 ROCBLAS_LEVEL2_THRESHOLD_VERSION,
+                                 [&](const std::string& line) { return read_line(line, result); }))
+        return false;
+
+    db = std::move(result);
+    return true;
+}
+
+void rocblas_level2_thresholds_write(std::ostream& os, const rocblas_level2_threshold_db& db)
+{
+    os << "# rocBLAS Level 2 thresholds: <arch> <precision> <threshold> <value>\n"
+       << "rocblas_level2_threshold " << ROCBLAS_LEVEL2_THRESHOLD_VERSION << '\n';
+
+    for(const auto& arch : db.archs)
+    {
+        os << '\n';
+        for(int p = 0; p < 4; ++p)
+            for(const auto& field : fields)
+                os << arch.first << ' ' << precisions[p] << ' ' << field.name << ' '
+                   << arch.second[p].*field.member << '\n';
+    }
+}
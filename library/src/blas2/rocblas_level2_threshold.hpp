@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2019-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (C) 2019-2023 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,39 +21,142 @@
  * ************************************************************************ */
 
 #pragma once
+#include "handle.hpp"
 #include "rocblas.h"
+#include <array>
+#include <climits>
+#include <map>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
 
-/*********************************************************************gemv**********************************************************************/
+/*******************************************************************************
+ * Thresholds of the sizes at which gemv and symv switch between kernels, for  *
+ * one architecture and precision. Each field at its default never selects    *
+ * its kernel, so that architectures without tuned thresholds take the generic *
+ * paths.                                                                      *
+ *                                                                             *
+ * The compiled-in thresholds can be overridden from the file named by         *
+ * ROCBLAS_LEVEL2_THRESHOLD_PATH, in the text format read and written below,   *
+ * which the rocblas-level2-tune client measures and writes.                   *
+ *******************************************************************************/
+struct rocblas_level2_thresholds
+{
+    /*********************************************************************gemv*********/
 
-// Threshold values of (M, N) in gfx908 and gfx906 below which the threads per block should be 512 or less to get better performance
-constexpr int gemvn_gfx908_threshold        = 15000;
-constexpr int zgemvn_gfx908_threshold       = 18000;
-constexpr int gemvn_gfx906_threshold        = 6000;
-constexpr int dgemvn_gfx906_lower_threshold = 15000;
-constexpr int dgemvn_gfx906_upper_threshold = 24000;
-constexpr int gemvt_threshold               = 6000;
+    // gemvn with 32 x 16 thread blocks when m and n are both at most gemvn_upper,
+    // or both at least gemvn_lower
+    rocblas_int gemvn_upper = 0;
+    rocblas_int gemvn_lower = INT_MAX;
 
-// Threshold values of (M, N) in gfx10 and gfx11
-constexpr int sgemvt_gfx_arch_10_11_threshold = 4000;
+    // gemvt with double buffered loads for square matrices with m above this threshold
+    rocblas_int gemvt_double_buffered_lower = INT_MAX;
 
-// Double buffered load optimized for single and double precision for gemv (transpose)
-constexpr int sgemvt_gfx908_lower_threshold = 7000;
-constexpr int dgemvt_gfx908_lower_threshold = 3000;
+    // gemvt with warp reduction when m or n is below this threshold
+    rocblas_int gemvt_warp_reduce_upper = 0;
 
-/*********************************************************************symv**********************************************************************/
+    // gemvt with shared memory reduction when m or n is below this threshold
+    rocblas_int gemvt_shared_reduce_upper = 6000;
 
-// Double buffered load optimized for single and double precision for symv (upper)
-constexpr int ssymv_U_gfx908_gfx90a_higher_threshold = 22000;
-constexpr int dsymv_U_gfx908_higher_threshold        = 23000;
-constexpr int dsymv_U_gfx90a_higher_threshold        = 16000;
+    /*********************************************************************symv*********/
 
-// Double buffered load optimized for single and double precision for symv (lower)
-constexpr int ssymv_L_gfx90a_higher_threshold = 29000;
-constexpr int dsymv_L_gfx90a_higher_threshold = 20000;
+    // symv with double buffered loads when n is below *_upper or above *_lower. The
+    // generic thresholds apply when n is not a multiple of 32
+    rocblas_int symv_U_upper         = 0;
+    rocblas_int symv_U_lower         = INT_MAX;
+    rocblas_int symv_U_generic_upper = 0;
+    rocblas_int symv_U_generic_lower = INT_MAX;
+    rocblas_int symv_L_upper         = 0;
+    rocblas_int symv_L_lower         = INT_MAX;
+    rocblas_int symv_L_generic_upper = 0;
+    rocblas_int symv_L_generic_lower = INT_MAX;
+};
 
-// Double buffered load optimized for double precision for symv (lower) generic cases
-constexpr int dsymv_L_gfx90a_generic_higher_threshold = 26000;
+// The thresholds of one architecture for float, double, float complex and double complex
+using rocblas_level2_arch_thresholds = std::array<rocblas_level2_thresholds, 4>;
 
-// Double buffered load optimized for double precision for symv (upper) generic cases
-constexpr int dsymv_U_gfx908_generic_higher_threshold = 14000;
-constexpr int dsymv_U_gfx908_generic_lower_threshold  = 19000;
+template <typename T>
+constexpr size_t rocblas_level2_precision_index = std::is_same<T, float>{}    ? 0
+                                                  : std::is_same<T, double>{} ? 1
+                                                  : std::is_same<T, rocblas_float_complex>{}
+                                                      ? 2
+                                                      : 3;
+
+/*******************************************************************************
+ * Dispatch decisions, which depend only on the thresholds and sizes           *
+ *******************************************************************************/
+inline bool rocblas_gemvn_use_small_blocks(const rocblas_level2_thresholds& t,
+                                           rocblas_int                      m,
+                                           rocblas_int                      n)
+{
+    return (m <= t.gemvn_upper && n <= t.gemvn_upper) || (m >= t.gemvn_lower && n >= t.gemvn_lower);
+}
+
+inline bool rocblas_gemvt_use_double_buffered(const rocblas_level2_thresholds& t, rocblas_int m)
+{
+    return m > t.gemvt_double_buffered_lower;
+}
+
+inline bool rocblas_gemvt_use_warp_reduce(const rocblas_level2_thresholds& t,
+                                          rocblas_int                      m,
+                                          rocblas_int                      n)
+{
+    return m < t.gemvt_warp_reduce_upper || n < t.gemvt_warp_reduce_upper;
+}
+
+inline bool rocblas_gemvt_use_shared_reduce(const rocblas_level2_thresholds& t,
+                                            rocblas_int                      m,
+                                            rocblas_int                      n)
+{
+    return m < t.gemvt_shared_reduce_upper || n < t.gemvt_shared_reduce_upper;
+}
+
+inline bool rocblas_symv_use_double_buffered(const rocblas_level2_thresholds& t,
+                                             rocblas_fill                     uplo,
+                                             rocblas_int                      n)
+{
+    const bool  upper   = uplo == rocblas_fill_upper;
+    const bool  aligned = n % 32 == 0;
+    rocblas_int below   = upper ? aligned ? t.symv_U_upper : t.symv_U_generic_upper
+                                : aligned ? t.symv_L_upper : t.symv_L_generic_upper;
+    rocblas_int above   = upper ? aligned ? t.symv_U_lower : t.symv_U_generic_lower
+                                : aligned ? t.symv_L_lower : t.symv_L_generic_lower;
+    return n < below || n > above;
+}
+
+/*******************************************************************************
+ * Threshold database, keyed on the architecture name, such as gfx90a. An      *
+ * architecture without an entry of its own takes that of its family, such as  *
+ * gfx10 for gfx1030, or else the entry "default".                             *
+ *******************************************************************************/
+struct rocblas_level2_threshold_db
+{
+    std::map<std::string, rocblas_level2_arch_thresholds> archs;
+
+    // Entries are never removed, so the result lives as long as the database
+    const rocblas_level2_arch_thresholds& lookup(const std::string& arch) const;
+};
+
+// The compiled-in database
+ROCBLAS_INTERNAL_EXPORT const rocblas_level2_threshold_db& rocblas_level2_default_threshold_db();
+
+// The database used by new handles: the compiled-in one, overridden by the file named by
+// ROCBLAS_LEVEL2_THRESHOLD_PATH. Tuning clients may change it while no other thread uses it.
+ROCBLAS_INTERNAL_EXPORT rocblas_level2_threshold_db& rocblas_level2_current_threshold_db();
+
+// Read thresholds into db, one per line as <arch> <s|d|c|z> <field> <value>, after the
+// header line rocblas_level2_threshold <version>. Lines starting with # are comments.
+// Returns false, leaving db unchanged, if the stream is malformed or of another version.
+ROCBLAS_INTERNAL_EXPORT bool rocblas_level2_thresholds_read(std::istream&                is,
+                                                            rocblas_level2_threshold_db& db);
+
+ROCBLAS_INTERNAL_EXPORT void rocblas_level2_thresholds_write(std::ostream&                      os,
+                                                             const rocblas_level2_threshold_db& db);
+
+// Thresholds of the handle's architecture for precision T
+template <typename T>
+inline const rocblas_level2_thresholds& rocblas_level2_thresholds_of(rocblas_handle handle)
+{
+    return handle->level2_thresholds[rocblas_level2_precision_index<T>];
+}
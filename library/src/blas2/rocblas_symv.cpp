@@ -53,6 +53,9 @@ namespace
             return rocblas_status_invalid_handle;
 
         auto check_numerics = handle->check_numerics;
+
+        auto latency = log_latency(handle, rocblas_symv_name<T>);
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
@@ -60,6 +60,8 @@ namespace
 
         auto check_numerics = handle->check_numerics;
 
+        auto latency = log_latency(handle, rocblas_tpmv_strided_batched_name<T>);
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
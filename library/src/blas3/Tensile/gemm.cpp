@@ -68,6 +68,8 @@ namespace
             rocblas_copy_alpha_beta_to_host_if_on_device(handle, alpha, beta, alpha_h, beta_h, k));
         auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
 
+        auto latency = log_latency(handle, rocblas_gemm_name<T>);
+
         // Perform logging
         auto layer_mode     = handle->layer_mode;
         auto check_numerics = handle->check_numerics;
@@ -0,0 +1,184 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "handle.hpp"
+#include "rocblas_gemm_override.hpp"
+#include "rocblas_ostream.hpp"
+#include "rocblas_tuning_file.hpp"
+#include "utility.hpp"
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+    constexpr rocblas_datatype datatypes[] = {
+        rocblas_datatype_f16_r,
+        rocblas_datatype_f32_r,
+        rocblas_datatype_f64_r,
+        rocblas_datatype_f16_c,
+        rocblas_datatype_f32_c,
+        rocblas_datatype_f64_c,
+        rocblas_datatype_i8_r,
+        rocblas_datatype_u8_r,
+        rocblas_datatype_i32_r,
+        rocblas_datatype_u32_r,
+        rocblas_datatype_i8_c,
+        rocblas_datatype_u8_c,
+        rocblas_datatype_i32_c,
+        rocblas_datatype_u32_c,
+        rocblas_datatype_bf16_r,
+        rocblas_datatype_bf16_c,
+    };
+
+    bool read_datatype(std::istream& is, rocblas_datatype& type)
+    {
+        std::string name;
+        if(!(is >> name))
+            return false;
+        for(auto t : datatypes)
+        {
+            if(name == rocblas_datatype_string(t))
+            {
+                type = t;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool read_operation(std::istream& is, rocblas_operation& trans)
+    {
+        std::string letter;
+        if(!(is >> letter) || letter.size() != 1)
+            return false;
+        for(auto op : {rocblas_operation_none,
+                       rocblas_operation_transpose,
+                       rocblas_operation_conjugate_transpose})
+        {
+            if(letter[0] == rocblas_transpose_letter(op))
+            {
+                trans = op;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool read_line(const std::string& line, rocblas_gemm_override_db& db)
+    {
+        std::istringstream        in(line);
+        std::string               arch, extra;
+        rocblas_gemm_override_key key;
+        long long                 index;
+
+        if(!(in >> arch) || !read_datatype(in, key.a_type) || !read_datatype(in, key.c_type)
+           || !read_datatype(in, key.compute_type) || !read_operation(in, key.trans_a)
+           || !read_operation(in, key.trans_b))
+            return false;
+
+        if(!(in >> key.m >> key.n >> key.k >> key.lda >> key.ldb >> key.ldc >> key.ldd
+             >> key.batch_count >> index)
+           || (in >> extra) || key.m < 0 || key.n < 0 || key.k < 0 || key.batch_count < 0
+           || index <= 0 || index > INT_MAX)
+            return false;
+
+        db.archs[arch][key] = rocblas_int(index);
+        return true;
+    }
+}
+
+const rocblas_gemm_override_table* rocblas_gemm_override_db::lookup(const std::string& arch) const
+{
+    auto it = archs.find(arch);
+    return it == archs.end() || it->second.empty() ? nullptr : &it->second;
+}
+
+const rocblas_gemm_override_db& rocblas_gemm_current_override_db()
+{
+    // One database per file, each read once. Databases are never removed, so the tables
+    // handed to handles stay valid when ROCBLAS_GEMM_OVERRIDE_PATH changes.
+    static std::mutex                                      mutex;
+    static std::map<std::string, rocblas_gemm_override_db> dbs;
+
+    const char*                 env  = getenv("ROCBLAS_GEMM_OVERRIDE_PATH");
+    std::string                 path = env ? env : "";
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = dbs.find(path);
+    if(it == dbs.end())
+    {
+        rocblas_gemm_override_db db;
+        if(!path.empty())
+        {
+            std::ifstream is(path);
+            if(!is || !rocblas_gemm_overrides_read(is, db))
+                rocblas_cerr << "\nrocBLAS warning: Ignoring invalid GEMM override file " << path
+                             << std::endl;
+        }
+        it = dbs.emplace(path, std::move(db)).first;
+    }
+    return it->second;
+}
+
+bool rocblas_gemm_overrides_read(std::istream& is, rocblas_gemm_override_db& db)
+{
+    rocblas_gemm_override_db result = db;
+    if(!rocblas_read_tuning_file(is,
+                                 "rocblas_gemm_override",
+                                 ROCBLAS_GEMM_OVERRIDE_VERSION,
+                                 [&](const std::string& line) { return read_line(line, result); }))
+        return false;
+
+    db = std::move(result);
+    return true;
+}
+
+void rocblas_gemm_overrides_write(std::ostream& os, const rocblas_gemm_override_db& db)
+{
+    os << "# rocBLAS GEMM solution overrides: <arch> <a_type> <c_type> <compute_type> <transA> "
+          "<transB> <m> <n> <k> <lda> <ldb> <ldc> <ldd> <batch_count> <solution_index>\n"
+       << "rocblas_gemm_override " << ROCBLAS_GEMM_OVERRIDE_VERSION << '\n';
+
+    for(const auto& arch : db.archs)
+    {
+        os << '\n';
+        for(const auto& entry : arch.second)
+        {
+            const auto& key = entry.first;
+            os << arch.first << ' ' << rocblas_datatype_string(key.a_type) << ' '
+               << rocblas_datatype_string(key.c_type) << ' '
+               << rocblas_datatype_string(key.compute_type) << ' '
+               << rocblas_transpose_letter(key.trans_a) << ' '
+               << rocblas_transpose_letter(key.trans_b) << ' ' << key.m << ' ' << key.n << ' '
+               << key.k << ' ' << key.lda << ' ' << key.ldb << ' ' << key.ldc << ' ' << key.ldd
+               << ' ' << key.batch_count << ' ' << entry.second << '\n';
+        }
+    }
+}
+
+rocblas_int rocblas_internal_last_gemm_solution_index(rocblas_handle handle)
+{
+    return handle ? handle->last_gemm_solution_index : 0;
+}
@@ -68,6 +68,9 @@ namespace
             return rocblas_status_invalid_handle;
 
         auto check_numerics = handle->check_numerics;
+
+        auto latency = log_latency(handle, rocblas_trsm_name<T>);
+
         /////////////
         // LOGGING //
         /////////////
@@ -27,105 +27,9 @@
 #include "../blas_ex/rocblas_gemm_ex.hpp"
 #endif
 #include "rocblas_trmm.hpp"
+#include "rocblas_trsm_blksize.hpp"
 #include "trtri_trsm.hpp"
 
-/** Constants for block size of trsm **/
-// clang-format off
-#define TRSM_NUMROWS_REAL 12
-#define TRSM_NUMCOLS_REAL 16
-#define TRSM_INTERVALSROW_REAL                                          \
-    40, 56, 80, 112, 144, 176, 208, 240, 288, 352, 480
-#define TRSM_INTERVALSCOL_REAL                                          \
-    448, 768, 960, 1152, 1408, 1920, 2304, 2816, 3840, 4096, 4736,      \
-    4992, 5888, 7680, 9728
-#define TRSM_BLKSIZES_REAL                                              \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},    \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 24, 24, 24, 16},    \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1, 32, 32, 32, 32, 32, 24, 16},    \
-    {1,  1,  1,  1,  1,  1,  1, 48, 48, 48, 48, 32, 32, 32, 24, 16},    \
-    {1,  1,  1,  1,  1,  1, 64, 64, 64, 48, 48, 32, 32, 32, 24, 16},    \
-    {1,  1,  1,  1,  1, 80, 80, 80, 56, 56, 40, 40, 40, 32, 32, 32},    \
-    {1,  1,  1,  1, 80, 80, 80, 80, 80, 48, 48, 48, 40, 32,  0,  0},    \
-    {1,  1,  1, 80, 80, 80, 80, 80, 56, 56, 32, 32, 32, 32,  0,  0},    \
-    {1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
-    {1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
-    {1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
-    {0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
-
-#define TRSM_NUMROWS_COMPLEX 10
-#define TRSM_NUMCOLS_COMPLEX 12
-#define TRSM_INTERVALSROW_COMPLEX                                       \
-    40, 56, 80, 112, 144, 208, 240, 288, 480
-#define TRSM_INTERVALSCOL_COMPLEX                                       \
-    704, 960, 1344, 1920, 2304, 2816, 3200, 3840, 4864, 5888, 7680
-#define TRSM_BLKSIZES_COMPLEX                                           \
-    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},                               \
-    {1, 1, 1, 1, 1, 1, 1, 1, 1, 24, 24, 24},                            \
-    {1, 1, 1, 1, 1, 1, 1, 1, 32, 32, 32, 32},                           \
-    {1, 1, 1, 1, 1, 72, 72, 56, 48, 32, 32, 32},                        \
-    {1, 1, 1, 1, 64, 64, 64, 64, 48, 32, 32, 32},                       \
-    {1, 1, 1, 80, 80, 80, 64, 64, 48, 32, 32, 32},                      \
-    {1, 1, 80, 80, 80, 80, 64, 64, 40, 40, 32, 32},                     \
-    {1, 1, 72, 72, 64, 64, 64, 64, 32, 32, 32, 0},                      \
-    {1, 80, 80, 80, 80, 80, 64, 64, 48, 40, 32, 0},                     \
-    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
-
-#define TRSM_BATCH_NUMROWS_REAL 11
-#define TRSM_BATCH_NUMCOLS_REAL 17
-#define TRSM_BATCH_INTERVALSROW_REAL                                        \
-    20, 28, 40, 80, 112, 176, 208, 288, 352, 480
-#define TRSM_BATCH_INTERVALSCOL_REAL                                        \
-    6, 10, 12, 22, 28, 30, 36, 42, 46, 50, 60, 96, 432, 928, 960, 1472
-#define TRSM_BATCH_BLKSIZES_REAL                                            \
-    { 1,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
-    { 1,  1,  1,  1, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
-    { 1,  1,  1,  1, 16, 16, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0},   \
-    { 1, 24, 24, 24, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},   \
-    {48, 48, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 16, 16, 16, 16, 16},   \
-    {64, 64, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 24, 24, 24, 24, 24},   \
-    {64, 64, 32, 32, 24, 24, 24, 24, 32, 32, 32, 32, 32, 24, 24, 24, 24},   \
-    {64, 64, 64, 32, 32, 32, 32, 40, 40, 40, 40, 32, 32, 24, 24, 32, 32},   \
-    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32, 32},   \
-    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32,  0},   \
-    {64, 64, 64, 32, 32, 32, 48, 48, 48, 48, 40, 32, 32, 32,  0,  0,  0}
-
-#define TRSM_BATCH_NUMROWS_COMPLEX 10
-#define TRSM_BATCH_NUMCOLS_COMPLEX 16
-#define TRSM_BATCH_INTERVALSROW_COMPLEX                                     \
-    20, 28, 40, 56, 80, 112, 144, 176, 480
-#define TRSM_BATCH_INTERVALSCOL_COMPLEX                                     \
-    4, 12, 16, 28, 32, 40, 48, 50, 60, 72, 88, 176, 232, 400, 464
-#define TRSM_BATCH_BLKSIZES_COMPLEX                                         \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  8,  1,  1,  1,  1,  1,  1,  1},        \
-    {1,  1,  1,  1, 16, 16, 16, 16,  1,  1,  1, 16, 16, 16, 16, 16},        \
-    {1,  1,  1, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},        \
-    {1,  1, 32, 32, 32, 32, 32, 32, 32, 32, 32, 16, 16, 16, 16, 16},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 48, 48, 32},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 32},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 80, 80, 56, 56, 32, 32},        \
-    {1, 64, 32, 32, 32, 64, 48, 32, 32, 32, 32, 32, 32, 32, 32, 32},        \
-    {1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 64, 64, 48, 48, 48}
-// clang-format on
-
-static constexpr rocblas_int trsm_intervals_row_real_batch[] = {TRSM_BATCH_INTERVALSROW_REAL};
-static constexpr rocblas_int trsm_intervals_col_real_batch[] = {TRSM_BATCH_INTERVALSCOL_REAL};
-static constexpr rocblas_int trsm_blksizes_real_batch[][TRSM_BATCH_NUMCOLS_REAL]
-    = {TRSM_BATCH_BLKSIZES_REAL};
-static constexpr rocblas_int trsm_intervals_row_real_nonbatch[] = {TRSM_INTERVALSROW_REAL};
-static constexpr rocblas_int trsm_intervals_col_real_nonbatch[] = {TRSM_INTERVALSCOL_REAL};
-static constexpr rocblas_int trsm_blksizes_real_nonbatch[][TRSM_NUMCOLS_REAL]
-    = {TRSM_BLKSIZES_REAL};
-
-static constexpr rocblas_int trsm_intervals_row_complex_batch[] = {TRSM_BATCH_INTERVALSROW_COMPLEX};
-static constexpr rocblas_int trsm_intervals_col_complex_batch[] = {TRSM_BATCH_INTERVALSCOL_COMPLEX};
-static constexpr rocblas_int trsm_blksizes_complex_batch[][TRSM_BATCH_NUMCOLS_COMPLEX]
-    = {TRSM_BATCH_BLKSIZES_COMPLEX};
-static constexpr rocblas_int trsm_intervals_row_complex_nonbatch[] = {TRSM_INTERVALSROW_COMPLEX};
-static constexpr rocblas_int trsm_intervals_col_complex_nonbatch[] = {TRSM_INTERVALSCOL_COMPLEX};
-static constexpr rocblas_int trsm_blksizes_complex_nonbatch[][TRSM_NUMCOLS_COMPLEX]
-    = {TRSM_BLKSIZES_COMPLEX};
-
 template <typename T>
 static const T alpha_negative_one = T(-1);
 template <typename T>
@@ -1572,41 +1476,18 @@ inline bool rocblas_internal_trsm_use_substitution(rocblas_side side,
            && ((n <= 32 && batch_count >= 16 && m < 512) || (n > 32 && n <= 128 && m <= 340));
 }
 
-inline rocblas_int get_index(const rocblas_int* intervals, rocblas_int max, rocblas_int dim)
-{
-    rocblas_int i;
-
-    for(i = 0; i < max; ++i)
-    {
-        if(dim <= intervals[i])
-            break;
-    }
-
-    return i;
-}
-
 /** This function returns the block size for the internal blocked trsm implementation.
- *  The block sizes and logic is taken directly from rocSOLVER.
+ *  The default block sizes and logic are taken directly from rocSOLVER, and may be
+ *  replaced per architecture of the device, see rocblas_trsm_blksize.hpp.
  */
-template <bool BATCHED, typename T, std::enable_if_t<!rocblas_is_complex<T>, int> = 0>
-rocblas_int rocblas_trsm_blksize(rocblas_int m, rocblas_int n)
+template <bool BATCHED, typename T>
+rocblas_int rocblas_trsm_blksize(int device, rocblas_int m, rocblas_int n)
 {
-    rocblas_int blk = 0;
-
-    if(BATCHED)
-    {
-        rocblas_int M = TRSM_BATCH_NUMROWS_REAL - 1;
-        rocblas_int N = TRSM_BATCH_NUMCOLS_REAL - 1;
-        blk           = trsm_blksizes_real_batch[get_index(trsm_intervals_row_real_batch, M, m)]
-                                      [get_index(trsm_intervals_col_real_batch, N, n)];
-    }
-    else
-    {
-        rocblas_int M = TRSM_NUMROWS_REAL - 1;
-        rocblas_int N = TRSM_NUMCOLS_REAL - 1;
-        blk = trsm_blksizes_real_nonbatch[get_index(trsm_intervals_row_real_nonbatch, M, m)]
-                                         [get_index(trsm_intervals_col_real_nonbatch, N, n)];
-    }
+    rocblas_int blk = rocblas_internal_trsm_blksize_override();
+    if(blk < 0)
+        blk = rocblas_trsm_current_blksize_tables(device)
+                  .get<BATCHED, rocblas_is_complex<T>>()
+                  .lookup(m, n);
 
     if(blk == 1)
         blk = std::min(m, 512);
@@ -1615,83 +1496,20 @@ rocblas_int rocblas_trsm_blksize(rocblas_int m, rocblas_int n)
     return blk;
 }
 
-template <bool BATCHED, typename T, std::enable_if_t<rocblas_is_complex<T>, int> = 0>
-rocblas_int rocblas_trsm_blksize(rocblas_int m, rocblas_int n)
-{
-    rocblas_int blk = 0;
-
-    if(BATCHED)
-    {
-        rocblas_int M = TRSM_BATCH_NUMROWS_COMPLEX - 1;
-        rocblas_int N = TRSM_BATCH_NUMCOLS_COMPLEX - 1;
-        blk = trsm_blksizes_complex_batch[get_index(trsm_intervals_row_complex_batch, M, m)]
-                                         [get_index(trsm_intervals_col_complex_batch, N, n)];
-    }
-    else
-    {
-        rocblas_int M = TRSM_NUMROWS_COMPLEX - 1;
-        rocblas_int N = TRSM_NUMCOLS_COMPLEX - 1;
-        blk = trsm_blksizes_complex_nonbatch[get_index(trsm_intervals_row_complex_nonbatch, M, m)]
-                                            [get_index(trsm_intervals_col_complex_nonbatch, N, n)];
-    }
-
-    if(blk == 1)
-        blk = std::min(m, 512);
-
-    return blk;
-}
-
-/*! \brief rocblas_internal_trsm_workspace_size
-    Calculates needed memory allocation for trsm, does not allocate any memory.
-    Note that for the batched version of trsm, we are also allocating memory to store the
-    arrays of pointers for invA and w_x_temp.
-
-    @param[in]
-    side rocblas_side
-        Whether matrix A is located on the left or right of X
-    @param[in]
-    m rocblas_int
-        Number of rows of matrix B
-    @param[in]
-    n rocblas_int
-        Number of columns of matrix B
-    @param[in]
-    batch_count rocblas_int
-        Number of batches
-    @param[in]
-    supplied_invA_size rocblas_int
-        If the user supplies an invA matrix, this may reduce the needed memory. supplied_invA_size
-        specifies the number of elements in device memory of the supplied invA matrix.
-    @param[out]
-    w_x_tmp_size size_t
-        The bytes of workspace memory needed for x_tmp in the trsm calculations
-    @param[out]
-    w_x_tmp_arr_size size_t
-        The bytes of workspace memory needed for the array of pointers for x_tmp
-    @param[out]
-    w_invA_size size_t
-        The bytes of workspace memory needed for invA in the trsm calculations
-    @param[out]
-    w_invA_arr_size size_t
-        The bytes of workspace memory needed for the array of pointers for invA
-    @param[out]
-    w_x_tmp_size_backup size_t
-        If the user is unable to allocate w_x_tmp_arr_size bytes, w_x_tmp_size_backup
-        bytes may be used in trsm with degraded performance.
-    ********************************************************************/
+// Workspace sizes of trsm, choosing the block sizes of the substitution method for device
 template <rocblas_int BLOCK, bool BATCHED, typename T>
-ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
-    rocblas_internal_trsm_workspace_size(rocblas_side      side,
-                                         rocblas_operation transA,
-                                         rocblas_int       m,
-                                         rocblas_int       n,
-                                         rocblas_int       batch_count,
-                                         rocblas_int       supplied_invA_size,
-                                         size_t*           w_x_tmp_size,
-                                         size_t*           w_x_tmp_arr_size,
-                                         size_t*           w_invA_size,
-                                         size_t*           w_invA_arr_size,
-                                         size_t*           w_x_tmp_size_backup)
+rocblas_status rocblas_trsm_workspace_size_for_device(int               device,
+                                                      rocblas_side      side,
+                                                      rocblas_operation transA,
+                                                      rocblas_int       m,
+                                                      rocblas_int       n,
+                                                      rocblas_int       batch_count,
+                                                      rocblas_int       supplied_invA_size,
+                                                      size_t*           w_x_tmp_size,
+                                                      size_t*           w_x_tmp_arr_size,
+                                                      size_t*           w_invA_size,
+                                                      size_t*           w_invA_arr_size,
+                                                      size_t*           w_x_tmp_size_backup)
 {
     if(!w_x_tmp_size || !w_x_tmp_arr_size || !w_invA_size || !w_invA_arr_size
        || !w_x_tmp_size_backup)
@@ -1727,7 +1545,7 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
     // no memory needed for substitution method, only used for specific sizes
     const bool  LEFT    = rocblas_side_left == side;
-    rocblas_int blksize = rocblas_trsm_blksize<BATCHED, T>(LEFT ? m : n, LEFT ? n : m);
+    rocblas_int blksize = rocblas_trsm_blksize<BATCHED, T>(device, LEFT ? m : n, LEFT ? n : m);
     const bool  use_sub = rocblas_internal_trsm_use_substitution(side, m, n, batch_count);
 
     if(use_sub && blksize)
@@ -1799,6 +1617,113 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     return rocblas_status_success;
 }
 
+/*! \brief rocblas_internal_trsm_workspace_size
+    Calculates needed memory allocation for trsm, does not allocate any memory.
+    Note that for the batched version of trsm, we are also allocating memory to store the
+    arrays of pointers for invA and w_x_temp.
+
+    @param[in]
+    handle rocblas_handle
+        Handle whose device the block sizes of the substitution method are chosen for.
+        The overload without a handle chooses them for the current device.
+    @param[in]
+    side rocblas_side
+        Whether matrix A is located on the left or right of X
+    @param[in]
+    m rocblas_int
+        Number of rows of matrix B
+    @param[in]
+    n rocblas_int
+        Number of columns of matrix B
+    @param[in]
+    batch_count rocblas_int
+        Number of batches
+    @param[in]
+    supplied_invA_size rocblas_int
+        If the user supplies an invA matrix, this may reduce the needed memory. supplied_invA_size
+        specifies the number of elements in device memory of the supplied invA matrix.
+    @param[out]
+    w_x_tmp_size size_t
+        The bytes of workspace memory needed for x_tmp in the trsm calculations
+    @param[out]
+    w_x_tmp_arr_size size_t
+        The bytes of workspace memory needed for the array of pointers for x_tmp
+    @param[out]
+    w_invA_size size_t
+        The bytes of workspace memory needed for invA in the trsm calculations
+    @param[out]
+    w_invA_arr_size size_t
+        The bytes of workspace memory needed for the array of pointers for invA
+    @param[out]
+    w_x_tmp_size_backup size_t
+        If the user is unable to allocate w_x_tmp_arr_size bytes, w_x_tmp_size_backup
+        bytes may be used in trsm with degraded performance.
+    ********************************************************************/
+template <rocblas_int BLOCK, bool BATCHED, typename T>
+ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
+    rocblas_internal_trsm_workspace_size(rocblas_handle    handle,
+                                         rocblas_side      side,
+                                         rocblas_operation transA,
+                                         rocblas_int       m,
+                                         rocblas_int       n,
+                                         rocblas_int       batch_count,
+                                         rocblas_int       supplied_invA_size,
+                                         size_t*           w_x_tmp_size,
+                                         size_t*           w_x_tmp_arr_size,
+                                         size_t*           w_invA_size,
+                                         size_t*           w_invA_arr_size,
+                                         size_t*           w_x_tmp_size_backup)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    return rocblas_trsm_workspace_size_for_device<BLOCK, BATCHED, T>(handle->getDevice(),
+                                                                     side,
+                                                                     transA,
+                                                                     m,
+                                                                     n,
+                                                                     batch_count,
+                                                                     supplied_invA_size,
+                                                                     w_x_tmp_size,
+                                                                     w_x_tmp_arr_size,
+                                                                     w_invA_size,
+                                                                     w_invA_arr_size,
+                                                                     w_x_tmp_size_backup);
+}
+
+template <rocblas_int BLOCK, bool BATCHED, typename T>
+ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
+    rocblas_internal_trsm_workspace_size(rocblas_side      side,
+                                         rocblas_operation transA,
+                                         rocblas_int       m,
+                                         rocblas_int       n,
+                                         rocblas_int       batch_count,
+                                         rocblas_int       supplied_invA_size,
+                                         size_t*           w_x_tmp_size,
+                                         size_t*           w_x_tmp_arr_size,
+                                         size_t*           w_invA_size,
+                                         size_t*           w_invA_arr_size,
+                                         size_t*           w_x_tmp_size_backup)
+{
+    int        device;
+    hipError_t hip_status = hipGetDevice(&device);
+    if(hip_status != hipSuccess)
+        return get_rocblas_status_for_hip_status(hip_status);
+
+    return rocblas_trsm_workspace_size_for_device<BLOCK, BATCHED, T>(device,
+                                                                     side,
+                                                                     transA,
+                                                                     m,
+                                                                     n,
+                                                                     batch_count,
+                                                                     supplied_invA_size,
+                                                                     w_x_tmp_size,
+                                                                     w_x_tmp_arr_size,
+                                                                     w_invA_size,
+                                                                     w_invA_arr_size,
+                                                                     w_x_tmp_size_backup);
+}
+
 /**
  *  The purpose of this function is to allocate memory for trsm. It is added to remove
  *  memory allocation from the rocblas_internal_trsm_template function, but also allow code reuse
@@ -1827,7 +1752,8 @@ rocblas_status rocblas_internal_trsm_template_mem(rocblas_handle              ha
     // calculate needed memory
     size_t w_x_tmp_size, w_x_tmp_arr_size, w_invA_size, w_invA_arr_size, w_x_tmp_size_backup;
     rocblas_status memory_status
-        = rocblas_internal_trsm_workspace_size<BLOCK, BATCHED, T>(side,
+        = rocblas_internal_trsm_workspace_size<BLOCK, BATCHED, T>(handle,
+                                                                  side,
                                                                   transA,
                                                                   m,
                                                                   n,
@@ -3455,7 +3381,8 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
             // from rocSOLVER profiling, if we get a blksize of 0,
             // substitution method shouldn't be used
             const bool  LEFT    = rocblas_side_left == side;
-            rocblas_int blksize = rocblas_trsm_blksize<BATCHED, T>(LEFT ? m : n, LEFT ? n : m);
+            rocblas_int blksize
+                = rocblas_trsm_blksize<BATCHED, T>(handle->getDevice(), LEFT ? m : n, LEFT ? n : m);
 
             const bool use_sub = rocblas_internal_trsm_use_substitution(side, m, n, batch_count);
 
@@ -0,0 +1,351 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_trsm_blksize.hpp"
+#include "rocblas_ostream.hpp"
+#include "utility.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+/** Constants for block size of trsm **/
+// clang-format off
+#define TRSM_NUMROWS_REAL 12
+#define TRSM_NUMCOLS_REAL 16
+#define TRSM_INTERVALSROW_REAL                                          \
+    40, 56, 80, 112, 144, 176, 208, 240, 288, 352, 480
+#define TRSM_INTERVALSCOL_REAL                                          \
+    448, 768, 960, 1152, 1408, 1920, 2304, 2816, 3840, 4096, 4736,      \
+    4992, 5888, 7680, 9728
+#define TRSM_BLKSIZES_REAL                                              \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},    \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 24, 24, 24, 16},    \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1, 32, 32, 32, 32, 32, 24, 16},    \
+    {1,  1,  1,  1,  1,  1,  1, 48, 48, 48, 48, 32, 32, 32, 24, 16},    \
+    {1,  1,  1,  1,  1,  1, 64, 64, 64, 48, 48, 32, 32, 32, 24, 16},    \
+    {1,  1,  1,  1,  1, 80, 80, 80, 56, 56, 40, 40, 40, 32, 32, 32},    \
+    {1,  1,  1,  1, 80, 80, 80, 80, 80, 48, 48, 48, 40, 32,  0,  0},    \
+    {1,  1,  1, 80, 80, 80, 80, 80, 56, 56, 32, 32, 32, 32,  0,  0},    \
+    {1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
+    {1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
+    {1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
+    {0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+
+#define TRSM_NUMROWS_COMPLEX 10
+#define TRSM_NUMCOLS_COMPLEX 12
+#define TRSM_INTERVALSROW_COMPLEX                                       \
+    40, 56, 80, 112, 144, 208, 240, 288, 480
+#define TRSM_INTERVALSCOL_COMPLEX                                       \
+    704, 960, 1344, 1920, 2304, 2816, 3200, 3840, 4864, 5888, 7680
+#define TRSM_BLKSIZES_COMPLEX                                           \
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},                               \
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 24, 24, 24},                            \
+    {1, 1, 1, 1, 1, 1, 1, 1, 32, 32, 32, 32},                           \
+    {1, 1, 1, 1, 1, 72, 72, 56, 48, 32, 32, 32},                        \
+    {1, 1, 1, 1, 64, 64, 64, 64, 48, 32, 32, 32},                       \
+    {1, 1, 1, 80, 80, 80, 64, 64, 48, 32, 32, 32},                      \
+    {1, 1, 80, 80, 80, 80, 64, 64, 40, 40, 32, 32},                     \
+    {1, 1, 72, 72, 64, 64, 64, 64, 32, 32, 32, 0},                      \
+    {1, 80, 80, 80, 80, 80, 64, 64, 48, 40, 32, 0},                     \
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+
+#define TRSM_BATCH_NUMROWS_REAL 11
+#define TRSM_BATCH_NUMCOLS_REAL 17
+#define TRSM_BATCH_INTERVALSROW_REAL                                        \
+    20, 28, 40, 80, 112, 176, 208, 288, 352, 480
+#define TRSM_BATCH_INTERVALSCOL_REAL                                        \
+    6, 10, 12, 22, 28, 30, 36, 42, 46, 50, 60, 96, 432, 928, 960, 1472
+#define TRSM_BATCH_BLKSIZES_REAL                                            \
+    { 1,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
+    { 1,  1,  1,  1, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
+    { 1,  1,  1,  1, 16, 16, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0},   \
+    { 1, 24, 24, 24, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},   \
+    {48, 48, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 16, 16, 16, 16, 16},   \
+    {64, 64, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 24, 24, 24, 24, 24},   \
+    {64, 64, 32, 32, 24, 24, 24, 24, 32, 32, 32, 32, 32, 24, 24, 24, 24},   \
+    {64, 64, 64, 32, 32, 32, 32, 40, 40, 40, 40, 32, 32, 24, 24, 32, 32},   \
+    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32, 32},   \
+    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32,  0},   \
+    {64, 64, 64, 32, 32, 32, 48, 48, 48, 48, 40, 32, 32, 32,  0,  0,  0}
+
+#define TRSM_BATCH_NUMROWS_COMPLEX 10
+#define TRSM_BATCH_NUMCOLS_COMPLEX 16
+#define TRSM_BATCH_INTERVALSROW_COMPLEX                                     \
+    20, 28, 40, 56, 80, 112, 144, 176, 480
+#define TRSM_BATCH_INTERVALSCOL_COMPLEX                                     \
+    4, 12, 16, 28, 32, 40, 48, 50, 60, 72, 88, 176, 232, 400, 464
+#define TRSM_BATCH_BLKSIZES_COMPLEX                                         \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  8,  1,  1,  1,  1,  1,  1,  1},        \
+    {1,  1,  1,  1, 16, 16, 16, 16,  1,  1,  1, 16, 16, 16, 16, 16},        \
+    {1,  1,  1, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},        \
+    {1,  1, 32, 32, 32, 32, 32, 32, 32, 32, 32, 16, 16, 16, 16, 16},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 48, 48, 32},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 32},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 80, 80, 56, 56, 32, 32},        \
+    {1, 64, 32, 32, 32, 64, 48, 32, 32, 32, 32, 32, 32, 32, 32, 32},        \
+    {1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 64, 64, 48, 48, 48}
+// clang-format on
+
+namespace
+{
+    template <size_t ROWS, size_t COLS>
+    rocblas_trsm_blksize_table make_table(std::vector<rocblas_int> intervals_row,
+                                          std::vector<rocblas_int> intervals_col,
+                                          const rocblas_int (&blksizes)[ROWS][COLS])
+    {
+        rocblas_trsm_blksize_table table;
+        table.intervals_row = std::move(intervals_row);
+        table.intervals_col = std::move(intervals_col);
+        for(const auto& row : blksizes)
+            table.blksizes.insert(table.blksizes.end(), row, row + COLS);
+        return table;
+    }
+
+    // Names of the tables in the text format
+    constexpr const char* table_names[] = {"real", "real_batched", "complex", "complex_batched"};
+
+    rocblas_trsm_blksize_table* table_by_name(rocblas_trsm_blksize_tables& tables,
+                                              const std::string&           name)
+    {
+        rocblas_trsm_blksize_table* table[]
+            = {&tables.real, &tables.real_batched, &tables.complex, &tables.complex_batched};
+        for(size_t i = 0; i < 4; ++i)
+            if(name == table_names[i])
+                return table[i];
+        return nullptr;
+    }
+
+    bool read_keyword(std::istream& is, const char* keyword)
+    {
+        std::string word;
+        return (is >> word) && word == keyword;
+    }
+
+    // Read the keyword followed by a count of intervals
+    bool read_count(std::istream& is, const char* keyword, size_t& count)
+    {
+        return read_keyword(is, keyword) && (is >> count) && count <= 1024;
+    }
+
+    bool read_values(std::istream& is, size_t count, std::vector<rocblas_int>& values)
+    {
+        values.resize(count);
+        for(auto& v : values)
+            if(!(is >> v))
+                return false;
+        return true;
+    }
+
+    std::atomic<rocblas_int> blksize_override{-1};
+}
+
+bool rocblas_trsm_blksize_table::valid() const
+{
+    auto ascending = [](const std::vector<rocblas_int>& v) {
+        for(size_t i = 0; i < v.size(); ++i)
+            if(v[i] <= (i ? v[i - 1] : 0))
+                return false;
+        return true;
+    };
+
+    if(!ascending(intervals_row) || !ascending(intervals_col)
+       || blksizes.size() != rows() * cols())
+        return false;
+
+    for(auto blk : blksizes)
+        if(blk < 0 || blk > ROCBLAS_TRSM_BLKSIZE_MAX)
+            return false;
+
+    return true;
+}
+
+const rocblas_trsm_blksize_tables& rocblas_trsm_default_blksize_tables()
+{
+    static const rocblas_trsm_blksize_tables tables = [] {
+        static constexpr rocblas_int real[][TRSM_NUMCOLS_REAL] = {TRSM_BLKSIZES_REAL};
+        static constexpr rocblas_int real_batched[][TRSM_BATCH_NUMCOLS_REAL]
+            = {TRSM_BATCH_BLKSIZES_REAL};
+        static constexpr rocblas_int complex[][TRSM_NUMCOLS_COMPLEX] = {TRSM_BLKSIZES_COMPLEX};
+        static constexpr rocblas_int complex_batched[][TRSM_BATCH_NUMCOLS_COMPLEX]
+            = {TRSM_BATCH_BLKSIZES_COMPLEX};
+
+        rocblas_trsm_blksize_tables t;
+        t.real         = make_table({TRSM_INTERVALSROW_REAL}, {TRSM_INTERVALSCOL_REAL}, real);
+        t.real_batched = make_table(
+            {TRSM_BATCH_INTERVALSROW_REAL}, {TRSM_BATCH_INTERVALSCOL_REAL}, real_batched);
+        t.complex
+            = make_table({TRSM_INTERVALSROW_COMPLEX}, {TRSM_INTERVALSCOL_COMPLEX}, complex);
+        t.complex_batched = make_table(
+            {TRSM_BATCH_INTERVALSROW_COMPLEX}, {TRSM_BATCH_INTERVALSCOL_COMPLEX}, complex_batched);
+        return t;
+    }();
+    return tables;
+}
+
+/*******************************************************************************
+ * Text format:                                                                *
+ *                                                                             *
+ *   rocblas_trsm_blksize <version>                                            *
+ *   arch <arch>                                                               *
+ *   table <real | real_batched | complex | complex_batched>                   *
+ *   rows <number of row intervals> <upper bounds...>                          *
+ *   cols <number of column intervals> <upper bounds...>                       *
+ *   blksizes <(rows + 1) x (cols + 1) block sizes, row by row>                *
+ *   ...                                                                       *
+ *                                                                             *
+ * Lines starting with # are comments. Tables which are not given keep their   *
+ * previous values.                                                            *
+ *******************************************************************************/
+bool rocblas_trsm_blksize_tables_read(std::istream&                is,
+                                      const std::string&           arch,
+                                      rocblas_trsm_blksize_tables& tables)
+{
+    // Strip comments
+    std::string text;
+    for(std::string line; std::getline(is, line);)
+        if(line.empty() || line[0] != '#')
+            text += line + '\n';
+    std::istringstream in(text);
+
+    std::string word, file_arch;
+    int         version = 0;
+    if(!(in >> word >> version) || word != "rocblas_trsm_blksize"
+       || version != ROCBLAS_TRSM_BLKSIZE_VERSION || !(in >> word >> file_arch) || word != "arch"
+       || file_arch != arch)
+        return false;
+
+    rocblas_trsm_blksize_tables result = tables;
+    while(in >> word)
+    {
+        std::string name;
+        size_t      nrows, ncols;
+        if(word != "table" || !(in >> name))
+            return false;
+
+        rocblas_trsm_blksize_table* table = table_by_name(result, name);
+        rocblas_trsm_blksize_table  t;
+        if(!table || !read_count(in, "rows", nrows)
+           || !read_values(in, nrows, t.intervals_row) || !read_count(in, "cols", ncols)
+           || !read_values(in, ncols, t.intervals_col) || !read_keyword(in, "blksizes")
+           || !read_values(in, t.rows() * t.cols(), t.blksizes) || !t.valid())
+            return false;
+        *table = std::move(t);
+    }
+
+    tables = std::move(result);
+    return true;
+}
+
+void rocblas_trsm_blksize_tables_write(std::ostream&                      os,
+                                       const std::string&                 arch,
+                                       const rocblas_trsm_blksize_tables& tables)
+{
+    const rocblas_trsm_blksize_table* table[]
+        = {&tables.real, &tables.real_batched, &tables.complex, &tables.complex_batched};
+
+    os << "# rocBLAS trsm block sizes\n"
+       << "rocblas_trsm_blksize " << ROCBLAS_TRSM_BLKSIZE_VERSION << "\narch " << arch << "\n";
+
+    for(size_t i = 0; i < 4; ++i)
+    {
+        const auto& t = *table[i];
+        os << "\ntable " << table_names[i] << "\nrows " << t.intervals_row.size();
+        for(auto v : t.intervals_row)
+            os << ' ' << v;
+        os << "\ncols " << t.intervals_col.size();
+        for(auto v : t.intervals_col)
+            os << ' ' << v;
+        os << "\nblksizes";
+        for(size_t r = 0; r < t.rows(); ++r)
+        {
+            os << '\n';
+            for(size_t c = 0; c < t.cols(); ++c)
+                os << (c ? " " : "") << t.blksizes[r * t.cols() + c];
+        }
+        os << '\n';
+    }
+}
+
+namespace
+{
+    // The tables of a device's architecture, loaded once per architecture
+    const rocblas_trsm_blksize_tables* load_blksize_tables(int device)
+    {
+        static std::mutex                                                          mutex;
+        static std::map<std::string, std::unique_ptr<rocblas_trsm_blksize_tables>> by_arch;
+
+        std::string                 arch = rocblas_internal_get_arch_name(device);
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto& entry = by_arch[arch];
+        if(!entry)
+        {
+            entry = std::make_unique<rocblas_trsm_blksize_tables>(
+                rocblas_trsm_default_blksize_tables());
+
+            const char* dir = getenv("ROCBLAS_TRSM_BLKSIZE_PATH");
+            if(dir)
+            {
+                std::string   path = std::string(dir) + "/trsm_blksize_" + arch + ".txt";
+                std::ifstream is(path);
+                if(is && !rocblas_trsm_blksize_tables_read(is, arch, *entry))
+                    rocblas_cerr << "\nrocBLAS warning: Ignoring invalid trsm block size file "
+                                 << path << std::endl;
+            }
+        }
+        return entry.get();
+    }
+}
+
+const rocblas_trsm_blksize_tables& rocblas_trsm_current_blksize_tables(int device)
+{
+    // The tables of the first devices are read without locking once resolved. Others are
+    // resolved on each call, which only takes the lock of load_blksize_tables.
+    static constexpr int                                   max_cached = 64;
+    static std::atomic<const rocblas_trsm_blksize_tables*> by_device[max_cached] = {};
+
+    if(device < 0 || device >= max_cached)
+        return *load_blksize_tables(device);
+
+    const rocblas_trsm_blksize_tables* tables = by_device[device].load(std::memory_order_acquire);
+    if(!tables)
+    {
+        tables = load_blksize_tables(device);
+        by_device[device].store(tables, std::memory_order_release);
+    }
+    return *tables;
+}
+
+void rocblas_internal_trsm_set_blksize_override(rocblas_int blksize)
+{
+    blksize_override = blksize;
+}
+
+rocblas_int rocblas_internal_trsm_blksize_override()
+{
+    return blksize_override;
+}
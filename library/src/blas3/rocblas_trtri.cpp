@@ -59,6 +59,8 @@ namespace
             return handle->set_optimal_device_memory_size(size);
         }
 
+        auto latency = log_latency(handle, rocblas_trtri_name<T>);
+
         auto layer_mode     = handle->layer_mode;
         auto check_numerics = handle->check_numerics;
 
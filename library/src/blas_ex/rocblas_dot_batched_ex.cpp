@@ -60,6 +60,8 @@ namespace
                 return handle->set_optimal_device_memory_size(dev_bytes);
         }
 
+        auto latency = log_latency(handle, name, x_type, y_type, result_type, execution_type);
+
         auto layer_mode = handle->layer_mode;
         if(layer_mode
            & (rocblas_layer_mode_log_trace | rocblas_layer_mode_log_bench
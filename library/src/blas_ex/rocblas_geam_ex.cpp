@@ -56,6 +56,8 @@ namespace
 
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
+        auto latency = log_latency(handle, "rocblas_geam_ex", a_type, b_type, c_type, compute_type);
+
         // Perform logging
         auto layer_mode = handle->layer_mode;
         if(layer_mode
@@ -69,6 +69,9 @@ try
         handle, alpha, beta, alpha_h, beta_h, k, compute_type));
     auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
 
+    auto latency = log_latency(
+        handle, "rocblas_gemm_batched_ex", a_type, b_type, c_type, compute_type);
+
     if(!handle->is_device_memory_size_query())
     {
         // Perform logging
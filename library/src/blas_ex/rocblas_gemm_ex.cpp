@@ -70,6 +70,8 @@ namespace
             handle, alpha, beta, alpha_h, beta_h, k, compute_type));
         auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
 
+        auto latency = log_latency(handle, "rocblas_gemm_ex", a_type, b_type, c_type, compute_type);
+
         // If this is a solution fitness query (internal testing), bypass logging and error checks
         if(handle->get_solution_fitness_query())
             goto solution_fitness_query;
@@ -56,6 +56,8 @@ namespace
             }
         }
 
+        auto latency = log_latency(handle, "nrm2_ex", x_type, result_type, execution_type);
+
         auto x_type_str      = rocblas_datatype_string(x_type);
         auto result_type_str = rocblas_datatype_string(result_type);
         auto ex_type_str     = rocblas_datatype_string(execution_type);
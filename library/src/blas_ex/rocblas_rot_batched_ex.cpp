@@ -49,6 +49,9 @@ namespace
 
         RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
 
+        auto latency = log_latency(
+            handle, "rocblas_rot_batched_ex", x_type, y_type, cs_type, execution_type);
+
         auto layer_mode  = handle->layer_mode;
         auto x_type_str  = rocblas_datatype_string(x_type);
         auto y_type_str  = rocblas_datatype_string(y_type);
@@ -45,6 +45,9 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        auto latency = log_latency(
+            handle, "rocblas_trsv_batched_ex", rocblas_datatype_from_type<T>);
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
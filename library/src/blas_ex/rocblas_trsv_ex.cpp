@@ -44,6 +44,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        auto latency = log_latency(handle, "rocblas_trsv_ex", rocblas_datatype_from_type<T>);
+
         auto layer_mode = handle->layer_mode;
         if(layer_mode & rocblas_layer_mode_log_trace)
             log_trace(handle, "rocblas_trsv_ex", uplo, transA, diag, m, A, lda, B, incx);
@@ -19,9 +19,13 @@
  * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  *
  * ************************************************************************ */
+#include "blas2/rocblas_level2_threshold.hpp"
 #include "handle.hpp"
+#include <atomic>
 #include <cstdarg>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 #ifdef WIN32
 #include <windows.h>
 #endif
@@ -31,6 +35,43 @@
 // see TensileHost.cpp for normal rocblas_initialize definition
 // it isn't compiled if not BUILD_WITH_TENSILE so defining here
 extern "C" void rocblas_initialize() {}
+
+// Number of devices requested through rocblas_initialize_async
+static std::atomic<rocblas_int> initialize_async_requested{0};
+
+extern "C" rocblas_status rocblas_initialize_async(const rocblas_int* devices, rocblas_int count)
+{
+    if(count < 0)
+        return rocblas_status_invalid_size;
+    if(count && !devices)
+        return rocblas_status_invalid_pointer;
+
+    int device_count = 0;
+    if(hipGetDeviceCount(&device_count) != hipSuccess)
+        return rocblas_status_internal_error;
+    for(rocblas_int i = 0; i < count; ++i)
+        if(devices[i] < 0 || devices[i] >= device_count)
+            return rocblas_status_invalid_value;
+
+    // Without Tensile there is nothing to load, so every device is initialized immediately
+    initialize_async_requested += count ? count : device_count;
+    return rocblas_status_success;
+}
+
+extern "C" rocblas_status rocblas_query_initialize_progress(rocblas_initialize_progress* progress)
+{
+    if(!progress)
+        return rocblas_status_invalid_pointer;
+    *progress           = {};
+    progress->devices   = initialize_async_requested;
+    progress->completed = progress->devices;
+    return rocblas_status_success;
+}
+
+extern "C" rocblas_status rocblas_initialize_wait()
+{
+    return rocblas_status_success;
+}
 #endif
 
 // forcing early cleanup
@@ -73,19 +114,50 @@ static inline int getActiveDevice()
     return device;
 }
 
-static inline int getActiveArch(int deviceId)
+// Properties of a device which do not change, queried once and shared by all handles on it
+struct rocblas_device_properties
+{
+    int                              arch;
+    std::string                      arch_name;
+    const rocblas_level2_thresholds* level2_thresholds;
+};
+
+static const rocblas_device_properties& getDeviceProperties(int deviceId)
 {
-    hipDeviceProp_t deviceProperties;
-    hipGetDeviceProperties(&deviceProperties, deviceId);
-    return deviceProperties.gcnArch;
+    static std::mutex                                         mutex;
+    static std::unordered_map<int, rocblas_device_properties> properties;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = properties.find(deviceId);
+    if(it == properties.end())
+    {
+        hipDeviceProp_t deviceProperties;
+        hipGetDeviceProperties(&deviceProperties, deviceId);
+
+        // Level 2 dispatch thresholds of the device's architecture
+        std::string                      arch_name = rocblas_internal_get_arch_name(deviceId);
+        const rocblas_level2_thresholds* level2_thresholds
+            = rocblas_level2_current_threshold_db().lookup(arch_name).data();
+
+        it = properties
+                 .emplace(deviceId,
+                          rocblas_device_properties{
+                              deviceProperties.gcnArch, arch_name, level2_thresholds})
+                 .first;
+    }
+    return it->second;
 }
 
 /*******************************************************************************
  * constructor
  ******************************************************************************/
 _rocblas_handle::_rocblas_handle()
-    : device(getActiveDevice()) // active device is handle device
-    , arch(getActiveArch(device))
+    : device_arena([this](void** ptr, size_t size) { return device_arena_allocate(ptr, size); },
+                   [this](void* ptr) { return device_arena_deallocate(ptr); })
+    , workspace_pools([this](void** ptr, size_t size) { return device_arena_allocate(ptr, size); },
+                      [this](void* ptr) { return device_arena_deallocate(ptr); })
+    , device(getActiveDevice()) // active device is handle device
+    , arch(getDeviceProperties(device).arch)
 {
     archMajor = arch / 100; // this may need to switch to string handling in the future
 
@@ -99,7 +171,8 @@ _rocblas_handle::_rocblas_handle()
     }
 
     // Device memory size
-    const char* env = read_env("ROCBLAS_DEVICE_MEMORY_SIZE");
+    size_t      device_memory_size = 0;
+    const char* env                = read_env("ROCBLAS_DEVICE_MEMORY_SIZE");
     if(env)
         device_memory_size = strtoul(env, nullptr, 0);
 
@@ -125,10 +198,29 @@ _rocblas_handle::_rocblas_handle()
         }
     }
 
+    // Clones of the handle, and the arena of each stream, allocate a workspace of the same size
+    device_memory_base_size = device_memory_size;
+    workspace_pools.set_base_size(device_memory_base_size);
+
+    // Slabs appended to the device arena on demand are kept by default, so that calls which
+    // need more than the base workspace allocate it once. If ROCBLAS_DEVICE_MEMORY_HIGH_WATER
+    // is set, they are released when the arena becomes idle with more than that many bytes.
+    const char* high_water_env = read_env("ROCBLAS_DEVICE_MEMORY_HIGH_WATER");
+    if(high_water_env)
+    {
+        device_arena.set_high_water(strtoul(high_water_env, nullptr, 0));
+        workspace_pools.set_high_water(device_arena.high_water());
+    }
+
+    // Each stream has its own device arena if ROCBLAS_WORKSPACE_POOL_BUDGET is nonzero
+    const char* pool_budget_env = read_env("ROCBLAS_WORKSPACE_POOL_BUDGET");
+    if(pool_budget_env)
+        workspace_pools.set_budget(strtoul(pool_budget_env, nullptr, 0));
+
     if(!stream_order_alloc)
-    { // Allocate device memory
-        if(device_memory_size)
-            THROW_IF_HIP_ERROR((hipMalloc)(&device_memory, device_memory_size));
+    { // Allocate device memory, unless it is allocated per stream on first use
+        if(device_memory_size && !use_workspace_pools())
+            THROW_IF_HIP_ERROR(hipError_t(device_arena.reserve(device_memory_size)));
     }
     else
     {
@@ -138,11 +230,10 @@ _rocblas_handle::_rocblas_handle()
         // The following allocation & free of device memory using hipMallocAsync/hipFreeAsync will allocate memory from
         // the OS and release it to default memory pool. Further allocation of memory using hipMallocAsync
         // will be from the memory pool and it will be faster.
+        void* device_memory = nullptr;
         THROW_IF_HIP_ERROR((hipMallocAsync)(&device_memory, device_memory_size, stream));
 
         THROW_IF_HIP_ERROR((hipFreeAsync)(device_memory, stream));
-
-        device_memory = nullptr;
 #else
         rocblas_cerr
             << "rocBLAS internal error: Stream order allocation is supported on ROCm 5.3 and above."
@@ -156,6 +247,177 @@ _rocblas_handle::_rocblas_handle()
 
     // Initialize numerical checking
     init_check_numerics();
+
+    // Initialize solution selection cache
+    init_solution_cache();
+
+    // Level 2 dispatch thresholds and tuned GEMM solutions of the handle's architecture.
+    // ROCBLAS_GEMM_OVERRIDE_PATH is read on each handle creation, like ROCBLAS_LAYER.
+    const rocblas_device_properties& properties = getDeviceProperties(device);
+
+    level2_thresholds = properties.level2_thresholds;
+    gemm_overrides    = rocblas_gemm_current_override_db().lookup(properties.arch_name);
+}
+
+/*******************************************************************************
+ * clone constructor
+ ******************************************************************************/
+_rocblas_handle::_rocblas_handle(const _rocblas_handle& src, clone_t)
+    : device_arena([this](void** ptr, size_t size) { return device_arena_allocate(ptr, size); },
+                   [this](void* ptr) { return device_arena_deallocate(ptr); })
+    , workspace_pools([this](void** ptr, size_t size) { return device_arena_allocate(ptr, size); },
+                      [this](void* ptr) { return device_arena_deallocate(ptr); })
+    , device(src.device)
+    , arch(src.arch)
+{
+    archMajor = src.archMajor;
+
+    copy_settings(src);
+
+    stream_order_alloc = src.stream_order_alloc;
+    device_arena.set_high_water(src.device_arena.high_water());
+    workspace_pools.set_high_water(src.device_arena.high_water());
+    workspace_pools.set_budget(src.workspace_pools.budget());
+
+    // A workspace owned by the user is not shared, so the clone manages its own
+    if(src.device_memory_owner == rocblas_device_memory_ownership::user_owned)
+    {
+        device_memory_owner     = rocblas_device_memory_ownership::rocblas_managed;
+        device_memory_base_size = DEFAULT_DEVICE_MEMORY_SIZE;
+    }
+    else
+    {
+        device_memory_owner     = src.device_memory_owner;
+        device_memory_base_size = src.device_memory_base_size;
+    }
+    workspace_pools.set_base_size(device_memory_base_size);
+
+    // The workspace is allocated on the device of src, which may not be the current device
+    auto saved_device_id = push_device_id();
+    if(!stream_order_alloc && device_memory_base_size && !use_workspace_pools())
+        THROW_IF_HIP_ERROR(hipError_t(device_arena.reserve(device_memory_base_size)));
+}
+
+/*******************************************************************************
+ * Copy the settings of another handle. The modes are copied rather than
+ * shared, so later changes to either handle do not affect the other.
+ ******************************************************************************/
+void _rocblas_handle::copy_settings(const _rocblas_handle& src)
+{
+    pointer_mode           = src.pointer_mode;
+    layer_mode             = src.layer_mode;
+    atomics_mode           = src.atomics_mode;
+    performance_metric     = src.performance_metric;
+    check_numerics         = src.check_numerics;
+    rocblas_int8_type      = src.rocblas_int8_type;
+    level2_thresholds      = src.level2_thresholds;
+    gemm_overrides         = src.gemm_overrides;
+    solution_fitness_query = nullptr;
+    startEvent             = nullptr;
+    stopEvent              = nullptr;
+    stream                 = 0;
+
+    // The log streams share the workers, and so the files, of src
+    auto dup_log_stream = [](const std::unique_ptr<rocblas_internal_ostream>& os) {
+        return os ? std::make_unique<rocblas_internal_ostream>(os->dup())
+                  : std::unique_ptr<rocblas_internal_ostream>{};
+    };
+    log_trace_os   = dup_log_stream(src.log_trace_os);
+    log_bench_os   = dup_log_stream(src.log_bench_os);
+    log_profile_os = dup_log_stream(src.log_profile_os);
+
+    // Setting the capacity discards the cached solutions, which are kept if it is unchanged
+    if(solution_cache.capacity() != src.solution_cache.capacity())
+        solution_cache.set_capacity(src.solution_cache.capacity());
+}
+
+/*******************************************************************************
+ * Reset an idle handle for reuse by a handle pool
+ ******************************************************************************/
+bool _rocblas_handle::reset_settings(const _rocblas_handle& prototype)
+{
+    // Memory kept for a captured graph is only released when the handle is destroyed
+    if(alpha_beta_memcpy_complete || !dev_mem_pointers.empty() || !host_mem_pointers.empty())
+        return false;
+
+    if(device_arena.in_use() || workspace_pools.in_use()
+       || device_memory_owner != prototype.device_memory_owner
+       || device_memory_base_size != prototype.device_memory_base_size
+       || stream_order_alloc != prototype.stream_order_alloc
+       || workspace_pools.budget() != prototype.workspace_pools.budget())
+        return false;
+
+    copy_settings(prototype);
+    device_arena.set_high_water(prototype.device_arena.high_water());
+    last_gemm_solution_index = 0;
+    return true;
+}
+
+/*******************************************************************************
+ * Handle pool
+ ******************************************************************************/
+_rocblas_handle_pool::~_rocblas_handle_pool()
+{
+    for(auto& entry : devices)
+        for(rocblas_handle handle : entry.second.parked)
+            delete handle;
+}
+
+rocblas_handle _rocblas_handle_pool::acquire()
+{
+    int                    device = getActiveDevice();
+    const _rocblas_handle* prototype;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        device_entry&               entry = devices[device];
+        if(!entry.parked.empty())
+        {
+            rocblas_handle handle = entry.parked.back();
+            entry.parked.pop_back();
+            ++m_hits;
+            return handle;
+        }
+
+        // The prototype only provides settings, so its workspace is released
+        if(!entry.prototype)
+        {
+            entry.prototype = std::make_unique<_rocblas_handle>();
+            THROW_IF_HIP_ERROR(hipError_t(entry.prototype->device_arena.clear()));
+        }
+        prototype = entry.prototype.get();
+        ++m_misses;
+    }
+
+    // The prototype is never modified, so it is cloned without holding the lock
+    return new _rocblas_handle(*prototype, _rocblas_handle::clone_t{});
+}
+
+void _rocblas_handle_pool::release(rocblas_handle handle)
+{
+    // Work queued on the handle's stream must finish before its workspace is reused
+    {
+        auto saved_device_id = handle->push_device_id();
+        THROW_IF_HIP_ERROR(hipStreamSynchronize(handle->stream));
+    }
+
+    // Handles which are not parked are destroyed after the lock is released
+    std::unique_ptr<_rocblas_handle> unparked(handle);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = devices.find(handle->getDevice());
+    if(it != devices.end() && it->second.prototype && it->second.parked.size() < max_parked
+       && handle->reset_settings(*it->second.prototype))
+        it->second.parked.push_back(unparked.release());
+}
+
+void _rocblas_handle_pool::stats(size_t* hits, size_t* misses, size_t* parked)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    *hits   = m_hits;
+    *misses = m_misses;
+    *parked = 0;
+    for(auto& entry : devices)
+        *parked += entry.second.parked.size();
 }
 
 /*******************************************************************************
@@ -163,45 +425,33 @@ _rocblas_handle::_rocblas_handle()
  ******************************************************************************/
 _rocblas_handle::~_rocblas_handle()
 {
-    if(device_memory_in_use)
+    if(device_arena.in_use() || workspace_pools.in_use())
     {
         rocblas_cerr
             << "rocBLAS internal error: Handle object destroyed while device memory still in use."
             << std::endl;
         rocblas_abort();
     }
-    // Free device memory unless it's user-owned
+
+    // Free device memory slabs, except user-owned ones
+    hipError_t hipStatus = hipError_t(device_arena.clear());
+    if(hipStatus == hipSuccess)
+        hipStatus = hipError_t(workspace_pools.clear());
+    if(hipStatus != hipSuccess)
+    {
+        rocblas_cerr << "rocBLAS error during freeing of allocated memory in handle destructor: "
+                     << rocblas_status_to_string(get_rocblas_status_for_hip_status(hipStatus))
+                     << std::endl;
+        rocblas_abort();
+    }
+
     if(device_memory_owner != rocblas_device_memory_ownership::user_owned)
     {
-        hipError_t hipStatus;
-        if(!stream_order_alloc)
-        {
-            hipStatus = (hipFree)(device_memory);
-            if(hipStatus != hipSuccess)
-            {
-                rocblas_cerr
-                    << "rocBLAS error during freeing of allocated memory in handle destructor: "
-                    << rocblas_status_to_string(get_rocblas_status_for_hip_status(hipStatus))
-                    << std::endl;
-                rocblas_abort();
-            };
-        }
-        else
+        if(stream_order_alloc)
         {
 // hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
 // Support for default stream added in hip version 5.3.0
 #if HIP_VERSION >= 50300000
-            hipStatus = (device_memory) ? (hipFreeAsync)(device_memory, stream) : hipSuccess;
-            if(hipStatus != hipSuccess)
-            {
-                rocblas_cerr << "rocBLAS error during freeing of allocated memory in handle "
-                                "destructor (stream order allocation): "
-                             << rocblas_status_to_string(
-                                    get_rocblas_status_for_hip_status(hipStatus))
-                             << std::endl;
-                rocblas_abort();
-            };
-
             for(auto dev_mem : dev_mem_pointers)
             {
                 hipStatus = (dev_mem) ? (hipFreeAsync)(dev_mem, stream) : hipSuccess;
@@ -234,38 +484,49 @@ _rocblas_handle::~_rocblas_handle()
 }
 
 /*******************************************************************************
- * helper for allocating device memory
+ * device arena backend, allocating and freeing slabs on the handle's device
  ******************************************************************************/
-#if ROCBLAS_REALLOC_ON_DEMAND
-bool _rocblas_handle::device_allocator(size_t size)
+int _rocblas_handle::device_arena_allocate(void** ptr, size_t size)
 {
-    bool success = size <= device_memory_size - device_memory_in_use;
-    if(!success && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
-    {
-        if(device_memory_in_use)
-        {
-            rocblas_cerr << "rocBLAS internal error: Cannot reallocate device memory while it is "
-                            "already in use.";
-            rocblas_abort();
-        }
-
-        // Temporarily change the thread's default device ID to the handle's device ID
-        // cppcheck-suppress unreadVariable
-        auto saved_device_id = push_device_id();
+    // Temporarily change the thread's default device ID to the handle's device ID
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = push_device_id();
 
-        device_memory_size = 0;
-        if(!device_memory || (hipFree)(device_memory) == hipSuccess)
-        {
-            success = (hipMalloc)(&device_memory, size) == hipSuccess;
-            if(success)
-                device_memory_size = size;
-            else
-                device_memory = nullptr;
-        }
-    }
-    return success;
+    if(!stream_order_alloc)
+        return (hipMalloc)(ptr, size);
+// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
+// Support for default stream added in hip version 5.3.0
+#if HIP_VERSION >= 50300000
+    return (hipMallocAsync)(ptr, size, stream);
+#else
+    return hipErrorNotSupported;
+#endif
 }
+
+int _rocblas_handle::device_arena_deallocate(void* ptr)
+{
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = push_device_id();
+
+    if(!stream_order_alloc)
+        return (hipFree)(ptr);
+#if HIP_VERSION >= 50300000
+    return (hipFreeAsync)(ptr, stream);
+#else
+    return hipErrorNotSupported;
 #endif
+}
+
+/*******************************************************************************
+ * helper for allocating device memory from the device arena, which may grow
+ * by a slab when rocBLAS is managing the device memory
+ ******************************************************************************/
+void* _rocblas_handle::device_allocator(rocblas_device_arena& arena, size_t size)
+{
+    bool grow = ROCBLAS_REALLOC_ON_DEMAND
+                && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed;
+    return arena.allocate(size, grow);
+}
 
 /*******************************************************************************
  * start device memory size queries
@@ -317,7 +578,7 @@ try
         return rocblas_status_invalid_handle;
     if(!size)
         return rocblas_status_invalid_pointer;
-    *size = handle->device_memory_size;
+    *size = handle->device_arena.capacity() + handle->workspace_pools.capacity();
     return rocblas_status_success;
 }
 catch(...)
@@ -334,27 +595,17 @@ static rocblas_status free_existing_device_memory(rocblas_handle handle)
     // Cannot change memory allocation when a device_malloc object is alive and
     // using device memory. This should never happen unless this function is
     // called from inside library code which borrows allocated device memory.
-    if(handle->device_memory_in_use)
+    if(handle->device_arena.in_use() || handle->workspace_pools.in_use())
         return rocblas_status_internal_error;
 
-    // Free existing device memory in handle, unless owned by user
-    if(handle->device_memory
-       && handle->device_memory_owner != rocblas_device_memory_ownership::user_owned)
-    {
-        if(!handle->stream_order_alloc)
-            RETURN_IF_HIP_ERROR((hipFree)(handle->device_memory));
-// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
-// Support for default stream added in hip version 5.3.0
-#if HIP_VERSION >= 50300000
-        else
-            RETURN_IF_HIP_ERROR((hipFreeAsync)(handle->device_memory, handle->stream));
-#endif
-    }
+    // Free existing device memory slabs in handle, unless owned by user
+    RETURN_IF_HIP_ERROR(hipError_t(handle->device_arena.clear()));
+    RETURN_IF_HIP_ERROR(hipError_t(handle->workspace_pools.clear()));
 
-    // Clear the memory size and address, and set the memory to be rocBLAS-managed
-    handle->device_memory_size  = 0;
-    handle->device_memory       = nullptr;
+    // Set the memory to be rocBLAS-managed
     handle->device_memory_owner = rocblas_device_memory_ownership::rocblas_managed;
+    handle->device_memory_base_size = 0;
+    handle->workspace_pools.set_base_size(0);
 
     return rocblas_status_success;
 }
@@ -384,28 +635,20 @@ try
     // Allocate size rounded up to MIN_CHUNK_SIZE
     size = roundup_device_memory_size(size);
 
-    hipError_t hipStatus;
-    if(!handle->stream_order_alloc)
-        hipStatus = (hipMalloc)(&handle->device_memory, size);
-// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
-// Support for default stream added in hip version 5.3.0
-#if HIP_VERSION >= 50300000
-    else
-        hipStatus = (hipMallocAsync)(&handle->device_memory, size, handle->stream);
-#endif
+    hipError_t hipStatus = hipError_t(handle->device_arena.reserve(size));
 
     if(hipStatus != hipSuccess)
     {
-        // If allocation fails, nullify device memory address and return error
+        // If allocation fails, return error
         // Leave the memory under rocBLAS management for future calls
-        handle->device_memory = nullptr;
         return get_rocblas_status_for_hip_status(hipStatus);
     }
     else
     {
-        // If allocation succeeds, set size, mark it under user-management, and return success
-        handle->device_memory_size  = size;
+        // If allocation succeeds, mark it under user-management, and return success
         handle->device_memory_owner = rocblas_device_memory_ownership::user_managed;
+        handle->device_memory_base_size = size;
+        handle->workspace_pools.set_base_size(size);
         return rocblas_status_success;
     }
 }
@@ -437,8 +680,7 @@ try
     if(size && addr)
     {
         handle->device_memory_owner = rocblas_device_memory_ownership::user_owned;
-        handle->device_memory_size  = size;
-        handle->device_memory       = addr;
+        handle->device_arena.adopt(addr, size, false);
     }
 
     return rocblas_status_success;
@@ -469,6 +711,101 @@ extern "C" bool rocblas_is_user_managing_device_memory(rocblas_handle handle)
     return handle && handle->device_memory_owner == rocblas_device_memory_ownership::user_managed;
 }
 
+/*******************************************************************************
+ * Returns statistics of the handle's device memory arena
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_device_memory_stats(rocblas_handle handle,
+                                                          size_t*        peak,
+                                                          size_t*        slabs,
+                                                          size_t*        reallocations)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    if(!peak || !slabs || !reallocations)
+        return rocblas_status_invalid_pointer;
+
+    *peak          = handle->device_arena.peak();
+    *slabs         = handle->device_arena.slabs();
+    *reallocations = handle->device_arena.reallocations();
+
+    // Include the per-stream device arenas
+    handle->workspace_pools.for_each([=](const rocblas_device_arena& arena) {
+        *peak = std::max(*peak, arena.peak());
+        *slabs += arena.slabs();
+        *reallocations += arena.reallocations();
+    });
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the byte budget of the per-stream workspace pools
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_workspace_pool_budget(rocblas_handle handle, size_t budget)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    // Cannot move device memory between arenas while a device_malloc object is alive
+    if(handle->device_arena.in_use() || handle->workspace_pools.in_use())
+        return rocblas_status_internal_error;
+
+    // Temporarily change the thread's default device ID to the handle's device ID
+    auto saved_device_id = handle->push_device_id();
+
+    if(!budget)
+    {
+        // Free the per-stream arenas, and return to a single arena for all streams
+        RETURN_IF_HIP_ERROR(hipError_t(handle->workspace_pools.clear()));
+    }
+    else if(!handle->workspace_pools.enabled()
+            && handle->device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
+    {
+        // Free the shared arena, which is replaced by per-stream arenas
+        RETURN_IF_HIP_ERROR(hipError_t(handle->device_arena.clear()));
+    }
+
+    handle->workspace_pools.set_budget(budget);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Returns statistics of the per-stream workspace pools
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_workspace_pool_stats(rocblas_handle handle,
+                                                           size_t*        pools,
+                                                           size_t*        hits,
+                                                           size_t*        misses,
+                                                           size_t*        evictions)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    if(!pools || !hits || !misses || !evictions)
+        return rocblas_status_invalid_pointer;
+
+    *pools     = handle->workspace_pools.size();
+    *hits      = handle->workspace_pools.hits();
+    *misses    = handle->workspace_pools.misses();
+    *evictions = handle->workspace_pools.evictions();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /* \brief
    \details
    Returns true if the handle is in device memory size query mode.
@@ -686,13 +1023,17 @@ void _rocblas_handle::init_logging()
     {
         layer_mode = static_cast<rocblas_layer_mode>(strtol(str_layer_mode, 0, 0));
 
-        // open log_trace file
-        if(layer_mode & rocblas_layer_mode_log_trace)
-            log_trace_os = open_log_stream("ROCBLAS_LOG_TRACE_PATH");
+        // trace and bench logs are written to the binary log file when it is turned on
+        if(!(layer_mode & rocblas_layer_mode_log_binary))
+        {
+            // open log_trace file
+            if(layer_mode & rocblas_layer_mode_log_trace)
+                log_trace_os = open_log_stream("ROCBLAS_LOG_TRACE_PATH");
 
-        // open log_bench file
-        if(layer_mode & rocblas_layer_mode_log_bench)
-            log_bench_os = open_log_stream("ROCBLAS_LOG_BENCH_PATH");
+            // open log_bench file
+            if(layer_mode & rocblas_layer_mode_log_bench)
+                log_bench_os = open_log_stream("ROCBLAS_LOG_BENCH_PATH");
+        }
 
         // open log_profile file
         if(layer_mode & rocblas_layer_mode_log_profile)
@@ -753,3 +1094,53 @@ void _rocblas_handle::init_check_numerics()
             = static_cast<rocblas_check_numerics_mode>(strtol(str_check_numerics_mode, 0, 0));
     }
 }
+
+/*******************************************************************************
+ * Solution cache initialization
+ ******************************************************************************/
+void _rocblas_handle::init_solution_cache()
+{
+    // set the solution cache capacity from environment variable ROCBLAS_SOLUTION_CACHE_SIZE
+    const char* str_cache_size = read_env("ROCBLAS_SOLUTION_CACHE_SIZE");
+    if(str_cache_size)
+        solution_cache.set_capacity(strtoul(str_cache_size, nullptr, 0));
+}
+
+/*******************************************************************************
+ * Set the maximum number of entries in the solution selection cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_solution_cache_size(rocblas_handle handle, size_t size)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->solution_cache.set_capacity(size);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get solution selection cache statistics
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_solution_cache_info(rocblas_handle handle,
+                                                          size_t*        hits,
+                                                          size_t*        misses,
+                                                          size_t*        entries)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!hits || !misses || !entries)
+        return rocblas_status_invalid_pointer;
+    *hits    = handle->solution_cache.hits();
+    *misses  = handle->solution_cache.misses();
+    *entries = handle->solution_cache.size();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
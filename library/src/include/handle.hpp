@@ -24,14 +24,19 @@
 
 #include "macros.hpp"
 #include "rocblas.h"
+#include "rocblas_device_arena.hpp"
+#include "rocblas_gemm_override.hpp"
 #include "rocblas_ostream.hpp"
+#include "rocblas_solution_cache.hpp"
 #include "utility.hpp"
 #include <array>
 #include <cstddef>
 #include <hip/hip_runtime.h>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #ifdef WIN32
 #include <stdio.h>
 #define STDOUT_FILENO _fileno(stdout)
@@ -40,14 +45,17 @@
 #include <unistd.h>
 #endif
 #include <utility>
+#include <vector>
 
 // forcing early cleanup
 extern "C" ROCBLAS_EXPORT void rocblas_shutdown();
 
-// Whether rocBLAS can reallocate device memory on demand, at the cost of only
-// allowing one allocation at a time, and at the cost of potential synchronization.
-// If this is 0, then stack-like allocation is allowed, but reallocation on demand
-// does not occur.
+struct rocblas_level2_thresholds;
+
+// Whether rocBLAS can grow device memory on demand by appending slabs to the
+// handle's device arena, at the cost of potential synchronization when a slab
+// is allocated. If this is 0, then stack-like allocation is allowed, but the
+// device memory never grows.
 #define ROCBLAS_REALLOC_ON_DEMAND 1
 
 // Round up size to the nearest MIN_CHUNK_SIZE
@@ -176,12 +184,26 @@ private:
     // clang-format on
 
 public:
+    // Tag selecting the constructor used by rocblas_clone_handle
+    struct clone_t
+    {
+    };
+
     _rocblas_handle();
     ~_rocblas_handle();
 
+    // Create a handle on the device of src, with a copy of its settings and a workspace of the
+    // same size. The device properties are shared and the log files are not reopened.
+    _rocblas_handle(const _rocblas_handle& src, clone_t);
+
     _rocblas_handle(const _rocblas_handle&) = delete;
     _rocblas_handle& operator=(const _rocblas_handle&) = delete;
 
+    // Reset an idle handle to the settings of prototype so that it can be reused, keeping its
+    // device memory. Returns false if its device memory is configured differently from that of
+    // prototype, or it was used in stream capture, in which case it must be destroyed instead.
+    bool reset_settings(const _rocblas_handle& prototype);
+
     // Set the HIP default device ID to the handle's device ID, and restore on exit
     auto push_device_id()
     {
@@ -225,6 +247,19 @@ public:
     // used by hipBLAS to set int8 datatype to int8_t or rocblas_int8x4
     rocblas_int8_type_for_hipblas rocblas_int8_type = rocblas_int8_type_for_hipblas_default;
 
+    // Cache of Tensile solution selections, disabled by default
+    rocblas_solution_cache solution_cache;
+    void                   init_solution_cache();
+
+    // Level 2 dispatch thresholds of the handle's architecture, indexed by precision
+    const rocblas_level2_thresholds* level2_thresholds = nullptr;
+
+    // Tuned GEMM solutions of the handle's architecture, or nullptr if there are none
+    const rocblas_gemm_override_table* gemm_overrides = nullptr;
+
+    // Solution index, starting at 1, of the last gemm which Tensile ran on the handle, or 0
+    rocblas_int last_gemm_solution_index = 0;
+
     // logging streams
     std::unique_ptr<rocblas_internal_ostream> log_trace_os;
     std::unique_ptr<rocblas_internal_ostream> log_bench_os;
@@ -239,9 +274,17 @@ public:
     friend rocblas_status(::rocblas_set_device_memory_size)(_rocblas_handle*, size_t);
     friend rocblas_status(::free_existing_device_memory)(rocblas_handle);
     friend rocblas_status(::rocblas_set_workspace)(_rocblas_handle*, void*, size_t);
+    friend rocblas_status(::rocblas_get_device_memory_stats)(_rocblas_handle*,
+                                                             size_t*,
+                                                             size_t*,
+                                                             size_t*);
+    friend rocblas_status(::rocblas_set_workspace_pool_budget)(_rocblas_handle*, size_t);
+    friend rocblas_status(::rocblas_get_workspace_pool_stats)(
+        _rocblas_handle*, size_t*, size_t*, size_t*, size_t*);
     friend bool(::rocblas_is_managing_device_memory)(_rocblas_handle*);
     friend bool(::rocblas_is_user_managing_device_memory)(_rocblas_handle*);
     friend rocblas_status(::rocblas_set_stream)(_rocblas_handle*, hipStream_t);
+    friend struct _rocblas_handle_pool;
 
     // C interfaces that interact with the solution selection process
     friend rocblas_status(::rocblas_set_solution_fitness_query)(_rocblas_handle*, double*);
@@ -256,9 +299,14 @@ public:
         return device_memory_size_query;
     }
 
-    size_t get_available_workspace()
+    // Largest workspace available to the current stream. This neither creates nor reorders
+    // the per-stream arenas; a stream without one will get an arena of the base size.
+    size_t get_available_workspace() const
     {
-        return (device_memory_size - device_memory_in_use);
+        if(!use_workspace_pools())
+            return device_arena.available();
+        auto* arena = workspace_pools.find(stream);
+        return arena ? arena->available() : workspace_pools.base_size();
     }
 
     // Get the solution fitness query
@@ -354,9 +402,8 @@ private:
     static constexpr size_t DEFAULT_DEVICE_MEMORY_SIZE = 32 * 1024 * 1024;
 
     // Variables holding state of device memory allocation
-    void*                           device_memory              = nullptr;
-    size_t                          device_memory_size         = 0;
-    size_t                          device_memory_in_use       = 0;
+    rocblas_device_arena            device_arena;
+    rocblas_device_arena_pool       workspace_pools;
     bool                            device_memory_size_query   = false;
     bool                            alpha_beta_memcpy_complete = false;
     rocblas_device_memory_ownership device_memory_owner;
@@ -366,16 +413,44 @@ private:
 
     bool stream_order_alloc = false;
 
+    // Size of the workspace allocated when the handle was created or last resized, which is
+    // also allocated for its clones
+    size_t device_memory_base_size = 0;
+
     // Solution fitness query (used for internal testing)
     double* solution_fitness_query = nullptr;
 
     // rocblas by default take the system default stream 0 users cannot create
     hipStream_t stream = 0;
 
-#if ROCBLAS_REALLOC_ON_DEMAND
-    // Helper for device memory allocator
-    bool device_allocator(size_t size);
-#endif
+    // Copy the modes, logging configuration and solution cache capacity of src
+    void copy_settings(const _rocblas_handle& src);
+
+    // Helpers for the device arena backend and device memory allocator
+    int   device_arena_allocate(void** ptr, size_t size);
+    int   device_arena_deallocate(void* ptr);
+    void* device_allocator(rocblas_device_arena& arena, size_t size);
+
+    // Whether each stream has its own device arena from workspace_pools
+    bool use_workspace_pools() const
+    {
+        return workspace_pools.enabled() && !stream_order_alloc
+               && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed;
+    }
+
+    // Device arena for the current stream. A size query launches no kernels, so it does not
+    // create an arena for a new stream, and uses the shared arena instead.
+    rocblas_device_arena& get_device_arena()
+    {
+        if(!use_workspace_pools())
+            return device_arena;
+        if(device_memory_size_query)
+        {
+            auto* arena = workspace_pools.find(stream);
+            return arena ? *arena : device_arena;
+        }
+        return workspace_pools.acquire(stream);
+    }
 
     // Device ID is created at handle creation time and remains in effect for the life of the handle.
     const int device;
@@ -390,8 +465,9 @@ private:
     {
     protected:
         // Order is important (pointers member declared last):
-        rocblas_handle handle;
-        size_t         prev_device_memory_in_use;
+        rocblas_handle        handle;
+        rocblas_device_arena* arena;
+        size_t                prev_device_memory_in_use;
         size_t         size;
         void*          dev_mem = nullptr;
         hipStream_t    stream_in_use;
@@ -433,19 +509,16 @@ private:
             }
             else
             {
-    #if ROCBLAS_REALLOC_ON_DEMAND
-                success = handle->device_allocator(size);
-    #else
-                success = size <= handle->device_memory_size - handle->device_memory_in_use;
-    #endif
-                // If allocation failed, return an array of nullptr's
                 // If total size is 0, return an array of nullptr's, but leave it marked as successful
-                if(!success || !size)
+                if(!size)
                     return decltype(pointers)(sizeof...(sizes));
 
-                // We allocate the total amount needed, taking it from the available device memory.
-                addr = static_cast<char*>(handle->device_memory) + handle->device_memory_in_use;
-                handle->device_memory_in_use += size;
+                // We allocate the total amount needed, taking it from the device arena.
+                // If allocation failed, return an array of nullptr's
+                addr    = static_cast<char*>(handle->device_allocator(*arena, size));
+                success = addr != nullptr;
+                if(!success)
+                    return decltype(pointers)(sizeof...(sizes));
             }
             // An array of pointers to all of the allocated arrays is formed.
             // If a size is 0, the corresponding pointer is nullptr
@@ -459,7 +532,8 @@ private:
         template <typename... Ss>
         explicit _device_malloc(rocblas_handle handle, Ss... sizes)
             : handle(handle)
-            , prev_device_memory_in_use(handle->device_memory_in_use)
+            , arena(&handle->get_device_arena())
+            , prev_device_memory_in_use(arena->in_use())
             , size(0)
             , stream_in_use(handle->stream)
             , success(true)
@@ -471,7 +545,8 @@ private:
         // Constructor for allocating count pointers of a certain total size
         explicit _device_malloc(rocblas_handle handle, std::nullptr_t, size_t count, size_t total)
             : handle(handle)
-            , prev_device_memory_in_use(handle->device_memory_in_use)
+            , arena(&handle->get_device_arena())
+            , prev_device_memory_in_use(arena->in_use())
             , size(roundup_device_memory_size(total))
             , stream_in_use(handle->stream)
             , success(true)
@@ -490,18 +565,10 @@ private:
             }
             else
             {
-#if ROCBLAS_REALLOC_ON_DEMAND
-            success = handle->device_allocator(size);
-#else
-            success = size <= handle->device_memory_size - handle->device_memory_in_use;
-#endif
+            void* addr = size ? handle->device_allocator(*arena, size) : nullptr;
+            success    = addr || !size;
             for(auto i= 0 ; i < count ; i++)
-            {    pointers.push_back(success ? static_cast<char*>(handle->device_memory)
-                                         + handle->device_memory_in_use : nullptr);
-            }
-
-            if(success)
-                handle->device_memory_in_use += size;
+                pointers.push_back(addr);
             }
         }
 
@@ -514,6 +581,7 @@ private:
         // moves to, or the LIFO ordering will be violated and flagged.
         _device_malloc(_device_malloc&& other) noexcept
             : handle(other.handle)
+            , arena(other.arena)
             , prev_device_memory_in_use(other.prev_device_memory_in_use)
             , size(other.size)
             , dev_mem(other.dev_mem)
@@ -571,9 +639,10 @@ private:
                 }
                 else
                 {
-                    // Subtract size from the handle's device_memory_in_use, making sure
-                    // it matches the device_memory_in_use when this object was created.
-                    if((handle->device_memory_in_use -= size) != prev_device_memory_in_use)
+                    // Release size bytes from the device arena they were taken from, making sure
+                    // the bytes in use match those in use when this object was created.
+                    int hipStatus;
+                    if(arena->release(size, &hipStatus) != prev_device_memory_in_use)
                     {
                         rocblas_cerr
                             << "rocBLAS internal error: device_malloc() RAII object not "
@@ -586,6 +655,11 @@ private:
                             << std::endl;
                         rocblas_abort();
                     }
+
+                    // A slab which cannot be freed is kept, and freed with the handle
+                    if(hipStatus != hipSuccess)
+                        rocblas_cerr << "rocBLAS warning: device memory could not be freed: "
+                                     << hipGetErrorString(hipError_t(hipStatus)) << std::endl;
                 }
             }
         }
@@ -669,6 +743,49 @@ public:
     };
 };
 
+/*******************************************************************************
+ * rocblas_handle_pool parks released handles, with their device memory, for
+ * reuse by later acquisitions on the same device. New handles are cloned from
+ * a prototype created once per device, so they share its device properties
+ * and logging configuration; parked handles are reset to its settings.
+ ******************************************************************************/
+struct _rocblas_handle_pool
+{
+private:
+    struct device_entry
+    {
+        std::unique_ptr<_rocblas_handle> prototype;
+        std::vector<rocblas_handle>      parked;
+    };
+
+    std::mutex                            mutex;
+    std::unordered_map<int, device_entry> devices;
+    size_t                                max_parked;
+    size_t                                m_hits   = 0;
+    size_t                                m_misses = 0;
+
+public:
+    explicit _rocblas_handle_pool(size_t max_parked)
+        : max_parked(max_parked)
+    {
+    }
+
+    ~_rocblas_handle_pool();
+
+    _rocblas_handle_pool(const _rocblas_handle_pool&) = delete;
+    _rocblas_handle_pool& operator=(const _rocblas_handle_pool&) = delete;
+
+    // Return a parked handle on the current device, or a new clone of the prototype
+    rocblas_handle acquire();
+
+    // Park a handle for reuse after its stream is synchronized, or destroy it if max_parked
+    // handles are already parked or it cannot be reset to the settings of the prototype
+    void release(rocblas_handle handle);
+
+    // Statistics: acquisitions served by a parked handle and by a new clone, and parked handles
+    void stats(size_t* hits, size_t* misses, size_t* parked);
+};
+
 // For functions which don't use temporary device memory, and won't be likely
 // to use them in the future, the RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle)
 // macro can be used to return from a rocblas function with a requested size of 0.
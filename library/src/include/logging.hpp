@@ -23,8 +23,11 @@
 #pragma once
 
 #include "handle.hpp"
+#include "rocblas_binary_log.hpp"
+#include "rocblas_latency.hpp"
 #include "rocblas_ostream.hpp"
 #include "tuple_helper.hpp"
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
@@ -46,35 +49,56 @@
 template <typename TUP>
 class argument_profile
 {
-    // Output stream
-    mutable rocblas_internal_ostream os;
-
-    // Mutex for multithreaded access to table
-    mutable std::shared_timed_mutex mutex;
+    using hash_t  = typename tuple_helper::hash_t<TUP>;
+    using equal_t = typename tuple_helper::equal_t<TUP>;
 
     // Table mapping argument tuples into counts
     // size_t is used for the map target type since atomic types are not movable, and
     // the map elements will only be moved when we hold an exclusive lock to the map.
-    std::unordered_map<TUP,
-                       size_t,
-                       typename tuple_helper::hash_t<TUP>,
-                       typename tuple_helper::equal_t<TUP>>
-        map;
+    using map_t = std::unordered_map<TUP, size_t, hash_t, equal_t>;
+
+    // Each thread counts calls in one of SHARDS tables, assigned round robin, so threads
+    // profiling at the same time neither serialize on inserting new tuples nor share the
+    // counts of common tuples. The tables are merged when the profile is dumped.
+    static constexpr size_t SHARDS = 64;
+
+    // Shards are aligned to avoid false sharing between their locks
+    struct alignas(64) shard
+    {
+        // Mutex for multithreaded access to table
+        mutable std::shared_timed_mutex mutex;
+
+        map_t map;
+    };
+
+    // Output stream
+    mutable rocblas_internal_ostream os;
+
+    std::unique_ptr<shard[]> shards{new shard[SHARDS]};
+
+    static shard& this_thread_shard(shard* shards)
+    {
+        static std::atomic<size_t> next_shard{0};
+        thread_local size_t        index = next_shard++ % SHARDS;
+        return shards[index];
+    }
 
 public:
-    // A tuple of arguments is looked up in an unordered map.
+    // A tuple of arguments is looked up in the calling thread's shard.
     // A count of the number of calls with these arguments is kept.
     // arg is assumed to be an rvalue for efficiency
     void operator()(TUP&& arg)
     {
+        shard& s = this_thread_shard(shards.get());
+
         { // Acquire a shared lock for reading map
-            std::shared_lock<std::shared_timed_mutex> lock(mutex);
+            std::shared_lock<std::shared_timed_mutex> lock(s.mutex);
 
             // Look up the tuple in the map
-            auto p = map.find(arg);
+            auto p = s.map.find(arg);
 
             // If tuple already exists, atomically increment count and return
-            if(p != map.end())
+            if(p != s.map.end())
             {
                 __atomic_fetch_add(&p->second, 1, __ATOMIC_SEQ_CST);
                 return;
@@ -82,12 +106,12 @@ public:
         } // Release shared lock
 
         { // Acquire an exclusive lock for modifying map
-            std::lock_guard<std::shared_timed_mutex> lock(mutex);
+            std::lock_guard<std::shared_timed_mutex> lock(s.mutex);
 
             // If doesn't already exist, insert tuple by moving arg and initializing count to 0.
             // Increment the count after searching for tuple and returning old or new match.
             // We hold a lock to the map, so we don't have to increment the count atomically.
-            map.emplace(std::move(arg), 0).first->second++;
+            s.map.emplace(std::move(arg), 0).first->second++;
         } // Release exclusive lock
     }
 
@@ -101,14 +125,20 @@ public:
     // Dump the current profile
     void dump() const
     {
-        // Acquire an exclusive lock to use map
-        std::lock_guard<std::shared_timed_mutex> lock(mutex);
+        // Merge the counts of all shards, acquiring an exclusive lock to use each map
+        map_t merged;
+        for(size_t i = 0; i < SHARDS; ++i)
+        {
+            std::lock_guard<std::shared_timed_mutex> lock(shards[i].mutex);
+            for(const auto& p : shards[i].map)
+                merged.emplace(p.first, 0).first->second += p.second;
+        }
 
         // Clear the output buffer
         os.clear();
 
         // Print all of the tuples in the map
-        for(const auto& p : map)
+        for(const auto& p : merged)
         {
             os << "- ";
             tuple_helper::print_tuple_pairs(
@@ -152,6 +182,25 @@ void log_profile(rocblas_handle handle, const char* func, Ts&&... xs)
     profile(std::move(tup));
 }
 
+// if latency logging is turned on with
+// (handle->layer_mode & rocblas_layer_mode_log_latency) != 0
+// log_latency returns a scope which records the host time spent until it is destroyed,
+// normally when the function returns, in the latency histogram of func. It is declared
+// at function scope, so that the time includes argument checks and kernel launches.
+// Device memory size and solution fitness queries launch nothing and are not recorded.
+// Functions whose data types are arguments, such as the _ex functions, pass up to 4 of
+// them, which select the histogram together with func.
+template <typename... Ts>
+inline rocblas_latency_scope log_latency(rocblas_handle handle, const char* func, Ts... types)
+{
+    static_assert(std::conjunction<std::is_same<Ts, rocblas_datatype>...>{},
+                  "data types must be rocblas_datatype");
+    bool record = handle && (handle->layer_mode & rocblas_layer_mode_log_latency)
+                  && !handle->is_device_memory_size_query()
+                  && !handle->get_solution_fitness_query();
+    return rocblas_latency_scope(record ? func : nullptr, rocblas_latency_types(types...));
+}
+
 /********************************************
  * Log values (for log_trace and log_bench) *
  ********************************************/
@@ -165,13 +214,32 @@ void log_arguments(rocblas_internal_ostream& os, const char* sep, H&& head, Ts&&
     os << std::endl;
 }
 
+// if binary logging is turned on with
+// (handle->layer_mode & rocblas_layer_mode_log_binary) != 0
+// log_binary will copy the arguments into a record of the calling thread's
+// ring buffer, to be formatted later by rocblas-log-decode
+template <typename... Ts>
+void log_binary(rocblas_binary_log_kind kind, Ts&&... xs)
+{
+    rocblas_binary_log_record* record = rocblas_binary_log_begin(kind);
+    if(record)
+    {
+        rocblas_binary_log_encoder encode(*record);
+        (void)(int[]){(encode(std::forward<Ts>(xs)), 0)...};
+        rocblas_binary_log_commit();
+    }
+}
+
 // if trace logging is turned on with
 // (handle->layer_mode & rocblas_layer_mode_log_trace) != 0
 // log_function will call log_arguments to log arguments with a comma separator
 template <typename... Ts>
 void log_trace(rocblas_handle handle, Ts&&... xs)
 {
-    log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
+    if(handle->layer_mode & rocblas_layer_mode_log_binary)
+        log_binary(rocblas_binary_log_kind::trace, std::forward<Ts>(xs)..., handle->atomics_mode);
+    else
+        log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
 }
 
 // if bench logging is turned on with
@@ -181,7 +249,15 @@ void log_trace(rocblas_handle handle, Ts&&... xs)
 template <typename... Ts>
 void log_bench(rocblas_handle handle, Ts&&... xs)
 {
-    if(handle->atomics_mode == rocblas_atomics_not_allowed)
+    if(handle->layer_mode & rocblas_layer_mode_log_binary)
+    {
+        if(handle->atomics_mode == rocblas_atomics_not_allowed)
+            log_binary(
+                rocblas_binary_log_kind::bench, std::forward<Ts>(xs)..., "--atomics_not_allowed");
+        else
+            log_binary(rocblas_binary_log_kind::bench, std::forward<Ts>(xs)...);
+    }
+    else if(handle->atomics_mode == rocblas_atomics_not_allowed)
         log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)..., "--atomics_not_allowed");
     else
         log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)...);
@@ -0,0 +1,417 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include "rocblas_ostream.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*******************************************************************************
+ * Binary log format                                                           *
+ *                                                                             *
+ * A binary log file is a rocblas_binary_log_header followed by fixed-size     *
+ * rocblas_binary_log_records. Each record holds the arguments passed to one   *
+ * call of log_trace or log_bench, as a sequence of tagged values which keep   *
+ * enough type information for rocblas-log-decode to reproduce the text that   *
+ * rocblas_internal_ostream would have written. The function name is the      *
+ * first argument of each record. Records of different threads are written in  *
+ * batches, and are ordered by their timestamps when decoded.                  *
+ *******************************************************************************/
+constexpr char     ROCBLAS_BINARY_LOG_MAGIC[8]     = "rbbinlg";
+constexpr uint32_t ROCBLAS_BINARY_LOG_VERSION      = 1;
+constexpr size_t   ROCBLAS_BINARY_LOG_RECORD_BYTES = 1024;
+
+struct rocblas_binary_log_header
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_bytes;
+};
+
+enum class rocblas_binary_log_kind : uint8_t
+{
+    trace   = 1, // arguments of log_trace, decoded with comma separators
+    bench   = 2, // arguments of log_bench, decoded with space separators
+    dropped = 3, // number of records a thread dropped because its ring buffer was full
+};
+
+enum class rocblas_binary_log_tag : uint8_t
+{
+    int64,
+    uint64,
+    real,
+    float_complex,
+    double_complex,
+    boolean,
+    character,
+    pointer,
+    string,
+    datatype,
+    operation,
+    fill,
+    diagonal,
+    side,
+    status,
+    atomics_mode,
+    gemm_flags,
+};
+
+struct rocblas_binary_log_record
+{
+    uint64_t timestamp; // nanoseconds since the log was opened
+    uint32_t thread; // sequential number of the logging thread
+    uint16_t size; // bytes of the payload in use
+    uint8_t  kind; // rocblas_binary_log_kind
+    uint8_t  truncated; // nonzero if the arguments did not fit in the payload
+    char     payload[ROCBLAS_BINARY_LOG_RECORD_BYTES - 16];
+};
+
+static_assert(sizeof(rocblas_binary_log_header) == 16, "unexpected binary log header size");
+static_assert(sizeof(rocblas_binary_log_record) == ROCBLAS_BINARY_LOG_RECORD_BYTES,
+              "unexpected binary log record size");
+
+/*******************************************************************************
+ * Reserve the next record in the calling thread's ring buffer, or return      *
+ * nullptr if logging is unavailable or the ring is full. A reserved record    *
+ * must be committed before the next one is reserved. The log file is opened   *
+ * on first use, from the environment variable ROCBLAS_LOG_BINARY_PATH, or     *
+ * rocblas_log.bin in the current directory. A background thread drains the    *
+ * ring buffers of all threads to the file.                                    *
+ *******************************************************************************/
+rocblas_binary_log_record* rocblas_binary_log_begin(rocblas_binary_log_kind kind);
+void                       rocblas_binary_log_commit();
+
+// Write all committed records to the log file (for testing)
+ROCBLAS_INTERNAL_EXPORT void rocblas_binary_log_flush();
+
+/*******************************************************************************
+ * Encode the arguments of a log_trace or log_bench call into a record         *
+ *******************************************************************************/
+class rocblas_binary_log_encoder
+{
+    rocblas_binary_log_record& record;
+
+    void put(rocblas_binary_log_tag tag, const void* data, size_t bytes)
+    {
+        if(record.truncated || record.size + 1 + bytes > sizeof(record.payload))
+        {
+            record.truncated = 1;
+            return;
+        }
+        record.payload[record.size] = char(tag);
+        memcpy(record.payload + record.size + 1, data, bytes);
+        record.size += 1 + bytes;
+    }
+
+    template <typename T>
+    void put_value(rocblas_binary_log_tag tag, T value)
+    {
+        put(tag, &value, sizeof(value));
+    }
+
+    void put_string(const char* s, size_t len)
+    {
+        uint16_t n = uint16_t(std::min<size_t>(len, UINT16_MAX));
+        if(record.truncated || size_t(record.size) + 3 + n > sizeof(record.payload))
+        {
+            record.truncated = 1;
+            return;
+        }
+        record.payload[record.size] = char(rocblas_binary_log_tag::string);
+        memcpy(record.payload + record.size + 1, &n, sizeof(n));
+        memcpy(record.payload + record.size + 3, s, n);
+        record.size += 3 + n;
+    }
+
+public:
+    explicit rocblas_binary_log_encoder(rocblas_binary_log_record& record)
+        : record(record)
+    {
+    }
+
+    void operator()(bool x)
+    {
+        put_value(rocblas_binary_log_tag::boolean, uint8_t(x));
+    }
+
+    void operator()(char x)
+    {
+        put_value(rocblas_binary_log_tag::character, x);
+    }
+
+    void operator()(const char* s)
+    {
+        s ? put_string(s, strlen(s)) : put_string("", 0);
+    }
+
+    void operator()(const std::string& s)
+    {
+        put_string(s.data(), s.size());
+    }
+
+    void operator()(rocblas_half x)
+    {
+        put_value(rocblas_binary_log_tag::real, double(float(x)));
+    }
+
+    void operator()(rocblas_bfloat16 x)
+    {
+        put_value(rocblas_binary_log_tag::real, double(float(x)));
+    }
+
+    void operator()(rocblas_float_complex x)
+    {
+        float z[2] = {std::real(x), std::imag(x)};
+        put(rocblas_binary_log_tag::float_complex, z, sizeof(z));
+    }
+
+    void operator()(rocblas_double_complex x)
+    {
+        double z[2] = {std::real(x), std::imag(x)};
+        put(rocblas_binary_log_tag::double_complex, z, sizeof(z));
+    }
+
+    // Enumerations with their own text representations
+    void operator()(rocblas_datatype x)
+    {
+        put_value(rocblas_binary_log_tag::datatype, int64_t(x));
+    }
+
+    void operator()(rocblas_operation x)
+    {
+        put_value(rocblas_binary_log_tag::operation, int64_t(x));
+    }
+
+    void operator()(rocblas_fill x)
+    {
+        put_value(rocblas_binary_log_tag::fill, int64_t(x));
+    }
+
+    void operator()(rocblas_diagonal x)
+    {
+        put_value(rocblas_binary_log_tag::diagonal, int64_t(x));
+    }
+
+    void operator()(rocblas_side x)
+    {
+        put_value(rocblas_binary_log_tag::side, int64_t(x));
+    }
+
+    void operator()(rocblas_status x)
+    {
+        put_value(rocblas_binary_log_tag::status, int64_t(x));
+    }
+
+    void operator()(rocblas_atomics_mode x)
+    {
+        put_value(rocblas_binary_log_tag::atomics_mode, int64_t(x));
+    }
+
+    void operator()(rocblas_gemm_flags x)
+    {
+        put_value(rocblas_binary_log_tag::gemm_flags, int64_t(x));
+    }
+
+    // Pointers, arrays, other enumerations and arithmetic types. Anything else is formatted
+    // to text, which is slower but produces the same output.
+    template <typename T>
+    void operator()(const T& x)
+    {
+        if constexpr(std::is_pointer<T>{} || std::is_array<T>{})
+        {
+            using E = std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>;
+            if constexpr(std::is_same<E, char>{})
+                (*this)(static_cast<const char*>(x));
+            else
+                put_value(rocblas_binary_log_tag::pointer, uint64_t(uintptr_t(x)));
+        }
+        else if constexpr(std::is_enum<T>{} || std::is_integral<T>{})
+        {
+            using U = std::conditional_t<std::is_enum<T>{}, std::underlying_type<T>, std::decay<T>>;
+            if constexpr(sizeof(typename U::type) == 1 && !std::is_enum<T>{})
+                put_value(rocblas_binary_log_tag::character, char(x));
+            else if constexpr(std::is_signed<typename U::type>{})
+                put_value(rocblas_binary_log_tag::int64, int64_t(x));
+            else
+                put_value(rocblas_binary_log_tag::uint64, uint64_t(x));
+        }
+        else if constexpr(std::is_floating_point<T>{})
+            put_value(rocblas_binary_log_tag::real, double(x));
+        else
+        {
+            rocblas_internal_ostream os;
+            os << x;
+            (*this)(os.str());
+        }
+    }
+};
+
+/*******************************************************************************
+ * Decode the records of one kind in a binary log, writing each record as a    *
+ * line in the text format of log_trace or log_bench. With timestamps, each    *
+ * line is preceded by the time in microseconds and the thread number.         *
+ * Returns false if the stream is not a binary log.                            *
+ *******************************************************************************/
+struct rocblas_binary_log_summary
+{
+    size_t records   = 0; // records decoded
+    size_t truncated = 0; // decoded records whose arguments were truncated
+    size_t dropped   = 0; // records dropped by the library because a ring buffer was full
+};
+
+inline bool rocblas_binary_log_decode(std::istream&               in,
+                                      rocblas_binary_log_kind     kind,
+                                      rocblas_internal_ostream&   os,
+                                      bool                        timestamps,
+                                      rocblas_binary_log_summary& summary)
+{
+    rocblas_binary_log_header header;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+       || memcmp(header.magic, ROCBLAS_BINARY_LOG_MAGIC, sizeof(header.magic))
+       || header.version != ROCBLAS_BINARY_LOG_VERSION
+       || header.record_bytes != ROCBLAS_BINARY_LOG_RECORD_BYTES)
+        return false;
+
+    std::vector<rocblas_binary_log_record> records;
+    rocblas_binary_log_record              record;
+    while(in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        if(record.kind == uint8_t(rocblas_binary_log_kind::dropped))
+        {
+            uint64_t count;
+            memcpy(&count, record.payload + 1, sizeof(count));
+            summary.dropped += count;
+        }
+        else if(record.kind == uint8_t(kind))
+            records.push_back(record);
+    }
+
+    // Records are drained in batches per thread, so restore the order of the calls
+    std::stable_sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    const char* sep = kind == rocblas_binary_log_kind::trace ? "," : " ";
+    for(const auto& r : records)
+    {
+        if(timestamps)
+            os << r.timestamp / 1000 << sep << r.thread << sep;
+
+        const char* p   = r.payload;
+        const char* end = r.payload + r.size;
+        for(bool first = true; p < end; first = false)
+        {
+            auto tag = rocblas_binary_log_tag(*p++);
+            auto get = [&p](auto& value) {
+                memcpy(&value, p, sizeof(value));
+                p += sizeof(value);
+                return value;
+            };
+            int64_t  i;
+            uint64_t u;
+            double   d;
+            float    c[2];
+            double   z[2];
+            uint8_t  b;
+            char     ch;
+            uint16_t n;
+
+            if(!first)
+                os << sep;
+
+            switch(tag)
+            {
+            case rocblas_binary_log_tag::int64:
+                os << get(i);
+                break;
+            case rocblas_binary_log_tag::uint64:
+                os << get(u);
+                break;
+            case rocblas_binary_log_tag::real:
+                os << get(d);
+                break;
+            case rocblas_binary_log_tag::float_complex:
+                get(c);
+                os << rocblas_float_complex{c[0], c[1]};
+                break;
+            case rocblas_binary_log_tag::double_complex:
+                get(z);
+                os << rocblas_double_complex{z[0], z[1]};
+                break;
+            case rocblas_binary_log_tag::boolean:
+                os << bool(get(b));
+                break;
+            case rocblas_binary_log_tag::character:
+                os << get(ch);
+                break;
+            case rocblas_binary_log_tag::pointer:
+                os << reinterpret_cast<void*>(uintptr_t(get(u)));
+                break;
+            case rocblas_binary_log_tag::string:
+                get(n);
+                os << std::string(p, n);
+                p += n;
+                break;
+            case rocblas_binary_log_tag::datatype:
+                os << rocblas_datatype(get(i));
+                break;
+            case rocblas_binary_log_tag::operation:
+                os << rocblas_operation(get(i));
+                break;
+            case rocblas_binary_log_tag::fill:
+                os << rocblas_fill(get(i));
+                break;
+            case rocblas_binary_log_tag::diagonal:
+                os << rocblas_diagonal(get(i));
+                break;
+            case rocblas_binary_log_tag::side:
+                os << rocblas_side(get(i));
+                break;
+            case rocblas_binary_log_tag::status:
+                os << rocblas_status(get(i));
+                break;
+            case rocblas_binary_log_tag::atomics_mode:
+                os << rocblas_atomics_mode(get(i));
+                break;
+            case rocblas_binary_log_tag::gemm_flags:
+                os << rocblas_gemm_flags(get(i));
+                break;
+            default:
+                p = end; // unknown tag, skip the rest of the record
+                break;
+            }
+        }
+        os << std::endl;
+
+        summary.records++;
+        if(r.truncated)
+            summary.truncated++;
+    }
+    return true;
+}
@@ -0,0 +1,485 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * The device arena holds the allocation policy for a handle's workspace. It *
+ * is free of HIP identifiers: slabs are obtained and released through       *
+ * backend functions supplied by the handle, so that the policy can be       *
+ * tested on a host-only build.                                              *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*******************************************************************************
+ * rocblas_device_arena is a LIFO (stack-like) allocator over a list of slabs. *
+ * When an allocation does not fit in the slab at the top of the stack, a new  *
+ * slab is appended rather than the existing memory being reallocated, so the  *
+ * addresses of live allocations never change and warm memory is kept.        *
+ *                                                                             *
+ * The first slab is the base workspace and is kept until clear() is called.   *
+ * Slabs appended on demand are released, newest first, whenever the arena    *
+ * becomes idle with a total capacity above the high-water mark. By default   *
+ * the high-water mark is the size of the base slabs, so the arena returns to *
+ * its base workspace whenever it becomes idle.                               *
+ *******************************************************************************/
+class rocblas_device_arena
+{
+public:
+    // Backend functions return 0 on success, or a backend-specific error code
+    using allocate_fn   = std::function<int(void** ptr, size_t size)>;
+    using deallocate_fn = std::function<int(void* ptr)>;
+
+    // Sentinel returned by release() when allocations are not released in LIFO order
+    static constexpr size_t LIFO_VIOLATION = ~size_t{0};
+
+    // High-water mark which keeps every slab, the default
+    static constexpr size_t NO_HIGH_WATER = ~size_t{0};
+
+private:
+    struct slab
+    {
+        char*  base;
+        size_t size;
+        size_t used;
+        bool   owned; // whether the slab is released through the backend
+        bool   is_base; // whether the slab was adopted as base workspace
+    };
+
+    // A live allocation: the slab it was taken from and its size
+    struct block
+    {
+        size_t slab;
+        size_t size;
+    };
+
+    allocate_fn        m_allocate;
+    deallocate_fn      m_deallocate;
+    std::vector<slab>  m_slabs;
+    std::vector<block> m_blocks;
+    size_t             m_capacity      = 0;
+    size_t             m_base_capacity = 0;
+    size_t             m_in_use        = 0;
+    size_t             m_high_water    = NO_HIGH_WATER;
+    size_t             m_peak          = 0;
+    size_t             m_reallocations = 0;
+
+    // Index of the slab at the top of the stack. Slabs above it are empty.
+    size_t top_slab() const
+    {
+        return m_blocks.empty() ? 0 : m_blocks.back().slab;
+    }
+
+    // Release empty slabs appended on demand, newest first, while keep(capacity) is false
+    template <typename Keep>
+    int release_slabs(size_t first, Keep keep)
+    {
+        while(m_slabs.size() > std::max<size_t>(first, 1) && !keep(m_capacity))
+        {
+            slab& s = m_slabs.back();
+            if(s.used)
+                break;
+            int status = pop_slab();
+            if(status)
+                return status;
+        }
+        return 0;
+    }
+
+    // Release the last slab through the backend if it is owned, and remove it
+    int pop_slab()
+    {
+        slab& s = m_slabs.back();
+        if(s.owned)
+        {
+            int status = m_deallocate(s.base);
+            if(status)
+                return status;
+        }
+        m_capacity -= s.size;
+        if(s.is_base)
+            m_base_capacity -= s.size;
+        m_slabs.pop_back();
+        return 0;
+    }
+
+    void append_slab(void* base, size_t size, bool owned, bool is_base)
+    {
+        m_slabs.push_back({static_cast<char*>(base), size, 0, owned, is_base});
+        m_capacity += size;
+        if(is_base)
+            m_base_capacity += size;
+    }
+
+public:
+    rocblas_device_arena(allocate_fn allocate, deallocate_fn deallocate)
+        : m_allocate(std::move(allocate))
+        , m_deallocate(std::move(deallocate))
+    {
+    }
+
+    rocblas_device_arena(const rocblas_device_arena&) = delete;
+    rocblas_device_arena& operator=(const rocblas_device_arena&) = delete;
+
+    // Total bytes held in all slabs
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    // Total bytes in live allocations
+    size_t in_use() const
+    {
+        return m_in_use;
+    }
+
+    // Largest allocation which can currently be made without growing the arena
+    size_t available() const
+    {
+        size_t avail = 0;
+        for(size_t i = top_slab(); i < m_slabs.size(); ++i)
+            avail = std::max(avail, m_slabs[i].size - m_slabs[i].used);
+        return avail;
+    }
+
+    size_t slabs() const
+    {
+        return m_slabs.size();
+    }
+
+    // Maximum of in_use() over the lifetime of the arena
+    size_t peak() const
+    {
+        return m_peak;
+    }
+
+    // Number of slabs allocated on demand by allocate()
+    size_t reallocations() const
+    {
+        return m_reallocations;
+    }
+
+    // Capacity above which idle slabs appended on demand are released. By default there is
+    // no limit, and grown capacity is kept; 0 stands for the size of the base slabs.
+    size_t high_water() const
+    {
+        return m_high_water;
+    }
+
+    void set_high_water(size_t bytes)
+    {
+        m_high_water = bytes;
+    }
+
+    // Add a base slab. If owned is false, the memory belongs to the caller and
+    // is never passed to the backend. Must be called while the arena is idle.
+    void adopt(void* base, size_t size, bool owned)
+    {
+        append_slab(base, size, owned, true);
+    }
+
+    // Allocate and adopt a base slab of the given size
+    int reserve(size_t size)
+    {
+        void* base   = nullptr;
+        int   status = m_allocate(&base, size);
+        if(!status)
+            adopt(base, size, true);
+        return status;
+    }
+
+    // Release all slabs. Fails if any allocation is still live.
+    int clear()
+    {
+        if(m_in_use)
+            return -1;
+        while(!m_slabs.empty())
+        {
+            int status = pop_slab();
+            if(status)
+                return status;
+        }
+        return 0;
+    }
+
+    // Allocate size bytes on top of the stack, appending a slab if grow is true
+    // and no slab has room. Returns nullptr if the allocation cannot be made.
+    void* allocate(size_t size, bool grow)
+    {
+        size_t i = top_slab();
+        while(i < m_slabs.size() && m_slabs[i].size - m_slabs[i].used < size)
+            ++i;
+
+        if(i == m_slabs.size())
+        {
+            if(!grow)
+                return nullptr;
+
+            // If the backend is out of memory, release the empty slabs (which are
+            // too small for this request) and try once more
+            void* base = nullptr;
+            if(m_allocate(&base, size))
+            {
+                size_t first = m_blocks.empty() ? 0 : top_slab() + 1;
+                if(release_slabs(first, [](size_t) { return false; }) || m_allocate(&base, size))
+                    return nullptr;
+            }
+            append_slab(base, size, true, false);
+            i = m_slabs.size() - 1;
+            ++m_reallocations;
+        }
+
+        slab& s    = m_slabs[i];
+        char* addr = s.base + s.used;
+        s.used += size;
+        m_in_use += size;
+        m_peak = std::max(m_peak, m_in_use);
+        m_blocks.push_back({i, size});
+        return addr;
+    }
+
+    // Release the most recent allocation, which must be of the given size.
+    // Returns in_use() afterwards, or LIFO_VIOLATION if size does not match.
+    // If the backend fails to free an idle slab, its error is stored in
+    // *backend_status and the slab is kept; otherwise *backend_status is 0.
+    size_t release(size_t size, int* backend_status = nullptr)
+    {
+        if(backend_status)
+            *backend_status = 0;
+        if(m_blocks.empty() || m_blocks.back().size != size)
+            return LIFO_VIOLATION;
+
+        m_slabs[m_blocks.back().slab].used -= size;
+        m_in_use -= size;
+        m_blocks.pop_back();
+
+        // Apply the high-water policy once the arena is idle
+        if(m_blocks.empty())
+        {
+            size_t limit  = std::max(m_high_water, m_base_capacity);
+            int    status = release_slabs(1, [=](size_t capacity) { return capacity <= limit; });
+            if(backend_status)
+                *backend_status = status;
+        }
+
+        return m_in_use;
+    }
+};
+
+/*******************************************************************************
+ * rocblas_device_arena_pool holds one device arena per key (a HIP stream), so *
+ * that kernels on different streams never share workspace. Each arena starts *
+ * with a base slab of the pool's base size, like the handle's shared arena.  *
+ * Arenas are kept in most-recently-used order. When switching keys, least    *
+ * recently used idle arenas are released while the total capacity exceeds   *
+ * the byte budget. A budget of 0 disables the pool.                          *
+ *******************************************************************************/
+class rocblas_device_arena_pool
+{
+    using entry_list = std::list<std::pair<const void*, std::unique_ptr<rocblas_device_arena>>>;
+
+    rocblas_device_arena::allocate_fn                     m_allocate;
+    rocblas_device_arena::deallocate_fn                   m_deallocate;
+    entry_list                                            m_lru;
+    std::unordered_map<const void*, entry_list::iterator> m_index;
+    size_t                                                m_budget     = 0;
+    size_t                                                m_base_size  = 0;
+    size_t                                                m_high_water = ~size_t{0}; // no limit
+    size_t                                                m_hits       = 0;
+    size_t                                                m_misses     = 0;
+    size_t                                                m_evictions  = 0;
+
+    // Release least recently used idle arenas, other than the most recent one,
+    // while the total capacity exceeds the budget
+    void trim()
+    {
+        size_t total = capacity();
+        for(auto it = m_lru.end(); total > m_budget && --it != m_lru.begin();)
+        {
+            rocblas_device_arena& arena = *it->second;
+            size_t                cap   = arena.capacity();
+            if(arena.in_use() || arena.clear())
+                continue;
+            total -= cap;
+            m_index.erase(it->first);
+            it = m_lru.erase(it);
+            ++m_evictions;
+        }
+    }
+
+public:
+    rocblas_device_arena_pool(rocblas_device_arena::allocate_fn   allocate,
+                              rocblas_device_arena::deallocate_fn deallocate)
+        : m_allocate(std::move(allocate))
+        , m_deallocate(std::move(deallocate))
+    {
+    }
+
+    rocblas_device_arena_pool(const rocblas_device_arena_pool&) = delete;
+    rocblas_device_arena_pool& operator=(const rocblas_device_arena_pool&) = delete;
+
+    bool enabled() const
+    {
+        return m_budget != 0;
+    }
+
+    size_t budget() const
+    {
+        return m_budget;
+    }
+
+    void set_budget(size_t bytes)
+    {
+        m_budget = bytes;
+    }
+
+    size_t base_size() const
+    {
+        return m_base_size;
+    }
+
+    // Size of the base slab of arenas created from now on
+    void set_base_size(size_t bytes)
+    {
+        m_base_size = bytes;
+    }
+
+    // High-water mark of arenas created from now on
+    void set_high_water(size_t bytes)
+    {
+        m_high_water = bytes;
+    }
+
+    // Number of arenas in the pool
+    size_t size() const
+    {
+        return m_lru.size();
+    }
+
+    // Number of acquisitions for a key which already had an arena
+    size_t hits() const
+    {
+        return m_hits;
+    }
+
+    // Number of arenas created
+    size_t misses() const
+    {
+        return m_misses;
+    }
+
+    // Number of arenas released to stay within the budget
+    size_t evictions() const
+    {
+        return m_evictions;
+    }
+
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for(auto& e : m_lru)
+            total += e.second->capacity();
+        return total;
+    }
+
+    size_t in_use() const
+    {
+        size_t total = 0;
+        for(auto& e : m_lru)
+            total += e.second->in_use();
+        return total;
+    }
+
+    // Call f(const rocblas_device_arena&) for each arena in the pool
+    template <typename F>
+    void for_each(F f) const
+    {
+        for(auto& e : m_lru)
+            f(*e.second);
+    }
+
+    // Return the arena for a key, or nullptr if it has none. Unlike acquire(), this neither
+    // creates arenas nor changes their order, so it can be used by queries.
+    rocblas_device_arena* find(const void* key) const
+    {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? nullptr : it->second->second.get();
+    }
+
+    // Return the arena for a key, creating it if necessary
+    rocblas_device_arena& acquire(const void* key)
+    {
+        // Repeated use of the same key is the common case
+        if(!m_lru.empty() && m_lru.front().first == key)
+        {
+            ++m_hits;
+            return *m_lru.front().second;
+        }
+
+        auto it = m_index.find(key);
+        if(it != m_index.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            ++m_hits;
+        }
+        else
+        {
+            // If the base slab cannot be allocated, the arena grows on demand instead
+            auto arena = std::make_unique<rocblas_device_arena>(m_allocate, m_deallocate);
+            arena->set_high_water(m_high_water);
+            if(m_base_size)
+                arena->reserve(m_base_size);
+            m_lru.emplace_front(key, std::move(arena));
+            m_index[key] = m_lru.begin();
+            ++m_misses;
+        }
+
+        trim();
+        return *m_lru.front().second;
+    }
+
+    // Release all arenas. Fails if any allocation is still live.
+    int clear()
+    {
+        if(in_use())
+            return -1;
+        while(!m_lru.empty())
+        {
+            int status = m_lru.back().second->clear();
+            if(status)
+                return status;
+            m_index.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+        return 0;
+    }
+};
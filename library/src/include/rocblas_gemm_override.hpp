@@ -0,0 +1,127 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+/*******************************************************************************
+ * Tuned GEMM solution overrides                                               *
+ *                                                                             *
+ * An override names the Tensile solution to run for one GEMM problem on one  *
+ * architecture, in place of the library's own selection. Solution indices are *
+ * those taken by rocblas_gemm_algo_solution_index, and an override is ignored *
+ * if its solution is not in the library or cannot solve the problem.          *
+ *                                                                             *
+ * Overrides are read from the file named by ROCBLAS_GEMM_OVERRIDE_PATH, in    *
+ * the text format read and written below, which rocblas-bench writes with     *
+ * --autotune.                                                                 *
+ *******************************************************************************/
+constexpr int ROCBLAS_GEMM_OVERRIDE_VERSION = 1;
+
+// The problem fields an override is matched on
+struct rocblas_gemm_override_key
+{
+    rocblas_datatype  a_type;
+    rocblas_datatype  c_type;
+    rocblas_datatype  compute_type;
+    rocblas_operation trans_a;
+    rocblas_operation trans_b;
+    int64_t           m;
+    int64_t           n;
+    int64_t           k;
+    int64_t           lda;
+    int64_t           ldb;
+    int64_t           ldc;
+    int64_t           ldd;
+    int64_t           batch_count;
+
+    auto tie() const
+    {
+        return std::tie(a_type,
+                        c_type,
+                        compute_type,
+                        trans_a,
+                        trans_b,
+                        m,
+                        n,
+                        k,
+                        lda,
+                        ldb,
+                        ldc,
+                        ldd,
+                        batch_count);
+    }
+
+    bool operator<(const rocblas_gemm_override_key& rhs) const
+    {
+        return tie() < rhs.tie();
+    }
+
+    bool operator==(const rocblas_gemm_override_key& rhs) const
+    {
+        return tie() == rhs.tie();
+    }
+};
+
+// The overrides of one architecture, mapping problems to solution indices
+using rocblas_gemm_override_table = std::map<rocblas_gemm_override_key, rocblas_int>;
+
+/*******************************************************************************
+ * Override database, keyed on the architecture name, such as gfx90a          *
+ *******************************************************************************/
+struct rocblas_gemm_override_db
+{
+    std::map<std::string, rocblas_gemm_override_table> archs;
+
+    // The overrides of arch, or nullptr if it has none. Entries are never removed, so the
+    // result lives as long as the database.
+    const rocblas_gemm_override_table* lookup(const std::string& arch) const;
+};
+
+// The database used by new handles, read from the file currently named by
+// ROCBLAS_GEMM_OVERRIDE_PATH the first time it is named, and empty if it is not set
+ROCBLAS_INTERNAL_EXPORT const rocblas_gemm_override_db& rocblas_gemm_current_override_db();
+
+// Read overrides into db, one per line as
+//   <arch> <a_type> <c_type> <compute_type> <transA> <transB> <m> <n> <k>
+//   <lda> <ldb> <ldc> <ldd> <batch_count> <solution_index>
+// after the header line rocblas_gemm_override <version>, where the types are written as in
+// rocblas_datatype_string and the operations as N, T or C. Lines starting with # are comments,
+// and a later line for the same problem replaces an earlier one. Returns false, leaving db
+// unchanged, if the stream is malformed or of another version.
+ROCBLAS_INTERNAL_EXPORT bool rocblas_gemm_overrides_read(std::istream&             is,
+                                                         rocblas_gemm_override_db& db);
+
+ROCBLAS_INTERNAL_EXPORT void rocblas_gemm_overrides_write(std::ostream&                   os,
+                                                          const rocblas_gemm_override_db& db);
+
+// Solution index, starting at 1 as in override files, of the last gemm which Tensile ran on
+// handle, or 0 if it has run none. Tests use it to check which solution was selected.
+ROCBLAS_INTERNAL_EXPORT rocblas_int
+    rocblas_internal_last_gemm_solution_index(rocblas_handle handle);
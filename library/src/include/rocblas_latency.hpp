@@ -0,0 +1,181 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/*******************************************************************************
+ * Latency histograms                                                          *
+ *                                                                             *
+ * rocblas_latency_histogram counts latencies in nanoseconds in HDR-style      *
+ * log-linear buckets: values below 2^SUB_BITS are counted exactly, and each   *
+ * larger power of two is split into 2^SUB_BITS buckets, so every bucket is    *
+ * within 1/2^SUB_BITS of the values it counts. Values of 2^MAX_BITS or more   *
+ * are counted in the last bucket.                                             *
+ *******************************************************************************/
+class rocblas_latency_histogram
+{
+public:
+    static constexpr int    SUB_BITS    = 5;
+    static constexpr int    MAX_BITS    = 36; // about 68 seconds
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+    static constexpr size_t BUCKETS     = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+    // Bucket counting a value
+    static size_t bucket(uint64_t value)
+    {
+        value = std::min(value, (uint64_t(1) << MAX_BITS) - 1);
+        if(value < SUB_BUCKETS)
+            return value;
+        int exponent = 63 - __builtin_clzll(value);
+        return (exponent - SUB_BITS + 1) * SUB_BUCKETS
+               + ((value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+    }
+
+    // Smallest value counted in a bucket
+    static uint64_t bucket_lowest(size_t b)
+    {
+        if(b < SUB_BUCKETS)
+            return b;
+        int exponent = int(b / SUB_BUCKETS) + SUB_BITS - 1;
+        return uint64_t(SUB_BUCKETS + b % SUB_BUCKETS) << (exponent - SUB_BITS);
+    }
+
+    void record(uint64_t value)
+    {
+        ++m_counts[bucket(value)];
+        ++m_count;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void merge(const rocblas_latency_histogram& other)
+    {
+        for(size_t b = 0; b < BUCKETS; ++b)
+            m_counts[b] += other.m_counts[b];
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    // Largest value counted in the bucket holding the given percentile, limited to the maximum
+    uint64_t percentile(double p) const
+    {
+        uint64_t rank  = uint64_t(p / 100 * m_count + 0.5);
+        uint64_t total = 0;
+        for(size_t b = 0; b < BUCKETS; ++b)
+        {
+            total += m_counts[b];
+            if(total && total >= rank)
+                return std::min(b + 1 < BUCKETS ? bucket_lowest(b + 1) - 1 : m_max, m_max);
+        }
+        return m_max;
+    }
+
+    uint64_t count() const
+    {
+        return m_count;
+    }
+
+    uint64_t min() const
+    {
+        return m_count ? m_min : 0;
+    }
+
+    uint64_t max() const
+    {
+        return m_max;
+    }
+
+    double mean() const
+    {
+        return m_count ? double(m_sum) / m_count : 0;
+    }
+
+private:
+    std::array<uint64_t, BUCKETS> m_counts{};
+    uint64_t                      m_count = 0;
+    uint64_t                      m_sum   = 0;
+    uint64_t                      m_min   = UINT64_MAX;
+    uint64_t                      m_max   = 0;
+};
+
+/*******************************************************************************
+ * The data types of functions which take them as arguments, such as the _ex   *
+ * functions, are part of the key of their histograms. Up to 4 enumerators are *
+ * packed in 16 bits each, offset by 1 so that 0 stands for no types.          *
+ *******************************************************************************/
+constexpr int ROCBLAS_LATENCY_TYPE_BITS = 16;
+
+template <typename... Ts>
+constexpr uint64_t rocblas_latency_types(Ts... types)
+{
+    static_assert(sizeof...(Ts) * ROCBLAS_LATENCY_TYPE_BITS <= 64, "too many types");
+    uint64_t packed = 0;
+    ((packed = packed << ROCBLAS_LATENCY_TYPE_BITS | (uint64_t(types) + 1)), ...);
+    return packed;
+}
+
+// Record the host latency of one call of a function, in the calling thread's histograms.
+// func must point to a string which lives as long as the library, such as a function name.
+void rocblas_latency_record(const char* func, uint64_t types, uint64_t nanoseconds);
+
+/*******************************************************************************
+ * rocblas_latency_scope records the time from its construction to its         *
+ * destruction in the histogram of a function and its packed data types, if    *
+ * func is not nullptr.                                                        *
+ *******************************************************************************/
+class rocblas_latency_scope
+{
+    const char*                           m_func;
+    uint64_t                              m_types;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    explicit rocblas_latency_scope(const char* func, uint64_t types = 0)
+        : m_func(func)
+        , m_types(types)
+    {
+        if(m_func)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~rocblas_latency_scope()
+    {
+        if(m_func)
+            rocblas_latency_record(m_func,
+                                   m_types,
+                                   std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now() - m_start)
+                                       .count());
+    }
+
+    rocblas_latency_scope(const rocblas_latency_scope&) = delete;
+    rocblas_latency_scope& operator=(const rocblas_latency_scope&) = delete;
+};
@@ -24,6 +24,7 @@
 
 #include "rocblas.h"
 #include "utility.hpp"
+#include <chrono>
 #include <cmath>
 #include <complex>
 #include <condition_variable>
@@ -42,6 +43,7 @@
 #include <sys/stat.h>
 #include <thread>
 #include <utility>
+#include <vector>
 #ifdef WIN32
 #include <io.h>
 #include <iostream>
@@ -127,7 +129,16 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
         // Queue of tasks
         std::queue<task_t> m_queue;
 
-        // Worker thread which waits for and handles tasks sequentially
+        // Maximum number of tasks written together
+        size_t m_batch_size;
+
+        // Maximum time to wait for a batch to fill once a task is queued
+        std::chrono::microseconds m_batch_latency;
+
+        // Write the payloads of a batch of tasks, returning false on error
+        bool write_batch(const std::vector<task_t>& batch);
+
+        // Worker thread which waits for tasks and writes each batch of queued tasks at once
         void thread_function();
 
     public:
@@ -0,0 +1,269 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * The solution cache is deliberately free of HIP and Tensile identifiers so *
+ * that it can be included by host-only code and tested without a GPU. The  *
+ * selected solution and the constructed problem are held as opaque          *
+ * std::shared_ptr<void>, which tensile_host.cpp converts back to a          *
+ * Tensile::ContractionSolution and a Tensile::ContractionProblem.           *
+ *****************************************************************************/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/*********************************************************************************
+ * rocblas_solution_signature holds every field of a contraction problem which   *
+ * can influence solution selection. Problems with equal signatures are certain  *
+ * to construct the same Tensile problem, to select the same solution and to     *
+ * require the same workspace. All fields are 64-bit so that the struct has no  *
+ * padding and can be hashed and compared as raw bytes.                          *
+ *********************************************************************************/
+struct rocblas_solution_signature
+{
+    // Device. arch_name is a hash of the device's full architecture name.
+    int64_t arch;
+    int64_t arch_name;
+    int64_t cu_count;
+
+    // Data types (Tensile::DataType values)
+    int64_t a_type;
+    int64_t c_type;
+    int64_t compute_type;
+
+    // Operations and flags
+    int64_t trans_a;
+    int64_t trans_b;
+    int64_t flags;
+
+    // Sizes. k is the effective k, which is 0 when alpha == 0.
+    int64_t m;
+    int64_t n;
+    int64_t k;
+    int64_t batch_count;
+
+    // Strides and offsets
+    int64_t row_stride_a, col_stride_a, batch_stride_a, buffer_offset_a;
+    int64_t row_stride_b, col_stride_b, batch_stride_b, buffer_offset_b;
+    int64_t row_stride_c, col_stride_c, batch_stride_c, buffer_offset_c;
+    int64_t row_stride_d, col_stride_d, batch_stride_d, buffer_offset_d;
+
+    // Problem predicates
+    int64_t strided_batch;
+    int64_t alpha_category;
+    int64_t beta_category;
+    int64_t c_equals_d;
+
+    // Environment settings which change the problem
+    int64_t fp16_alt_impl;
+    int64_t force_valu_for_dgemm;
+
+    // Handle state
+    int64_t atomics_mode;
+    int64_t performance_metric;
+    int64_t workspace_size;
+
+    bool operator==(const rocblas_solution_signature& rhs) const
+    {
+        return !memcmp(this, &rhs, sizeof(*this));
+    }
+
+    bool operator!=(const rocblas_solution_signature& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+static_assert(std::has_unique_object_representations<rocblas_solution_signature>{},
+              "rocblas_solution_signature must not contain padding");
+
+// Hash function class compatible with STL containers
+struct rocblas_solution_signature_hash
+{
+    size_t operator()(const rocblas_solution_signature& sig) const
+    {
+        size_t seed = 0xcbf29ce484222325;
+        auto*  p    = reinterpret_cast<const unsigned char*>(&sig);
+        for(size_t i = 0; i < sizeof(sig); ++i)
+            seed = (seed ^ p[i]) * 0x100000001b3; // FNV-1a
+        return seed;
+    }
+};
+
+/***************************************************************************
+ * Result of a solution selection: the selected solution, the problem it   *
+ * was selected for, the workspace it requires, and whether it can solve   *
+ * the problem on the current hardware. Copying an entry does not allocate *
+ ***************************************************************************/
+struct rocblas_solution_cache_entry
+{
+    std::shared_ptr<void> solution;
+    std::shared_ptr<void> problem;
+    size_t                workspace_size = 0;
+    bool                  can_solve      = false;
+};
+
+/*******************************************************************************
+ * rocblas_solution_cache is a bounded, thread-safe LRU map from problem       *
+ * signatures to selected solutions. A capacity of 0 disables the cache.       *
+ *******************************************************************************/
+class rocblas_solution_cache
+{
+    using entry_list
+        = std::list<std::pair<rocblas_solution_signature, rocblas_solution_cache_entry>>;
+
+    // Mutex for multithreaded access to the table
+    mutable std::mutex mutex;
+
+    // Entries in most-recently-used order, and an index into them
+    entry_list lru;
+    std::unordered_map<rocblas_solution_signature,
+                       entry_list::iterator,
+                       rocblas_solution_signature_hash>
+        index;
+
+    std::atomic<size_t> max_entries{0};
+    std::atomic<size_t> hit_count{0};
+    std::atomic<size_t> miss_count{0};
+
+public:
+    explicit rocblas_solution_cache(size_t capacity = 0)
+        : max_entries(capacity)
+    {
+    }
+
+    rocblas_solution_cache(const rocblas_solution_cache&) = delete;
+    rocblas_solution_cache& operator=(const rocblas_solution_cache&) = delete;
+
+    bool enabled() const
+    {
+        return max_entries.load(std::memory_order_relaxed) != 0;
+    }
+
+    size_t capacity() const
+    {
+        return max_entries;
+    }
+
+    size_t hits() const
+    {
+        return hit_count;
+    }
+
+    size_t misses() const
+    {
+        return miss_count;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index.size();
+    }
+
+    // Change the capacity, discarding all entries and resetting the counters
+    void set_capacity(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index.clear();
+        lru.clear();
+        max_entries = capacity;
+        hit_count   = 0;
+        miss_count  = 0;
+    }
+
+    // Look up a signature, returning true and copying the entry on a hit
+    bool find(const rocblas_solution_signature& sig, rocblas_solution_cache_entry& entry)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto                        p = index.find(sig);
+            if(p != index.end())
+            {
+                // Move the entry to the front of the LRU list
+                lru.splice(lru.begin(), lru, p->second);
+                entry = p->second->second;
+                hit_count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        miss_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Insert or replace an entry, evicting the least recently used entries if full
+    void insert(const rocblas_solution_signature& sig, const rocblas_solution_cache_entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t                      capacity = max_entries;
+        if(!capacity)
+            return;
+
+        auto p = index.find(sig);
+        if(p != index.end())
+        {
+            p->second->second = entry;
+            lru.splice(lru.begin(), lru, p->second);
+            return;
+        }
+
+        while(index.size() >= capacity)
+        {
+            index.erase(lru.back().first);
+            lru.pop_back();
+        }
+
+        lru.emplace_front(sig, entry);
+        index.emplace(sig, lru.begin());
+    }
+};
+
+/*****************************************************************************
+ * Returns the library's solution with the given index. A lazily loaded      *
+ * library only holds the solutions whose code objects are loaded, so when  *
+ * the index is not loaded yet the solutions for the problem are loaded and  *
+ * the lookup is retried. Returns null if the index still cannot be found.   *
+ *****************************************************************************/
+template <typename Library, typename Problem, typename Hardware>
+auto rocblas_get_solution_by_index(Library&        library,
+                                   int64_t         index,
+                                   const Problem&  problem,
+                                   const Hardware& hardware)
+{
+    auto solution = library.getSolutionByIndex(index);
+    if(!solution)
+    {
+        library.findAllSolutions(problem, hardware);
+        solution = library.getSolutionByIndex(index);
+    }
+    return solution;
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include "rocblas_solution_cache.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**********************************************************************************
+ * rocblas_solution_db is a persistent database of solution selections, mapping   *
+ * problem signatures to solution indices and workspace sizes. The file is        *
+ * memory-mapped read-only when opened, and lookups probe its open-addressed hash *
+ * table directly, without any parsing. Selections made during this process are   *
+ * held in memory and merged into the file when the database is flushed, together *
+ * with any records which other processes have written to it in the meantime.     *
+ *                                                                                *
+ * A file is only accepted if its header matches the format version, signature    *
+ * layout, architecture of the Tensile library, rocBLAS version and Tensile       *
+ * library hash, and if the checksum of its header and table is correct.          *
+ * Otherwise it is ignored and rewritten. Each record's signature holds the full  *
+ * architecture name of the device it was selected on, so devices of different   *
+ * architectures in one process do not share selections.                         *
+ **********************************************************************************/
+class ROCBLAS_INTERNAL_EXPORT rocblas_solution_db
+{
+public:
+    static constexpr char     MAGIC[8]       = {'R', 'O', 'C', 'S', 'O', 'L', 'D', 'B'};
+    static constexpr uint32_t FORMAT_VERSION = 3;
+
+    // File header. The hash table of records follows immediately.
+    struct header_t
+    {
+        char     magic[8];
+        uint32_t format_version;
+        uint32_t record_size;
+        char     arch[64];
+        char     rocblas_version[64];
+        uint64_t library_hash;
+        uint64_t bucket_count; // power of 2
+        uint64_t record_count;
+        uint64_t checksum; // FNV-1a of the preceding fields and the hash table
+    };
+
+    // Hash table record. Empty buckets have solution_index == -1.
+    struct record_t
+    {
+        rocblas_solution_signature signature;
+        int64_t                    solution_index;
+        int64_t                    workspace_size;
+    };
+
+    rocblas_solution_db(std::string path,
+                        std::string arch,
+                        std::string rocblas_version,
+                        uint64_t    library_hash,
+                        bool        read_only = false);
+
+    // Flushes any new records and unmaps the file
+    ~rocblas_solution_db();
+
+    rocblas_solution_db(const rocblas_solution_db&) = delete;
+    rocblas_solution_db& operator=(const rocblas_solution_db&) = delete;
+
+    // Whether an existing file was accepted when the database was opened
+    bool is_loaded() const
+    {
+        return m_table != nullptr;
+    }
+
+    // Number of records in the file which was loaded
+    size_t loaded_records() const
+    {
+        return m_header ? m_header->record_count : 0;
+    }
+
+    // Look up a signature, returning true on success
+    bool find(const rocblas_solution_signature& sig,
+              int64_t&                          solution_index,
+              size_t&                           workspace_size) const;
+
+    // Record a new selection, to be written when the database is flushed
+    void record(const rocblas_solution_signature& sig,
+                int64_t                           solution_index,
+                size_t                            workspace_size);
+
+    // Discard the selection for a signature which turned out to be unusable, so that it is not
+    // found again and is removed from the file when the database is flushed
+    void discard(const rocblas_solution_signature& sig);
+
+    // Merge the new records into the file, if there are unwritten records. Records which
+    // other processes have written since the file was loaded are kept. Writers are serialized
+    // by a lock file, and the file is replaced atomically. Returns false on I/O error.
+    bool flush();
+
+    // FNV-1a checksum
+    static uint64_t checksum(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325);
+
+    // Checksum of a file's header, excluding the checksum field, and hash table
+    static uint64_t checksum(const header_t& header, const record_t* table);
+
+private:
+    std::string m_path;
+    std::string m_arch;
+    std::string m_rocblas_version;
+    uint64_t    m_library_hash;
+    bool        m_read_only;
+
+    // Mapping of the file which was loaded
+    void*           m_map      = nullptr;
+    size_t          m_map_size = 0;
+    const header_t* m_header   = nullptr;
+    const record_t* m_table    = nullptr;
+#ifdef WIN32
+    std::vector<char> m_buffer;
+#endif
+
+    // Records made during this process, and whether any are not yet written. Discarded
+    // selections are held as records with solution_index == -1. Once any loaded record has
+    // been replaced or discarded, the new records are checked before the loaded ones.
+    mutable std::mutex m_mutex;
+    bool               m_dirty = false;
+    std::atomic<bool>  m_replaced{false};
+    std::unordered_map<rocblas_solution_signature, record_t, rocblas_solution_signature_hash>
+        m_new_records;
+
+    void load();
+    void unload();
+    bool validate(const void* data, size_t size) const;
+    void read_records(std::vector<record_t>& records) const;
+};
@@ -0,0 +1,88 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <cstddef>
+#include <hip/hip_runtime.h>
+
+/*******************************************************************************
+ * Copies a matrix of cols columns, each width bytes long, between host and    *
+ * device memory through persistent pinned staging buffers. kind must be       *
+ * hipMemcpyHostToDevice or hipMemcpyDeviceToHost. Leading dimensions are in   *
+ * bytes. The matrix is split into chunks which fit in a staging buffer, and   *
+ * host-side packing or unpacking of one chunk overlaps the DMA of another.    *
+ * Large chunks are packed by several threads. The copy is complete when the   *
+ * function returns.                                                           *
+ *******************************************************************************/
+rocblas_status rocblas_staged_copy_matrix(hipMemcpyKind kind,
+                                          size_t        width,
+                                          size_t        cols,
+                                          const void*   src,
+                                          size_t        src_ld,
+                                          void*         dst,
+                                          size_t        dst_ld,
+                                          hipStream_t   stream = 0);
+
+/*******************************************************************************
+ * A pinned host or device staging block taken from a process-wide cache.      *
+ * Blocks are bucketed by power-of-two size for each device, and are returned  *
+ * to the cache when released, as long as the idle bytes held by the cache     *
+ * stay within its limit. The limit defaults to 64 MiB and may be set with the *
+ * environment variable ROCBLAS_STAGING_CACHE_LIMIT, or with                   *
+ * rocblas_set_staging_cache_limit. The block is empty if size is 0 or if    *
+ * allocation fails.                                                           *
+ *******************************************************************************/
+class rocblas_staging_block
+{
+    void*  ptr;
+    size_t bucket;
+    int    device;
+    bool   host;
+
+public:
+    rocblas_staging_block(bool host, size_t size);
+    ~rocblas_staging_block();
+
+    rocblas_staging_block(const rocblas_staging_block&) = delete;
+    rocblas_staging_block& operator=(const rocblas_staging_block&) = delete;
+
+    void* get() const
+    {
+        return ptr;
+    }
+
+    explicit operator bool() const
+    {
+        return ptr != nullptr;
+    }
+};
+
+// Set the limit of idle bytes held by the staging block cache, freeing blocks above it
+void rocblas_staging_cache_set_limit(size_t bytes);
+
+// Limit of idle bytes held by the staging block cache
+size_t rocblas_staging_cache_get_limit();
+
+// Statistics of the staging block cache
+void rocblas_staging_cache_stats(size_t* hits, size_t* misses, size_t* bytes_held);
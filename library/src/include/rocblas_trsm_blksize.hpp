@@ -0,0 +1,115 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+ * Block sizes for the substitution method of trsm                             *
+ *                                                                             *
+ * A table's rows are indexed by the interval holding the order of the         *
+ * triangular matrix, and its columns by the interval holding the other        *
+ * dimension of B. Each interval is given by its upper bound; sizes above the  *
+ * last bound fall in an extra row or column. An entry of 0 means that the     *
+ * substitution method is not used, and 1 means a block size of min(m, 512).   *
+ *                                                                             *
+ * The compiled-in tables can be replaced per architecture by the file         *
+ * trsm_blksize_<arch>.txt in the directory ROCBLAS_TRSM_BLKSIZE_PATH, in the  *
+ * text format read and written below, which rocblas-bench writes with         *
+ * --trsm_blksize_sweep.                                                       *
+ *******************************************************************************/
+constexpr int         ROCBLAS_TRSM_BLKSIZE_VERSION = 1;
+constexpr rocblas_int ROCBLAS_TRSM_BLKSIZE_MAX     = 512;
+
+struct rocblas_trsm_blksize_table
+{
+    std::vector<rocblas_int> intervals_row; // ascending upper bounds of the row intervals
+    std::vector<rocblas_int> intervals_col; // ascending upper bounds of the column intervals
+    std::vector<rocblas_int> blksizes; // rows() x cols() block sizes, row-major
+
+    size_t rows() const
+    {
+        return intervals_row.size() + 1;
+    }
+
+    size_t cols() const
+    {
+        return intervals_col.size() + 1;
+    }
+
+    // Index of the interval holding dim
+    static size_t index(const std::vector<rocblas_int>& intervals, rocblas_int dim)
+    {
+        size_t i = 0;
+        while(i < intervals.size() && dim > intervals[i])
+            ++i;
+        return i;
+    }
+
+    rocblas_int lookup(rocblas_int m, rocblas_int n) const
+    {
+        return blksizes[index(intervals_row, m) * cols() + index(intervals_col, n)];
+    }
+
+    // Whether the intervals ascend, and the block sizes match them and are in range
+    bool valid() const;
+};
+
+// The tables of one architecture, for each precision and whether the trsm is batched
+struct rocblas_trsm_blksize_tables
+{
+    rocblas_trsm_blksize_table real, real_batched, complex, complex_batched;
+
+    template <bool BATCHED, bool COMPLEX>
+    const rocblas_trsm_blksize_table& get() const
+    {
+        return COMPLEX ? BATCHED ? complex_batched : complex : BATCHED ? real_batched : real;
+    }
+};
+
+// The compiled-in tables
+ROCBLAS_INTERNAL_EXPORT const rocblas_trsm_blksize_tables& rocblas_trsm_default_blksize_tables();
+
+// The tables for the architecture of device, loaded once per architecture
+ROCBLAS_INTERNAL_EXPORT const rocblas_trsm_blksize_tables&
+    rocblas_trsm_current_blksize_tables(int device);
+
+// Read tables for arch, replacing those present in the stream. Returns false if the stream is
+// malformed, of another version, or for another architecture, leaving tables unchanged.
+ROCBLAS_INTERNAL_EXPORT bool rocblas_trsm_blksize_tables_read(std::istream&                is,
+                                                              const std::string&           arch,
+                                                              rocblas_trsm_blksize_tables& tables);
+
+ROCBLAS_INTERNAL_EXPORT void
+    rocblas_trsm_blksize_tables_write(std::ostream&                      os,
+                                      const std::string&                 arch,
+                                      const rocblas_trsm_blksize_tables& tables);
+
+// Force the block size returned by rocblas_trsm_blksize, so that rocblas-bench can time the
+// candidates. A negative value returns to the tables.
+ROCBLAS_INTERNAL_EXPORT void rocblas_internal_trsm_set_blksize_override(rocblas_int blksize);
+ROCBLAS_INTERNAL_EXPORT rocblas_int rocblas_internal_trsm_blksize_override();
@@ -0,0 +1,64 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <istream>
+#include <sstream>
+#include <string>
+
+/*******************************************************************************
+ * Reads a line-oriented tuning file: a header line "<name> <version>" and one *
+ * entry per following line. Blank lines and lines starting with # are         *
+ * skipped. read_entry(line) parses an entry and returns false if it is        *
+ * malformed. Returns false if the header is missing or of another name or     *
+ * version, or an entry is malformed; entries read before that are kept by     *
+ * read_entry, so callers read into a copy of their database.                  *
+ *******************************************************************************/
+template <typename ReadEntry>
+bool rocblas_read_tuning_file(std::istream& is,
+                              const char*   name,
+                              int           version,
+                              ReadEntry&&   read_entry)
+{
+    bool header = false;
+
+    for(std::string line; std::getline(is, line);)
+    {
+        if(line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#')
+            continue;
+
+        if(!header)
+        {
+            std::istringstream in(line);
+            std::string        word;
+            int                file_version = 0;
+            if(!(in >> word >> file_version) || word != name || file_version != version)
+                return false;
+            header = true;
+        }
+        else if(!read_entry(line))
+            return false;
+    }
+
+    return header;
+}
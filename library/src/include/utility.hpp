@@ -763,6 +763,7 @@ bool rocblas_internal_tensile_supports_ldc_ne_ldd(rocblas_handle handle);
 
 // for internal use during testing, fetch arch name
 ROCBLAS_INTERNAL_EXPORT std::string rocblas_internal_get_arch_name();
+ROCBLAS_INTERNAL_EXPORT std::string rocblas_internal_get_arch_name(int deviceId);
 
 // for internal use during testing, whether to skip actual kernel launch
 ROCBLAS_INTERNAL_EXPORT bool rocblas_internal_tensile_debug_skip_launch();
@@ -23,6 +23,7 @@
 #include "handle.hpp"
 #include "logging.hpp"
 #include "rocblas-auxiliary.h"
+#include "rocblas_staging.hpp"
 #include <cctype>
 #include <cstdlib>
 #include <memory>
@@ -251,6 +252,123 @@ catch(...)
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ *! \brief create rocblas handle with the settings of another handle
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_clone_handle(rocblas_handle handle, rocblas_handle* clone)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!clone)
+        return rocblas_status_invalid_pointer;
+
+    *clone = new _rocblas_handle(*handle, _rocblas_handle::clone_t{});
+
+    if((*clone)->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(*clone, "rocblas_clone_handle");
+
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief handle pool
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_create_handle_pool(rocblas_handle_pool* pool, size_t max_parked)
+try
+{
+    if(!pool)
+        return rocblas_status_invalid_pointer;
+
+    *pool = new _rocblas_handle_pool(max_parked);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_destroy_handle_pool(rocblas_handle_pool pool)
+try
+{
+    if(!pool)
+        return rocblas_status_invalid_pointer;
+
+    delete pool;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_handle_pool_acquire(rocblas_handle_pool pool,
+                                                      rocblas_handle*     handle)
+try
+{
+    if(!pool || !handle)
+        return rocblas_status_invalid_pointer;
+
+    *handle = pool->acquire();
+
+    if((*handle)->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(*handle, "rocblas_handle_pool_acquire");
+
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_handle_pool_release(rocblas_handle_pool pool,
+                                                      rocblas_handle      handle)
+try
+{
+    if(!pool)
+        return rocblas_status_invalid_pointer;
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    if(handle->layer_mode & rocblas_layer_mode_log_trace)
+        log_trace(handle, "rocblas_handle_pool_release");
+
+    pool->release(handle);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_get_handle_pool_stats(rocblas_handle_pool pool,
+                                                        size_t*             hits,
+                                                        size_t*             misses,
+                                                        size_t*             parked)
+try
+{
+    if(!pool)
+        return rocblas_status_invalid_pointer;
+
+    size_t h, m, p;
+    pool->stats(&h, &m, &p);
+    if(hits)
+        *hits = h;
+    if(misses)
+        *misses = m;
+    if(parked)
+        *parked = p;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  *! \brief   set rocblas stream used for all subsequent library function calls.
  *   If not set, all hip kernels will take the default NULL stream.
@@ -331,29 +449,11 @@ rocblas_copy_void_ptr_vector_kernel(rocblas_int n,
     }
 }
 
-/* ============================================================================================ */
-// TODO: Need to replace this with new device memory allocation system
-
-// device_malloc wraps hipMalloc and provides same API as malloc
-static void* device_malloc(size_t byte_size)
-{
-    void* pointer = nullptr;
-    PRINT_IF_HIP_ERROR((hipMalloc)(&pointer, byte_size));
-    return pointer;
-}
-
-// device_free wraps hipFree and provides same API as free
-static void device_free(void* ptr)
-{
-    PRINT_IF_HIP_ERROR((hipFree)(ptr));
-}
-
-using rocblas_unique_ptr = std::unique_ptr<void, void (*)(void*)>;
-
 /*******************************************************************************
  *! \brief   copies void* vector x with stride incx on host to void* vector
      y with stride incy on device. Vectors have n elements of size elem_size.
-  TODO: Need to replace device memory allocation with new system
+     Non-contiguous vectors are staged through pinned host and device blocks
+     taken from the process-wide staging block cache.
  ******************************************************************************/
 extern "C" rocblas_status rocblas_set_vector(rocblas_int n,
                                              rocblas_int elem_size,
@@ -390,6 +490,14 @@ try
         size_t y_d_byte_stride = (size_t)elem_size * incy;
         size_t t_h_byte_stride = (size_t)elem_size;
 
+        // host buffer packs a non-contiguous host vector, device buffer feeds the scatter kernel
+        rocblas_staging_block t_h_block(true, incx != 1 ? temp_byte_size : 0);
+        rocblas_staging_block t_d_block(false, incy != 1 ? temp_byte_size : 0);
+        void*                 t_h = t_h_block.get();
+        void*                 t_d = t_d_block.get();
+        if((incx != 1 && !t_h) || (incy != 1 && !t_d))
+            return rocblas_status_memory_error;
+
         for(int i_copy = 0; i_copy < n_copy; i_copy++)
         {
             int         i_start     = i_copy * n_elem;
@@ -398,17 +506,8 @@ try
             void*       y_d_start   = (char*)y_d + i_start * y_d_byte_stride;
             const void* x_h_start   = (const char*)x_h + i_start * x_h_byte_stride;
 
-            if((incx != 1) && (incy != 1))
+            if(incx != 1)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
                 // non-contiguous host vector -> host buffer
                 for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
                 {
@@ -416,29 +515,12 @@ try
                            (const char*)x_h + i_x * x_h_byte_stride,
                            elem_size);
                 }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   t_d,
-                                   1,
-                                   y_d_start,
-                                   incy);
+                x_h_start = t_h;
             }
-            else if(incx == 1 && incy != 1)
+
+            if(incy != 1)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host vector -> device buffer
+                // host vector or buffer -> device buffer
                 PRINT_IF_HIP_ERROR(hipMemcpy(t_d, x_h_start, contig_size, hipMemcpyHostToDevice));
                 // device buffer -> non-contiguous device vector
                 hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
@@ -453,24 +535,16 @@ try
                                    y_d_start,
                                    incy);
             }
-            else if(incx != 1 && incy == 1)
+            else
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size);
-                }
                 // host buffer -> contiguous device vector
                 PRINT_IF_HIP_ERROR(hipMemcpy(y_d_start, t_h, contig_size, hipMemcpyHostToDevice));
             }
         }
+
+        // the device buffer returns to the cache, so the last scatter must finish reading it
+        if(incy != 1)
+            PRINT_IF_HIP_ERROR(hipStreamSynchronize(0));
     }
     return rocblas_status_success;
 }
@@ -482,6 +556,8 @@ catch(...) // catch all exceptions
 /*******************************************************************************
  *! \brief   copies void* vector x with stride incx on device to void* vector
      y with stride incy on host. Vectors have n elements of size elem_size.
+     Non-contiguous vectors are staged through pinned host and device blocks
+     taken from the process-wide staging block cache.
  ******************************************************************************/
 extern "C" rocblas_status rocblas_get_vector(rocblas_int n,
                                              rocblas_int elem_size,
@@ -518,6 +594,14 @@ try
         size_t y_h_byte_stride = (size_t)elem_size * incy;
         size_t t_h_byte_stride = (size_t)elem_size;
 
+        // device buffer gathers a non-contiguous device vector, host buffer is unpacked
+        rocblas_staging_block t_d_block(false, incx != 1 ? temp_byte_size : 0);
+        rocblas_staging_block t_h_block(true, incy != 1 ? temp_byte_size : 0);
+        void*                 t_d = t_d_block.get();
+        void*                 t_h = t_h_block.get();
+        if((incx != 1 && !t_d) || (incy != 1 && !t_h))
+            return rocblas_status_memory_error;
+
         for(int i_copy = 0; i_copy < n_copy; i_copy++)
         {
             int i_start           = i_copy * n_elem;
@@ -526,17 +610,8 @@ try
             const void* x_d_start = (const char*)x_d + i_start * x_d_byte_stride;
             void*       y_h_start = (char*)y_h + i_start * y_h_byte_stride;
 
-            if(incx != 1 && incy != 1)
+            if(incx != 1)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
                 // non-contiguous device vector -> device buffer
                 hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
                                    grid,
@@ -549,26 +624,13 @@ try
                                    incx,
                                    t_d,
                                    1);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
+                x_d_start = t_d;
             }
-            else if(incx == 1 && incy != 1)
+
+            if(incy != 1)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device vector -> host buffer
+                // device vector or buffer -> host buffer
                 PRINT_IF_HIP_ERROR(hipMemcpy(t_h, x_d_start, contig_size, hipMemcpyDeviceToHost));
-
                 // host buffer -> non-contiguous host vector
                 for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
                 {
@@ -577,25 +639,8 @@ try
                            elem_size);
                 }
             }
-            else if(incx != 1 && incy == 1)
+            else
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   x_d_start,
-                                   incx,
-                                   t_d,
-                                   1);
                 // device buffer -> contiguous host vector
                 PRINT_IF_HIP_ERROR(hipMemcpy(y_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
             }
@@ -608,6 +653,51 @@ catch(...) // catch all exceptions
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ *! \brief   sets the limit of idle bytes held by the staging block cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_staging_cache_limit(size_t bytes)
+try
+{
+    rocblas_staging_cache_set_limit(bytes);
+    return rocblas_status_success;
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   returns the limit of idle bytes held by the staging block cache
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_staging_cache_limit(size_t* bytes)
+try
+{
+    if(!bytes)
+        return rocblas_status_invalid_pointer;
+    *bytes = rocblas_staging_cache_get_limit();
+    return rocblas_status_success;
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   returns the hits, misses and idle bytes of the staging block cache
+ ******************************************************************************/
+extern "C" rocblas_status
+    rocblas_get_staging_cache_stats(size_t* hits, size_t* misses, size_t* bytes_held)
+try
+{
+    rocblas_staging_cache_stats(hits, misses, bytes_held);
+    return rocblas_status_success;
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  *! \brief   copies void* vector x with stride incx on host to void* vector
      y with stride incy on device. Vectors have n elements of size elem_size.
@@ -694,34 +784,6 @@ catch(...) // catch all exceptions
     return exception_to_rocblas_status();
 }
 
-/*******************************************************************************
- *! \brief  Matrix copy on device. Matrices are void pointers with element
-     size elem_size
- ******************************************************************************/
-
-constexpr size_t      MAT_BUFF_MAX_BYTES = 1048576;
-constexpr rocblas_int MATRIX_DIM_X       = 128;
-constexpr rocblas_int MATRIX_DIM_Y       = 8;
-
-template <rocblas_int DIM_X, rocblas_int DIM_Y>
-ROCBLAS_KERNEL(DIM_X* DIM_Y)
-rocblas_copy_void_ptr_matrix_kernel(rocblas_int rows,
-                                    rocblas_int cols,
-                                    size_t      elem_size,
-                                    const void* a,
-                                    rocblas_int lda,
-                                    void*       b,
-                                    rocblas_int ldb)
-{
-    rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
-    rocblas_int ty = blockIdx.y * blockDim.y + threadIdx.y;
-
-    if(tx < rows && ty < cols)
-        memcpy((char*)b + (tx + ldb * ty) * elem_size,
-               (const char*)a + (tx + lda * ty) * elem_size,
-               elem_size);
-}
-
 /*******************************************************************************
  *! \brief   copies void* matrix a_h with leading dimentsion lda on host to
      void* matrix b_d with leading dimension ldb on device. Matrices have
@@ -751,122 +813,17 @@ try
                                * static_cast<size_t>(cols);
         PRINT_IF_HIP_ERROR(hipMemcpy(b_d, a_h, bytes_to_copy, hipMemcpyHostToDevice));
     }
-    // matrix colums too large to fit in temp buffer, copy matrix col by col
-    else if(rows * elem_size > MAT_BUFF_MAX_BYTES)
-    {
-        for(size_t i = 0; i < cols; i++)
-        {
-            PRINT_IF_HIP_ERROR(hipMemcpy((char*)b_d + ldb * i * elem_size,
-                                         (const char*)a_h + lda * i * elem_size,
-                                         (size_t)elem_size * rows,
-                                         hipMemcpyHostToDevice));
-        }
-    }
-    // columns fit in temp buffer, pack columns in buffer, hipMemcpy host->device, unpack
-    // columns
+    // strided matrices: copy through pinned staging buffers, packing the host
+    // matrix in chunks which overlap the DMA of the previous chunk
     else
     {
-        size_t bytes_to_copy = static_cast<size_t>(elem_size) * static_cast<size_t>(rows)
-                               * static_cast<size_t>(cols);
-        size_t temp_byte_size
-            = bytes_to_copy < MAT_BUFF_MAX_BYTES ? bytes_to_copy : MAT_BUFF_MAX_BYTES;
-        int n_cols = temp_byte_size / (elem_size * rows); // number of columns in buffer
-        int n_copy = ((cols - 1) / n_cols) + 1; // number of times buffer is copied
-
-        rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
-        rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
-        dim3        grid(blocksX, blocksY);
-        dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
-
-        size_t lda_h_byte = (size_t)elem_size * lda;
-        size_t ldb_d_byte = (size_t)elem_size * ldb;
-        size_t ldt_h_byte = (size_t)elem_size * rows;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            size_t      i_start     = i_copy * n_cols;
-            int         n_cols_max  = cols - i_start < n_cols ? cols - i_start : n_cols;
-            int         contig_size = elem_size * rows * n_cols_max;
-            void*       b_d_start   = (char*)b_d + i_start * ldb_d_byte;
-            const void* a_h_start   = (const char*)a_h + i_start * lda_h_byte;
-
-            if((lda != rows) && (ldb != rows))
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device matrix
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size,
-                    t_d,
-                    rows,
-                    b_d_start,
-                    ldb);
-            }
-            else if(lda == rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host matrix -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, a_h_start, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device matrix
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size,
-                    t_d,
-                    rows,
-                    b_d_start,
-                    ldb);
-            }
-            else if(lda != rows && ldb == rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
-                // host buffer -> contiguous device matrix
-                PRINT_IF_HIP_ERROR(hipMemcpy(b_d_start, t_h, contig_size, hipMemcpyHostToDevice));
-            }
-        }
+        return rocblas_staged_copy_matrix(hipMemcpyHostToDevice,
+                                          size_t(elem_size) * rows,
+                                          cols,
+                                          a_h,
+                                          size_t(elem_size) * lda,
+                                          b_d,
+                                          size_t(elem_size) * ldb);
     }
     return rocblas_status_success;
 }
@@ -903,120 +860,17 @@ try
         size_t bytes_to_copy = elem_size * static_cast<size_t>(rows) * cols;
         PRINT_IF_HIP_ERROR(hipMemcpy(b_h, a_d, bytes_to_copy, hipMemcpyDeviceToHost));
     }
-    // columns too large for temp buffer, hipMemcpy column by column
-    else if(rows * elem_size > MAT_BUFF_MAX_BYTES)
-    {
-        for(size_t i = 0; i < cols; i++)
-        {
-            PRINT_IF_HIP_ERROR(hipMemcpy((char*)b_h + i * ldb * elem_size,
-                                         (const char*)a_d + i * lda * elem_size,
-                                         elem_size * rows,
-                                         hipMemcpyDeviceToHost));
-        }
-    }
-    // columns fit in temp buffer, pack columns in buffer, hipMemcpy device->host, unpack
-    // columns
+    // strided matrices: copy through pinned staging buffers, unpacking each chunk
+    // into the host matrix while the DMA of the next chunk proceeds
     else
     {
-        size_t bytes_to_copy = elem_size * static_cast<size_t>(rows) * cols;
-        size_t temp_byte_size
-            = bytes_to_copy < MAT_BUFF_MAX_BYTES ? bytes_to_copy : MAT_BUFF_MAX_BYTES;
-        int n_cols = temp_byte_size / (elem_size * rows); // number of columns in buffer
-        int n_copy = ((cols - 1) / n_cols) + 1; // number times buffer copied
-
-        rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
-        rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
-        dim3        grid(blocksX, blocksY);
-        dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
-
-        size_t lda_d_byte = (size_t)elem_size * lda;
-        size_t ldb_h_byte = (size_t)elem_size * ldb;
-        size_t ldt_h_byte = (size_t)elem_size * rows;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            int         i_start     = i_copy * n_cols;
-            int         n_cols_max  = cols - i_start < n_cols ? cols - i_start : n_cols;
-            size_t      contig_size = elem_size * (size_t)rows * n_cols_max;
-            const void* a_d_start   = (const char*)a_d + i_start * lda_d_byte;
-            void*       b_h_start   = (char*)b_h + i_start * ldb_h_byte;
-            if(lda != rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device matrix -> device buffer
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size,
-                    a_d_start,
-                    lda,
-                    t_d,
-                    rows);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
-            }
-            else if(lda == rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device matrix -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, a_d_start, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
-            }
-            else if(lda != rows && ldb == rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device matrix -> device buffer
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size,
-                    a_d_start,
-                    lda,
-                    t_d,
-                    rows);
-                // device temp buffer -> contiguous host matrix
-                PRINT_IF_HIP_ERROR(hipMemcpy(b_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
-            }
-        }
+        return rocblas_staged_copy_matrix(hipMemcpyDeviceToHost,
+                                          size_t(elem_size) * rows,
+                                          cols,
+                                          a_d,
+                                          size_t(elem_size) * lda,
+                                          b_h,
+                                          size_t(elem_size) * ldb);
     }
     return rocblas_status_success;
 }
@@ -1204,6 +1058,12 @@ std::string rocblas_internal_get_arch_name()
 {
     int deviceId;
     hipGetDevice(&deviceId);
+    return rocblas_internal_get_arch_name(deviceId);
+}
+
+// exported. Get architecture name of a device
+std::string rocblas_internal_get_arch_name(int deviceId)
+{
     hipDeviceProp_t deviceProperties;
     hipGetDeviceProperties(&deviceProperties, deviceId);
     return ArchName<hipDeviceProp_t>{}(deviceProperties);
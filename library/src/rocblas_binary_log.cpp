@@ -0,0 +1,244 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_binary_log.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    // Records in each thread's ring buffer, and the interval between drains of the rings
+    constexpr uint64_t RING_RECORDS   = 2048;
+    constexpr auto     DRAIN_INTERVAL = std::chrono::milliseconds(5);
+
+    /***************************************************************************
+     * Ring buffer of records written by one thread and drained by the         *
+     * background thread. head is only advanced by the writing thread and tail *
+     * only by the drainer, so no locks are needed.                            *
+     ***************************************************************************/
+    struct ring
+    {
+        std::unique_ptr<rocblas_binary_log_record[]> records{
+            new rocblas_binary_log_record[RING_RECORDS]};
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> tail{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool>     orphaned{false};
+        uint32_t              thread = 0;
+    };
+
+    class binary_logger
+    {
+        FILE*                                 file = nullptr;
+        std::chrono::steady_clock::time_point start;
+        std::list<std::shared_ptr<ring>>      rings;
+        std::mutex                            rings_mutex;
+        std::mutex                            drain_mutex;
+        std::condition_variable               drain_cv;
+        std::thread                           drainer;
+        uint32_t                              threads = 0;
+        bool                                  stop    = false;
+
+        // Write the committed records of one ring to the file
+        void drain(ring& r)
+        {
+            uint64_t tail = r.tail.load(std::memory_order_relaxed);
+            uint64_t head = r.head.load(std::memory_order_acquire);
+            while(tail != head)
+            {
+                uint64_t begin = tail % RING_RECORDS;
+                uint64_t count = std::min(head - tail, RING_RECORDS - begin);
+                fwrite(&r.records[begin], sizeof(rocblas_binary_log_record), count, file);
+                tail += count;
+            }
+            r.tail.store(tail, std::memory_order_release);
+
+            if(uint64_t dropped = r.dropped.exchange(0, std::memory_order_relaxed))
+            {
+                rocblas_binary_log_record record{};
+                record.timestamp = timestamp();
+                record.thread    = r.thread;
+                record.kind      = uint8_t(rocblas_binary_log_kind::dropped);
+                rocblas_binary_log_encoder{record}(dropped);
+                fwrite(&record, sizeof(record), 1, file);
+            }
+        }
+
+        void drain_all()
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            for(auto it = rings.begin(); it != rings.end();)
+            {
+                bool orphaned = (*it)->orphaned.load(std::memory_order_acquire);
+                drain(**it);
+                it = orphaned ? rings.erase(it) : std::next(it);
+            }
+            fflush(file);
+        }
+
+        void drain_loop()
+        {
+            std::unique_lock<std::mutex> lock(drain_mutex);
+            while(!stop)
+            {
+                drain_cv.wait_for(lock, DRAIN_INTERVAL);
+                drain_all();
+            }
+        }
+
+        binary_logger()
+            : start(std::chrono::steady_clock::now())
+        {
+            const char* path = getenv("ROCBLAS_LOG_BINARY_PATH");
+            file             = fopen(path ? path : "rocblas_log.bin", "wb");
+            if(!file)
+            {
+                rocblas_cerr << "rocBLAS error: cannot open binary log file "
+                             << (path ? path : "rocblas_log.bin") << std::endl;
+                return;
+            }
+
+            rocblas_binary_log_header header{};
+            memcpy(header.magic, ROCBLAS_BINARY_LOG_MAGIC, sizeof(header.magic));
+            header.version      = ROCBLAS_BINARY_LOG_VERSION;
+            header.record_bytes = ROCBLAS_BINARY_LOG_RECORD_BYTES;
+            fwrite(&header, sizeof(header), 1, file);
+            fflush(file);
+
+            drainer = std::thread(&binary_logger::drain_loop, this);
+        }
+
+    public:
+        // Never destroyed, since threads may log during static destruction; the records
+        // are flushed at exit instead
+        static binary_logger* instance()
+        {
+            static binary_logger* logger = new binary_logger;
+            static int            flush  = atexit([] { logger->shutdown(); });
+            (void)flush;
+            return logger->file ? logger : nullptr;
+        }
+
+        uint64_t timestamp() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start)
+                .count();
+        }
+
+        std::shared_ptr<ring> add_ring()
+        {
+            auto                        r = std::make_shared<ring>();
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            r->thread = ++threads;
+            rings.push_back(r);
+            return r;
+        }
+
+        // Wake the drainer early when a ring fills up
+        void notify()
+        {
+            drain_cv.notify_one();
+        }
+
+        void flush()
+        {
+            std::lock_guard<std::mutex> lock(drain_mutex);
+            if(!stop)
+                drain_all();
+        }
+
+        void shutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(drain_mutex);
+                if(stop)
+                    return;
+                stop = true;
+            }
+            drain_cv.notify_one();
+            drainer.join();
+            drain_all();
+        }
+    };
+
+    // The calling thread's ring, marked orphaned when the thread exits so the drainer frees it
+    struct thread_ring
+    {
+        std::shared_ptr<ring> r;
+        uint64_t              head = 0;
+
+        ~thread_ring()
+        {
+            if(r)
+                r->orphaned.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local thread_ring t_ring;
+}
+
+rocblas_binary_log_record* rocblas_binary_log_begin(rocblas_binary_log_kind kind)
+{
+    binary_logger* logger = binary_logger::instance();
+    if(!logger)
+        return nullptr;
+
+    if(!t_ring.r)
+        t_ring.r = logger->add_ring();
+    ring& r = *t_ring.r;
+
+    uint64_t used = t_ring.head - r.tail.load(std::memory_order_acquire);
+    if(used >= RING_RECORDS)
+    {
+        r.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if(used == RING_RECORDS / 2)
+        logger->notify();
+
+    rocblas_binary_log_record& record = r.records[t_ring.head % RING_RECORDS];
+    record.timestamp                  = logger->timestamp();
+    record.thread                     = r.thread;
+    record.size                       = 0;
+    record.kind                       = uint8_t(kind);
+    record.truncated                  = 0;
+    return &record;
+}
+
+void rocblas_binary_log_commit()
+{
+    t_ring.r->head.store(++t_ring.head, std::memory_order_release);
+}
+
+void rocblas_binary_log_flush()
+{
+    if(binary_logger* logger = binary_logger::instance())
+        logger->flush();
+}
@@ -0,0 +1,213 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_latency.hpp"
+#include "rocblas.h"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Histograms keyed by function name and packed data types
+    using latency_map = std::map<std::pair<std::string, uint64_t>, rocblas_latency_histogram>;
+
+    using latency_key = std::pair<const char*, uint64_t>;
+
+    struct latency_key_hash
+    {
+        size_t operator()(const latency_key& key) const
+        {
+            return std::hash<const char*>{}(key.first) ^ std::hash<uint64_t>{}(key.second);
+        }
+    };
+
+    /***************************************************************************
+     * Histograms of one thread, keyed by the address of the function name and *
+     * the packed data types. The mutex is only contended while the histograms *
+     * are being merged.                                                       *
+     ***************************************************************************/
+    struct latency_accumulator
+    {
+        std::mutex mutex;
+        std::unordered_map<latency_key,
+                           std::unique_ptr<rocblas_latency_histogram>,
+                           latency_key_hash>
+            histograms;
+
+        latency_accumulator();
+        ~latency_accumulator();
+
+        // Merge into a map keyed by function name, since equal names may have different addresses
+        void merge_into(latency_map& merged)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(const auto& h : histograms)
+                merged[{h.first.first, h.first.second}].merge(*h.second);
+        }
+    };
+
+    /***************************************************************************
+     * The registry of every thread's accumulator, and the merged histograms   *
+     * of threads which have exited. It is never destroyed, so that threads    *
+     * exiting during static destruction can still retire their histograms.    *
+     ***************************************************************************/
+    class latency_registry
+    {
+        std::mutex                        mutex;
+        std::vector<latency_accumulator*> threads;
+        latency_map                       retired;
+
+    public:
+        static latency_registry& instance()
+        {
+            static latency_registry* registry = new latency_registry;
+            return *registry;
+        }
+
+        void add(latency_accumulator* acc)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.push_back(acc);
+        }
+
+        void retire(latency_accumulator* acc)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.erase(std::find(threads.begin(), threads.end(), acc));
+            acc->merge_into(retired);
+        }
+
+        latency_map merged()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            latency_map result = retired;
+            for(auto acc : threads)
+                acc->merge_into(result);
+            return result;
+        }
+    };
+
+    latency_accumulator::latency_accumulator()
+    {
+        latency_registry::instance().add(this);
+    }
+
+    latency_accumulator::~latency_accumulator()
+    {
+        latency_registry::instance().retire(this);
+    }
+
+    // File for the histograms when no path is given: ROCBLAS_LOG_LATENCY_PATH, or else
+    // ROCBLAS_LOG_PROFILE_PATH with .latency.csv appended. An empty path means standard error.
+    std::string latency_path()
+    {
+        if(const char* path = getenv("ROCBLAS_LOG_LATENCY_PATH"))
+            return path;
+        if(const char* path = getenv("ROCBLAS_LOG_PROFILE_PATH"))
+            return std::string(path) + ".latency.csv";
+        return {};
+    }
+
+    // Names of packed data types, separated by spaces, in the order they were passed
+    std::string latency_types_string(uint64_t types)
+    {
+        std::string str;
+        for(; types; types >>= ROCBLAS_LATENCY_TYPE_BITS)
+        {
+            auto type = rocblas_datatype((types & ((1 << ROCBLAS_LATENCY_TYPE_BITS) - 1)) - 1);
+            str       = rocblas_datatype_string(type) + (str.empty() ? "" : " " + str);
+        }
+        return str;
+    }
+
+    // Write the merged histograms of all threads as CSV, one row per function and data types.
+    // stdio is used, because this may run during static destruction.
+    bool write_latency_histograms(const std::string& path)
+    {
+        std::ostringstream csv;
+        csv << "function,types,count,min_ns,mean_ns,p50_ns,p90_ns,p99_ns,p99.9_ns,max_ns\n";
+        for(const auto& h : latency_registry::instance().merged())
+        {
+            const auto& hist = h.second;
+            csv << h.first.first << ',' << latency_types_string(h.first.second) << ','
+                << hist.count() << ',' << hist.min() << ','
+                << uint64_t(hist.mean()) << ',' << hist.percentile(50) << ','
+                << hist.percentile(90) << ',' << hist.percentile(99) << ','
+                << hist.percentile(99.9) << ',' << hist.max() << '\n';
+        }
+
+        FILE* file = path.empty() ? stderr : fopen(path.c_str(), "w");
+        if(!file)
+            return false;
+        std::string str = csv.str();
+        bool        ok  = fwrite(str.data(), 1, str.size(), file) == str.size();
+        ok              = (path.empty() ? fflush(file) : fclose(file)) == 0 && ok;
+        return ok;
+    }
+
+    // Writes the histograms when the library is unloaded or the program exits. Each thread's
+    // histograms are retired by its thread_local destructor, which runs before this one.
+    struct latency_dump_at_exit
+    {
+        ~latency_dump_at_exit()
+        {
+            if(!write_latency_histograms(latency_path()))
+                perror("Error writing latency histograms");
+        }
+    };
+}
+
+void rocblas_latency_record(const char* func, uint64_t types, uint64_t nanoseconds)
+{
+    static latency_dump_at_exit dump_at_exit;
+    thread_local latency_accumulator acc;
+
+    std::lock_guard<std::mutex> lock(acc.mutex);
+    auto&                       hist = acc.histograms[{func, types}];
+    if(!hist)
+        hist = std::make_unique<rocblas_latency_histogram>();
+    hist->record(nanoseconds);
+}
+
+/*******************************************************************************
+ * Write the host latency histograms of all threads
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_write_latency_histograms(const char* path)
+try
+{
+    return write_latency_histograms(path ? path : latency_path()) ? rocblas_status_success
+                                                                   : rocblas_status_internal_error;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
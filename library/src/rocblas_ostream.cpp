@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2020-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (C) 2020-2023 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,10 +24,16 @@
 static void rocblas_abort_once [[noreturn]] ();
 
 #include "rocblas_ostream.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <csignal>
 #include <fcntl.h>
 #include <iostream>
 #include <type_traits>
+#ifndef WIN32
+#include <sys/uio.h>
+#endif
 #ifdef WIN32
 #include <io.h>
 #include <sys/stat.h>
@@ -256,12 +262,58 @@ void rocblas_internal_ostream::worker::send(std::string str)
 #endif
 }
 
+// Write the payloads of a batch of tasks in order, with a single writev where possible
+bool rocblas_internal_ostream::worker::write_batch(const std::vector<task_t>& batch)
+{
+#ifdef WIN32
+    for(const auto& task : batch)
+        fwrite(task.data(), 1, task.size(), m_file);
+
+    // Detect any error and flush the C FILE stream
+    return !ferror(m_file) && !fflush(m_file);
+#else
+    // The FILE is only used for its file descriptor, and is never buffered
+    int fd = fileno(m_file);
+
+    std::vector<iovec> iov;
+    iov.reserve(batch.size());
+    for(const auto& task : batch)
+        if(task.size())
+            iov.push_back({const_cast<char*>(task.data()), task.size()});
+
+    // Write all of the iovecs, resuming after partial writes
+    for(size_t i = 0; i < iov.size();)
+    {
+        ssize_t n = writev(fd, &iov[i], int(iov.size() - i));
+        if(n < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+
+        // Skip the iovecs which were completely written, and advance into a partial one
+        for(; i < iov.size() && size_t(n) >= iov[i].iov_len; ++i)
+            n -= iov[i].iov_len;
+        if(i < iov.size())
+        {
+            iov[i].iov_base = static_cast<char*>(iov[i].iov_base) + n;
+            iov[i].iov_len -= n;
+        }
+    }
+    return true;
+#endif
+}
+
 // Worker thread which serializes data to be written to a device/inode
 void rocblas_internal_ostream::worker::thread_function()
 {
     // Clear any errors in the FILE
     clearerr(m_file);
 
+    // Tasks removed from the queue to be written together
+    std::vector<task_t> batch;
+
     // Lock the mutex in preparation for cond.wait
     std::unique_lock<std::mutex> lock(m_mutex);
 
@@ -270,36 +322,35 @@ void rocblas_internal_ostream::worker::thread_function()
         // Wait for any data, ignoring spurious wakeups, locks lock on continue
         m_cond.wait(lock, [&] { return !m_queue.empty(); });
 
-        // With the mutex locked, get and pop data from the front of queue
-        task_t task = std::move(m_queue.front());
-        m_queue.pop();
-
-        // Temporarily unlock queue mutex, unblocking other threads
-        lock.unlock();
+        // Optionally wait a little longer for the batch to fill
+        if(m_batch_latency.count() && m_queue.size() < m_batch_size)
+            m_cond.wait_for(lock, m_batch_latency, [&] { return m_queue.size() >= m_batch_size; });
 
-        // An empty message indicates the closing of the stream
-        if(!task.size())
+        // With the mutex locked, move up to m_batch_size tasks from the front of queue.
+        // An empty message indicates the closing of the stream, and ends the batch.
+        bool closing = false;
+        while(!closing && !m_queue.empty() && batch.size() < m_batch_size)
         {
-            // Tell future to wake up
-            task.set_value();
-            break;
+            batch.push_back(std::move(m_queue.front()));
+            m_queue.pop();
+            closing = !batch.back().size();
         }
 
-        // Write the data
-        fwrite(task.data(), 1, task.size(), m_file);
+        // Temporarily unlock queue mutex, unblocking other threads
+        lock.unlock();
 
-        // Detect any error and flush the C FILE stream
-        if(ferror(m_file) || fflush(m_file))
-        {
+        // Write the data of every message in the batch
+        bool error = !write_batch(batch);
+        if(error)
             perror("Error writing log file");
 
-            // Tell future to wake up
+        // Promise that the data has been written, or tell futures to wake up on error
+        for(auto& task : batch)
             task.set_value();
-            break;
-        }
+        batch.clear();
 
-        // Promise that the data has been written
-        task.set_value();
+        if(closing || error)
+            break;
 
         // Re-lock the mutex in preparation for cond.wait
         lock.lock();
@@ -309,6 +360,21 @@ void rocblas_internal_ostream::worker::thread_function()
 // Constructor creates a worker thread from a file descriptor
 rocblas_internal_ostream::worker::worker(int fd)
 {
+    // The batch size and latency can be set with ROCBLAS_LOG_BATCH_SIZE and
+    // ROCBLAS_LOG_BATCH_LATENCY (in microseconds). By default, every queued message
+    // is written at once, up to the system's limit, without waiting for more.
+#ifdef IOV_MAX
+    constexpr size_t max_batch_size = IOV_MAX;
+#else
+    constexpr size_t max_batch_size = 1024;
+#endif
+    const char* env = getenv("ROCBLAS_LOG_BATCH_SIZE");
+    m_batch_size    = env ? strtoul(env, nullptr, 0) : max_batch_size;
+    m_batch_size    = std::max<size_t>(1, std::min(m_batch_size, max_batch_size));
+
+    env             = getenv("ROCBLAS_LOG_BATCH_LATENCY");
+    m_batch_latency = std::chrono::microseconds(env ? strtoul(env, nullptr, 0) : 0);
+
     // The worker duplicates the file descriptor (RAII)
 #ifdef WIN32
     fd = _dup(fd);
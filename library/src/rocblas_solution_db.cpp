@@ -0,0 +1,427 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_solution_db.hpp"
+#include "rocblas_ostream.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <share.h>
+#include <sys/locking.h>
+#include <sys/stat.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr char rocblas_solution_db::MAGIC[8];
+
+namespace
+{
+    // Round up to a power of 2, with the table at most half full
+    uint64_t db_bucket_count(uint64_t records)
+    {
+        uint64_t buckets = 16;
+        while(buckets < records * 2)
+            buckets *= 2;
+        return buckets;
+    }
+
+    // Copy a string into a fixed-size, zero-padded field
+    template <size_t N>
+    void db_copy_field(char (&field)[N], const std::string& str)
+    {
+        memset(field, 0, N);
+        strncpy(field, str.c_str(), N - 1);
+    }
+
+    // Compare a string to a fixed-size, zero-padded field
+    template <size_t N>
+    bool db_equal_field(const char (&field)[N], const std::string& str)
+    {
+        return str.size() < N && !strncmp(field, str.c_str(), N);
+    }
+
+    // Exclusive lock on a file next to the database, held while it is merged and replaced.
+    // The lock file is left in place, since removing it would race with other writers.
+    class db_lock_file
+    {
+        int m_fd;
+
+    public:
+        explicit db_lock_file(const std::string& path)
+        {
+#ifdef WIN32
+            if(_sopen_s(&m_fd,
+                        path.c_str(),
+                        _O_RDWR | _O_CREAT | _O_NOINHERIT,
+                        _SH_DENYNO,
+                        _S_IREAD | _S_IWRITE))
+                m_fd = -1;
+            // _LK_LOCK gives up with EDEADLOCK after 10 attempts, 1 second apart
+            while(m_fd != -1 && _locking(m_fd, _LK_LOCK, 1) && errno == EDEADLOCK)
+                ;
+#else
+            m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            while(m_fd != -1 && flock(m_fd, LOCK_EX) && errno == EINTR)
+                ;
+#endif
+        }
+
+        ~db_lock_file()
+        {
+            if(m_fd == -1)
+                return;
+#ifdef WIN32
+            _locking(m_fd, _LK_UNLCK, 1);
+            _close(m_fd);
+#else
+            close(m_fd); // releases the lock
+#endif
+        }
+
+        db_lock_file(const db_lock_file&) = delete;
+        db_lock_file& operator=(const db_lock_file&) = delete;
+    };
+} // namespace
+
+uint64_t rocblas_solution_db::checksum(const void* data, size_t size, uint64_t seed)
+{
+    auto* p = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < size; ++i)
+        seed = (seed ^ p[i]) * 0x100000001b3; // FNV-1a
+    return seed;
+}
+
+uint64_t rocblas_solution_db::checksum(const header_t& header, const record_t* table)
+{
+    static_assert(offsetof(header_t, checksum) + sizeof(header.checksum) == sizeof(header_t),
+                  "the checksum must be the last field of the header");
+    uint64_t sum = checksum(&header, offsetof(header_t, checksum));
+    return checksum(table, header.bucket_count * sizeof(record_t), sum);
+}
+
+rocblas_solution_db::rocblas_solution_db(std::string path,
+                                         std::string arch,
+                                         std::string rocblas_version,
+                                         uint64_t    library_hash,
+                                         bool        read_only)
+    : m_path(std::move(path))
+    , m_arch(std::move(arch))
+    , m_rocblas_version(std::move(rocblas_version))
+    , m_library_hash(library_hash)
+    , m_read_only(read_only)
+{
+    load();
+}
+
+rocblas_solution_db::~rocblas_solution_db()
+{
+    flush();
+    unload();
+}
+
+/*******************************************************************************
+ * Check the header and checksum of a mapped file
+ ******************************************************************************/
+bool rocblas_solution_db::validate(const void* data, size_t size) const
+{
+    if(size < sizeof(header_t))
+        return false;
+
+    auto* header = static_cast<const header_t*>(data);
+    if(memcmp(header->magic, MAGIC, sizeof(MAGIC)) || header->format_version != FORMAT_VERSION
+       || header->record_size != sizeof(record_t) || !db_equal_field(header->arch, m_arch)
+       || !db_equal_field(header->rocblas_version, m_rocblas_version)
+       || header->library_hash != m_library_hash)
+        return false;
+
+    uint64_t buckets = header->bucket_count;
+    if(!buckets || (buckets & (buckets - 1)) || header->record_count >= buckets
+       || (size - sizeof(header_t)) / sizeof(record_t) != buckets
+       || (size - sizeof(header_t)) % sizeof(record_t))
+        return false;
+
+    return checksum(*header, reinterpret_cast<const record_t*>(header + 1)) == header->checksum;
+}
+
+/*******************************************************************************
+ * Map the database file read-only, and accept it if it is valid
+ ******************************************************************************/
+void rocblas_solution_db::load()
+{
+    const void* data = nullptr;
+    size_t      size = 0;
+
+#ifdef WIN32
+    std::ifstream is(m_path, std::ios::binary | std::ios::ate);
+    if(!is)
+        return;
+    m_buffer.resize(size_t(is.tellg()));
+    is.seekg(0);
+    if(!is.read(m_buffer.data(), m_buffer.size()))
+        return;
+    data = m_buffer.data();
+    size = m_buffer.size();
+#else
+    int fd = open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+        return;
+
+    struct stat st;
+    if(!fstat(fd, &st) && st.st_size > 0)
+    {
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if(map != MAP_FAILED)
+        {
+            m_map      = map;
+            m_map_size = st.st_size;
+            data       = map;
+            size       = m_map_size;
+        }
+    }
+    close(fd);
+    if(!data)
+        return;
+#endif
+
+    if(validate(data, size))
+    {
+        m_header = static_cast<const header_t*>(data);
+        m_table  = reinterpret_cast<const record_t*>(m_header + 1);
+    }
+    else
+    {
+        rocblas_cerr << "\nrocBLAS warning: Ignoring stale or corrupted solution database "
+                     << m_path << std::endl;
+        unload();
+    }
+}
+
+void rocblas_solution_db::unload()
+{
+#ifdef WIN32
+    m_buffer.clear();
+#else
+    if(m_map)
+        munmap(m_map, m_map_size);
+#endif
+    m_map      = nullptr;
+    m_map_size = 0;
+    m_header   = nullptr;
+    m_table    = nullptr;
+}
+
+/*******************************************************************************
+ * Look up a signature in the loaded file, then in the new records
+ ******************************************************************************/
+bool rocblas_solution_db::find(const rocblas_solution_signature& sig,
+                               int64_t&                          solution_index,
+                               size_t&                           workspace_size) const
+{
+    const record_t* loaded = nullptr;
+    if(m_table)
+    {
+        // The probe is bounded, so that a table without empty buckets cannot hang the lookup
+        uint64_t buckets = m_header->bucket_count;
+        uint64_t i       = rocblas_solution_signature_hash{}(sig) & (buckets - 1);
+        for(uint64_t probe = 0; probe < buckets; ++probe, i = (i + 1) & (buckets - 1))
+        {
+            const record_t& rec = m_table[i];
+            if(rec.solution_index < 0)
+                break;
+            if(rec.signature == sig)
+            {
+                loaded = &rec;
+                break;
+            }
+        }
+    }
+
+    // A loaded record is used without locking, unless a new record may replace it
+    const record_t* found = loaded;
+    if(!loaded || m_replaced.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        p = m_new_records.find(sig);
+        if(p != m_new_records.end())
+        {
+            if(p->second.solution_index < 0)
+                return false;
+            solution_index = p->second.solution_index;
+            workspace_size = p->second.workspace_size;
+            return true;
+        }
+    }
+    if(!found)
+        return false;
+    solution_index = found->solution_index;
+    workspace_size = found->workspace_size;
+    return true;
+}
+
+void rocblas_solution_db::record(const rocblas_solution_signature& sig,
+                                 int64_t                           solution_index,
+                                 size_t                            workspace_size)
+{
+    if(m_read_only || solution_index < 0)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_new_records[sig] = {sig, solution_index, int64_t(workspace_size)};
+    m_dirty            = true;
+    m_replaced.store(true, std::memory_order_release);
+}
+
+void rocblas_solution_db::discard(const rocblas_solution_signature& sig)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_new_records[sig] = {sig, -1, 0};
+    m_dirty            = !m_read_only;
+    m_replaced.store(true, std::memory_order_release);
+}
+
+/*******************************************************************************
+ * Read the records of the database file as it is now, if it is valid
+ ******************************************************************************/
+void rocblas_solution_db::read_records(std::vector<record_t>& records) const
+{
+    std::ifstream is(m_path, std::ios::binary | std::ios::ate);
+    if(!is)
+        return;
+    std::vector<char> data(size_t(is.tellg()));
+    is.seekg(0);
+    if(!is.read(data.data(), data.size()) || !validate(data.data(), data.size()))
+        return;
+
+    auto* header = reinterpret_cast<const header_t*>(data.data());
+    auto* table  = reinterpret_cast<const record_t*>(header + 1);
+    for(uint64_t i = 0; i < header->bucket_count; ++i)
+        if(table[i].solution_index >= 0)
+            records.push_back(table[i]);
+}
+
+/*******************************************************************************
+ * Merge the loaded records, the records in the file as it is now, and the new
+ * records, write them to a temporary file, and rename it
+ ******************************************************************************/
+bool rocblas_solution_db::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_read_only || !m_dirty)
+        return true;
+
+    // Other processes may have replaced the file since it was loaded. Holding the lock
+    // file, their records are read back, so that the last writer does not discard them.
+    db_lock_file file_lock(m_path + ".lock");
+
+    // Gather all records. Later records replace earlier ones with the same signature, so the
+    // file's records replace the loaded ones, and the new records replace both. Discarded
+    // selections remove them.
+    std::vector<record_t> records;
+    if(m_table)
+        for(uint64_t i = 0; i < m_header->bucket_count; ++i)
+            if(m_table[i].solution_index >= 0)
+                records.push_back(m_table[i]);
+    read_records(records);
+    for(const auto& p : m_new_records)
+        if(p.second.solution_index >= 0)
+            records.push_back(p.second);
+
+    // Build the hash table
+    uint64_t              buckets = db_bucket_count(records.size());
+    uint64_t              mask    = buckets - 1;
+    uint64_t              count   = 0;
+    std::vector<record_t> table(buckets);
+    for(auto& rec : table)
+        rec.solution_index = -1;
+    for(const record_t& rec : records)
+    {
+        auto p = m_new_records.find(rec.signature);
+        if(p != m_new_records.end() && p->second.solution_index < 0)
+            continue;
+
+        for(uint64_t i = rocblas_solution_signature_hash{}(rec.signature) & mask;;
+            i = (i + 1) & mask)
+        {
+            if(table[i].solution_index < 0)
+            {
+                table[i] = rec;
+                ++count;
+                break;
+            }
+            if(table[i].signature == rec.signature)
+            {
+                table[i] = rec;
+                break;
+            }
+        }
+    }
+
+    header_t header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.format_version = FORMAT_VERSION;
+    header.record_size    = sizeof(record_t);
+    db_copy_field(header.arch, m_arch);
+    db_copy_field(header.rocblas_version, m_rocblas_version);
+    header.library_hash = m_library_hash;
+    header.bucket_count = buckets;
+    header.record_count = count;
+    header.checksum     = checksum(header, table.data());
+
+    // Write to a temporary file in the same directory, and atomically replace the database
+    std::string tmp_path = m_path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream os(tmp_path, std::ios::binary | std::ios::trunc);
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os.write(reinterpret_cast<const char*>(table.data()), buckets * sizeof(record_t));
+        if(!os.flush())
+        {
+            os.close();
+            remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+#ifdef WIN32
+    remove(m_path.c_str());
+#endif
+    if(rename(tmp_path.c_str(), m_path.c_str()))
+    {
+        remove(tmp_path.c_str());
+        return false;
+    }
+
+    // The new records stay in memory, since the mapping still refers to the old file
+    m_dirty = false;
+    return true;
+}
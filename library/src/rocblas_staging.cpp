@@ -0,0 +1,575 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_staging.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // Size of each pinned staging buffer, and the number of buffers used by one copy
+    constexpr size_t STAGING_BUFFER_BYTES = 4 * 1024 * 1024;
+    constexpr size_t STAGING_BUFFERS      = 2;
+
+    // Chunks at least this large are packed by several threads
+    constexpr size_t PARALLEL_PACK_BYTES = 1024 * 1024;
+
+    // Maximum number of threads which pack one chunk, including the calling thread
+    constexpr unsigned MAX_PACK_THREADS = 4;
+
+    /***************************************************************************
+     * Persistent worker threads which split a packing job with the caller.    *
+     * One job runs at a time; a caller which finds the workers busy packs on   *
+     * its own thread.                                                         *
+     ***************************************************************************/
+    class pack_workers
+    {
+        std::vector<std::thread>            threads;
+        std::mutex                          mutex;
+        std::mutex                          busy;
+        std::condition_variable             start_cv;
+        std::condition_variable             done_cv;
+        std::function<void(size_t, size_t)> task;
+        size_t                              generation = 0;
+        size_t                              remaining  = 0;
+        bool                                stop       = false;
+
+        void worker(size_t part)
+        {
+            size_t seen = 0;
+            for(;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    start_cv.wait(lock, [&] { return stop || generation != seen; });
+                    if(stop)
+                        return;
+                    seen = generation;
+                }
+                task(part, threads.size() + 1);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!--remaining)
+                        done_cv.notify_one();
+                }
+            }
+        }
+
+        pack_workers()
+        {
+            unsigned n = std::min(std::thread::hardware_concurrency(), MAX_PACK_THREADS);
+            for(unsigned i = 1; i < n; ++i)
+                threads.emplace_back(&pack_workers::worker, this, i);
+        }
+
+    public:
+        ~pack_workers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            start_cv.notify_all();
+            for(auto& t : threads)
+                t.join();
+        }
+
+        static pack_workers& instance()
+        {
+            static pack_workers workers;
+            return workers;
+        }
+
+        // Call f(part, parts) for each part in [0, parts)
+        void run(const std::function<void(size_t, size_t)>& f)
+        {
+            std::unique_lock<std::mutex> busy_lock(busy, std::try_to_lock);
+            if(!busy_lock || threads.empty())
+                return f(0, 1);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                task      = f;
+                remaining = threads.size();
+                ++generation;
+            }
+            start_cv.notify_all();
+            f(0, threads.size() + 1);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done_cv.wait(lock, [&] { return !remaining; });
+        }
+    };
+
+    // Copy cols columns of width bytes between host buffers with different leading dimensions
+    void copy_columns(
+        char* dst, size_t dst_ld, const char* src, size_t src_ld, size_t width, size_t cols)
+    {
+        auto copy = [=](size_t part, size_t parts) {
+            if(cols >= parts)
+            {
+                // Split the columns between the threads
+                for(size_t c = cols * part / parts; c < cols * (part + 1) / parts; ++c)
+                    memcpy(dst + c * dst_ld, src + c * src_ld, width);
+            }
+            else
+            {
+                // Split each column between the threads
+                size_t begin = width * part / parts, end = width * (part + 1) / parts;
+                for(size_t c = 0; c < cols; ++c)
+                    memcpy(dst + c * dst_ld + begin, src + c * src_ld + begin, end - begin);
+            }
+        };
+
+        if(width * cols < PARALLEL_PACK_BYTES)
+            copy(0, 1);
+        else
+            pack_workers::instance().run(copy);
+    }
+
+    /***************************************************************************
+     * A set of pinned staging buffers, each with an event recording the last  *
+     * DMA which used it. Sets are created on first use and kept for the life  *
+     * of the process, so pinned allocations are not repeated on every copy.   *
+     ***************************************************************************/
+    struct staging_set
+    {
+        std::array<void*, STAGING_BUFFERS>      buffers{};
+        std::array<hipEvent_t, STAGING_BUFFERS> events{};
+    };
+
+    class staging_pool
+    {
+        std::mutex                                         mutex;
+        std::unordered_map<int, std::vector<staging_set*>> free_sets;
+
+    public:
+        static staging_pool& instance()
+        {
+            // Never destroyed, since HIP may already be shut down at exit
+            static staging_pool* pool = new staging_pool;
+            return *pool;
+        }
+
+        // Take a free staging set for a device, or create one. Returns nullptr on failure.
+        staging_set* acquire(int device)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto&                       sets = free_sets[device];
+                if(!sets.empty())
+                {
+                    staging_set* set = sets.back();
+                    sets.pop_back();
+                    return set;
+                }
+            }
+
+            auto* set = new staging_set;
+            for(size_t i = 0; i < STAGING_BUFFERS; ++i)
+            {
+                if(hipHostMalloc(&set->buffers[i], STAGING_BUFFER_BYTES, hipHostMallocPortable)
+                       != hipSuccess
+                   || hipEventCreateWithFlags(&set->events[i], hipEventDisableTiming)
+                          != hipSuccess)
+                {
+                    for(size_t j = 0; j <= i; ++j)
+                    {
+                        if(set->buffers[j])
+                            (void)hipHostFree(set->buffers[j]);
+                        if(set->events[j])
+                            (void)hipEventDestroy(set->events[j]);
+                    }
+                    delete set;
+                    return nullptr;
+                }
+            }
+            return set;
+        }
+
+        void release(int device, staging_set* set)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free_sets[device].push_back(set);
+        }
+    };
+
+    // Holds a staging set for the duration of a copy, waiting for outstanding DMA
+    // before returning it to the pool, even if the copy fails part way
+    class staging_lease
+    {
+        int          device;
+        staging_set* set;
+
+    public:
+        explicit staging_lease(int device)
+            : device(device)
+            , set(staging_pool::instance().acquire(device))
+        {
+        }
+
+        ~staging_lease()
+        {
+            if(set)
+            {
+                for(auto event : set->events)
+                    (void)hipEventSynchronize(event);
+                staging_pool::instance().release(device, set);
+            }
+        }
+
+        staging_lease(const staging_lease&) = delete;
+        staging_lease& operator=(const staging_lease&) = delete;
+
+        explicit operator bool() const
+        {
+            return set != nullptr;
+        }
+
+        void* buffer(size_t i) const
+        {
+            return set->buffers[i % STAGING_BUFFERS];
+        }
+
+        hipEvent_t event(size_t i) const
+        {
+            return set->events[i % STAGING_BUFFERS];
+        }
+    };
+
+    /***************************************************************************
+     * Division of a matrix into chunks which fit in a staging buffer. Narrow  *
+     * columns are grouped into chunks of whole columns; columns wider than a  *
+     * staging buffer are split into segments of one column each.              *
+     ***************************************************************************/
+    class chunk_layout
+    {
+        size_t width, cols, cols_per_chunk, segment, segments;
+
+    public:
+        chunk_layout(size_t width, size_t cols)
+            : width(width)
+            , cols(cols)
+            , cols_per_chunk(width <= STAGING_BUFFER_BYTES ? STAGING_BUFFER_BYTES / width : 1)
+            , segment(std::min(width, STAGING_BUFFER_BYTES))
+            , segments((width - 1) / segment + 1)
+        {
+        }
+
+        size_t count() const
+        {
+            return ((cols - 1) / cols_per_chunk + 1) * segments;
+        }
+
+        // First column, number of columns, byte offset within the columns, and bytes per column
+        void get(size_t i, size_t& col, size_t& ncols, size_t& offset, size_t& bytes) const
+        {
+            col    = i / segments * cols_per_chunk;
+            ncols  = std::min(cols_per_chunk, cols - col);
+            offset = i % segments * segment;
+            bytes  = std::min(segment, width - offset);
+        }
+    };
+
+    rocblas_status staged_set(const chunk_layout& layout,
+                              const staging_lease& staging,
+                              const char*          src,
+                              size_t               src_ld,
+                              char*                dst,
+                              size_t               dst_ld,
+                              hipStream_t          stream)
+    {
+        for(size_t i = 0; i < layout.count(); ++i)
+        {
+            size_t col, ncols, offset, bytes;
+            layout.get(i, col, ncols, offset, bytes);
+            char* buffer = static_cast<char*>(staging.buffer(i));
+
+            // Wait for the DMA out of this buffer, then pack the chunk into it while the
+            // DMA of the previous chunk proceeds
+            RETURN_IF_HIP_ERROR(hipEventSynchronize(staging.event(i)));
+            copy_columns(buffer, bytes, src + col * src_ld + offset, src_ld, bytes, ncols);
+
+            RETURN_IF_HIP_ERROR(hipMemcpy2DAsync(dst + col * dst_ld + offset,
+                                                 dst_ld,
+                                                 buffer,
+                                                 bytes,
+                                                 bytes,
+                                                 ncols,
+                                                 hipMemcpyHostToDevice,
+                                                 stream));
+            RETURN_IF_HIP_ERROR(hipEventRecord(staging.event(i), stream));
+        }
+
+        // Wait for the last DMAs to complete
+        for(size_t i = 0; i < STAGING_BUFFERS; ++i)
+            RETURN_IF_HIP_ERROR(hipEventSynchronize(staging.event(i)));
+        return rocblas_status_success;
+    }
+
+    rocblas_status staged_get(const chunk_layout& layout,
+                              const staging_lease& staging,
+                              const char*          src,
+                              size_t               src_ld,
+                              char*                dst,
+                              size_t               dst_ld,
+                              hipStream_t          stream)
+    {
+        size_t count = layout.count();
+
+        // Start the DMA of chunk i into its staging buffer
+        auto issue = [&](size_t i) {
+            size_t col, ncols, offset, bytes;
+            layout.get(i, col, ncols, offset, bytes);
+            RETURN_IF_HIP_ERROR(hipMemcpy2DAsync(staging.buffer(i),
+                                                 bytes,
+                                                 src + col * src_ld + offset,
+                                                 src_ld,
+                                                 bytes,
+                                                 ncols,
+                                                 hipMemcpyDeviceToHost,
+                                                 stream));
+            RETURN_IF_HIP_ERROR(hipEventRecord(staging.event(i), stream));
+            return rocblas_status_success;
+        };
+
+        for(size_t i = 0; i < std::min(count, STAGING_BUFFERS - 1); ++i)
+            RETURN_IF_ROCBLAS_ERROR(issue(i));
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            // The buffer of chunk i + STAGING_BUFFERS - 1 was unpacked in the last iteration
+            if(i + STAGING_BUFFERS - 1 < count)
+                RETURN_IF_ROCBLAS_ERROR(issue(i + STAGING_BUFFERS - 1));
+
+            // Unpack chunk i while the DMA of the following chunks proceeds
+            size_t col, ncols, offset, bytes;
+            layout.get(i, col, ncols, offset, bytes);
+            RETURN_IF_HIP_ERROR(hipEventSynchronize(staging.event(i)));
+            copy_columns(dst + col * dst_ld + offset,
+                         dst_ld,
+                         static_cast<const char*>(staging.buffer(i)),
+                         bytes,
+                         bytes,
+                         ncols);
+        }
+        return rocblas_status_success;
+    }
+}
+
+rocblas_status rocblas_staged_copy_matrix(hipMemcpyKind kind,
+                                          size_t        width,
+                                          size_t        cols,
+                                          const void*   src,
+                                          size_t        src_ld,
+                                          void*         dst,
+                                          size_t        dst_ld,
+                                          hipStream_t   stream)
+{
+    if(!width || !cols)
+        return rocblas_status_success;
+
+    int device;
+    RETURN_IF_HIP_ERROR(hipGetDevice(&device));
+
+    staging_lease staging(device);
+    if(!staging)
+    {
+        // Without pinned memory, fall back to an unstaged copy
+        RETURN_IF_HIP_ERROR(hipMemcpy2DAsync(dst, dst_ld, src, src_ld, width, cols, kind, stream));
+        RETURN_IF_HIP_ERROR(hipStreamSynchronize(stream));
+        return rocblas_status_success;
+    }
+
+    chunk_layout layout(width, cols);
+    auto         s = static_cast<const char*>(src);
+    auto         d = static_cast<char*>(dst);
+    return kind == hipMemcpyHostToDevice
+               ? staged_set(layout, staging, s, src_ld, d, dst_ld, stream)
+               : staged_get(layout, staging, s, src_ld, d, dst_ld, stream);
+}
+
+namespace
+{
+    // Smallest staging block, and the default limit of idle bytes held by the block cache
+    constexpr size_t STAGING_BLOCK_MIN_BYTES   = 4096;
+    constexpr size_t STAGING_CACHE_LIMIT_BYTES = 64 * 1024 * 1024;
+
+    /***************************************************************************
+     * Free lists of pinned host and device staging blocks, keyed by device,   *
+     * memory kind and power-of-two size. Only idle blocks are counted against *
+     * the limit; blocks in use are owned by their rocblas_staging_block.      *
+     ***************************************************************************/
+    class staging_block_cache
+    {
+        // Free lists ordered by bucket size, then device and memory kind
+        using block_key = std::tuple<size_t, int, bool>;
+
+        std::mutex                              mutex;
+        std::map<block_key, std::vector<void*>> free_blocks;
+        size_t                                  limit;
+        size_t                                  held   = 0;
+        size_t                                  hits   = 0;
+        size_t                                  misses = 0;
+
+        static void free_block(bool host, void* ptr)
+        {
+            if(host)
+                PRINT_IF_HIP_ERROR(hipHostFree(ptr));
+            else
+                PRINT_IF_HIP_ERROR(hipFree(ptr));
+        }
+
+        // Free idle blocks, largest first, until the bytes held are within the limit
+        void trim()
+        {
+            for(auto it = free_blocks.rbegin(); held > limit && it != free_blocks.rend(); ++it)
+            {
+                while(held > limit && !it->second.empty())
+                {
+                    free_block(std::get<2>(it->first), it->second.back());
+                    it->second.pop_back();
+                    held -= std::get<0>(it->first);
+                }
+            }
+        }
+
+        staging_block_cache()
+        {
+            const char* env = getenv("ROCBLAS_STAGING_CACHE_LIMIT");
+            limit           = env ? strtoull(env, nullptr, 0) : STAGING_CACHE_LIMIT_BYTES;
+        }
+
+    public:
+        static staging_block_cache& instance()
+        {
+            // Never destroyed, since HIP may already be shut down at exit
+            static staging_block_cache* cache = new staging_block_cache;
+            return *cache;
+        }
+
+        void* acquire(int device, bool host, size_t bucket)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto                        it = free_blocks.find(block_key{bucket, device, host});
+                if(it != free_blocks.end() && !it->second.empty())
+                {
+                    void* ptr = it->second.back();
+                    it->second.pop_back();
+                    held -= bucket;
+                    ++hits;
+                    return ptr;
+                }
+                ++misses;
+            }
+
+            void* ptr = nullptr;
+            if((host ? hipHostMalloc(&ptr, bucket, hipHostMallocPortable) : hipMalloc(&ptr, bucket))
+               != hipSuccess)
+                return nullptr;
+            return ptr;
+        }
+
+        void release(int device, bool host, size_t bucket, void* ptr)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(held + bucket <= limit)
+                {
+                    free_blocks[block_key{bucket, device, host}].push_back(ptr);
+                    held += bucket;
+                    return;
+                }
+            }
+            free_block(host, ptr);
+        }
+
+        void set_limit(size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            limit = bytes;
+            trim();
+        }
+
+        size_t get_limit()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return limit;
+        }
+
+        void stats(size_t* hits_out, size_t* misses_out, size_t* held_out)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(hits_out)
+                *hits_out = hits;
+            if(misses_out)
+                *misses_out = misses;
+            if(held_out)
+                *held_out = held;
+        }
+    };
+}
+
+rocblas_staging_block::rocblas_staging_block(bool host, size_t size)
+    : ptr(nullptr)
+    , bucket(STAGING_BLOCK_MIN_BYTES)
+    , device(0)
+    , host(host)
+{
+    while(bucket < size)
+        bucket *= 2;
+    if(size && hipGetDevice(&device) == hipSuccess)
+        ptr = staging_block_cache::instance().acquire(device, host, bucket);
+}
+
+rocblas_staging_block::~rocblas_staging_block()
+{
+    if(ptr)
+        staging_block_cache::instance().release(device, host, bucket, ptr);
+}
+
+void rocblas_staging_cache_set_limit(size_t bytes)
+{
+    staging_block_cache::instance().set_limit(bytes);
+}
+
+size_t rocblas_staging_cache_get_limit()
+{
+    return staging_block_cache::instance().get_limit();
+}
+
+void rocblas_staging_cache_stats(size_t* hits, size_t* misses, size_t* bytes_held)
+{
+    staging_block_cache::instance().stats(hits, misses, bytes_held);
+}
@@ -31,6 +31,8 @@ extern "C" void rocblas_shutdown();
  * or reference Tensile identifiers. tensile_host.hpp defines the interface. *
  *****************************************************************************/
 
+#include "logging.hpp"
+#include "rocblas_solution_db.hpp"
 #include "tensile_host.hpp"
 //#include <Tensile/AMDGPU.hpp>
 #include <Tensile/Contractions.hpp>
@@ -43,14 +45,21 @@ extern "C" void rocblas_shutdown();
 #include <Tensile/hip/HipHardware.hpp>
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <complex>
+#include <condition_variable>
+#include <deque>
 #include <exception>
+#include <fstream>
 #include <future>
 #include <iomanip>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -215,6 +224,43 @@ namespace
         }
     };
 
+    /*********************************************************************
+     * Size of the GSU workspace which is available to Tensile. We set   *
+     * it to max size_t if this is a size query.                         *
+     *********************************************************************/
+    size_t GetTensileWorkspaceSize(rocblas_handle handle)
+    {
+        return handle->is_device_memory_size_query()
+                   ? ~size_t{0}
+                   : (handle->get_available_workspace() / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
+                         * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+    }
+
+    /*********************************************************************
+     * Whether the environment forces the use of VALU for double         *
+     * precision gemm                                                    *
+     *********************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    bool ForceValuForDgemm()
+    {
+        static const bool force_valu_for_dgemm
+            = std::getenv("ROCBLAS_INTERNAL_FORCE_VALU_FOR_DGEMM");
+        return std::is_same<Ti, double>{} && std::is_same<To, double>{}
+               && std::is_same<Tc, double>{} && force_valu_for_dgemm;
+    }
+
+    /*********************************************************************
+     * Whether to use the alternate fp16 implementation: the environment *
+     * variable ROCBLAS_INTERNAL_FP16_ALT_IMPL overrides the flag         *
+     *********************************************************************/
+    bool Fp16AltImpl(rocblas_gemm_flags flags)
+    {
+        static const char* fp16AltImplEnvStr = std::getenv("ROCBLAS_INTERNAL_FP16_ALT_IMPL");
+        static const int   fp16AltImplEnv
+            = (fp16AltImplEnvStr == NULL ? -1 : (std::atoi(fp16AltImplEnvStr) == 0 ? 0 : 1));
+        return fp16AltImplEnv != -1 ? fp16AltImplEnv : (flags & rocblas_gemm_flags_fp16_alt_impl);
+    }
+
     /****************************************************************
      * Construct a Tensile Problem from a RocblasContractionProblem *
      ****************************************************************/
@@ -320,12 +366,8 @@ namespace
                                     {prob.row_stride_d, prob.col_stride_d, prob.batch_stride_d},
                                     prob.buffer_offset_d};
 
-        // Size of GSU workspace. We set it to max size_t if this is a size query.
-        size_t workspace_size
-            = prob.handle->is_device_memory_size_query()
-                  ? ~size_t{0}
-                  : (prob.handle->get_available_workspace() / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
-                        * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+        // Size of GSU workspace
+        size_t workspace_size = GetTensileWorkspaceSize(prob.handle);
 
         // The ContractionProblem
         Tensile::ContractionProblem tensileProblem{a,
@@ -351,9 +393,7 @@ namespace
                                                   || std::is_same<Ti, rocblas_int8x4>{});
 
         // Environment variable to force use of VALU for double precision gemm
-        static bool force_valu_for_dgemm = std::getenv("ROCBLAS_INTERNAL_FORCE_VALU_FOR_DGEMM");
-        if(std::is_same<Ti, double>::value && std::is_same<To, double>::value
-           && std::is_same<Tc, double>::value && force_valu_for_dgemm)
+        if(ForceValuForDgemm<Ti, To, Tc>())
         {
             tensileProblem.setArithmeticUnit(Tensile::ArithmeticUnit::VALU);
         }
@@ -388,17 +428,113 @@ namespace
         // Add problem predicates for CEqualsD
         tensileProblem.setCEqualsD(prob.C == prob.D);
 
-        static const char* fp16AltImplEnvStr = std::getenv("ROCBLAS_INTERNAL_FP16_ALT_IMPL");
-        static const int   fp16AltImplEnv
-            = (fp16AltImplEnvStr == NULL ? -1 : (std::atoi(fp16AltImplEnvStr) == 0 ? 0 : 1));
-        if(fp16AltImplEnv != -1)
-            tensileProblem.setFp16AltImpl(fp16AltImplEnv);
-        else
-            tensileProblem.setFp16AltImpl(prob.flags & rocblas_gemm_flags_fp16_alt_impl);
+        tensileProblem.setFp16AltImpl(Fp16AltImpl(prob.flags));
 
         return tensileProblem;
     }
 
+    /***********************************************************************
+     * Construct the solution cache signature of a RocblasContractionProblem *
+     * Every input to ConstructTensileProblem() which can affect solution    *
+     * selection must be captured here.                                      *
+     ***********************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    auto ConstructSolutionSignature(const RocblasContractionProblem<Ti, To, Tc>& prob,
+                                    const hipDeviceProp_t&                       deviceProp)
+    {
+        rocblas_performance_metric metric;
+        rocblas_get_performance_metric(prob.handle, &metric);
+
+        // The metric is overridden by the CU efficiency flag in ConstructTensileProblem
+        if(prob.flags & rocblas_gemm_flags_use_cu_efficiency)
+            metric = rocblas_cu_efficiency_performance_metric;
+
+        rocblas_solution_signature sig;
+
+        // The full name, with its features, distinguishes devices with the same gcnArch
+        const char* arch_name = deviceProp.gcnArchName;
+
+        sig.arch      = prob.handle->getArch();
+        sig.arch_name = rocblas_solution_db::checksum(
+            arch_name, strnlen(arch_name, sizeof(deviceProp.gcnArchName)));
+        sig.cu_count  = deviceProp.multiProcessorCount;
+
+        sig.a_type       = int64_t(tensile_datatype<Ti>);
+        sig.c_type       = int64_t(tensile_datatype<To>);
+        sig.compute_type = int64_t(tensile_datatype<Tc>);
+
+        sig.trans_a = prob.trans_a;
+        sig.trans_b = prob.trans_b;
+        sig.flags   = prob.flags;
+
+        sig.m           = prob.m;
+        sig.n           = prob.n;
+        sig.k           = prob.k && *prob.alpha ? prob.k : 0;
+        sig.batch_count = prob.batch_count;
+
+        sig.row_stride_a    = prob.row_stride_a;
+        sig.col_stride_a    = prob.col_stride_a;
+        sig.batch_stride_a  = prob.batch_stride_a;
+        sig.buffer_offset_a = prob.buffer_offset_a;
+        sig.row_stride_b    = prob.row_stride_b;
+        sig.col_stride_b    = prob.col_stride_b;
+        sig.batch_stride_b  = prob.batch_stride_b;
+        sig.buffer_offset_b = prob.buffer_offset_b;
+        sig.row_stride_c    = prob.row_stride_c;
+        sig.col_stride_c    = prob.col_stride_c;
+        sig.batch_stride_c  = prob.batch_stride_c;
+        sig.buffer_offset_c = prob.buffer_offset_c;
+        sig.row_stride_d    = prob.row_stride_d;
+        sig.col_stride_d    = prob.col_stride_d;
+        sig.batch_stride_d  = prob.batch_stride_d;
+        sig.buffer_offset_d = prob.buffer_offset_d;
+
+        sig.strided_batch  = prob.strided_batch;
+        sig.alpha_category = prob.k ? int64_t(value_category(*prob.alpha)) : 0;
+        sig.beta_category  = int64_t(value_category(*prob.beta));
+        sig.c_equals_d     = prob.C == prob.D;
+
+        // Settings from the environment
+        sig.fp16_alt_impl        = Fp16AltImpl(prob.flags);
+        sig.force_valu_for_dgemm = ForceValuForDgemm<Ti, To, Tc>();
+
+        sig.atomics_mode       = prob.handle->atomics_mode;
+        sig.performance_metric = metric;
+        sig.workspace_size     = GetTensileWorkspaceSize(prob.handle);
+
+        return sig;
+    }
+
+    /***********************************************************************
+     * Construct the key of the tuned override for a problem, if there is *
+     * one                                                                *
+     ***********************************************************************/
+    template <typename T>
+    constexpr rocblas_datatype override_datatype
+        = std::is_same<T, rocblas_int8x4>{} ? rocblas_datatype_i8_r : rocblas_datatype_from_type<T>;
+
+    template <typename Ti, typename To, typename Tc>
+    auto ConstructOverrideKey(const RocblasContractionProblem<Ti, To, Tc>& prob)
+    {
+        rocblas_gemm_override_key key;
+
+        key.a_type       = override_datatype<Ti>;
+        key.c_type       = override_datatype<To>;
+        key.compute_type = override_datatype<Tc>;
+        key.trans_a      = prob.trans_a;
+        key.trans_b      = prob.trans_b;
+        key.m            = prob.m;
+        key.n            = prob.n;
+        key.k            = prob.k;
+        key.lda          = prob.col_stride_a;
+        key.ldb          = prob.col_stride_b;
+        key.ldc          = prob.col_stride_c;
+        key.ldd          = prob.col_stride_d;
+        key.batch_count  = prob.batch_count;
+
+        return key;
+    }
+
     /***************************************************************
      * Construct the inputs to a Tensile ContractionProblem        *
      ***************************************************************/
@@ -454,6 +590,46 @@ namespace
         return inputs;
     }
 
+    /**********************************************************************
+     * Time spent in each phase of Tensile initialization, in nanoseconds *
+     * summed over devices                                                *
+     **********************************************************************/
+    struct tensile_init_timings
+    {
+        std::atomic<uint64_t> parse{0};
+        std::atomic<uint64_t> code_object_load{0};
+        std::atomic<uint64_t> adapter_init{0};
+    };
+
+    tensile_init_timings& init_timings()
+    {
+        static tensile_init_timings timings;
+        return timings;
+    }
+
+    // Adds the time from its construction to its destruction to a phase of init_timings()
+    class init_phase_timer
+    {
+        std::atomic<uint64_t>&                m_total;
+        std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+
+    public:
+        explicit init_phase_timer(std::atomic<uint64_t>& total)
+            : m_total(total)
+        {
+        }
+
+        ~init_phase_timer()
+        {
+            m_total += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - m_start)
+                           .count();
+        }
+    };
+
+    // Waits for the workers started by rocblas_initialize_async
+    void tensile_warmup_wait(bool cancel);
+
     /**************************************************
      * The TensileHost struct interfaces with Tensile *
      **************************************************/
@@ -461,19 +637,24 @@ namespace
     {
         // The library object
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> m_library;
-        std::shared_ptr<hipDeviceProp_t>                                             m_deviceProp;
 
         // The adapter object. mutable is used to allow adapters to be modified
-        // even when they are stored in a const vector which is immutable in size
+        // even when they are stored in a const vector which is immutable in size.
+        // The device properties are set before the adapter is published.
         struct adapter_s
         {
             mutable std::atomic<Tensile::hip::SolutionAdapter*> adapter{nullptr};
             mutable std::mutex                                  mutex;
+            mutable std::shared_ptr<hipDeviceProp_t>            deviceProp;
+            mutable std::shared_ptr<Tensile::Hardware>          hardware;
         };
 
         // Each device contains an adapter
         std::vector<adapter_s> const m_adapters;
 
+        // Persistent solution selection database, if ROCBLAS_SOLUTION_DB_PATH is set
+        std::unique_ptr<rocblas_solution_db> m_solution_db;
+
     public:
         TensileHost()
             : m_adapters(GetDeviceCount())
@@ -503,6 +684,9 @@ namespace
 
         ~TensileHost()
         {
+            // Devices already being initialized in the background must finish first
+            tensile_warmup_wait(true);
+
             for(auto& a : m_adapters)
                 delete a.adapter;
         }
@@ -512,14 +696,65 @@ namespace
             return m_library;
         }
 
-        auto& get_device_property() const
+        auto& get_adapters() const
+        {
+            return m_adapters;
+        }
+
+        auto* get_solution_db() const
         {
-            return m_deviceProp;
+            return m_solution_db.get();
         }
 
-        auto& get_adapters() const
+        /******************************************************************
+         * Identify a Tensile library file by its contents, so that a     *
+         * database is neither kept for a rebuilt library at the same     *
+         * path nor discarded when an identical library is copied or      *
+         * reinstalled. The file is read once, when the database opens.   *
+         ******************************************************************/
+        static uint64_t LibraryHash(const std::string& path)
         {
-            return m_adapters;
+            std::ifstream     is(path, std::ios::binary);
+            std::vector<char> buffer(1 << 20);
+            uint64_t          hash = rocblas_solution_db::checksum(nullptr, 0);
+            while(is.read(buffer.data(), buffer.size()) || is.gcount())
+                hash = rocblas_solution_db::checksum(buffer.data(), is.gcount(), hash);
+            return hash;
+        }
+
+        /*********************************************************************
+         * Open the solution selection database named by the environment     *
+         * variable ROCBLAS_SOLUTION_DB_PATH. If ROCBLAS_SOLUTION_DB_READONLY *
+         * is set to a nonzero value, new selections are not recorded.       *
+         *********************************************************************/
+        void OpenSolutionDB(const std::string& processor, const std::string& tensileLibraryPath)
+        {
+            const char* db_path = getenv("ROCBLAS_SOLUTION_DB_PATH");
+            if(!db_path || !*db_path)
+                return;
+
+            const char* read_only_env = getenv("ROCBLAS_SOLUTION_DB_READONLY");
+            bool        read_only     = read_only_env && strtol(read_only_env, nullptr, 0);
+
+            size_t len;
+            rocblas_get_version_string_size(&len);
+            std::string version(len, '\0');
+            rocblas_get_version_string(&version[0], len);
+            version.resize(len - 1);
+
+            m_solution_db = std::make_unique<rocblas_solution_db>(
+                db_path, processor, version, LibraryHash(tensileLibraryPath), read_only);
+        }
+
+        /**********************************************************
+         * Parse the master solution library, timing the parsing *
+         **********************************************************/
+        static std::shared_ptr<Tensile::SolutionLibrary<Tensile::ContractionProblem>>
+            ParseLibrary(const std::string&                           path,
+                         const std::vector<Tensile::LazyLoadingInit>& preload)
+        {
+            init_phase_timer timer(init_timings().parse);
+            return Tensile::LoadLibraryFilePreload<Tensile::ContractionProblem>(path, preload);
         }
 
         /*******************************************************
@@ -642,12 +877,14 @@ namespace
                 static int once = [&] {
                     ftr_lib = std::async(
                         std::launch::async,
-                        Tensile::LoadLibraryFilePreload<Tensile::ContractionProblem>,
+                        ParseLibrary,
                         tensileLibraryPath,
                         std::vector<Tensile::LazyLoadingInit>{Tensile::LazyLoadingInit::All});
                     return 0;
                 }();
 
+                init_phase_timer timer(init_timings().code_object_load);
+
                 // only load modules for the current architecture
                 auto dir = path + "/*" + processor + "*co";
 
@@ -706,15 +943,15 @@ namespace
             else // initialize lazy loading
             {
                 static int once = [&] {
-                    ftr_lib
-                        = std::async(std::launch::async,
-                                     Tensile::LoadLibraryFilePreload<Tensile::ContractionProblem>,
-                                     tensileLibraryPath,
-                                     std::vector<Tensile::LazyLoadingInit>{});
+                    ftr_lib = std::async(std::launch::async,
+                                         ParseLibrary,
+                                         tensileLibraryPath,
+                                         std::vector<Tensile::LazyLoadingInit>{});
 
                     return 0;
                 }();
 
+                init_phase_timer timer(init_timings().adapter_init);
                 adapter.initializeLazyLoading(processor, path);
             }
 
@@ -729,6 +966,7 @@ namespace
                         using MSL = Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>;
                         m_library = std::dynamic_pointer_cast<MSL>(lib);
                     }
+                    OpenSolutionDB(processor, tensileLibraryPath);
                     return 0;
                 }();
             }
@@ -739,10 +977,13 @@ namespace
                 rocblas_abort();
             }
 
-            hipDeviceProp_t prop;
+            init_phase_timer timer(init_timings().adapter_init);
+            hipDeviceProp_t  prop;
             HIP_CHECK_EXC(hipGetDeviceProperties(&prop, deviceId));
 
-            m_deviceProp = std::make_shared<hipDeviceProp_t>(prop);
+            auto& a      = m_adapters.at(deviceId);
+            a.deviceProp = std::make_shared<hipDeviceProp_t>(prop);
+            a.hardware   = Tensile::hip::GetDevice(prop);
         }
     };
 
@@ -750,8 +991,10 @@ namespace
     auto& get_library_and_adapter(
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>>* library
         = nullptr,
-        std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1)
+        std::shared_ptr<hipDeviceProp_t>*   deviceProp  = nullptr,
+        int                                 device      = -1,
+        rocblas_solution_db**               solution_db = nullptr,
+        std::shared_ptr<Tensile::Hardware>* hardware    = nullptr)
     try
     {
         // TensileHost is initialized on the first call
@@ -774,7 +1017,10 @@ namespace
             if(!adapter)
             {
                 // Allocate a new adapter using the current HIP device
-                adapter = new Tensile::hip::SolutionAdapter;
+                {
+                    init_phase_timer timer(init_timings().adapter_init);
+                    adapter = new Tensile::hip::SolutionAdapter;
+                }
 
                 // Initialize the adapter and possibly the library
                 host.initialize(*adapter, device);
@@ -788,7 +1034,11 @@ namespace
         if(library)
             *library = host.get_library();
         if(deviceProp)
-            *deviceProp = host.get_device_property();
+            *deviceProp = a.deviceProp;
+        if(solution_db)
+            *solution_db = host.get_solution_db();
+        if(hardware)
+            *hardware = a.hardware;
 
         return *adapter;
     }
@@ -826,6 +1076,113 @@ namespace
             rocblas_cerr << msg << std::endl;
     }
 
+    /****************************************************************
+     * Initializes Tensile for a list of devices on worker threads, *
+     * one device per worker at a time                              *
+     ****************************************************************/
+    class tensile_warmup
+    {
+        mutable std::mutex       m_mutex;
+        std::condition_variable  m_done;
+        std::deque<int>          m_pending;
+        std::vector<std::thread> m_workers;
+        std::atomic<rocblas_int> m_requested{0};
+        std::atomic<rocblas_int> m_completed{0};
+        std::atomic<rocblas_int> m_failed{0};
+
+        void worker()
+        {
+            for(;;)
+            {
+                int device;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if(m_pending.empty())
+                        return;
+                    device = m_pending.front();
+                    m_pending.pop_front();
+                }
+
+                // The architecture is queried from the current HIP device
+                bool initialized = false;
+                if(hipSetDevice(device) == hipSuccess)
+                {
+                    try
+                    {
+                        get_library_and_adapter(nullptr, nullptr, device);
+                        initialized = true;
+                    }
+                    catch(...)
+                    {
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if(initialized)
+                    ++m_completed;
+                else
+                    ++m_failed;
+                m_done.notify_all();
+            }
+        }
+
+    public:
+        // Never destroyed, since ~TensileHost waits for the workers during static destruction
+        static tensile_warmup& instance()
+        {
+            static auto* warmup = new tensile_warmup;
+            return *warmup;
+        }
+
+        void start(const std::vector<int>& devices)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.insert(m_pending.end(), devices.begin(), devices.end());
+            m_requested += rocblas_int(devices.size());
+
+            // Workers exit once the queue is empty, so each request gets its own workers
+            size_t max_workers = std::max(std::thread::hardware_concurrency(), 1u);
+            size_t workers     = std::min(devices.size(), max_workers);
+            for(size_t i = 0; i < workers; ++i)
+                m_workers.emplace_back(&tensile_warmup::worker, this);
+        }
+
+        void progress(rocblas_int& requested, rocblas_int& completed, rocblas_int& failed) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            completed = m_completed;
+            failed    = m_failed;
+            requested = m_requested;
+        }
+
+        // If cancel is true, devices which no worker has started on are skipped, and counted as
+        // failed. Returns whether every device requested so far was initialized.
+        bool wait(bool cancel = false)
+        {
+            std::vector<std::thread> workers;
+            bool                     all_initialized;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if(cancel)
+                {
+                    m_failed += rocblas_int(m_pending.size());
+                    m_pending.clear();
+                }
+                m_done.wait(lock, [&] { return m_completed + m_failed == m_requested; });
+                workers.swap(m_workers);
+                all_initialized = m_failed == 0;
+            }
+            for(auto& worker : workers)
+                worker.join();
+            return all_initialized;
+        }
+    };
+
+    void tensile_warmup_wait(bool cancel)
+    {
+        tensile_warmup::instance().wait(cancel);
+    }
+
 } // namespace
 
 /******************************************************************************
@@ -845,28 +1202,83 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> library;
         std::shared_ptr<hipDeviceProp_t>                                             deviceProp;
         std::shared_ptr<Tensile::Hardware>                                           hardware;
+        rocblas_solution_db*                                                         solution_db;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->getDevice());
+        auto& adapter = get_library_and_adapter(
+            &library, &deviceProp, prob.handle->getDevice(), &solution_db, &hardware);
 
-        hardware = Tensile::hip::GetDevice(*deviceProp);
-
-        auto  tensile_prob  = ConstructTensileProblem(prob);
         auto  handle        = prob.handle;
         auto* fitness_query = handle->get_solution_fitness_query();
 
-        if(algo == rocblas_gemm_algo_solution_index && solution_index > 0)
+        // The solution cache and database are bypassed for fitness queries and explicit
+        // solution indices
+        bool select    = !fitness_query
+                      && !(algo == rocblas_gemm_algo_solution_index && solution_index > 0);
+        bool use_cache = select && handle->solution_cache.enabled();
+        bool use_db    = select && solution_db;
+        bool use_entry = use_cache || use_db;
+        bool cache_hit = false, db_hit = false, override_hit = false;
+        rocblas_solution_signature   signature{};
+        rocblas_solution_cache_entry cached;
+
+        if(use_entry)
+            signature = ConstructSolutionSignature(prob, *deviceProp);
+
+        if(use_cache)
+            cache_hit = handle->solution_cache.find(signature, cached);
+
+        // The problem depends only on the signature, so on a cache hit the problem constructed
+        // on the miss is reused, and only the pointers and scalars in the inputs are rebound
+        auto problem
+            = cache_hit ? std::static_pointer_cast<Tensile::ContractionProblem>(cached.problem)
+                        : std::make_shared<Tensile::ContractionProblem>(
+                            ConstructTensileProblem(prob));
+        const auto& tensile_prob = *problem;
+
+        if(cache_hit)
         {
-            solution = library->getSolutionByIndex(solution_index - 1);
-            // load solution if not already loaded
-            if(!solution)
-            {
-                library->findAllSolutions(tensile_prob, *hardware);
-                solution = library->getSolutionByIndex(solution_index - 1);
-            }
+            solution = std::static_pointer_cast<Tensile::ContractionSolution>(cached.solution);
+        }
+        else if(algo == rocblas_gemm_algo_solution_index && solution_index > 0)
+        {
+            solution = rocblas_get_solution_by_index(
+                *library, solution_index - 1, tensile_prob, *hardware);
         }
         else
         {
-            solution = library->findBestSolution(tensile_prob, *hardware, fitness_query);
+            // Use the tuned override for the problem, unless its solution cannot solve it
+            if(select && handle->gemm_overrides)
+            {
+                auto& overrides = *handle->gemm_overrides;
+                auto  it        = overrides.find(ConstructOverrideKey(prob));
+                if(it != overrides.end())
+                {
+                    solution = rocblas_get_solution_by_index(
+                        *library, it->second - 1, tensile_prob, *hardware);
+                    if(solution && !solution->canSolve(tensile_prob, *hardware))
+                        solution = nullptr;
+                    override_hit = solution != nullptr;
+                }
+            }
+
+            // Otherwise use the database's selection, loading its solution if the library has
+            // not loaded it yet, as it has not in a new process. A stale selection which cannot
+            // solve the problem is discarded, and the solution is selected again.
+            int64_t db_index;
+            if(!solution && use_db && solution_db->find(signature, db_index, cached.workspace_size))
+            {
+                solution
+                    = rocblas_get_solution_by_index(*library, db_index, tensile_prob, *hardware);
+                if(!solution || !solution->canSolve(tensile_prob, *hardware))
+                {
+                    solution_db->discard(signature);
+                    solution = nullptr;
+                }
+                db_hit = solution != nullptr;
+            }
+
+            if(!solution)
+                solution = library->findBestSolution(tensile_prob, *hardware, fitness_query);
         }
 
         if(!solution)
@@ -884,31 +1296,52 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
         }
         else
         {
+            // Remember the selection, its workspace and whether it can solve the problem
+            if(use_entry && !cache_hit)
+            {
+                cached.solution = solution;
+                cached.problem  = problem;
+                if(!db_hit)
+                    cached.workspace_size = solution->requiredWorkspaceSize(tensile_prob);
+                cached.can_solve = solution->canSolve(tensile_prob, *hardware);
+                if(use_cache)
+                    handle->solution_cache.insert(signature, cached);
+                if(use_db && !db_hit && !override_hit)
+                    solution_db->record(signature, solution->index, cached.workspace_size);
+            }
+
             if(fitness_query)
                 status = rocblas_status_success;
             else if(handle->is_device_memory_size_query())
             {
-                status = handle->set_optimal_device_memory_size(
-                    ((solution->requiredWorkspaceSize(tensile_prob)
-                      + HPA_GSU_WORKSPACE_SIZE_GRANULARITY - 1)
+                size_t WorkspaceSize = use_entry ? cached.workspace_size
+                                                 : solution->requiredWorkspaceSize(tensile_prob);
+                status               = handle->set_optimal_device_memory_size(
+                    ((WorkspaceSize + HPA_GSU_WORKSPACE_SIZE_GRANULARITY - 1)
                      / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
                     * HPA_GSU_WORKSPACE_SIZE_GRANULARITY);
             }
             else
             {
-                // check if the solution requires workspace for GSU and allocate it.
-                size_t WorkspaceSize = solution->requiredWorkspaceSize(tensile_prob);
-                auto   gsu_malloc    = prob.handle->gsu_malloc_by_size(WorkspaceSize);
-
-                if(solution->canSolve(tensile_prob, *hardware))
+                if(use_entry ? cached.can_solve : solution->canSolve(tensile_prob, *hardware))
                 {
                     if(!(prob.flags & rocblas_gemm_flags_check_solution_index))
                     {
+                        // check if the solution requires workspace for GSU and allocate it.
+                        // Nothing is allocated on the host when it requires none.
+                        size_t WorkspaceSize
+                            = use_entry ? cached.workspace_size
+                                        : solution->requiredWorkspaceSize(tensile_prob);
+                        std::optional<decltype(handle->gsu_malloc_by_size(0))> gsu_malloc;
+                        if(WorkspaceSize)
+                            gsu_malloc.emplace(handle->gsu_malloc_by_size(WorkspaceSize));
+
                         adapter.launchKernels(
                             solution->solve(tensile_prob, GetTensileInputs(prob), *hardware),
                             handle->get_stream(),
                             handle->startEvent,
                             handle->stopEvent);
+                        handle->last_gemm_solution_index = solution->index + 1;
                     }
                     status = rocblas_status_success;
                 }
@@ -943,11 +1376,10 @@ rocblas_status getAllSolutions(const RocblasContractionProblem<Ti, To, Tc>& prob
     try
     {
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> library;
-        std::shared_ptr<hipDeviceProp_t>                                             deviceProp;
         std::shared_ptr<Tensile::Hardware>                                           hardware;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->getDevice());
-        hardware      = Tensile::hip::GetDevice(*deviceProp);
+        auto& adapter = get_library_and_adapter(
+            &library, nullptr, prob.handle->getDevice(), nullptr, &hardware);
         auto tensile_prob = ConstructTensileProblem(prob);
 
         solutions = library->findAllSolutions(tensile_prob, *hardware);
@@ -997,6 +1429,77 @@ extern "C" void rocblas_initialize()
     get_library_and_adapter();
 }
 
+/*******************************************************************************
+ * ! \brief  Initialize rocBLAS for several HIP devices on background threads *
+ *******************************************************************************/
+extern "C" rocblas_status rocblas_initialize_async(const rocblas_int* devices, rocblas_int count)
+try
+{
+    if(count < 0)
+        return rocblas_status_invalid_size;
+    if(count && !devices)
+        return rocblas_status_invalid_pointer;
+
+    int device_count = 0;
+    if(hipGetDeviceCount(&device_count) != hipSuccess)
+        return rocblas_status_internal_error;
+
+    std::vector<int> ids;
+    if(count)
+    {
+        for(rocblas_int i = 0; i < count; ++i)
+        {
+            if(devices[i] < 0 || devices[i] >= device_count)
+                return rocblas_status_invalid_value;
+            ids.push_back(int(devices[i]));
+        }
+    }
+    else
+    {
+        for(int i = 0; i < device_count; ++i)
+            ids.push_back(i);
+    }
+
+    rocblas_initialize_called() = true;
+    tensile_warmup::instance().start(ids);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_query_initialize_progress(rocblas_initialize_progress* progress)
+try
+{
+    if(!progress)
+        return rocblas_status_invalid_pointer;
+
+    tensile_warmup::instance().progress(
+        progress->devices, progress->completed, progress->failed);
+
+    auto& timings                 = init_timings();
+    progress->parse_ms            = timings.parse * 1e-6;
+    progress->code_object_load_ms = timings.code_object_load * 1e-6;
+    progress->adapter_init_ms     = timings.adapter_init * 1e-6;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+extern "C" rocblas_status rocblas_initialize_wait()
+try
+{
+    return tensile_warmup::instance().wait() ? rocblas_status_success
+                                             : rocblas_status_internal_error;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /******************************************************************************
  * Intantiate the cases of runContractionProblem which are needed to satisfy  *
  * rocBLAS dependencies. This file's template functions are not defined in a  *